@@ -0,0 +1,346 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "compilation_workers.hpp"
+
+#include <dirent.h>
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <exception>
+#include <utility>
+
+#include <spdlog/spdlog.h>
+#include <tbb/task_scheduler_observer.h>
+
+#include "core_partitioning.hpp"
+#include "stringutils.hpp"
+
+namespace ovms {
+
+namespace {
+
+thread_local bool insideWorker = false;
+thread_local int callingThreadGuards = 0;
+
+const int MAX_NICE = 19;
+
+pid_t getThreadId() {
+    return static_cast<pid_t>(syscall(SYS_gettid));
+}
+
+void fillCpuSet(const std::vector<int>& cores, cpu_set_t& set) {
+    CPU_ZERO(&set);
+    for (int core : cores) {
+        CPU_SET(core, &set);
+    }
+}
+
+}  // namespace
+
+class CompilationWorkers::ArenaObserver : public tbb::task_scheduler_observer {
+public:
+    ArenaObserver(tbb::task_arena& arena, CompilationWorkers& workers) :
+        tbb::task_scheduler_observer(arena),
+        workers(workers) {
+        observe(true);
+    }
+
+    ~ArenaObserver() {
+        observe(false);
+    }
+
+    void on_scheduler_entry(bool) override {
+        workers.enterArena();
+    }
+
+    void on_scheduler_exit(bool) override {
+        workers.leaveArena();
+    }
+
+private:
+    CompilationWorkers& workers;
+};
+
+CompilationWorkers::CallingThreadGuard::CallingThreadGuard() {
+    callingThreadGuards++;
+}
+
+CompilationWorkers::CallingThreadGuard::~CallingThreadGuard() {
+    callingThreadGuards--;
+}
+
+CompilationWorkers::CompilationWorkers() = default;
+
+CompilationWorkers::~CompilationWorkers() {
+    stop();
+}
+
+Status CompilationWorkers::parseCores(const std::string& coresString, std::vector<int>& cores) {
+    cores.clear();
+    for (const std::string& range : tokenize(coresString, ',')) {
+        std::vector<std::string> bounds = tokenize(range, '-');
+        if (bounds.empty() || bounds.size() > 2) {
+            return StatusCode::COMPILATION_CORES_WRONG_FORMAT;
+        }
+        erase_spaces(bounds.front());
+        erase_spaces(bounds.back());
+        auto first = stou32(bounds.front());
+        auto last = stou32(bounds.back());
+        if (!first || !last || first.value() > last.value() || last.value() >= CPU_SETSIZE) {
+            return StatusCode::COMPILATION_CORES_WRONG_FORMAT;
+        }
+        for (uint32_t core = first.value(); core <= last.value(); core++) {
+            cores.push_back(core);
+        }
+    }
+    std::sort(cores.begin(), cores.end());
+    cores.erase(std::unique(cores.begin(), cores.end()), cores.end());
+    return StatusCode::OK;
+}
+
+Status CompilationWorkers::configure(uint32_t maxConcurrentCompilations, const std::string& coresString, int niceIncrement, const std::vector<int>& servingCores) {
+    stop();
+    auto status = parseCores(coresString, cores);
+    if (!status.ok()) {
+        return status;
+    }
+    auto available = CorePartitioning::getAvailableCores();
+    for (int core : cores) {
+        if (std::find(available.begin(), available.end(), core) == available.end()) {
+            SPDLOG_ERROR("Compilation core: {} is not available to the process", core);
+            return StatusCode::COMPILATION_CORES_WRONG_FORMAT;
+        }
+    }
+    this->servingCores = servingCores.empty() ? available : servingCores;
+    errno = 0;
+    servingNice = getpriority(PRIO_PROCESS, getThreadId());
+    if (errno != 0) {
+        servingNice = 0;
+    }
+    niceLevel = std::min(MAX_NICE, servingNice + std::max(0, niceIncrement));
+    if (maxConcurrentCompilations == 0 && cores.empty() && niceLevel == servingNice) {
+        return StatusCode::OK;
+    }
+    if (niceLevel != servingNice) {
+        // Threads created during compilation get serving priority back, lowering niceness requires CAP_SYS_NICE or RLIMIT_NICE
+        bool permitted = false;
+        std::thread probe([this, &permitted]() {
+            permitted = setpriority(PRIO_PROCESS, getThreadId(), niceLevel) == 0 &&
+                        setpriority(PRIO_PROCESS, getThreadId(), servingNice) == 0;
+        });
+        probe.join();
+        if (!permitted) {
+            return StatusCode::COMPILATION_PRIORITY_NOT_PERMITTED;
+        }
+    }
+    const uint32_t workersCount = std::max<uint32_t>(1, maxConcurrentCompilations);
+    // Parallel parts of compilation run in the arena, so they are bound by compilation cores instead of spreading to serving ones
+    const int hardwareConcurrency = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    const int concurrency = std::max<int>(workersCount, cores.empty() ? hardwareConcurrency : cores.size());
+    arena = std::make_unique<tbb::task_arena>(concurrency, std::min<int>(workersCount, concurrency));
+    arena->initialize();
+    observer = std::make_unique<ArenaObserver>(*arena, *this);
+    for (uint32_t i = 0; i < workersCount; i++) {
+        workers.emplace_back(&CompilationWorkers::run, this);
+    }
+    SPDLOG_INFO("Started {} model compilation workers; cores: {}; niceness: {}",
+        workersCount, cores.empty() ? "unrestricted" : coresString, niceLevel);
+    return StatusCode::OK;
+}
+
+Status CompilationWorkers::execute(const std::function<Status()>& load) {
+    if (insideWorker || callingThreadGuards > 0) {
+        return load();
+    }
+    CompilationTask task{load, {}};
+    auto result = task.result.get_future();
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        if (workers.empty() || stopRequested) {
+            return load();
+        }
+        tasks.push_back(std::move(task));
+    }
+    tasksNotify.notify_one();
+    return result.get();
+}
+
+void CompilationWorkers::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        stopRequested = true;
+    }
+    tasksNotify.notify_all();
+    for (auto& worker : workers) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+    observer.reset();
+    arena.reset();
+    std::lock_guard<std::mutex> lock(mtx);
+    workers.clear();
+    workerThreads.clear();
+    arenaThreads.clear();
+    stopRequested = false;
+}
+
+void CompilationWorkers::run() {
+    insideWorker = true;
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        workerThreads.insert(getThreadId());
+    }
+    isolateCurrentThread();
+    while (true) {
+        CompilationTask task;
+        {
+            std::unique_lock<std::mutex> lock(mtx);
+            tasksNotify.wait(lock, [this]() { return stopRequested || !tasks.empty(); });
+            // Loads queued before stop are still executed since their callers wait for results
+            if (tasks.empty()) {
+                return;
+            }
+            task = std::move(tasks.front());
+            tasks.pop_front();
+        }
+        auto threadsBefore = getThreads();
+        Status status;
+        std::exception_ptr error;
+        try {
+            arena->execute([&task, &status]() { status = task.load(); });
+        } catch (...) {
+            error = std::current_exception();
+        }
+        // Caller may start inference on the loaded model right after getting the result
+        restoreCreatedThreads(threadsBefore);
+        if (error) {
+            task.result.set_exception(error);
+        } else {
+            task.result.set_value(status);
+        }
+    }
+}
+
+void CompilationWorkers::isolateCurrentThread() {
+    if (!cores.empty()) {
+        cpu_set_t set;
+        fillCpuSet(cores, set);
+        if (sched_setaffinity(0, sizeof(set), &set) != 0) {
+            SPDLOG_WARN("Could not set compilation worker affinity; error: {}", errno);
+        }
+    }
+    if (niceLevel != servingNice && setpriority(PRIO_PROCESS, getThreadId(), niceLevel) != 0) {
+        SPDLOG_WARN("Could not set compilation worker niceness; error: {}", errno);
+    }
+}
+
+void CompilationWorkers::enterArena() {
+    // Workers keep their settings, TBB threads are isolated only while they help with compilation
+    if (insideWorker) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        arenaThreads.insert(getThreadId());
+    }
+    isolateCurrentThread();
+}
+
+void CompilationWorkers::leaveArena() {
+    if (insideWorker) {
+        return;
+    }
+    if (!cores.empty()) {
+        cpu_set_t set;
+        fillCpuSet(servingCores, set);
+        if (sched_setaffinity(0, sizeof(set), &set) != 0) {
+            SPDLOG_WARN("Could not restore affinity of thread leaving compilation; error: {}", errno);
+        }
+    }
+    if (niceLevel != servingNice && setpriority(PRIO_PROCESS, getThreadId(), servingNice) != 0) {
+        SPDLOG_WARN("Could not restore niceness of thread leaving compilation; error: {}", errno);
+    }
+    std::lock_guard<std::mutex> lock(mtx);
+    arenaThreads.erase(getThreadId());
+}
+
+std::set<pid_t> CompilationWorkers::getThreads() {
+    std::set<pid_t> threads;
+    DIR* dir = opendir("/proc/self/task");
+    if (dir == nullptr) {
+        return threads;
+    }
+    while (struct dirent* entry = readdir(dir)) {
+        if (entry->d_name[0] != '.') {
+            threads.insert(static_cast<pid_t>(std::atoi(entry->d_name)));
+        }
+    }
+    closedir(dir);
+    return threads;
+}
+
+void CompilationWorkers::restoreCreatedThreads(const std::set<pid_t>& threadsBefore) {
+    if (cores.empty() && niceLevel == servingNice) {
+        return;
+    }
+    std::lock_guard<std::mutex> restoreLock(restoreMtx);
+    cpu_set_t workerSet, servingSet;
+    fillCpuSet(cores, workerSet);
+    fillCpuSet(servingCores, servingSet);
+    size_t restored = 0;
+    for (pid_t thread : getThreads()) {
+        if (threadsBefore.count(thread)) {
+            continue;
+        }
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            // Threads still working in the arena may be compiling for another worker, they are restored when leaving it
+            if (workerThreads.count(thread) || arenaThreads.count(thread)) {
+                continue;
+            }
+        }
+        // Threads created meanwhile by other server components do not carry worker settings
+        if (!cores.empty()) {
+            cpu_set_t set;
+            if (sched_getaffinity(thread, sizeof(set), &set) != 0 || !CPU_EQUAL(&set, &workerSet)) {
+                continue;
+            }
+        }
+        if (niceLevel != servingNice) {
+            errno = 0;
+            int nice = getpriority(PRIO_PROCESS, thread);
+            if (errno != 0 || nice != niceLevel) {
+                continue;
+            }
+        }
+        if (!cores.empty() && sched_setaffinity(thread, sizeof(servingSet), &servingSet) != 0) {
+            SPDLOG_WARN("Could not restore affinity of thread: {}; error: {}", thread, errno);
+        }
+        if (niceLevel != servingNice && setpriority(PRIO_PROCESS, thread, servingNice) != 0) {
+            SPDLOG_WARN("Could not restore niceness of thread: {}; error: {}", thread, errno);
+        }
+        restored++;
+    }
+    SPDLOG_DEBUG("Moved {} threads created during model compilation to serving cores and priority", restored);
+}
+
+}  // namespace ovms
@@ -0,0 +1,134 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <sys/types.h>
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <tbb/task_arena.h>
+
+#include "status.hpp"
+
+namespace ovms {
+
+/**
+ * @brief Dedicated threads loading and compiling models, isolated from cores and priority of inference threads.
+ * Loads run in TBB arena limited to number of compilation cores, threads joining the arena get worker settings
+ * and get serving cores and priority back when they leave it. Other threads created during compilation inherit
+ * worker affinity and niceness, so after each load threads which appeared and still carry the worker settings
+ * are moved back to serving cores and priority.
+ */
+class CompilationWorkers {
+public:
+    static CompilationWorkers& instance() {
+        static CompilationWorkers instance;
+        return instance;
+    }
+
+    ~CompilationWorkers();
+
+    /**
+     * @brief Starts workers. With no limit, cores and niceness set, loads run in calling thread.
+     *
+     * @param maxConcurrentCompilations number of workers, 0 means one worker when cores or niceness are set
+     * @param coresString cores of workers in format 0-3,8, empty does not restrict cores
+     * @param niceIncrement niceness added to worker threads
+     * @param servingCores cores of inference threads, empty means cores available to the process
+     */
+    Status configure(uint32_t maxConcurrentCompilations, const std::string& coresString, int niceIncrement, const std::vector<int>& servingCores);
+
+    /**
+     * @brief Parses cores list in format 0-3,8,10-11
+     */
+    static Status parseCores(const std::string& coresString, std::vector<int>& cores);
+
+    /**
+     * @brief Runs load in one of the workers and waits for its result. Exceptions are rethrown in calling thread.
+     * Threads created by the load are moved back to serving cores and priority before the result is returned.
+     */
+    Status execute(const std::function<Status()>& load);
+
+    /**
+     * @brief Loads started by the thread while the guard exists run in that thread, with its cores and priority.
+     * Used by reloads requested by inference, which must not wait behind other loads.
+     */
+    class CallingThreadGuard {
+    public:
+        CallingThreadGuard();
+        ~CallingThreadGuard();
+        CallingThreadGuard(const CallingThreadGuard&) = delete;
+        CallingThreadGuard& operator=(const CallingThreadGuard&) = delete;
+    };
+
+    void stop();
+
+    bool isEnabled() const {
+        return !workers.empty();
+    }
+
+private:
+    struct CompilationTask {
+        std::function<Status()> load;
+        std::promise<Status> result;
+    };
+
+    class ArenaObserver;
+
+    CompilationWorkers();
+
+    void run();
+
+    void isolateCurrentThread();
+
+    void enterArena();
+
+    void leaveArena();
+
+    /**
+     * @brief Moves threads created by the load which inherited worker settings back to serving cores and priority
+     */
+    void restoreCreatedThreads(const std::set<pid_t>& threadsBefore);
+
+    static std::set<pid_t> getThreads();
+
+    std::vector<int> cores;
+    std::vector<int> servingCores;
+    int servingNice = 0;
+    int niceLevel = 0;
+
+    std::mutex mtx;
+    std::condition_variable tasksNotify;
+    std::deque<CompilationTask> tasks;
+    bool stopRequested = false;
+    std::vector<std::thread> workers;
+    std::set<pid_t> workerThreads;
+    std::set<pid_t> arenaThreads;
+    std::mutex restoreMtx;
+    std::unique_ptr<tbb::task_arena> arena;
+    std::unique_ptr<ArenaObserver> observer;
+};
+
+}  // namespace ovms
@@ -0,0 +1,145 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+// Measures notifications about finished nodes of wide pipelines. In every round each of N producer threads,
+// simulating inference callbacks of N parallel nodes, pushes one notification and the consumer, simulating
+// the pipeline, pulls all of them before starting the next round.
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <iostream>
+#include <mutex>
+#include <optional>
+#include <queue>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "threadsafequeue.hpp"
+
+using namespace ovms;
+
+namespace {
+const uint WAIT_TIMEOUT_MICROSECONDS = 10'000'000;
+
+// queue used for node notifications before lock-free one
+template <typename T>
+class MutexQueue {
+public:
+    void push(const T& element) {
+        std::unique_lock<std::mutex> lock(mtx);
+        queue.push(element);
+        lock.unlock();
+        signal.notify_one();
+    }
+
+    std::optional<T> tryPull(const uint waitDurationMicroseconds) {
+        std::unique_lock<std::mutex> lock(mtx);
+        if (!signal.wait_for(lock, std::chrono::microseconds(waitDurationMicroseconds), [this]() { return queue.size() > 0; })) {
+            return std::nullopt;
+        }
+        T element = queue.front();
+        queue.pop();
+        return element;
+    }
+
+private:
+    std::mutex mtx;
+    std::queue<T> queue;
+    std::condition_variable signal;
+};
+
+template <typename Queue>
+void benchmarkQueue(const std::string& name, size_t width, size_t rounds, size_t workIterations) {
+    Queue queue;
+    std::atomic<size_t> round{0};
+    std::atomic<bool> stop{false};
+    std::vector<std::thread> producers;
+    for (size_t node = 0; node < width; ++node) {
+        producers.emplace_back([&queue, &round, &stop, node, workIterations]() {
+            size_t done = 0;
+            volatile size_t work = 0;
+            while (true) {
+                while (round.load(std::memory_order_acquire) == done && !stop.load(std::memory_order_relaxed)) {
+                    std::this_thread::yield();
+                }
+                if (stop.load(std::memory_order_relaxed)) {
+                    return;
+                }
+                ++done;
+                for (size_t i = 0; i < workIterations; ++i) {
+                    work = work + i;
+                }
+                queue.push(node);
+            }
+        });
+    }
+    size_t pulled = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t r = 1; r <= rounds; ++r) {
+        round.store(r, std::memory_order_release);
+        for (size_t i = 0; i < width; ++i) {
+            if (queue.tryPull(WAIT_TIMEOUT_MICROSECONDS)) {
+                ++pulled;
+            }
+        }
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    stop.store(true);
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    std::cout << "  " << name << ": " << seconds * 1'000'000 / static_cast<double>(rounds) << " us per round; "
+              << static_cast<double>(pulled) / seconds << " notifications/s" << std::endl;
+    if (pulled != width * rounds) {
+        std::cout << "  " << name << ": lost " << width * rounds - pulled << " notifications" << std::endl;
+    }
+}
+
+void printUsage(const char* name) {
+    std::cout << "Usage: " << name << " [options]\n"
+              << "  --width <N>    parallel nodes, can be repeated, default: 16 32 64\n"
+              << "  --rounds <N>   pipeline executions, default: 10000\n"
+              << "  --work <N>     busy loop iterations of each node before notification, default: 0\n";
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+    std::vector<size_t> widths;
+    size_t rounds = 10000;
+    size_t work = 0;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--width" && i + 1 < argc) {
+            widths.push_back(std::stoul(argv[++i]));
+        } else if (arg == "--rounds" && i + 1 < argc) {
+            rounds = std::stoul(argv[++i]);
+        } else if (arg == "--work" && i + 1 < argc) {
+            work = std::stoul(argv[++i]);
+        } else {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+    if (widths.empty()) {
+        widths = {16, 32, 64};
+    }
+    for (size_t width : widths) {
+        std::cout << "width " << width << std::endl;
+        benchmarkQueue<MutexQueue<size_t>>("mutex + condition_variable", width, rounds, work);
+        benchmarkQueue<ThreadSafeQueue<size_t>>("lock-free + futex", width, rounds, work);
+    }
+    return 0;
+}
@@ -58,6 +58,34 @@ Config& Config::parse(int argc, char** argv) {
                 "number of workers in REST server - has no effect if rest_port is not set",
                 cxxopts::value<uint>()->default_value(DEFAULT_REST_WORKERS_STRING.c_str()),
                 "REST_WORKERS")
+            ("rest_compression_threshold",
+                "minimal size in bytes of REST response to be gzip compressed when client accepts gzip encoding. Default 0 disables compression",
+                cxxopts::value<uint64_t>()->default_value("0"),
+                "BYTES")
+            ("cpu_threads_budget",
+                "total number of CPU threads divided between models served on CPU proportionally to their cpu_weight. Default 0 does not limit models threads",
+                cxxopts::value<uint64_t>()->default_value("0"),
+                "CPU_THREADS_BUDGET")
+            ("core_partitioning",
+                "ratios of cores assigned to server threads roles, eg io=1,serialization=1,inference=6. Threads of each role are bound to their cores. Default empty does not bind threads",
+                cxxopts::value<std::string>(), "CORE_PARTITIONING")
+            ("max_concurrent_compilations",
+                "maximum number of models loaded and compiled at the same time in dedicated workers. Default 0 loads models in the thread requesting the load unless compilation_cores or compilation_nice is set",
+                cxxopts::value<uint32_t>()->default_value("0"),
+                "MAX_CONCURRENT_COMPILATIONS")
+            ("compilation_cores",
+                "cores of workers loading and compiling models, eg 0-1,6, also bounds the number of threads compiling in parallel. Threads created by OpenVINO during compilation are moved to inference cores afterwards. Default empty does not restrict cores",
+                cxxopts::value<std::string>(), "COMPILATION_CORES")
+            ("compilation_nice",
+                "niceness from 0 to 19 added to workers loading and compiling models. Default 0",
+                cxxopts::value<int>()->default_value("0"),
+                "COMPILATION_NICE")
+            ("share_identical_models",
+                "model versions with identical files and load settings use one compiled network and its infer requests",
+                cxxopts::value<bool>()->default_value("false"))
+            ("cpu_profiler",
+                "enables REST endpoint /v1/profiler/cpu returning sampled call stacks of server threads in folded stacks format",
+                cxxopts::value<bool>()->default_value("false"))
             ("log_level",
                 "serving log level - one of DEBUG, INFO, ERROR",
                 cxxopts::value<std::string>()->default_value("INFO"), "LOG_LEVEL")
@@ -170,6 +198,11 @@ void Config::validate() {
         exit(EX_USAGE);
     }
 
+    if (this->compilationNice() < 0 || this->compilationNice() > 19) {
+        std::cerr << "compilation_nice should be from 0 to 19" << std::endl;
+        exit(EX_USAGE);
+    }
+
     // check docker ports
     if (result->count("port") && ((this->port() > MAX_PORT_NUMBER) || (this->port() < 0))) {
         std::cerr << "port number out of range from 0 to " << MAX_PORT_NUMBER << std::endl;
@@ -125,6 +125,24 @@ public:
         return result->operator[]("rest_workers").as<uint>();
     }
 
+    /**
+         * @brief Gets the minimal size of REST response to be compressed
+         * 
+         * @return uint64_t
+         */
+    uint64_t restCompressionThreshold() {
+        return result->operator[]("rest_compression_threshold").as<uint64_t>();
+    }
+
+    /**
+         * @brief Gets the number of CPU threads shared by models served on CPU
+         * 
+         * @return uint64_t
+         */
+    uint64_t cpuThreadsBudget() {
+        return result->operator[]("cpu_threads_budget").as<uint64_t>();
+    }
+
     /**
          * @brief Get the model name
          * 
@@ -236,6 +254,64 @@ public:
         return empty;
     }
 
+    /**
+        * @brief Get the ratios of cores assigned to server threads roles
+        *
+        * @return const std::string&
+        */
+    const std::string& corePartitioning() {
+        if (result->count("core_partitioning"))
+            return result->operator[]("core_partitioning").as<std::string>();
+        return empty;
+    }
+
+    /**
+        * @brief Get the maximum number of models compiled at the same time
+        *
+        * @return uint32_t
+        */
+    uint32_t maxConcurrentCompilations() {
+        return result->operator[]("max_concurrent_compilations").as<uint32_t>();
+    }
+
+    /**
+        * @brief Get the cores of model compilation workers
+        *
+        * @return const std::string&
+        */
+    const std::string& compilationCores() {
+        if (result->count("compilation_cores"))
+            return result->operator[]("compilation_cores").as<std::string>();
+        return empty;
+    }
+
+    /**
+        * @brief Get the niceness added to model compilation workers
+        *
+        * @return int
+        */
+    int compilationNice() {
+        return result->operator[]("compilation_nice").as<int>();
+    }
+
+    /**
+        * @brief Are identical model versions sharing compiled network
+        *
+        * @return bool
+        */
+    bool shareIdenticalModels() {
+        return result->operator[]("share_identical_models").as<bool>();
+    }
+
+    /**
+        * @brief Is CPU profiler endpoint enabled
+        *
+        * @return bool
+        */
+    bool cpuProfiler() {
+        return result->operator[]("cpu_profiler").as<bool>();
+    }
+
     /**
         * @brief Get the plugin config
         *
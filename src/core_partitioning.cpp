@@ -0,0 +1,166 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "core_partitioning.hpp"
+
+#include <pthread.h>
+#include <sched.h>
+
+#include <algorithm>
+
+#include <spdlog/spdlog.h>
+
+#include "stringutils.hpp"
+
+namespace ovms {
+
+static const std::map<std::string, ThreadRole> roleNames{
+    {"io", ThreadRole::IO},
+    {"serialization", ThreadRole::SERIALIZATION},
+    {"inference", ThreadRole::INFERENCE}};
+
+Status CorePartitioning::parseRatios(const std::string& ratiosString, std::map<ThreadRole, uint32_t>& ratios) {
+    ratios = {{ThreadRole::IO, 0}, {ThreadRole::SERIALIZATION, 0}, {ThreadRole::INFERENCE, 0}};
+    for (const std::string& ratioString : tokenize(ratiosString, ',')) {
+        std::vector<std::string> keyVal = tokenize(ratioString, '=');
+        if (keyVal.size() != 2) {
+            return StatusCode::CORE_PARTITIONING_WRONG_FORMAT;
+        }
+        erase_spaces(keyVal[0]);
+        erase_spaces(keyVal[1]);
+        auto role = roleNames.find(keyVal[0]);
+        if (role == roleNames.end()) {
+            return StatusCode::CORE_PARTITIONING_WRONG_FORMAT;
+        }
+        auto ratio = stou32(keyVal[1]);
+        if (!ratio) {
+            return StatusCode::CORE_PARTITIONING_WRONG_FORMAT;
+        }
+        ratios[role->second] = ratio.value();
+    }
+    if (ratios[ThreadRole::INFERENCE] == 0) {
+        return StatusCode::CORE_PARTITIONING_WRONG_FORMAT;
+    }
+    return StatusCode::OK;
+}
+
+bool CorePartitioning::partition(const std::vector<int>& cores, const std::map<ThreadRole, uint32_t>& ratios, std::map<ThreadRole, std::vector<int>>& result) {
+    uint64_t totalRatio = 0;
+    size_t rolesCount = 0;
+    for (const auto& [role, ratio] : ratios) {
+        totalRatio += ratio;
+        rolesCount += ratio > 0 ? 1 : 0;
+    }
+    if (totalRatio == 0 || cores.size() < rolesCount) {
+        return false;
+    }
+    std::map<ThreadRole, size_t> counts;
+    size_t assigned = 0;
+    for (const auto& [role, ratio] : ratios) {
+        if (ratio == 0) {
+            continue;
+        }
+        counts[role] = std::max<size_t>(1, cores.size() * ratio / totalRatio);
+        assigned += counts[role];
+    }
+    // Rounding leftovers go to inference, excess caused by minimum of one core is taken from the largest roles
+    while (assigned < cores.size()) {
+        counts[ThreadRole::INFERENCE]++;
+        assigned++;
+    }
+    while (assigned > cores.size()) {
+        auto largest = std::max_element(counts.begin(), counts.end(),
+            [](const auto& lhs, const auto& rhs) { return lhs.second < rhs.second; });
+        largest->second--;
+        assigned--;
+    }
+    result.clear();
+    auto next = cores.begin();
+    for (const auto& [role, count] : counts) {
+        result[role].assign(next, next + count);
+        next += count;
+    }
+    // Roles without dedicated cores share them with inference
+    for (const auto& [role, ratio] : ratios) {
+        if (ratio == 0) {
+            result[role] = result[ThreadRole::INFERENCE];
+        }
+    }
+    return true;
+}
+
+std::vector<int> CorePartitioning::getAvailableCores() {
+    std::vector<int> cores;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(0, sizeof(set), &set) != 0) {
+        return cores;
+    }
+    for (int core = 0; core < CPU_SETSIZE; core++) {
+        if (CPU_ISSET(core, &set)) {
+            cores.push_back(core);
+        }
+    }
+    return cores;
+}
+
+Status CorePartitioning::configure(const std::string& ratiosString) {
+    enabled = false;
+    cores.clear();
+    if (ratiosString.empty()) {
+        return StatusCode::OK;
+    }
+    std::map<ThreadRole, uint32_t> ratios;
+    auto status = parseRatios(ratiosString, ratios);
+    if (!status.ok()) {
+        return status;
+    }
+    auto available = getAvailableCores();
+    if (!partition(available, ratios, cores)) {
+        SPDLOG_WARN("Core partitioning is disabled since there are only {} cores available", available.size());
+        return StatusCode::OK;
+    }
+    enabled = true;
+    for (const auto& [name, role] : roleNames) {
+        SPDLOG_INFO("Threads role: {} assigned {} cores starting from core: {}", name, cores[role].size(), cores[role].front());
+    }
+    return StatusCode::OK;
+}
+
+const std::vector<int>& CorePartitioning::getCores(ThreadRole role) const {
+    static const std::vector<int> none;
+    auto it = cores.find(role);
+    if (it == cores.end()) {
+        return none;
+    }
+    return it->second;
+}
+
+void CorePartitioning::applyToCurrentThread(ThreadRole role) const {
+    if (!enabled) {
+        return;
+    }
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int core : getCores(role)) {
+        CPU_SET(core, &set);
+    }
+    int result = pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+    if (result != 0) {
+        SPDLOG_WARN("Could not set threads affinity; error: {}", result);
+    }
+}
+
+}  // namespace ovms
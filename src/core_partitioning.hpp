@@ -0,0 +1,90 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "status.hpp"
+
+namespace ovms {
+
+/**
+ * @brief Kinds of server threads which get separate sets of cores
+ */
+enum class ThreadRole {
+    IO,             // gRPC server threads and HTTP event loop
+    SERIALIZATION,  // REST workers parsing and serializing JSON
+    INFERENCE       // OpenVINO streams and threads created while loading models
+};
+
+/**
+ * @brief Assigns disjoint sets of cores available to the process to thread roles proportionally to configured ratios.
+ * Affinity is applied to the thread creating threads of given role, so that created threads inherit it.
+ */
+class CorePartitioning {
+public:
+    static CorePartitioning& instance() {
+        static CorePartitioning instance;
+        return instance;
+    }
+
+    /**
+     * @brief Parses ratios in format io=1,serialization=1,inference=6 and partitions cores available to the process.
+     * Empty string disables partitioning.
+     */
+    Status configure(const std::string& ratiosString);
+
+    /**
+     * @brief Parses ratios in format io=1,serialization=1,inference=6. Missing roles get ratio 0 and share inference cores.
+     */
+    static Status parseRatios(const std::string& ratiosString, std::map<ThreadRole, uint32_t>& ratios);
+
+    /**
+     * @brief Splits cores into consecutive ranges proportional to ratios, each role with non zero ratio gets at least one core
+     *
+     * @return false if there are not enough cores
+     */
+    static bool partition(const std::vector<int>& cores, const std::map<ThreadRole, uint32_t>& ratios, std::map<ThreadRole, std::vector<int>>& result);
+
+    /**
+     * @brief Cores the process is allowed to run on
+     */
+    static std::vector<int> getAvailableCores();
+
+    bool isEnabled() const {
+        return enabled;
+    }
+
+    /**
+     * @brief Cores assigned to role, empty when partitioning is disabled
+     */
+    const std::vector<int>& getCores(ThreadRole role) const;
+
+    /**
+     * @brief Binds calling thread to cores of given role. Threads created afterwards by calling thread inherit its affinity.
+     */
+    void applyToCurrentThread(ThreadRole role) const;
+
+private:
+    CorePartitioning() = default;
+
+    bool enabled = false;
+    std::map<ThreadRole, std::vector<int>> cores;
+};
+
+}  // namespace ovms
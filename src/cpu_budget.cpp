@@ -0,0 +1,42 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "cpu_budget.hpp"
+
+#include <algorithm>
+
+#include <spdlog/spdlog.h>
+
+namespace ovms {
+
+void assignCpuThreadsBudget(std::vector<ModelConfig>& configs, uint64_t totalThreads) {
+    uint64_t totalWeight = 0;
+    for (const auto& config : configs) {
+        if (config.isDeviceUsed("CPU")) {
+            totalWeight += config.getCpuWeight();
+        }
+    }
+    for (auto& config : configs) {
+        if (totalThreads == 0 || totalWeight == 0 || !config.isDeviceUsed("CPU")) {
+            config.setCpuThreadsBudget(0);
+            continue;
+        }
+        const uint64_t threads = std::max<uint64_t>(1, totalThreads * config.getCpuWeight() / totalWeight);
+        config.setCpuThreadsBudget(threads);
+        SPDLOG_DEBUG("Model: {} assigned {} of {} CPU threads; weight: {}", config.getName(), threads, totalThreads, config.getCpuWeight());
+    }
+}
+
+}  // namespace ovms
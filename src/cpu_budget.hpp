@@ -0,0 +1,34 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "modelconfig.hpp"
+
+namespace ovms {
+
+/**
+ * @brief Divides global CPU threads budget between models served on CPU proportionally to their configured weights.
+ * Each model using CPU gets at least one thread. Models not using CPU are not limited.
+ *
+ * @param configs models configurations
+ * @param totalThreads number of threads to divide, 0 disables the budget
+ */
+void assignCpuThreadsBudget(std::vector<ModelConfig>& configs, uint64_t totalThreads);
+
+}  // namespace ovms
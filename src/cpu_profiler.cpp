@@ -0,0 +1,286 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "cpu_profiler.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <thread>
+#include <unordered_map>
+
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <signal.h>
+#include <sys/syscall.h>
+#include <sys/time.h>
+#include <sys/uio.h>
+#include <ucontext.h>
+#include <unistd.h>
+
+#include <rapidjson/document.h>
+#include <spdlog/spdlog.h>
+
+namespace ovms {
+
+std::atomic<bool> CpuProfiler::sampling{false};
+std::atomic<int> CpuProfiler::handlersRunning{0};
+std::atomic<size_t> CpuProfiler::nextSample{0};
+std::atomic<size_t> CpuProfiler::droppedSamples{0};
+size_t CpuProfiler::samplesCapacity = 0;
+std::unique_ptr<CpuProfilerSample[]> CpuProfiler::samples;
+
+// Frames larger than this end the walk, corrupted frame pointers rarely point close above the current frame
+static const uintptr_t MAX_FRAME_SIZE = 1 << 20;
+
+// Reads memory with a syscall, so that corrupted frame pointer makes it fail instead of crashing signal handler
+static bool readStackWords(uintptr_t address, uintptr_t* words, size_t count) {
+    struct iovec local = {words, count * sizeof(uintptr_t)};
+    struct iovec remote = {reinterpret_cast<void*>(address), count * sizeof(uintptr_t)};
+    return process_vm_readv(getpid(), &local, 1, &remote, 1, 0) == static_cast<ssize_t>(count * sizeof(uintptr_t));
+}
+
+int CpuProfiler::walkFramePointers(uintptr_t pc, uintptr_t framePointer, uintptr_t stackPointer, void** frames, int maxDepth) {
+    if (maxDepth <= 0 || pc == 0) {
+        return 0;
+    }
+    int depth = 0;
+    frames[depth++] = reinterpret_cast<void*>(pc);
+    uintptr_t lowerBound = stackPointer;
+    while (depth < maxDepth) {
+        // Stack grows down, each caller frame is aligned and above the previous one
+        if (framePointer % sizeof(uintptr_t) != 0 || framePointer < lowerBound || framePointer - lowerBound > MAX_FRAME_SIZE) {
+            break;
+        }
+        // Saved frame pointer of the caller followed by return address
+        uintptr_t frame[2];
+        if (!readStackWords(framePointer, frame, 2) || frame[1] == 0) {
+            break;
+        }
+        frames[depth++] = reinterpret_cast<void*>(frame[1]);
+        if (frame[0] <= framePointer) {
+            break;
+        }
+        lowerBound = framePointer + 2 * sizeof(uintptr_t);
+        framePointer = frame[0];
+    }
+    return depth;
+}
+
+void CpuProfiler::handleSignal(int signal, siginfo_t* info, void* context) {
+    int savedErrno = errno;
+    handlersRunning.fetch_add(1);
+    if (sampling.load()) {
+        size_t index = nextSample.fetch_add(1);
+        if (index < samplesCapacity) {
+            auto& sample = samples[index];
+            sample.threadId = static_cast<int>(syscall(SYS_gettid));
+            // glibc backtrace is not async-signal-safe, stack of interrupted code is walked from its registers
+            const auto& registers = static_cast<ucontext_t*>(context)->uc_mcontext;
+            int depth = 0;
+#if defined(__x86_64__)
+            depth = walkFramePointers(registers.gregs[REG_RIP], registers.gregs[REG_RBP], registers.gregs[REG_RSP],
+                sample.frames, CpuProfilerSample::MAX_DEPTH);
+#elif defined(__aarch64__)
+            depth = walkFramePointers(registers.pc, registers.regs[29], registers.sp,
+                sample.frames, CpuProfilerSample::MAX_DEPTH);
+#endif
+            sample.depth.store(depth, std::memory_order_release);
+        } else {
+            droppedSamples.fetch_add(1);
+        }
+    }
+    handlersRunning.fetch_sub(1);
+    errno = savedErrno;
+}
+
+Status CpuProfiler::parseRequest(const std::string& body, std::chrono::seconds& duration, uint32_t& frequency) {
+    duration = std::chrono::seconds(DEFAULT_DURATION_SECONDS);
+    frequency = DEFAULT_FREQUENCY;
+    if (body.empty()) {
+        return StatusCode::OK;
+    }
+    rapidjson::Document doc;
+    if (doc.Parse(body.c_str()).HasParseError() || !doc.IsObject()) {
+        return StatusCode::CPU_PROFILER_INVALID_PARAMETERS;
+    }
+    if (doc.HasMember("duration_seconds")) {
+        const auto& value = doc["duration_seconds"];
+        if (!value.IsUint() || value.GetUint() == 0 || value.GetUint() > MAX_DURATION_SECONDS) {
+            return StatusCode::CPU_PROFILER_INVALID_PARAMETERS;
+        }
+        duration = std::chrono::seconds(value.GetUint());
+    }
+    if (doc.HasMember("frequency")) {
+        const auto& value = doc["frequency"];
+        if (!value.IsUint() || value.GetUint() == 0 || value.GetUint() > MAX_FREQUENCY) {
+            return StatusCode::CPU_PROFILER_INVALID_PARAMETERS;
+        }
+        frequency = value.GetUint();
+    }
+    return StatusCode::OK;
+}
+
+Status CpuProfiler::profile(std::chrono::seconds duration, uint32_t frequency, std::string& foldedStacks) {
+    if (!enabled) {
+        return StatusCode::CPU_PROFILER_DISABLED;
+    }
+    std::unique_lock<std::mutex> lock(mtx, std::try_to_lock);
+    if (!lock.owns_lock()) {
+        return StatusCode::CPU_PROFILER_ALREADY_RUNNING;
+    }
+    auto threads = std::max(std::thread::hardware_concurrency(), 1u);
+    samplesCapacity = std::min<size_t>(MAX_SAMPLES, duration.count() * frequency * threads);
+    SPDLOG_INFO("Starting CPU profiling for {} seconds with frequency {} Hz", duration.count(), frequency);
+    auto status = start(frequency);
+    if (!status.ok()) {
+        return status;
+    }
+    std::this_thread::sleep_for(duration);
+    stop();
+    foldedStacks = collect();
+    SPDLOG_INFO("Finished CPU profiling; collected samples: {}; dropped samples: {}",
+        std::min(nextSample.load(), samplesCapacity), droppedSamples.load());
+    samples.reset();
+    return StatusCode::OK;
+}
+
+Status CpuProfiler::start(uint32_t frequency) {
+    static bool handlerInstalled = false;
+    if (!handlerInstalled) {
+        struct sigaction action = {};
+        action.sa_sigaction = &CpuProfiler::handleSignal;
+        action.sa_flags = SA_RESTART | SA_SIGINFO;
+        sigemptyset(&action.sa_mask);
+        if (sigaction(SIGPROF, &action, nullptr) != 0) {
+            SPDLOG_ERROR("Failed to install CPU profiler signal handler: {}", errno);
+            return StatusCode::CPU_PROFILER_START_FAILED;
+        }
+        // Handler stays installed, so that signals pending after profiling do not terminate process
+        handlerInstalled = true;
+    }
+    samples = std::make_unique<CpuProfilerSample[]>(samplesCapacity);
+    nextSample = 0;
+    droppedSamples = 0;
+    sampling = true;
+
+    struct itimerval timer = {};
+    // tv_usec must stay below one second, longer periods are expressed with tv_sec
+    const uint64_t periodMicroseconds = 1000000 / frequency;
+    timer.it_interval.tv_sec = periodMicroseconds / 1000000;
+    timer.it_interval.tv_usec = periodMicroseconds % 1000000;
+    timer.it_value = timer.it_interval;
+    if (setitimer(ITIMER_PROF, &timer, nullptr) != 0) {
+        SPDLOG_ERROR("Failed to start CPU profiler timer: {}", errno);
+        stop();
+        samples.reset();
+        return StatusCode::CPU_PROFILER_START_FAILED;
+    }
+    return StatusCode::OK;
+}
+
+void CpuProfiler::stop() {
+    struct itimerval timer = {};
+    setitimer(ITIMER_PROF, &timer, nullptr);
+    sampling = false;
+    while (handlersRunning.load() > 0) {
+        std::this_thread::yield();
+    }
+}
+
+static std::string getThreadName(int threadId) {
+    std::ifstream comm("/proc/self/task/" + std::to_string(threadId) + "/comm");
+    std::string name;
+    if (!std::getline(comm, name) || name.empty()) {
+        name = "thread-" + std::to_string(threadId);
+    }
+    return name;
+}
+
+static std::string symbolize(void* address) {
+    Dl_info info;
+    if (dladdr(address, &info) == 0) {
+        std::stringstream ss;
+        ss << address;
+        return ss.str();
+    }
+    if (info.dli_sname != nullptr) {
+        int status = 0;
+        char* demangled = abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+        std::string name = (status == 0 && demangled != nullptr) ? demangled : info.dli_sname;
+        free(demangled);
+        return name;
+    }
+    // Symbols not exported by module can be resolved offline with addr2line
+    std::string module = info.dli_fname != nullptr ? info.dli_fname : "";
+    module = module.substr(module.find_last_of('/') + 1);
+    std::stringstream ss;
+    ss << module << "+0x" << std::hex << (static_cast<char*>(address) - static_cast<char*>(info.dli_fbase));
+    return ss.str();
+}
+
+std::string CpuProfiler::collect() {
+    std::unordered_map<void*, std::string> symbols;
+    std::unordered_map<int, std::string> threadNames;
+    std::vector<std::vector<std::string>> stacks;
+    const size_t collectedSamples = std::min(nextSample.load(), samplesCapacity);
+    for (size_t i = 0; i < collectedSamples; i++) {
+        const auto& sample = samples[i];
+        const int depth = sample.depth.load(std::memory_order_acquire);
+        if (depth == 0) {
+            continue;
+        }
+        std::vector<std::string> stack;
+        auto threadName = threadNames.find(sample.threadId);
+        if (threadName == threadNames.end()) {
+            threadName = threadNames.emplace(sample.threadId, getThreadName(sample.threadId)).first;
+        }
+        stack.push_back(threadName->second);
+        for (int frame = depth - 1; frame >= 0; frame--) {
+            // Return addresses of callers point after call instruction
+            void* address = frame == 0 ? sample.frames[frame] : static_cast<char*>(sample.frames[frame]) - 1;
+            auto symbol = symbols.find(address);
+            if (symbol == symbols.end()) {
+                symbol = symbols.emplace(address, symbolize(address)).first;
+            }
+            stack.push_back(symbol->second);
+        }
+        stacks.emplace_back(std::move(stack));
+    }
+    return foldStacks(stacks);
+}
+
+std::string CpuProfiler::foldStacks(const std::vector<std::vector<std::string>>& stacks) {
+    std::map<std::string, uint64_t> folded;
+    for (const auto& stack : stacks) {
+        std::string key;
+        for (const auto& frame : stack) {
+            if (!key.empty()) {
+                key += ';';
+            }
+            key += frame;
+        }
+        folded[key]++;
+    }
+    std::stringstream ss;
+    for (const auto& [stack, count] : folded) {
+        ss << stack << " " << count << "\n";
+    }
+    return ss.str();
+}
+
+}  // namespace ovms
@@ -0,0 +1,120 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <signal.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "status.hpp"
+
+namespace ovms {
+
+/**
+ * @brief Call stack captured by profiler signal handler
+ */
+struct CpuProfilerSample {
+    static constexpr int MAX_DEPTH = 48;
+    std::atomic<int> depth{0};
+    int threadId = 0;
+    void* frames[MAX_DEPTH];
+};
+
+/**
+ * @brief Sampling CPU profiler built into server.
+ * ITIMER_PROF delivers SIGPROF to the thread consuming CPU, signal handler stores its call stack
+ * in preallocated buffer. Stacks are symbolized and aggregated after profiling finishes.
+ * Call stacks are walked through frame pointers, so they end at code built without them.
+ */
+class CpuProfiler {
+public:
+    static constexpr uint32_t DEFAULT_DURATION_SECONDS = 10;
+    static constexpr uint32_t MAX_DURATION_SECONDS = 300;
+    static constexpr uint32_t DEFAULT_FREQUENCY = 99;
+    static constexpr uint32_t MAX_FREQUENCY = 1000;
+    static constexpr size_t MAX_SAMPLES = 50000;
+
+    static CpuProfiler& instance() {
+        static CpuProfiler instance;
+        return instance;
+    }
+
+    void setEnabled(bool enabled) {
+        this->enabled = enabled;
+    }
+
+    bool isEnabled() const {
+        return enabled;
+    }
+
+    /**
+     * @brief Samples call stacks of all server threads for given duration, blocks calling thread.
+     * Only one profiling can run at a time.
+     *
+     * @param duration profiling duration
+     * @param frequency samples per second of consumed CPU time
+     * @param foldedStacks result in folded stacks format: thread;frame;frame count
+     *
+     * @return Status
+     */
+    Status profile(std::chrono::seconds duration, uint32_t frequency, std::string& foldedStacks);
+
+    /**
+     * @brief Parses optional duration_seconds and frequency from JSON request body
+     */
+    static Status parseRequest(const std::string& body, std::chrono::seconds& duration, uint32_t& frequency);
+
+    /**
+     * @brief Aggregates identical samples into folded stacks, root frame first
+     */
+    static std::string foldStacks(const std::vector<std::vector<std::string>>& stacks);
+
+    /**
+     * @brief Walks call stack through frame pointers, async-signal-safe. Stops at frame pointer which is misaligned,
+     * not above the previous frame or not readable.
+     *
+     * @return number of stored frames, interrupted instruction first followed by return addresses
+     */
+    static int walkFramePointers(uintptr_t pc, uintptr_t framePointer, uintptr_t stackPointer, void** frames, int maxDepth);
+
+private:
+    CpuProfiler() = default;
+
+    static void handleSignal(int signal, siginfo_t* info, void* context);
+
+    Status start(uint32_t frequency);
+    void stop();
+    std::string collect();
+
+    bool enabled = false;
+    std::mutex mtx;
+
+    // Accessed from signal handler
+    static std::atomic<bool> sampling;
+    static std::atomic<int> handlersRunning;
+    static std::atomic<size_t> nextSample;
+    static std::atomic<size_t> droppedSamples;
+    static size_t samplesCapacity;
+    static std::unique_ptr<CpuProfilerSample[]> samples;
+};
+
+}  // namespace ovms
@@ -27,70 +27,23 @@
 #include "tensorflow_serving/apis/prediction_service.grpc.pb.h"
 #pragma GCC diagnostic pop
 
+#include "execution_plan.hpp"
+#include "sparse_tensor.hpp"
 #include "status.hpp"
 #include "tensorinfo.hpp"
 
 namespace ovms {
 
-template <typename T>
-InferenceEngine::Blob::Ptr makeBlob(const tensorflow::TensorProto& requestInput,
-    const std::shared_ptr<TensorInfo>& tensorInfo) {
-    return InferenceEngine::make_shared_blob<T>(
-        tensorInfo->getTensorDesc(),
-        const_cast<T*>(reinterpret_cast<const T*>(requestInput.tensor_content().data())));
-}
-
 class ConcreteTensorProtoDeserializator {
 public:
     static InferenceEngine::Blob::Ptr deserializeTensorProto(
         const tensorflow::TensorProto& requestInput,
         const std::shared_ptr<TensorInfo>& tensorInfo) {
-        switch (tensorInfo->getPrecision()) {
-        case InferenceEngine::Precision::FP32:
-            return makeBlob<float>(requestInput, tensorInfo);
-        case InferenceEngine::Precision::FP16: {
-            // Needs conversion due to zero padding for each value:
-            // https://github.com/tensorflow/tensorflow/blob/v2.2.0/tensorflow/core/framework/tensor.proto#L45
-            auto blob = InferenceEngine::make_shared_blob<uint16_t>(tensorInfo->getTensorDesc());
-            blob->allocate();
-            uint16_t* ptr = blob->buffer().as<uint16_t*>();
-            auto size = static_cast<size_t>(requestInput.half_val_size());
-            for (size_t i = 0; i < size; i++) {
-                ptr[i] = requestInput.half_val(i);
-            }
-            return blob;
-        }
-        case InferenceEngine::Precision::U8:
-            return makeBlob<uint8_t>(requestInput, tensorInfo);
-        case InferenceEngine::Precision::I8:
-            return makeBlob<int8_t>(requestInput, tensorInfo);
-        case InferenceEngine::Precision::U16: {
-            // Needs conversion due to zero padding for each value:
-            // https://github.com/tensorflow/tensorflow/blob/v2.2.0/tensorflow/core/framework/tensor.proto#L55
-            auto blob = InferenceEngine::make_shared_blob<uint16_t>(tensorInfo->getTensorDesc());
-            blob->allocate();
-            uint16_t* ptr = blob->buffer().as<uint16_t*>();
-            auto size = static_cast<size_t>(requestInput.int_val_size());
-            for (size_t i = 0; i < size; i++) {
-                ptr[i] = requestInput.int_val(i);
-            }
-            return blob;
-        }
-        case InferenceEngine::Precision::I16:
-            return makeBlob<int16_t>(requestInput, tensorInfo);
-        case InferenceEngine::Precision::I32:
-            return makeBlob<int32_t>(requestInput, tensorInfo);
-
-        case InferenceEngine::Precision::I64:
-
-        case InferenceEngine::Precision::MIXED:
-        case InferenceEngine::Precision::Q78:
-        case InferenceEngine::Precision::BIN:
-        case InferenceEngine::Precision::BOOL:
-        case InferenceEngine::Precision::CUSTOM:
-        default:
+        auto kernel = getInputConversionKernel(tensorInfo->getPrecision());
+        if (kernel == nullptr) {
             return nullptr;
         }
+        return kernel(requestInput, requestInput.tensor_content(), tensorInfo->getTensorDesc());
     }
 };
 
@@ -105,12 +58,23 @@ template <class TensorProtoDeserializator>
 Status deserializePredictRequest(
     const tensorflow::serving::PredictRequest& request,
     const tensor_map_t& inputMap,
-    InferenceEngine::InferRequest& inferRequest) {
+    InferenceEngine::InferRequest& inferRequest,
+    SparseInputsPool* sparseInputsPool = nullptr,
+    int streamId = 0) {
     try {
         for (const auto& pair : inputMap) {
             const auto& name = pair.first;
             auto tensorInfo = pair.second;
             auto requestInputItr = request.inputs().find(name);
+            if (requestInputItr == request.inputs().end() && sparseInputsPool != nullptr && sparseInputsPool->isSparseCapable(name)) {
+                InferenceEngine::Blob::Ptr blob;
+                auto status = sparseInputsPool->densify(request, *tensorInfo, streamId, blob);
+                if (!status.ok()) {
+                    return status;
+                }
+                inferRequest.SetBlob(tensorInfo->getName(), blob);
+                continue;
+            }
             if (requestInputItr == request.inputs().end()) {
                 SPDLOG_ERROR("Failed to deserialize request. Validation of request failed");
                 return Status(StatusCode::INTERNAL_ERROR, "Failed to deserialize request");
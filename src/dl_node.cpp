@@ -15,7 +15,9 @@
 //*****************************************************************************
 #include "dl_node.hpp"
 
+#include <future>
 #include <map>
+#include <unordered_map>
 #include <utility>
 
 #include <inference_engine.hpp>
@@ -38,6 +40,19 @@ Status DLNode::execute(ThreadSafeQueue<std::reference_wrapper<Node>>& notifyEndQ
             notifyEndQueue.push(*this);
             return status;
         }
+        if (tryUseCachedResults(notifyEndQueue)) {
+            return StatusCode::OK;
+        }
+        if (this->nodeBatchSize > 0) {
+            return submitToNodeBatcher(notifyEndQueue);
+        }
+        // Node is pushed to pipeline queue again by stream scheduler as soon as stream is assigned to it
+        auto onStreamAssigned = [this, &notifyEndQueue]() {
+            SPDLOG_DEBUG("[Node: {}] Stream Id assigned", this->getName());
+            notifyEndQueue.push(*this);
+        };
+        this->nodeStreamIdGuard = std::make_unique<NodeStreamIdGuard>(this->model->getInferRequestsQueue(), std::move(onStreamAssigned), this->requester);
+        return StatusCode::PIPELINE_STREAM_ID_NOT_READY_YET;
     }
     auto streamId = this->nodeStreamIdGuard->tryGetId(WAIT_FOR_STREAM_ID_TIMEOUT_MICROSECONDS);
     if (!streamId) {
@@ -73,13 +88,34 @@ Status DLNode::requestExecuteRequiredResources() {
         return status;
     }
 
-    status = prepareInputsAndModelForInference();
-    if (!status.ok()) {
-        return status;
+    return prepareInputsAndModelForInference();
+}
+
+bool DLNode::tryUseCachedResults(ThreadSafeQueue<std::reference_wrapper<Node>>& notifyEndQueue) {
+    auto cache = this->model->getNodeResultsCache();
+    if (cache == nullptr) {
+        return false;
     }
-    auto& inferRequestsQueue = this->model->getInferRequestsQueue();
-    this->nodeStreamIdGuard = std::make_unique<NodeStreamIdGuard>(inferRequestsQueue);
-    return status;
+    std::shared_ptr<NodeResultsCacheEntry> entry;
+    auto lookup = cache->acquire(this->inputBlobs, entry, [this, &notifyEndQueue]() {
+        SPDLOG_DEBUG("Cached results ready for node name: {}", this->getName());
+        notifyEndQueue.push(*this);
+    });
+    switch (lookup) {
+    case NodeResultsCache::Lookup::MISS:
+        this->resultsCacheProducer = std::make_unique<NodeResultsCacheProducer>(*cache, std::move(entry));
+        return false;
+    case NodeResultsCache::Lookup::HIT:
+        SPDLOG_DEBUG("[Node: {}] Using cached results of model:{}", getName(), modelName);
+        this->resultsCacheEntry = std::move(entry);
+        notifyEndQueue.push(*this);
+        return true;
+    case NodeResultsCache::Lookup::PENDING:
+        SPDLOG_DEBUG("[Node: {}] Waiting for results of the same inference of model:{} in progress", getName(), modelName);
+        this->resultsCacheEntry = std::move(entry);
+        return true;
+    }
+    return false;
 }
 
 Status DLNode::setInputsForInference(InferenceEngine::InferRequest& infer_request) {
@@ -110,6 +146,34 @@ Status DLNode::setInputsForInference(InferenceEngine::InferRequest& infer_reques
     return status;
 }
 
+Status DLNode::getNodeBatchTaskInputs(std::unordered_map<std::string, InferenceEngine::Blob::Ptr>& inputs) const {
+    for (const auto& kv : this->inputBlobs) {
+        std::string realModelInputName;
+        if (!getRealInputName(kv.first, &realModelInputName).ok()) {
+            SPDLOG_ERROR("[Node: {}] Cannot find real model input name for alias: {}", getName(), kv.first);
+            return StatusCode::INTERNAL_ERROR;
+        }
+        inputs.emplace(realModelInputName, kv.second);
+    }
+    return StatusCode::OK;
+}
+
+Status DLNode::submitToNodeBatcher(ThreadSafeQueue<std::reference_wrapper<Node>>& notifyEndQueue) {
+    std::unordered_map<std::string, InferenceEngine::Blob::Ptr> inputs;
+    auto status = getNodeBatchTaskInputs(inputs);
+    if (!status.ok()) {
+        notifyEndQueue.push(*this);
+        return status;
+    }
+    this->nodeBatchTask = std::make_shared<NodeBatchTask>(std::move(inputs), this->nodeBatchSize, [this, &notifyEndQueue]() {
+        SPDLOG_DEBUG("Batched inference finished for node name: {}", this->getName());
+        notifyEndQueue.push(*this);
+    });
+    SPDLOG_DEBUG("[Node: {}] Submitting inference with batch size: {} to node batcher of model: {}", getName(), this->nodeBatchSize, modelName);
+    this->model->getNodeBatcher()->submit(this->nodeBatchTask);
+    return StatusCode::OK;
+}
+
 Status DLNode::executeInference(ThreadSafeQueue<std::reference_wrapper<Node>>& notifyEndQueue, InferenceEngine::InferRequest& infer_request) {
     try {
         SPDLOG_DEBUG("Setting completion callback for node name: {}", this->getName());
@@ -145,6 +209,30 @@ Status DLNode::fetchResults(BlobMap& outputs) {
         return StatusCode::UNKNOWN_ERROR;
     }
 
+    if (this->resultsCacheEntry != nullptr) {
+        return fetchCachedResults(outputs);
+    }
+
+    if (this->nodeBatchTask != nullptr) {
+        this->inputBlobs.clear();
+        const auto& taskStatus = this->nodeBatchTask->getStatus();
+        if (!taskStatus.ok()) {
+            spdlog::debug("[Node: {}] Batched inference failed: {}", getName(), taskStatus.string());
+            return taskStatus;
+        }
+        auto status = fetchOutputsAndCompleteCacheEntry(outputs, [this](const std::string& realModelOutputName, InferenceEngine::Blob::Ptr& blob) {
+            SPDLOG_DEBUG("[Node: {}] Getting part of batched blob from model:{}, blobName:{}",
+                getName(), modelName, realModelOutputName);
+            return this->nodeBatchTask->getOutput(realModelOutputName, blob);
+        });
+        if (!status.ok()) {
+            return status;
+        }
+        // After results are fetched, model and batched inference are not needed anymore
+        this->release();
+        return StatusCode::OK;
+    }
+
     // Get infer request corresponding to this node model
     auto streamId = this->nodeStreamIdGuard->tryGetId();
     if (!streamId) {
@@ -162,42 +250,181 @@ Status DLNode::fetchResults(BlobMap& outputs) {
         spdlog::debug("[Node: {}] Async infer failed: {}; OV StatusCode: {}", getName(), status.string(), ov_status);
         return status;
     }
+    if (this->model->getProfile() != nullptr) {
+        this->model->getProfile()->record(infer_request);
+    }
 
-    // Fill outputs map with result blobs. Fetch only those that are required in following nodes.
+    auto status = fetchOutputsAndCompleteCacheEntry(outputs, [this, &infer_request, &streamId](const std::string& realModelOutputName, InferenceEngine::Blob::Ptr& blob) {
+        SPDLOG_DEBUG("[Node: {}] Getting blob from model:{}, inferRequestStreamId:{}, blobName:{}",
+            getName(), modelName, streamId.value(), realModelOutputName);
+        const auto resultBlob = infer_request.GetBlob(realModelOutputName);
+        SPDLOG_DEBUG("[Node: {}] Creating copy of blob from model:{}, inferRequestStreamId:{}, blobName:{}",
+            getName(), modelName, streamId.value(), realModelOutputName);
+        blob = blobClone(resultBlob);
+        if (blob == nullptr) {
+            SPDLOG_ERROR("[Node: {}] Cannot copy blob - buffer sizes mismatch", getName());
+            return Status(StatusCode::INTERNAL_ERROR);
+        }
+        return Status(StatusCode::OK);
+    });
+    if (!status.ok()) {
+        return status;
+    }
+    // After results are fetched, model and inference request are not needed anymore
+    this->release();
+    return StatusCode::OK;
+}
+
+Status DLNode::fetchCachedResults(BlobMap& outputs) {
+    const auto& entry = *this->resultsCacheEntry;
+    if (!entry.getStatus().ok()) {
+        SPDLOG_DEBUG("[Node: {}] Cached results are not available: {}", getName(), entry.getStatus().string());
+        auto status = this->nodeBatchSize > 0 ? executeBatchedInferenceSync(outputs) : executeInferenceSync(outputs);
+        if (status.ok()) {
+            this->release();
+        }
+        return status;
+    }
+    this->inputBlobs.clear();
+    auto status = fetchOutputs(outputs, [this, &entry](const std::string& realModelOutputName, InferenceEngine::Blob::Ptr& blob) {
+        auto it = entry.getOutputs().find(realModelOutputName);
+        if (it == entry.getOutputs().end()) {
+            SPDLOG_ERROR("[Node: {}] Cached results are missing blob: {}", getName(), realModelOutputName);
+            return Status(StatusCode::INTERNAL_ERROR);
+        }
+        blob = it->second;
+        return Status(StatusCode::OK);
+    });
+    if (!status.ok()) {
+        return status;
+    }
+    // After results are fetched, model and cached results are not needed anymore
+    this->release();
+    return StatusCode::OK;
+}
+
+Status DLNode::executeBatchedInferenceSync(BlobMap& outputs) {
+    SPDLOG_DEBUG("[Node: {}] Running batched inference of model:{} synchronously", getName(), modelName);
+    std::unordered_map<std::string, InferenceEngine::Blob::Ptr> inputs;
+    auto status = getNodeBatchTaskInputs(inputs);
+    if (!status.ok()) {
+        return status;
+    }
+    auto finished = std::make_shared<std::promise<void>>();
+    auto finishedFuture = finished->get_future();
+    this->nodeBatchTask = std::make_shared<NodeBatchTask>(std::move(inputs), this->nodeBatchSize, [finished]() {
+        finished->set_value();
+    });
+    this->model->getNodeBatcher()->submit(this->nodeBatchTask);
+    finishedFuture.wait();
+    this->inputBlobs.clear();
+    const auto& taskStatus = this->nodeBatchTask->getStatus();
+    if (!taskStatus.ok()) {
+        spdlog::debug("[Node: {}] Batched inference failed: {}", getName(), taskStatus.string());
+        return taskStatus;
+    }
+    return fetchOutputs(outputs, [this](const std::string& realModelOutputName, InferenceEngine::Blob::Ptr& blob) {
+        return this->nodeBatchTask->getOutput(realModelOutputName, blob);
+    });
+}
+
+Status DLNode::executeInferenceSync(BlobMap& outputs) {
+    SPDLOG_DEBUG("[Node: {}] Running inference of model:{} synchronously", getName(), modelName);
+    auto& inferRequestsQueue = this->model->getInferRequestsQueue();
+    ExecutingStreamIdGuard streamIdGuard(inferRequestsQueue, this->requester);
+    auto& inferRequest = inferRequestsQueue.getInferRequest(streamIdGuard.getId());
+    auto status = setInputsForInference(inferRequest);
+    if (!status.ok()) {
+        return status;
+    }
+    try {
+        inferRequest.Infer();
+    } catch (const InferenceEngine::details::InferenceEngineException& e) {
+        spdlog::debug("[Node: {}] Exception occured during inference on model: {}, error: {}", getName(), modelName, e.what());
+        return StatusCode::OV_INTERNAL_INFERENCE_ERROR;
+    }
+    if (this->model->getProfile() != nullptr) {
+        this->model->getProfile()->record(inferRequest);
+    }
+    this->inputBlobs.clear();
+    return fetchOutputs(outputs, [this, &inferRequest](const std::string& realModelOutputName, InferenceEngine::Blob::Ptr& blob) {
+        blob = blobClone(inferRequest.GetBlob(realModelOutputName));
+        if (blob == nullptr) {
+            SPDLOG_ERROR("[Node: {}] Cannot copy blob - buffer sizes mismatch", getName());
+            return Status(StatusCode::INTERNAL_ERROR);
+        }
+        return Status(StatusCode::OK);
+    });
+}
+
+Status DLNode::fetchOutputsAndCompleteCacheEntry(BlobMap& outputs, const std::function<Status(const std::string&, InferenceEngine::Blob::Ptr&)>& getOutputBlob) {
+    if (this->resultsCacheProducer == nullptr) {
+        return fetchOutputs(outputs, getOutputBlob);
+    }
+    // Cache keeps all model outputs since other pipelines may require different ones
+    BlobMap modelOutputs;
+    for (const auto& kv : this->model->getOutputsInfo()) {
+        const auto& realModelOutputName = kv.second->getName();
+        InferenceEngine::Blob::Ptr blob;
+        Status status;
+        try {
+            status = getOutputBlob(realModelOutputName, blob);
+        } catch (const InferenceEngine::details::InferenceEngineException& e) {
+            status = StatusCode::OV_INTERNAL_SERIALIZATION_ERROR;
+            SPDLOG_DEBUG("[Node: {}] Error during getting blob {}; exception message: {}", getName(), status.string(), e.what());
+        }
+        if (!status.ok()) {
+            this->resultsCacheProducer->complete(status);
+            return status;
+        }
+        modelOutputs.emplace(realModelOutputName, std::move(blob));
+    }
+    this->resultsCacheProducer->complete(StatusCode::OK, modelOutputs);
+    return fetchOutputs(outputs, [&modelOutputs](const std::string& realModelOutputName, InferenceEngine::Blob::Ptr& blob) {
+        blob = modelOutputs.at(realModelOutputName);
+        return Status(StatusCode::OK);
+    });
+}
+
+Status DLNode::fetchOutputs(BlobMap& outputs, const std::function<Status(const std::string&, InferenceEngine::Blob::Ptr&)>& getOutputBlob) {
+    // Fill outputs map with result blobs. Fetch only those that are required in following nodes or by node gate.
     for (const auto& node : this->next) {
         for (const auto& pair : node.get().getMappingByDependency(*this)) {
-            const auto& output_name = pair.first;
-            if (outputs.count(output_name) == 1) {
-                continue;
-            }
-
-            try {
-                std::string realModelOutputName;
-                if (!getRealOutputName(output_name, &realModelOutputName).ok()) {
-                    SPDLOG_ERROR("[Node: {}] Cannot find real model output name for alias: {}", getName(), output_name);
-                    return StatusCode::INTERNAL_ERROR;
-                }
-                SPDLOG_DEBUG("[Node: {}] Getting blob from model:{}, inferRequestStreamId:{}, blobName:{}",
-                    getName(), modelName, streamId.value(), realModelOutputName);
-                const auto blob = infer_request.GetBlob(realModelOutputName);
-                SPDLOG_DEBUG("[Node: {}] Creating copy of blob from model:{}, inferRequestStreamId:{}, blobName:{}",
-                    getName(), modelName, streamId.value(), realModelOutputName);
-                const auto copiedBlob = blobClone(blob);
-                if (copiedBlob == nullptr) {
-                    SPDLOG_ERROR("[Node: {}] Cannot copy blob - buffer sizes mismatch", getName());
-                    return StatusCode::INTERNAL_ERROR;
-                }
-                outputs.emplace(std::make_pair(output_name, std::move(copiedBlob)));
-            } catch (const InferenceEngine::details::InferenceEngineException& e) {
-                Status status = StatusCode::OV_INTERNAL_SERIALIZATION_ERROR;
-                SPDLOG_DEBUG("[Node: {}] Error during getting blob {}; exception message: {}", getName(), status.string(), e.what());
+            auto status = fetchOutput(outputs, pair.first, getOutputBlob);
+            if (!status.ok()) {
                 return status;
             }
-            spdlog::debug("[Node: {}]: Blob with name {} has been prepared", getName(), output_name);
         }
     }
-    // After results are fetched, model and inference request are not needed anymore
-    this->release();
+    if (this->gate) {
+        return fetchOutput(outputs, this->gate->dataItem, getOutputBlob);
+    }
+    return StatusCode::OK;
+}
+
+Status DLNode::fetchOutput(BlobMap& outputs, const std::string& output_name, const std::function<Status(const std::string&, InferenceEngine::Blob::Ptr&)>& getOutputBlob) {
+    if (outputs.count(output_name) == 1) {
+        return StatusCode::OK;
+    }
+
+    try {
+        std::string realModelOutputName;
+        if (!getRealOutputName(output_name, &realModelOutputName).ok()) {
+            SPDLOG_ERROR("[Node: {}] Cannot find real model output name for alias: {}", getName(), output_name);
+            return StatusCode::INTERNAL_ERROR;
+        }
+        InferenceEngine::Blob::Ptr blob;
+        auto status = getOutputBlob(realModelOutputName, blob);
+        if (!status.ok()) {
+            return status;
+        }
+        outputs.emplace(std::make_pair(output_name, std::move(blob)));
+    } catch (const InferenceEngine::details::InferenceEngineException& e) {
+        Status status = StatusCode::OV_INTERNAL_SERIALIZATION_ERROR;
+        SPDLOG_DEBUG("[Node: {}] Error during getting blob {}; exception message: {}", getName(), status.string(), e.what());
+        return status;
+    }
+    spdlog::debug("[Node: {}]: Blob with name {} has been prepared", getName(), output_name);
     return StatusCode::OK;
 }
 
@@ -271,11 +498,14 @@ Status DLNode::prepareInputsAndModelForInference() {
         }
 
         // If batch size is incorrect, perform network batch size change if allowed (shape mode=auto or batch size=auto)
+        // or merge with other nodes inferences if model has pipeline batching enabled
         if (status == StatusCode::INVALID_BATCH_SIZE) {
             if (this->model->getModelConfig().getBatchingMode() == Mode::AUTO) {
                 requestedBatchSize = blob->getTensorDesc().getDims()[0];
             } else if (this->model->getModelConfig().isShapeAuto(name)) {
                 requestedReshapes[name] = blob->getTensorDesc().getDims();
+            } else if (this->model->getNodeBatcher() != nullptr && blob->getTensorDesc().getDims()[0] < inputInfo.getShape()[0]) {
+                this->nodeBatchSize = blob->getTensorDesc().getDims()[0];
             } else {
                 return status;
             }
@@ -289,6 +519,19 @@ Status DLNode::prepareInputsAndModelForInference() {
             requestedReshapes[name] = blob->getTensorDesc().getDims();
         }
     }
+    if (this->nodeBatchSize > 0) {
+        for (const auto& kv : this->inputBlobs) {
+            if (kv.second->getTensorDesc().getDims()[0] != this->nodeBatchSize) {
+                std::stringstream ss;
+                ss << "Batched node inputs need equal batch size. Expected: " << this->nodeBatchSize
+                   << "; Actual: " << kv.second->getTensorDesc().getDims()[0] << " for input: " << kv.first;
+                const std::string details = ss.str();
+                spdlog::debug("[Node: {}] Invalid batch size - {}", getName(), details);
+                this->nodeBatchSize = 0;
+                return Status(StatusCode::INVALID_BATCH_SIZE, details);
+            }
+        }
+    }
     if (requestedReshapes.size() > 0) {
         auto status = this->model->reloadModel(0, requestedReshapes, this->modelUnloadGuard);
         if (!status.ok()) {
@@ -15,6 +15,7 @@
 //*****************************************************************************
 #pragma once
 
+#include <functional>
 #include <memory>
 #include <optional>
 #include <string>
@@ -25,6 +26,8 @@
 #include "modelinstance.hpp"
 #include "modelinstanceunloadguard.hpp"
 #include "node.hpp"
+#include "node_batcher.hpp"
+#include "node_results_cache.hpp"
 #include "nodestreamidguard.hpp"
 
 namespace ovms {
@@ -36,20 +39,34 @@ class DLNode : public Node {
     std::optional<model_version_t> modelVersion;
     ModelManager& modelManager;
     const std::unordered_map<std::string, std::string> nodeOutputNameAlias;
+    const StreamRequester requester;
 
     std::shared_ptr<ModelInstance> model;
     std::unique_ptr<NodeStreamIdGuard> nodeStreamIdGuard;
     std::unique_ptr<ModelInstanceUnloadGuard> modelUnloadGuard;
 
+    // Batch size of node inputs when node is merged with other nodes into batched inference, 0 otherwise
+    size_t nodeBatchSize = 0;
+    std::shared_ptr<NodeBatchTask> nodeBatchTask;
+
+    // Memoized results of the same inference requested earlier or concurrently by other node
+    std::shared_ptr<NodeResultsCacheEntry> resultsCacheEntry;
+    // Set when this node is the first one running inference on given inputs
+    std::unique_ptr<NodeResultsCacheProducer> resultsCacheProducer;
+
 public:
     DLNode(const std::string& nodeName, const std::string& modelName, std::optional<model_version_t> modelVersion,
         ModelManager& modelManager,
-        std::unordered_map<std::string, std::string> nodeOutputNameAlias = {}) :
+        std::unordered_map<std::string, std::string> nodeOutputNameAlias = {},
+        std::optional<NodeGate> gate = std::nullopt,
+        StreamRequester requester = StreamRequester::PIPELINE_NODE) :
         Node(nodeName),
         modelName(modelName),
         modelVersion(modelVersion),
         modelManager(modelManager),
-        nodeOutputNameAlias(nodeOutputNameAlias) {
+        nodeOutputNameAlias(nodeOutputNameAlias),
+        requester(requester) {
+        this->gate = gate;
     }
 
     Status execute(ThreadSafeQueue<std::reference_wrapper<Node>>& notifyEndQueue) override;
@@ -66,17 +83,12 @@ public:
      */
     Status prepareInputsAndModelForInference();
 
-    bool tryDisarmStreamIdGuard(const uint microseconds = 1) override {
-        SPDLOG_INFO("Trying to disarm stream id guard of node: {}", getName());
-        if (this->nodeStreamIdGuard == nullptr) {
-            return true;
-        }
-        return this->nodeStreamIdGuard->tryDisarm(microseconds);
-    }
-
     void release() override {
         SPDLOG_DEBUG("Releasing resources for node {}", getName());
+        this->resultsCacheProducer.reset();
+        this->resultsCacheEntry.reset();
         this->nodeStreamIdGuard.reset();
+        this->nodeBatchTask.reset();
         this->model.reset();
         this->modelUnloadGuard.reset();
     }
@@ -102,6 +114,15 @@ private:
     Status requestExecuteRequiredResources();
     Status setInputsForInference(InferenceEngine::InferRequest& infer_request);
     Status executeInference(ThreadSafeQueue<std::reference_wrapper<Node>>& notifyEndQueue, InferenceEngine::InferRequest& infer_request);
+    Status getNodeBatchTaskInputs(std::unordered_map<std::string, InferenceEngine::Blob::Ptr>& inputs) const;
+    Status submitToNodeBatcher(ThreadSafeQueue<std::reference_wrapper<Node>>& notifyEndQueue);
+    bool tryUseCachedResults(ThreadSafeQueue<std::reference_wrapper<Node>>& notifyEndQueue);
+    Status fetchCachedResults(BlobMap& outputs);
+    Status executeInferenceSync(BlobMap& outputs);
+    Status executeBatchedInferenceSync(BlobMap& outputs);
+    Status fetchOutputsAndCompleteCacheEntry(BlobMap& outputs, const std::function<Status(const std::string&, InferenceEngine::Blob::Ptr&)>& getOutputBlob);
+    Status fetchOutputs(BlobMap& outputs, const std::function<Status(const std::string&, InferenceEngine::Blob::Ptr&)>& getOutputBlob);
+    Status fetchOutput(BlobMap& outputs, const std::string& outputName, const std::function<Status(const std::string&, InferenceEngine::Blob::Ptr&)>& getOutputBlob);
 };
 
 }  // namespace ovms
@@ -47,7 +47,7 @@ Status EntryNode::fetchResults(BlobMap& outputs) {
             const auto& tensor_proto = request->inputs().at(output_name);
             InferenceEngine::Blob::Ptr blob;
             spdlog::debug("[Node: {}] Deserializing input:{}", getName(), output_name);
-            auto status = deserialize(tensor_proto, blob);
+            auto status = deserialize(tensor_proto, getInputContent(output_name, tensor_proto, decodedInputs), blob);
             if (!status.ok()) {
                 return status;
             }
@@ -61,15 +61,15 @@ Status EntryNode::fetchResults(BlobMap& outputs) {
     return StatusCode::OK;
 }
 
-Status EntryNode::deserialize(const tensorflow::TensorProto& proto, InferenceEngine::Blob::Ptr& blob) {
+Status EntryNode::deserialize(const tensorflow::TensorProto& proto, const std::string& content, InferenceEngine::Blob::Ptr& blob) {
     InferenceEngine::TensorDesc description;
-    if (proto.tensor_content().size() == 0) {
+    if (content.size() == 0) {
         const std::string details = "Tensor content size can't be 0";
         spdlog::debug("[Node: {}] {}", getName(), details);
         return Status(StatusCode::INVALID_CONTENT_SIZE, details);
     }
 
-    // Assuming content is in proto.tensor_content
+    // Assuming content is in proto.tensor_content or decoded from it
 
     InferenceEngine::SizeVector shape;
     for (int i = 0; i < proto.tensor_shape().dim_size(); i++) {
@@ -80,9 +80,9 @@ Status EntryNode::deserialize(const tensorflow::TensorProto& proto, InferenceEng
 
     size_t tensor_count = std::accumulate(shape.begin(), shape.end(), 1, std::multiplies<size_t>());
 
-    if (proto.tensor_content().size() != tensor_count * tensorflow::DataTypeSize(proto.dtype())) {
+    if (content.size() != tensor_count * tensorflow::DataTypeSize(proto.dtype())) {
         std::stringstream ss;
-        ss << "Expected: " << tensor_count * tensorflow::DataTypeSize(proto.dtype()) << "; Actual: " << proto.tensor_content().size();
+        ss << "Expected: " << tensor_count * tensorflow::DataTypeSize(proto.dtype()) << "; Actual: " << content.size();
         const std::string details = ss.str();
         spdlog::debug("[Node {}] Invalid size of tensor proto - {}", getName(), details);
         return Status(StatusCode::INVALID_CONTENT_SIZE, details);
@@ -94,23 +94,23 @@ Status EntryNode::deserialize(const tensorflow::TensorProto& proto, InferenceEng
         switch (proto.dtype()) {
         case tensorflow::DataType::DT_FLOAT:
             description.setPrecision(InferenceEngine::Precision::FP32);
-            blob = InferenceEngine::make_shared_blob<float>(description, (float*)proto.tensor_content().data());
+            blob = InferenceEngine::make_shared_blob<float>(description, (float*)content.data());
             break;
         case tensorflow::DataType::DT_UINT8:
             description.setPrecision(InferenceEngine::Precision::U8);
-            blob = InferenceEngine::make_shared_blob<uint8_t>(description, (uint8_t*)proto.tensor_content().data());
+            blob = InferenceEngine::make_shared_blob<uint8_t>(description, (uint8_t*)content.data());
             break;
         case tensorflow::DataType::DT_INT8:
             description.setPrecision(InferenceEngine::Precision::I8);
-            blob = InferenceEngine::make_shared_blob<int8_t>(description, (int8_t*)proto.tensor_content().data());
+            blob = InferenceEngine::make_shared_blob<int8_t>(description, (int8_t*)content.data());
             break;
         case tensorflow::DataType::DT_INT16:
             description.setPrecision(InferenceEngine::Precision::I16);
-            blob = InferenceEngine::make_shared_blob<int16_t>(description, (int16_t*)proto.tensor_content().data());
+            blob = InferenceEngine::make_shared_blob<int16_t>(description, (int16_t*)content.data());
             break;
         case tensorflow::DataType::DT_INT32:
             description.setPrecision(InferenceEngine::Precision::I32);
-            blob = InferenceEngine::make_shared_blob<int32_t>(description, (int32_t*)proto.tensor_content().data());
+            blob = InferenceEngine::make_shared_blob<int32_t>(description, (int32_t*)content.data());
             break;
         case tensorflow::DataType::DT_HALF:
         case tensorflow::DataType::DT_UINT16:
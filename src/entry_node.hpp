@@ -22,12 +22,14 @@
 #pragma GCC diagnostic pop
 
 #include "node.hpp"
+#include "tensor_encoding.hpp"
 #include "tensorinfo.hpp"
 
 namespace ovms {
 
 class EntryNode : public Node {
     const tensorflow::serving::PredictRequest* request;
+    const DecodedInputs* decodedInputs = nullptr;
 
 public:
     EntryNode(const tensorflow::serving::PredictRequest* request) :
@@ -41,13 +43,20 @@ public:
 
     Status fetchResults(BlobMap& outputs) override;
 
+    /**
+     * @brief Sets decoded contents of encoded request inputs, they must outlive pipeline execution
+     */
+    void setDecodedInputs(const DecodedInputs* decodedInputs) {
+        this->decodedInputs = decodedInputs;
+    }
+
     // Entry nodes have no dependency
     void addDependency(Node&, const InputPairs&) override {
         throw std::logic_error("This node cannot have dependency");
     }
 
     // Deserialize proto to blob
-    Status deserialize(const tensorflow::TensorProto& proto, InferenceEngine::Blob::Ptr& blob);
+    Status deserialize(const tensorflow::TensorProto& proto, const std::string& content, InferenceEngine::Blob::Ptr& blob);
 };
 
 }  // namespace ovms
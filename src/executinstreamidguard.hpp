@@ -19,9 +19,9 @@
 
 namespace ovms {
 struct ExecutingStreamIdGuard {
-    ExecutingStreamIdGuard(ovms::OVInferRequestsQueue& inferRequestsQueue) :
+    ExecutingStreamIdGuard(ovms::OVInferRequestsQueue& inferRequestsQueue, StreamRequester requester = StreamRequester::PREDICT, int preferredStreamId = -1) :
         inferRequestsQueue_(inferRequestsQueue),
-        id_(inferRequestsQueue_.getIdleStream().get()) {}
+        id_(inferRequestsQueue_.getIdleStream(requester, nullptr, preferredStreamId).get()) {}
     ~ExecutingStreamIdGuard() {
         inferRequestsQueue_.returnStream(id_);
     }
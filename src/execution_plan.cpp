@@ -0,0 +1,272 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "execution_plan.hpp"
+
+#include <sstream>
+
+#include <spdlog/spdlog.h>
+
+namespace ovms {
+
+namespace {
+
+template <typename T>
+InferenceEngine::Blob::Ptr wrapTensorContent(const tensorflow::TensorProto&, const std::string& content, const InferenceEngine::TensorDesc& desc) {
+    return InferenceEngine::make_shared_blob<T>(
+        desc,
+        const_cast<T*>(reinterpret_cast<const T*>(content.data())));
+}
+
+// 16 bit values are zero padded to 32 bits in repeated fields:
+// https://github.com/tensorflow/tensorflow/blob/v2.2.0/tensorflow/core/framework/tensor.proto#L45
+template <typename Field>
+InferenceEngine::Blob::Ptr narrowRepeatedField(const Field& values, const InferenceEngine::TensorDesc& desc) {
+    auto blob = InferenceEngine::make_shared_blob<uint16_t>(desc);
+    blob->allocate();
+    uint16_t* ptr = blob->buffer().as<uint16_t*>();
+    const auto size = static_cast<size_t>(values.size());
+    for (size_t i = 0; i < size; i++) {
+        ptr[i] = values.Get(i);
+    }
+    return blob;
+}
+
+InferenceEngine::Blob::Ptr convertHalfVal(const tensorflow::TensorProto& requestInput, const std::string&, const InferenceEngine::TensorDesc& desc) {
+    return narrowRepeatedField(requestInput.half_val(), desc);
+}
+
+InferenceEngine::Blob::Ptr convertIntVal(const tensorflow::TensorProto& requestInput, const std::string&, const InferenceEngine::TensorDesc& desc) {
+    return narrowRepeatedField(requestInput.int_val(), desc);
+}
+
+}  // namespace
+
+InputConversionKernel getInputConversionKernel(InferenceEngine::Precision precision) {
+    switch (precision) {
+    case InferenceEngine::Precision::FP32:
+        return wrapTensorContent<float>;
+    case InferenceEngine::Precision::FP16:
+        return convertHalfVal;
+    case InferenceEngine::Precision::U8:
+        return wrapTensorContent<uint8_t>;
+    case InferenceEngine::Precision::I8:
+        return wrapTensorContent<int8_t>;
+    case InferenceEngine::Precision::U16:
+        return convertIntVal;
+    case InferenceEngine::Precision::I16:
+        return wrapTensorContent<int16_t>;
+    case InferenceEngine::Precision::I32:
+        return wrapTensorContent<int32_t>;
+    default:
+        return nullptr;
+    }
+}
+
+bool getOutputDataType(InferenceEngine::Precision precision, tensorflow::DataType& dtype) {
+    switch (precision) {
+    case InferenceEngine::Precision::FP32:
+        dtype = tensorflow::DataTypeToEnum<float>::value;
+        return true;
+    case InferenceEngine::Precision::I32:
+        dtype = tensorflow::DataTypeToEnum<int>::value;
+        return true;
+    case InferenceEngine::Precision::I16:
+        dtype = tensorflow::DataTypeToEnum<int16_t>::value;
+        return true;
+    case InferenceEngine::Precision::U8:
+        dtype = tensorflow::DataTypeToEnum<uint8_t>::value;
+        return true;
+    case InferenceEngine::Precision::I8:
+        dtype = tensorflow::DataTypeToEnum<int8_t>::value;
+        return true;
+    // 2 byte padding [v1, v0, 0, 0, u1, u0, 0, 0, ...]
+    case InferenceEngine::Precision::U16:
+        dtype = tensorflow::DataTypeToEnum<uint32_t>::value;
+        return true;
+    case InferenceEngine::Precision::FP16:
+        dtype = tensorflow::DataTypeToEnum<float>::value;
+        return true;
+    case InferenceEngine::Precision::I64:
+        dtype = tensorflow::DataTypeToEnum<int32_t>::value;
+        return true;
+    default:
+        return false;
+    }
+}
+
+ExecutionPlan::ExecutionPlan(const std::map<std::string, std::shared_ptr<TensorInfo>>& inputsInfo,
+    const std::map<std::string, std::shared_ptr<TensorInfo>>& outputsInfo,
+    const ModelConfig* config) {
+    if (config != nullptr) {
+        bucketPaddingMode = getBucketPaddingModeFromString(config->getBucketPadding());
+        bucketFillValue = config->getBucketFillValue();
+    }
+    inputs.reserve(inputsInfo.size());
+    for (const auto& pair : inputsInfo) {
+        const auto& tensorInfo = pair.second;
+        InputStep step{pair.first, tensorInfo, tensorInfo->getTensorDesc(), getInputConversionKernel(tensorInfo->getPrecision()), {}};
+        // Buckets replace reshaping so they apply only to inputs with auto shape
+        if (config != nullptr && config->isShapeAuto(tensorInfo->getName())) {
+            auto it = config->getShapeBuckets().find(tensorInfo->getName());
+            if (it != config->getShapeBuckets().end()) {
+                step.shapeBuckets = it->second;
+            }
+        }
+        inputs.emplace_back(std::move(step));
+    }
+    outputs.reserve(outputsInfo.size());
+    for (const auto& pair : outputsInfo) {
+        const auto& tensorInfo = pair.second;
+        OutputStep step{tensorInfo->getName(), tensorInfo->getMappedName(), false, {}};
+        tensorflow::DataType dtype;
+        step.supported = getOutputDataType(tensorInfo->getPrecision(), dtype);
+        if (step.supported) {
+            step.prototype.set_dtype(dtype);
+            for (auto dim : tensorInfo->getShape()) {
+                step.prototype.mutable_tensor_shape()->add_dim()->set_size(dim);
+            }
+        }
+        outputs.emplace_back(std::move(step));
+    }
+}
+
+Status ExecutionPlan::deserialize(const tensorflow::serving::PredictRequest& request,
+    InferenceEngine::InferRequest& inferRequest,
+    SparseInputsPool* sparseInputsPool,
+    int streamId,
+    const DecodedInputs* decodedInputs) const {
+    try {
+        for (const auto& step : inputs) {
+            auto requestInputItr = request.inputs().find(step.requestName);
+            InferenceEngine::Blob::Ptr blob;
+            if (requestInputItr == request.inputs().end()) {
+                if (sparseInputsPool == nullptr || !sparseInputsPool->isSparseCapable(step.requestName)) {
+                    SPDLOG_ERROR("Failed to deserialize request. Validation of request failed");
+                    return Status(StatusCode::INTERNAL_ERROR, "Failed to deserialize request");
+                }
+                auto status = sparseInputsPool->densify(request, *step.tensorInfo, streamId, blob);
+                if (!status.ok()) {
+                    return status;
+                }
+            } else {
+                if (step.kernel == nullptr) {
+                    Status status = StatusCode::OV_UNSUPPORTED_DESERIALIZATION_PRECISION;
+                    SPDLOG_ERROR(status.string());
+                    return status;
+                }
+                const auto& content = getInputContent(step.requestName, requestInputItr->second, decodedInputs);
+                if (step.shapeBuckets.empty()) {
+                    blob = step.kernel(requestInputItr->second, content, step.desc);
+                } else {
+                    auto status = padToShapeBucket(step, requestInputItr->second, content, blob);
+                    if (!status.ok()) {
+                        return status;
+                    }
+                }
+            }
+            inferRequest.SetBlob(step.tensorInfo->getName(), blob);
+        }
+        // OV can throw exceptions derived from std::logic_error
+    } catch (const InferenceEngine::details::InferenceEngineException& e) {
+        Status status = StatusCode::OV_INTERNAL_DESERIALIZATION_ERROR;
+        SPDLOG_ERROR("{}: {}", status.string(), e.what());
+        return status;
+    } catch (std::logic_error& e) {
+        Status status = StatusCode::OV_INTERNAL_DESERIALIZATION_ERROR;
+        SPDLOG_ERROR("{}: {}", status.string(), e.what());
+        return status;
+    }
+    return StatusCode::OK;
+}
+
+Status ExecutionPlan::padToShapeBucket(const InputStep& step, const tensorflow::TensorProto& requestInput, const std::string& content, InferenceEngine::Blob::Ptr& blob) const {
+    const auto& requestShape = requestInput.tensor_shape();
+    shape_t requestDims;
+    for (int i = 0; i < requestShape.dim_size(); i++) {
+        requestDims.push_back(requestShape.dim(i).size());
+    }
+    if (requestDims == step.desc.getDims()) {
+        blob = step.kernel(requestInput, content, step.desc);
+        return StatusCode::OK;
+    }
+    if (!fitsInShapeWithPadding(step.desc.getDims(), step.desc.getLayout(), requestShape)) {
+        std::stringstream ss;
+        ss << "Expected: " << TensorInfo::shapeToString(step.desc.getDims())
+           << " or smaller; Actual: " << TensorInfo::tensorShapeToString(requestShape);
+        return Status(StatusCode::INVALID_SHAPE, ss.str());
+    }
+    auto source = step.kernel(requestInput, content, InferenceEngine::TensorDesc(step.desc.getPrecision(), requestDims, step.desc.getLayout()));
+    auto padding = getBucketPadding(step.desc.getDims(), step.desc.getLayout(), requestShape, bucketPaddingMode);
+    return padBlob(source, step.desc, padding, bucketFillValue, blob);
+}
+
+Status ExecutionPlan::getBucketShapes(const tensorflow::serving::PredictRequest& request, std::map<std::string, shape_t>& requestShapes) const {
+    for (const auto& step : inputs) {
+        if (step.shapeBuckets.empty()) {
+            continue;
+        }
+        auto it = request.inputs().find(step.requestName);
+        if (it == request.inputs().end()) {
+            continue;
+        }
+        auto status = getBucketShape(step.shapeBuckets, step.desc.getLayout(), it->second.tensor_shape(), requestShapes[step.requestName]);
+        if (!status.ok()) {
+            return status;
+        }
+    }
+    return StatusCode::OK;
+}
+
+void ExecutionPlan::addBucketPaddings(const tensorflow::serving::PredictRequest& request, tensorflow::serving::PredictResponse& response) const {
+    for (const auto& step : inputs) {
+        if (step.shapeBuckets.empty()) {
+            continue;
+        }
+        auto it = request.inputs().find(step.requestName);
+        if (it == request.inputs().end()) {
+            continue;
+        }
+        const auto& requestShape = it->second.tensor_shape();
+        const size_t batchSize = requestShape.dim_size() > 0 ? requestShape.dim(0).size() : 1;
+        addBucketPaddingToResponse(step.requestName,
+            getBucketPadding(step.desc.getDims(), step.desc.getLayout(), requestShape, bucketPaddingMode), batchSize, response);
+    }
+}
+
+Status ExecutionPlan::serialize(InferenceEngine::InferRequest& inferRequest,
+    tensorflow::serving::PredictResponse* response) const {
+    for (const auto& step : outputs) {
+        if (!step.supported) {
+            Status status = StatusCode::OV_UNSUPPORTED_SERIALIZATION_PRECISION;
+            SPDLOG_ERROR(status.string());
+            return status;
+        }
+        InferenceEngine::Blob::Ptr blob;
+        try {
+            blob = inferRequest.GetBlob(step.networkName);
+        } catch (const InferenceEngine::details::InferenceEngineException& e) {
+            Status status = StatusCode::OV_INTERNAL_SERIALIZATION_ERROR;
+            SPDLOG_ERROR("{}: {}", status.string(), e.what());
+            return status;
+        }
+        auto& tensorProto = (*response->mutable_outputs())[step.responseName];
+        tensorProto = step.prototype;
+        tensorProto.mutable_tensor_content()->assign((char*)blob->buffer(), blob->byteSize());
+    }
+    return StatusCode::OK;
+}
+
+}  // namespace ovms
@@ -0,0 +1,135 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <inference_engine.hpp>
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wall"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow_serving/apis/prediction_service.grpc.pb.h"
+#pragma GCC diagnostic pop
+
+#include "modelconfig.hpp"
+#include "shape_buckets.hpp"
+#include "sparse_tensor.hpp"
+#include "status.hpp"
+#include "tensor_encoding.hpp"
+#include "tensorinfo.hpp"
+
+namespace ovms {
+
+/**
+ * @brief Creates blob with network input data from request tensor
+ *
+ * @param content tensor_content of request tensor or its decoded content
+ */
+using InputConversionKernel = InferenceEngine::Blob::Ptr (*)(const tensorflow::TensorProto& requestInput, const std::string& content, const InferenceEngine::TensorDesc& desc);
+
+/**
+ * @brief Selects input conversion kernel for network precision
+ *
+ * @return nullptr if precision is not supported
+ */
+InputConversionKernel getInputConversionKernel(InferenceEngine::Precision precision);
+
+/**
+ * @brief Returns response tensor data type for network output precision
+ *
+ * @return false if precision is not supported
+ */
+bool getOutputDataType(InferenceEngine::Precision precision, tensorflow::DataType& dtype);
+
+/**
+ * @brief Per model version request handling plan prepared at model load.
+ * Conversion kernels and response tensor metadata are resolved once from network inputs and outputs
+ * so that handling a request is a plain loop over inputs and outputs without per tensor precision dispatch.
+ */
+class ExecutionPlan {
+public:
+    /**
+     * @param config optional model config with shape buckets of inputs
+     */
+    ExecutionPlan(const std::map<std::string, std::shared_ptr<TensorInfo>>& inputsInfo,
+        const std::map<std::string, std::shared_ptr<TensorInfo>>& outputsInfo,
+        const ModelConfig* config = nullptr);
+
+    /**
+     * @brief Sets blobs of infer request with request inputs
+     *
+     * @param sparseInputsPool optional pool used for inputs passed in sparse format
+     * @param streamId stream executing request
+     * @param decodedInputs optional decoded contents of encoded request inputs
+     */
+    Status deserialize(const tensorflow::serving::PredictRequest& request,
+        InferenceEngine::InferRequest& inferRequest,
+        SparseInputsPool* sparseInputsPool = nullptr,
+        int streamId = 0,
+        const DecodedInputs* decodedInputs = nullptr) const;
+
+    /**
+     * @brief Fills response with infer request outputs
+     */
+    Status serialize(InferenceEngine::InferRequest& inferRequest,
+        tensorflow::serving::PredictResponse* response) const;
+
+    /**
+     * @brief Replaces request shapes of bucketed inputs with shapes of smallest fitting buckets
+     */
+    Status getBucketShapes(const tensorflow::serving::PredictRequest& request, std::map<std::string, shape_t>& requestShapes) const;
+
+    /**
+     * @brief Adds padding applied to each bucketed input to response
+     */
+    void addBucketPaddings(const tensorflow::serving::PredictRequest& request, tensorflow::serving::PredictResponse& response) const;
+
+private:
+    struct InputStep {
+        std::string requestName;
+        std::shared_ptr<TensorInfo> tensorInfo;
+        InferenceEngine::TensorDesc desc;
+        InputConversionKernel kernel;
+        /**
+         * @brief Empty if input is not bucketed
+         */
+        std::vector<size_t> shapeBuckets;
+    };
+
+    Status padToShapeBucket(const InputStep& step, const tensorflow::TensorProto& requestInput, const std::string& content, InferenceEngine::Blob::Ptr& blob) const;
+
+    struct OutputStep {
+        std::string networkName;
+        std::string responseName;
+        bool supported;
+        /**
+         * @brief Response tensor with dtype and tensor_shape already set, copied into response
+         */
+        tensorflow::TensorProto prototype;
+    };
+
+    std::vector<InputStep> inputs;
+    std::vector<OutputStep> outputs;
+
+    BucketPaddingMode bucketPaddingMode = BucketPaddingMode::PAD;
+    double bucketFillValue = 0;
+};
+
+}  // namespace ovms
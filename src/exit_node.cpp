@@ -28,12 +28,19 @@
 namespace ovms {
 
 Status ExitNode::fetchResults(BlobMap&) {
+    if (outputsStreamed) {
+        return StatusCode::OK;
+    }
+    return serializeOutputs(this->inputBlobs, *this->response);
+}
+
+Status ExitNode::serializeOutputs(const BlobMap& outputs, tensorflow::serving::PredictResponse& response) {
     // Serialize results to proto
-    for (const auto& kv : this->inputBlobs) {
+    for (const auto& kv : outputs) {
         const auto& output_name = kv.first;
         auto& blob = kv.second;
         spdlog::debug("[Node: {}] Serializing response from pipeline. Output name:{}", getName(), output_name);
-        auto& proto = (*this->response->mutable_outputs())[output_name];
+        auto& proto = (*response.mutable_outputs())[output_name];
         auto status = serialize(blob, proto);
         if (!status.ok()) {
             return status;
@@ -30,6 +30,9 @@ namespace ovms {
 class ExitNode : public Node {
     tensorflow::serving::PredictResponse* response;
 
+    // Outputs were already sent by pipeline as soon as nodes producing them finished
+    bool outputsStreamed = false;
+
 public:
     ExitNode(tensorflow::serving::PredictResponse* response) :
         Node("response"),
@@ -45,6 +48,15 @@ public:
 
     Status fetchResults(BlobMap& outputs) override;
 
+    void setOutputsStreamed(bool streamed) {
+        outputsStreamed = streamed;
+    }
+
+    /**
+     * @brief Serializes blobs keyed by pipeline output names to response
+     */
+    Status serializeOutputs(const BlobMap& outputs, tensorflow::serving::PredictResponse& response);
+
     // Exit nodes have no dependants
     void addDependant(Node& node) override {
         throw std::logic_error("This node cannot have dependant");
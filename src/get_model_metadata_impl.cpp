@@ -15,6 +15,11 @@
 //*****************************************************************************
 #include "get_model_metadata_impl.hpp"
 
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include <google/protobuf/struct.pb.h>
 #include <google/protobuf/util/json_util.h>
 
 using google::protobuf::util::JsonPrintOptions;
@@ -62,6 +67,10 @@ Status GetModelMetadataImpl::getModelStatus(
         return StatusCode::MODEL_MISSING;
     }
 
+    if (request->metadata_field(0) == "profile") {
+        return buildProfileResponse(instance, response);
+    }
+
     buildResponse(instance, response);
 
     return StatusCode::OK;
@@ -80,7 +89,7 @@ Status GetModelMetadataImpl::validate(
 
     const auto& signature = request->metadata_field().at(0);
 
-    if (signature != "signature_def") {
+    if (signature != "signature_def" && signature != "profile") {
         return StatusCode::INVALID_SIGNATURE_DEF;
     }
 
@@ -120,12 +129,48 @@ void GetModelMetadataImpl::buildResponse(
     (*response->mutable_metadata())["signature_def"].PackFrom(def);
 }
 
-Status GetModelMetadataImpl::createGrpcRequest(std::string model_name, std::optional<int64_t> model_version, tensorflow::serving::GetModelMetadataRequest* request) {
+Status GetModelMetadataImpl::buildProfileResponse(
+    std::shared_ptr<ModelInstance> instance,
+    tensorflow::serving::GetModelMetadataResponse* response) {
+    auto profile = instance->getProfile();
+    if (profile == nullptr) {
+        return StatusCode::MODEL_PROFILING_DISABLED;
+    }
+
+    response->Clear();
+    response->mutable_model_spec()->set_name(instance->getName());
+    response->mutable_model_spec()->mutable_version()->set_value(instance->getVersion());
+
+    auto layers = profile->getLayers();
+    std::vector<std::pair<std::string, LayerProfile>> sortedLayers(layers.begin(), layers.end());
+    std::sort(sortedLayers.begin(), sortedLayers.end(),
+        [](const auto& lhs, const auto& rhs) { return lhs.second.realTimeUs > rhs.second.realTimeUs; });
+
+    google::protobuf::Struct profileStruct;
+    auto& fields = *profileStruct.mutable_fields();
+    fields["inferences"].set_number_value(profile->getInferencesCount());
+    auto* layersList = fields["layers"].mutable_list_value();
+    for (const auto& [name, layer] : sortedLayers) {
+        auto& layerFields = *layersList->add_values()->mutable_struct_value()->mutable_fields();
+        layerFields["name"].set_string_value(name);
+        layerFields["layer_type"].set_string_value(layer.layerType);
+        layerFields["exec_type"].set_string_value(layer.execType);
+        layerFields["count"].set_number_value(layer.count);
+        layerFields["real_time_us_total"].set_number_value(layer.realTimeUs);
+        layerFields["real_time_us_avg"].set_number_value(static_cast<double>(layer.realTimeUs) / layer.count);
+        layerFields["cpu_time_us_avg"].set_number_value(static_cast<double>(layer.cpuTimeUs) / layer.count);
+    }
+
+    (*response->mutable_metadata())["profile"].PackFrom(profileStruct);
+    return StatusCode::OK;
+}
+
+Status GetModelMetadataImpl::createGrpcRequest(std::string model_name, std::optional<int64_t> model_version, tensorflow::serving::GetModelMetadataRequest* request, const std::string& metadata_field) {
     request->mutable_model_spec()->set_name(model_name);
     if (model_version.has_value()) {
         request->mutable_model_spec()->mutable_version()->set_value(model_version.value());
     }
-    request->mutable_metadata_field()->Add("signature_def");
+    request->mutable_metadata_field()->Add(metadata_field);
     return StatusCode::OK;
 }
 
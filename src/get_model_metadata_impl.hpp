@@ -44,10 +44,17 @@ public:
         std::shared_ptr<ModelInstance> instance,
         tensorflow::serving::GetModelMetadataResponse* response);
 
+    /**
+     * @brief Builds response with per layer performance counters of model version, requested with profile metadata field
+     */
+    static Status buildProfileResponse(
+        std::shared_ptr<ModelInstance> instance,
+        tensorflow::serving::GetModelMetadataResponse* response);
+
     static Status getModelStatus(
         const tensorflow::serving::GetModelMetadataRequest* request,
         tensorflow::serving::GetModelMetadataResponse* response);
-    static Status createGrpcRequest(std::string model_name, std::optional<int64_t> model_version, tensorflow::serving::GetModelMetadataRequest* request);
+    static Status createGrpcRequest(std::string model_name, std::optional<int64_t> model_version, tensorflow::serving::GetModelMetadataRequest* request, const std::string& metadata_field = "signature_def");
     static Status serializeResponse2Json(const tensorflow::serving::GetModelMetadataResponse* response, std::string* output);
 };
 
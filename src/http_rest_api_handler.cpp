@@ -15,6 +15,7 @@
 //*****************************************************************************
 #include "http_rest_api_handler.hpp"
 
+#include <chrono>
 #include <memory>
 #include <string>
 #include <string_view>
@@ -23,9 +24,11 @@
 
 #include <spdlog/spdlog.h>
 
+#include "cpu_profiler.hpp"
 #include "get_model_metadata_impl.hpp"
 #include "model_service.hpp"
 #include "modelinstanceunloadguard.hpp"
+#include "parallel_workers.hpp"
 #include "prediction_service_utils.hpp"
 #include "rest_parser.hpp"
 #include "rest_utils.hpp"
@@ -38,11 +41,13 @@ using tensorflow::serving::PredictResponse;
 
 namespace ovms {
 
-const std::string HttpRestApiHandler::kPathRegexExp = R"((.?)\/v1\/models\/.*)";
+const std::string HttpRestApiHandler::kPathRegexExp = R"((.?)\/v1\/(?:models|profiler)\/.*)";
 const std::string HttpRestApiHandler::predictionRegexExp =
     R"((.?)\/v1\/models\/([^\/:]+)(?:(?:\/versions\/(\d+))|(?:\/labels\/(\w+)))?:(classify|regress|predict))";
 const std::string HttpRestApiHandler::modelstatusRegexExp =
-    R"((.?)\/v1\/models(?:\/([^\/:]+))?(?:(?:\/versions\/(\d+))|(?:\/labels\/(\w+)))?(?:\/(metadata))?)";
+    R"((.?)\/v1\/models(?:\/([^\/:]+))?(?:(?:\/versions\/(\d+))|(?:\/labels\/(\w+)))?(?:\/(metadata|profile))?)";
+const std::string HttpRestApiHandler::cpuProfilerRegexExp = R"((.?)\/v1\/profiler\/cpu)";
+const std::string HttpRestApiHandler::batchPredictRegexExp = R"((.?)\/v1\/batch:predict)";
 
 Status HttpRestApiHandler::validateUrlAndMethod(
     const std::string_view http_method,
@@ -103,6 +108,9 @@ Status HttpRestApiHandler::dispatchToProcessor(
         if (!request_components.model_subresource.empty() && request_components.model_subresource == "metadata") {
             return processModelMetadataRequest(request_components.model_name, request_components.model_version,
                 request_components.model_version_label, response);
+        } else if (request_components.model_subresource == "profile") {
+            return processModelMetadataRequest(request_components.model_name, request_components.model_version,
+                request_components.model_version_label, response, "profile");
         } else {
             return processModelStatusRequest(request_components.model_name, request_components.model_version,
                 request_components.model_version_label, response);
@@ -120,6 +128,21 @@ Status HttpRestApiHandler::processRequest(
 
     std::smatch sm;
     std::string request_path_str(request_path);
+    if (std::regex_match(request_path_str, sm, cpuProfilerRegex)) {
+        if (http_method != "POST") {
+            return StatusCode::REST_UNSUPPORTED_METHOD;
+        }
+        return processCpuProfilerRequest(request_body, headers, response);
+    }
+    if (std::regex_match(request_path_str, sm, batchPredictRegex)) {
+        if (http_method != "POST") {
+            return StatusCode::REST_UNSUPPORTED_METHOD;
+        }
+        headers->clear();
+        response->clear();
+        headers->push_back({"Content-Type", "application/json"});
+        return processBatchPredictRequest(request_body, response);
+    }
     auto status = validateUrlAndMethod(http_method, request_path_str, &sm);
     if (!status.ok()) {
         return status;
@@ -157,7 +180,18 @@ Status HttpRestApiHandler::processPredictRequest(
     const std::string& request,
     std::string* response) {
     // model_version_label currently is not in use
+    rapidjson::Document doc;
+    if (doc.Parse(request.c_str()).HasParseError()) {
+        return StatusCode::JSON_INVALID;
+    }
+    return processPredictRequest(modelName, modelVersion, doc, response);
+}
 
+Status HttpRestApiHandler::processPredictRequest(
+    const std::string& modelName,
+    const std::optional<int64_t>& modelVersion,
+    rapidjson::Value& request,
+    std::string* response) {
     Timer timer;
     timer.start("total");
     using std::chrono::microseconds;
@@ -165,15 +199,14 @@ Status HttpRestApiHandler::processPredictRequest(
     spdlog::debug("Processing REST request for model: {}; version: {}",
         modelName, modelVersion.value_or(0));
 
-    ModelManager& modelManager = ModelManager::getInstance();
     Order requestOrder;
     tensorflow::serving::PredictResponse responseProto;
     Status status;
 
-    if (modelManager.modelExists(modelName)) {
+    if (this->modelManager.modelExists(modelName)) {
         SPDLOG_INFO("Found model with name: {}. Searching for requested version...", modelName);
         status = processSingleModelRequest(modelName, modelVersion, request, requestOrder, responseProto);
-    } else if (modelManager.pipelineDefinitionExists(modelName)) {
+    } else if (this->modelManager.pipelineDefinitionExists(modelName)) {
         SPDLOG_INFO("Found pipeline with name: {}", modelName);
         status = processPipelineRequest(modelName, request, requestOrder, responseProto);
     } else {
@@ -192,16 +225,79 @@ Status HttpRestApiHandler::processPredictRequest(
     return StatusCode::OK;
 }
 
+static ParallelWorkers& getBatchPredictWorkers() {
+    static ParallelWorkers workers(HttpRestApiHandler::BATCH_PREDICT_WORKERS);
+    return workers;
+}
+
+Status HttpRestApiHandler::processBatchPredictRequest(const std::string& request, std::string* response) {
+    rapidjson::Document doc;
+    if (doc.Parse(request.c_str()).HasParseError()) {
+        return StatusCode::JSON_INVALID;
+    }
+    if (!doc.IsObject()) {
+        return StatusCode::REST_BODY_IS_NOT_AN_OBJECT;
+    }
+    auto requestsItr = doc.FindMember("requests");
+    if (requestsItr == doc.MemberEnd() || !requestsItr->value.IsArray() || requestsItr->value.Empty()) {
+        return StatusCode::REST_BATCH_REQUESTS_NOT_AN_ARRAY;
+    }
+    auto& requests = requestsItr->value;
+    if (requests.Size() > MAX_BATCH_PREDICT_REQUESTS) {
+        return StatusCode::REST_BATCH_TOO_MANY_REQUESTS;
+    }
+    SPDLOG_DEBUG("Processing REST batch of {} predict requests", requests.Size());
+
+    std::vector<std::string> responses(requests.Size());
+    auto processItem = [this, &requests, &responses](rapidjson::SizeType i) {
+        auto status = processBatchPredictItem(requests[i], &responses[i]);
+        if (!status.ok()) {
+            responses[i] = "{\"error\": \"" + status.string() + "\"}";
+        }
+    };
+    // Elements block on inference, so they do not occupy parallel workers meant for CPU bound work
+    getBatchPredictWorkers().run(requests.Size(), [&processItem](size_t i) { processItem(static_cast<rapidjson::SizeType>(i)); });
+
+    response->append("{\n\"responses\": [\n");
+    for (size_t i = 0; i < responses.size(); i++) {
+        if (i > 0) {
+            response->append(",\n");
+        }
+        response->append(responses[i]);
+    }
+    response->append("\n]\n}");
+    return StatusCode::OK;
+}
+
+Status HttpRestApiHandler::processBatchPredictItem(rapidjson::Value& request, std::string* response) {
+    if (!request.IsObject()) {
+        return StatusCode::REST_BODY_IS_NOT_AN_OBJECT;
+    }
+    auto modelNameItr = request.FindMember("model_name");
+    if (modelNameItr == request.MemberEnd() || !modelNameItr->value.IsString()) {
+        return StatusCode::MODEL_NAME_MISSING;
+    }
+    std::optional<int64_t> modelVersion;
+    auto modelVersionItr = request.FindMember("model_version");
+    if (modelVersionItr != request.MemberEnd()) {
+        if (!modelVersionItr->value.IsInt64()) {
+            return StatusCode::REST_COULD_NOT_PARSE_VERSION;
+        }
+        modelVersion = modelVersionItr->value.GetInt64();
+    }
+    return processPredictRequest(modelNameItr->value.GetString(), modelVersion, request, response);
+}
+
 Status HttpRestApiHandler::processSingleModelRequest(const std::string& modelName,
     const std::optional<int64_t>& modelVersion,
-    const std::string& request,
+    rapidjson::Value& request,
     Order& requestOrder,
     tensorflow::serving::PredictResponse& responseProto) {
 
     std::shared_ptr<ModelInstance> modelInstance;
     std::unique_ptr<ModelInstanceUnloadGuard> modelInstanceUnloadGuard;
     auto status = getModelInstance(
-        ModelManager::getInstance(),
+        this->modelManager,
         modelName,
         modelVersion.value_or(0),
         modelInstance,
@@ -214,7 +310,7 @@ Status HttpRestApiHandler::processSingleModelRequest(const std::string& modelNam
     Timer timer;
     timer.start("parse");
     RestParser requestParser(modelInstance->getInputsInfo());
-    status = requestParser.parse(request.c_str());
+    status = requestParser.parse(request);
     if (!status.ok()) {
         return status;
     }
@@ -232,7 +328,7 @@ Status HttpRestApiHandler::processSingleModelRequest(const std::string& modelNam
 }
 
 Status HttpRestApiHandler::processPipelineRequest(const std::string& modelName,
-    const std::string& request,
+    rapidjson::Value& request,
     Order& requestOrder,
     tensorflow::serving::PredictResponse& responseProto) {
 
@@ -241,7 +337,7 @@ Status HttpRestApiHandler::processPipelineRequest(const std::string& modelName,
     Timer timer;
     timer.start("parse");
     RestParser requestParser;
-    auto status = requestParser.parse(request.c_str());
+    auto status = requestParser.parse(request);
     if (!status.ok()) {
         return status;
     }
@@ -251,7 +347,7 @@ Status HttpRestApiHandler::processPipelineRequest(const std::string& modelName,
 
     tensorflow::serving::PredictRequest& requestProto = requestParser.getProto();
     requestProto.mutable_model_spec()->set_name(modelName);
-    status = getPipeline(ModelManager::getInstance(), pipelinePtr, &requestProto, &responseProto);
+    status = getPipeline(this->modelManager, pipelinePtr, &requestProto, &responseProto);
     if (!status.ok()) {
         return status;
     }
@@ -263,13 +359,14 @@ Status HttpRestApiHandler::processModelMetadataRequest(
     const std::string_view model_name,
     const std::optional<int64_t>& model_version,
     const std::optional<std::string_view>& model_version_label,
-    std::string* response) {
+    std::string* response,
+    const std::string& metadata_field) {
     // model_version_label currently is not in use
     tensorflow::serving::GetModelMetadataRequest grpc_request;
     tensorflow::serving::GetModelMetadataResponse grpc_response;
     Status status;
     std::string modelName(model_name);
-    status = GetModelMetadataImpl::createGrpcRequest(modelName, model_version, &grpc_request);
+    status = GetModelMetadataImpl::createGrpcRequest(modelName, model_version, &grpc_request, metadata_field);
     if (!status.ok()) {
         return status;
     }
@@ -284,6 +381,27 @@ Status HttpRestApiHandler::processModelMetadataRequest(
     return StatusCode::OK;
 }
 
+Status HttpRestApiHandler::processCpuProfilerRequest(
+    const std::string& request,
+    std::vector<std::pair<std::string, std::string>>* headers,
+    std::string* response) {
+    std::chrono::seconds duration;
+    uint32_t frequency;
+    auto status = CpuProfiler::parseRequest(request, duration, frequency);
+    if (!status.ok()) {
+        return status;
+    }
+    std::string foldedStacks;
+    status = CpuProfiler::instance().profile(duration, frequency, foldedStacks);
+    if (!status.ok()) {
+        return status;
+    }
+    headers->clear();
+    headers->push_back({"Content-Type", "text/plain"});
+    *response = std::move(foldedStacks);
+    return StatusCode::OK;
+}
+
 Status HttpRestApiHandler::processModelStatusRequest(
     const std::string_view model_name,
     const std::optional<int64_t>& model_version,
@@ -25,6 +25,7 @@
 #include "tensorflow_serving/apis/prediction_service.grpc.pb.h"
 #pragma GCC diagnostic pop
 
+#include "modelmanager.hpp"
 #include "rest_parser.hpp"
 #include "status.hpp"
 
@@ -44,17 +45,29 @@ public:
     static const std::string kPathRegexExp;
     static const std::string predictionRegexExp;
     static const std::string modelstatusRegexExp;
+    static const std::string cpuProfilerRegexExp;
+    static const std::string batchPredictRegexExp;
+
+    static const size_t MAX_BATCH_PREDICT_REQUESTS = 256;
+    /**
+     * @brief Threads helping REST workers with elements of batch predict requests, which mostly wait for inference
+     */
+    static const size_t BATCH_PREDICT_WORKERS = 16;
 
     /**
      * @brief Construct a new HttpRest Api Handler
      * 
      * @param timeout_in_ms 
+     * @param modelManager manager of models and pipelines serving predict requests
      */
-    HttpRestApiHandler(int timeout_in_ms) :
+    HttpRestApiHandler(int timeout_in_ms, ModelManager& modelManager = ModelManager::getInstance()) :
         sanityRegex(kPathRegexExp),
         predictionRegex(predictionRegexExp),
         modelstatusRegex(modelstatusRegexExp),
-        timeout_in_ms(timeout_in_ms) {}
+        cpuProfilerRegex(cpuProfilerRegexExp),
+        batchPredictRegex(batchPredictRegexExp),
+        timeout_in_ms(timeout_in_ms),
+        modelManager(modelManager) {}
 
     Status validateUrlAndMethod(
         const std::string_view http_method,
@@ -105,16 +118,41 @@ public:
         const std::string& request,
         std::string* response);
 
-    Status processSingleModelRequest(
+    /**
+     * @brief Process predict request already parsed to JSON object
+     */
+    Status processPredictRequest(
         const std::string& modelName,
         const std::optional<int64_t>& modelVersion,
+        rapidjson::Value& request,
+        std::string* response);
+
+    /**
+     * @brief Process array of predict requests to models or pipelines, executed concurrently
+     *
+     * @param request JSON with requests array, each element containing model_name, optional model_version and inputs or instances
+     * @param response JSON with responses array, each element is predict response or error
+     *
+     * @return StatusCode
+     */
+    Status processBatchPredictRequest(
         const std::string& request,
+        std::string* response);
+
+    Status processBatchPredictItem(
+        rapidjson::Value& request,
+        std::string* response);
+
+    Status processSingleModelRequest(
+        const std::string& modelName,
+        const std::optional<int64_t>& modelVersion,
+        rapidjson::Value& request,
         Order& requestOrder,
         tensorflow::serving::PredictResponse& responseProto);
 
     Status processPipelineRequest(
         const std::string& modelName,
-        const std::string& request,
+        rapidjson::Value& request,
         Order& requestOrder,
         tensorflow::serving::PredictResponse& responseProto);
 
@@ -125,6 +163,7 @@ public:
      * @param model_version 
      * @param model_version_label 
      * @param response
+     * @param metadata_field signature_def or profile
      *
      * @return StatusCode 
      */
@@ -132,7 +171,8 @@ public:
         const std::string_view model_name,
         const std::optional<int64_t>& model_version,
         const std::optional<std::string_view>& model_version_label,
-        std::string* response);
+        std::string* response,
+        const std::string& metadata_field = "signature_def");
 
     /**
      * @brief Process Model Status request
@@ -149,12 +189,29 @@ public:
         const std::optional<std::string_view>& model_version_label,
         std::string* response);
 
+    /**
+     * @brief Process CPU profiler request, blocks for requested profiling duration
+     *
+     * @param request JSON with optional duration_seconds and frequency
+     * @param headers
+     * @param response folded stacks
+     * @return StatusCode
+     */
+    Status processCpuProfilerRequest(
+        const std::string& request,
+        std::vector<std::pair<std::string, std::string>>* headers,
+        std::string* response);
+
 private:
     const std::regex sanityRegex;
     const std::regex predictionRegex;
     const std::regex modelstatusRegex;
+    const std::regex cpuProfilerRegex;
+    const std::regex batchPredictRegex;
 
     int timeout_in_ms;
+
+    ModelManager& modelManager;
 };
 
 }  // namespace ovms
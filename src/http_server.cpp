@@ -31,7 +31,9 @@
 #include "tensorflow_serving/util/threadpool_executor.h"
 #pragma GCC diagnostic pop
 
+#include "core_partitioning.hpp"
 #include "http_rest_api_handler.hpp"
+#include "rest_utils.hpp"
 #include "status.hpp"
 
 namespace ovms {
@@ -51,8 +53,9 @@ private:
 
 class RestApiRequestDispatcher {
 public:
-    RestApiRequestDispatcher(int timeout_in_ms) :
-        regex_(HttpRestApiHandler::kPathRegexExp) {
+    RestApiRequestDispatcher(int timeout_in_ms, size_t compression_threshold) :
+        regex_(HttpRestApiHandler::kPathRegexExp),
+        compression_threshold_(compression_threshold) {
         handler_ = std::make_unique<HttpRestApiHandler>(timeout_in_ms);
     }
 
@@ -87,6 +90,7 @@ private:
         for (const auto& kv : headers) {
             req->OverwriteResponseHeader(kv.first, kv.second);
         }
+        compressResponse(req, output);
         req->WriteResponseString(output);
         if (http_status != net_http::HTTPStatusCode::OK) {
             spdlog::error("Error Processing HTTP/REST request: {} {} Error: {}",
@@ -97,14 +101,41 @@ private:
         req->ReplyWithStatus(http_status);
     }
 
+    void compressResponse(net_http::ServerRequestInterface* req, std::string& output) {
+        if (compression_threshold_ == 0) {
+            return;
+        }
+        // Response depends on Accept-Encoding whenever compression is enabled
+        req->OverwriteResponseHeader("Vary", "Accept-Encoding");
+        if (output.size() < compression_threshold_) {
+            return;
+        }
+        const auto acceptEncoding = req->GetRequestHeader("Accept-Encoding");
+        if (!isGzipEncodingAccepted(std::string_view(acceptEncoding.data(), acceptEncoding.size()))) {
+            return;
+        }
+        std::string compressed;
+        if (!compressGzip(output, &compressed)) {
+            return;
+        }
+        spdlog::debug("Compressed REST response from {} to {} bytes", output.size(), compressed.size());
+        output = std::move(compressed);
+        req->OverwriteResponseHeader("Content-Encoding", "gzip");
+    }
+
     const std::regex regex_;
     std::unique_ptr<HttpRestApiHandler> handler_;
+    const size_t compression_threshold_;
 };
 
-std::unique_ptr<http_server> createAndStartHttpServer(int port, int num_threads, int timeout_in_ms) {
+std::unique_ptr<http_server> createAndStartHttpServer(int port, int num_threads, int timeout_in_ms, size_t compression_threshold) {
     auto options = std::make_unique<net_http::ServerOptions>();
     options->AddPort(static_cast<uint32_t>(port));
+    // REST workers parse and serialize JSON on serialization cores, event loop thread stays on I/O cores
+    auto& corePartitioning = CorePartitioning::instance();
+    corePartitioning.applyToCurrentThread(ThreadRole::SERIALIZATION);
     options->SetExecutor(std::make_unique<RequestExecutor>(num_threads));
+    corePartitioning.applyToCurrentThread(ThreadRole::IO);
 
     auto server = net_http::CreateEvHTTPServer(std::move(options));
     if (server == nullptr) {
@@ -113,7 +144,7 @@ std::unique_ptr<http_server> createAndStartHttpServer(int port, int num_threads,
     }
 
     std::shared_ptr<RestApiRequestDispatcher> dispatcher =
-        std::make_shared<RestApiRequestDispatcher>(timeout_in_ms);
+        std::make_shared<RestApiRequestDispatcher>(timeout_in_ms, compression_threshold);
 
     net_http::RequestHandlerOptions handler_options;
     server->RegisterRequestDispatcher(
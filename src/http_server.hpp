@@ -32,9 +32,10 @@ using http_server = tensorflow::serving::net_http::HTTPServerInterface;
  * @param port 
  * @param num_threads 
  * @param timeout_in_m
+ * @param compression_threshold minimal size of response in bytes to be gzip compressed, 0 disables compression
  *  
  * @return std::unique_ptr<http_server> 
  */
-std::unique_ptr<http_server> createAndStartHttpServer(int port, int num_threads, int timeout_in_ms);
+std::unique_ptr<http_server> createAndStartHttpServer(int port, int num_threads, int timeout_in_ms, size_t compression_threshold = 0);
 
 }  // namespace ovms
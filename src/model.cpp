@@ -17,6 +17,7 @@
 
 #include <map>
 #include <memory>
+#include <random>
 #include <utility>
 
 namespace ovms {
@@ -34,6 +35,7 @@ const std::map<model_version_t, std::shared_ptr<ModelInstance>>& Model::getModel
 }
 
 void Model::updateDefaultVersion() {
+    std::unique_lock lock(modelVersionsMtx);
     model_version_t newDefaultVersion = 0;
     spdlog::info("Updating default version for model:{}, from:{}", getName(), defaultVersion);
     for (const auto& [version, versionInstance] : modelVersions) {
@@ -48,11 +50,53 @@ void Model::updateDefaultVersion() {
     } else {
         SPDLOG_INFO("Model:{} will not have default version since no version is available.", getName());
     }
+    if (rampUpFromVersion == 0) {
+        return;
+    }
+    auto rampUpFrom = modelVersions.find(rampUpFromVersion);
+    if (newDefaultVersion != rampUpToVersion ||
+        rampUpFrom == modelVersions.end() ||
+        ModelVersionState::AVAILABLE != rampUpFrom->second->getStatus().getState()) {
+        SPDLOG_INFO("Ramp-up of model:{} from version:{} to version:{} cancelled", getName(), rampUpFromVersion, rampUpToVersion);
+        rampUpFromVersion = 0;
+        rampUpToVersion = 0;
+    }
+}
+
+void Model::startRampUp(model_version_t previousDefaultVersion, uint64_t rampUpMs) {
+    std::unique_lock lock(modelVersionsMtx);
+    if (rampUpMs == 0 || previousDefaultVersion == 0 || previousDefaultVersion == defaultVersion) {
+        return;
+    }
+    auto previous = modelVersions.find(previousDefaultVersion);
+    if (previous == modelVersions.end() ||
+        ModelVersionState::AVAILABLE != previous->second->getStatus().getState()) {
+        return;
+    }
+    rampUpFromVersion = previousDefaultVersion;
+    rampUpToVersion = defaultVersion;
+    rampUpStart = std::chrono::steady_clock::now();
+    rampUpDuration = std::chrono::milliseconds(rampUpMs);
+    SPDLOG_INFO("Requests to model:{} will ramp up from version:{} to version:{} in {} ms", getName(), rampUpFromVersion, rampUpToVersion, rampUpMs);
 }
 
 const std::shared_ptr<ModelInstance> Model::getDefaultModelInstance() const {
     std::shared_lock lock(modelVersionsMtx);
     auto defaultVersion = getDefaultVersion();
+    const auto now = std::chrono::steady_clock::now();
+    if (isRampUpInProgress(now)) {
+        // share of requests served by new default version grows linearly with ramp-up time
+        static thread_local std::minstd_rand generator(std::random_device{}());
+        std::uniform_real_distribution<double> distribution(0.0, 1.0);
+        const double progress = std::chrono::duration<double>(now - rampUpStart) / rampUpDuration;
+        if (distribution(generator) >= progress) {
+            const auto rampUpFrom = modelVersions.find(rampUpFromVersion);
+            if (rampUpFrom != modelVersions.end() &&
+                ModelVersionState::AVAILABLE == rampUpFrom->second->getStatus().getState()) {
+                return rampUpFrom->second;
+            }
+        }
+    }
     const auto modelInstanceIt = modelVersions.find(defaultVersion);
 
     if (modelVersions.end() == modelInstanceIt) {
@@ -83,6 +127,7 @@ Status Model::addVersion(const ModelConfig& config) {
 
 Status Model::addVersions(std::shared_ptr<model_versions_t> versionsToStart, ovms::ModelConfig& config) {
     Status result = StatusCode::OK;
+    const model_version_t previousDefaultVersion = getDefaultVersion();
     for (const auto version : *versionsToStart) {
         spdlog::info("Will add model: {}; version: {} ...", getName(), version);
         config.setVersion(version);
@@ -96,6 +141,7 @@ Status Model::addVersions(std::shared_ptr<model_versions_t> versionsToStart, ovm
             result = status;
         }
     }
+    startRampUp(previousDefaultVersion, config.getVersionRampUpMs());
     return result;
 }
 
@@ -113,6 +159,10 @@ Status Model::retireVersions(std::shared_ptr<model_versions_t> versionsToRetire)
             result = status;
             continue;
         }
+        if (isVersionRampingDown(version)) {
+            spdlog::debug("Model: {}; version: {} is kept loaded until requests ramp up to new default version", getName(), version);
+            continue;
+        }
         modelVersion->unloadModel();
         updateDefaultVersion();
     }
@@ -129,6 +179,7 @@ void Model::retireAllVersions() {
 
 Status Model::reloadVersions(std::shared_ptr<model_versions_t> versionsToReload, ovms::ModelConfig& config) {
     Status result = StatusCode::OK;
+    const model_version_t previousDefaultVersion = getDefaultVersion();
     for (const auto version : *versionsToReload) {
         spdlog::info("Will reload model: {}; version: {} ...", getName(), version);
         config.setVersion(version);
@@ -157,6 +208,7 @@ Status Model::reloadVersions(std::shared_ptr<model_versions_t> versionsToReload,
         }
         updateDefaultVersion();
     }
+    startRampUp(previousDefaultVersion, config.getVersionRampUpMs());
     return result;
 }
 
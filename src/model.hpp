@@ -15,6 +15,7 @@
 //*****************************************************************************
 #pragma once
 
+#include <chrono>
 #include <map>
 #include <memory>
 #include <shared_mutex>
@@ -36,10 +37,45 @@ private:
     mutable std::shared_mutex modelVersionsMtx;
 
     /**
-         * @brief Update default version
+         * @brief Previous default version still getting part of requests without version while they ramp up to new default version, 0 if there is no ramp-up
+         */
+    model_version_t rampUpFromVersion = 0;
+
+    /**
+         * @brief Default version requests ramp up to
+         */
+    model_version_t rampUpToVersion = 0;
+
+    /**
+         * @brief Start of the ramp-up
+         */
+    std::chrono::steady_clock::time_point rampUpStart;
+
+    /**
+         * @brief Time over which requests shift to new default version
+         */
+    std::chrono::milliseconds rampUpDuration{0};
+
+    /**
+         * @brief Update default version, cancels ramp-up when its versions are no longer default or available
          */
     void updateDefaultVersion();
 
+    /**
+         * @brief Starts shifting requests from previous default version when default version changed and ramp-up is configured
+         *
+         * @param previousDefaultVersion default version before versions were added or reloaded
+         * @param rampUpMs ramp-up time, 0 disables ramp-up
+         */
+    void startRampUp(model_version_t previousDefaultVersion, uint64_t rampUpMs);
+
+    /**
+         * @brief Checks if ramp-up is in progress, requires modelVersionsMtx to be locked
+         */
+    bool isRampUpInProgress(std::chrono::steady_clock::time_point now) const {
+        return rampUpFromVersion != 0 && now - rampUpStart < rampUpDuration;
+    }
+
 protected:
     /**
          * @brief Model name
@@ -107,12 +143,25 @@ public:
     }
 
     /**
-         * @brief Gets the default ModelInstance
+         * @brief Gets the default ModelInstance. During ramp-up previous default version is returned
+         * with probability decreasing linearly over the ramp-up time
          *
          * @return ModelInstance
          */
     const std::shared_ptr<ModelInstance> getDefaultModelInstance() const;
 
+    /**
+         * @brief Checks whether version is kept loaded to serve part of requests until ramp-up to new default version completes
+         *
+         * @param version of the model
+         *
+         * @return true if version is previous default version of ramp-up in progress
+         */
+    bool isVersionRampingDown(const model_version_t& version) const {
+        std::shared_lock lock(modelVersionsMtx);
+        return version == rampUpFromVersion && isRampUpInProgress(std::chrono::steady_clock::now());
+    }
+
     /**
      * @brief Gets model versions instances
      *
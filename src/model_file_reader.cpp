@@ -0,0 +1,393 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "model_file_reader.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <spdlog/spdlog.h>
+
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#define OVMS_IO_URING 1
+#endif
+
+namespace ovms {
+
+namespace {
+const size_t DIRECT_IO_ALIGNMENT = 4096;
+const size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+size_t alignUp(size_t value, size_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+struct Chunk {
+    size_t offset;
+    size_t size;
+};
+
+std::vector<Chunk> splitIntoChunks(size_t fileSize, size_t chunkSize) {
+    std::vector<Chunk> chunks;
+    for (size_t offset = 0; offset < fileSize; offset += chunkSize) {
+        // with direct I/O reads past end of file have to be aligned too, buffer is large enough
+        chunks.push_back({offset, alignUp(std::min(chunkSize, fileSize - offset), DIRECT_IO_ALIGNMENT)});
+    }
+    return chunks;
+}
+
+// Returns 0 or errno of failed read
+int readWithPread(int fd, char* data, size_t fileSize, const std::vector<Chunk>& chunks, unsigned threadsCount) {
+    std::atomic<size_t> nextChunk{0};
+    std::atomic<int> error{0};
+    auto worker = [&]() {
+        for (size_t i = nextChunk++; i < chunks.size() && error == 0; i = nextChunk++) {
+            size_t done = 0;
+            while (done < chunks[i].size && chunks[i].offset + done < fileSize) {
+                ssize_t result = pread(fd, data + chunks[i].offset + done, chunks[i].size - done, chunks[i].offset + done);
+                if (result < 0 && errno == EINTR) {
+                    continue;
+                }
+                if (result <= 0) {
+                    error = result < 0 ? errno : EIO;
+                    return;
+                }
+                done += result;
+            }
+        }
+    };
+    std::vector<std::thread> threads;
+    for (unsigned i = 1; i < std::min<size_t>(threadsCount, chunks.size()); i++) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    return error;
+}
+
+#ifdef OVMS_IO_URING
+// Minimal io_uring wrapper using raw system calls, so that no additional library is required
+class IoUring {
+public:
+    ~IoUring() {
+        if (sqes != MAP_FAILED) {
+            munmap(sqes, sqesSize);
+        }
+        if (cqRing != MAP_FAILED && cqRing != sqRing) {
+            munmap(cqRing, cqRingSize);
+        }
+        if (sqRing != MAP_FAILED) {
+            munmap(sqRing, sqRingSize);
+        }
+        if (ringFd >= 0) {
+            close(ringFd);
+        }
+    }
+
+    // Returns 0 or errno
+    int init(unsigned entries) {
+        io_uring_params params;
+        std::memset(&params, 0, sizeof(params));
+        ringFd = static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+        if (ringFd < 0) {
+            return errno;
+        }
+        sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        bool singleMmap = params.features & IORING_FEAT_SINGLE_MMAP;
+        if (singleMmap) {
+            sqRingSize = cqRingSize = std::max(sqRingSize, cqRingSize);
+        }
+        sqRing = mmap(nullptr, sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_SQ_RING);
+        if (sqRing == MAP_FAILED) {
+            return errno;
+        }
+        cqRing = singleMmap ? sqRing : mmap(nullptr, cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_CQ_RING);
+        if (cqRing == MAP_FAILED) {
+            return errno;
+        }
+        sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+        sqes = mmap(nullptr, sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_SQES);
+        if (sqes == MAP_FAILED) {
+            return errno;
+        }
+        char* sq = static_cast<char*>(sqRing);
+        sqHead = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+        sqTail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+        sqMask = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+        sqArray = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+        sqEntries = params.sq_entries;
+        char* cq = static_cast<char*>(cqRing);
+        cqHead = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+        cqTail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+        cqMask = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+        cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+        return 0;
+    }
+
+    unsigned getEntries() const {
+        return sqEntries;
+    }
+
+    // iovec has to stay valid until completion
+    bool queueRead(int fd, iovec* iov, size_t offset, uint64_t userData) {
+        unsigned tail = *sqTail;
+        if (tail - __atomic_load_n(sqHead, __ATOMIC_ACQUIRE) >= sqEntries) {
+            return false;
+        }
+        unsigned index = tail & sqMask;
+        io_uring_sqe* sqe = static_cast<io_uring_sqe*>(sqes) + index;
+        std::memset(sqe, 0, sizeof(*sqe));
+        // READV is available since first io_uring kernels
+        sqe->opcode = IORING_OP_READV;
+        sqe->fd = fd;
+        sqe->addr = reinterpret_cast<uint64_t>(iov);
+        sqe->len = 1;
+        sqe->off = offset;
+        sqe->user_data = userData;
+        sqArray[index] = index;
+        __atomic_store_n(sqTail, tail + 1, __ATOMIC_RELEASE);
+        return true;
+    }
+
+    // Submits queued reads and waits for at least one completion. Returns 0 or errno, submitted is set to number
+    // of reads consumed by the kernel, reads not consumed stay queued
+    int submitAndWait(unsigned toSubmit, unsigned& submitted) {
+        submitted = 0;
+        long result;
+        // interrupted call returns error only when nothing was submitted
+        while ((result = syscall(__NR_io_uring_enter, ringFd, toSubmit, 1, IORING_ENTER_GETEVENTS, nullptr, 0)) < 0) {
+            if (errno != EINTR) {
+                return errno;
+            }
+        }
+        submitted = static_cast<unsigned>(result);
+        return 0;
+    }
+
+    bool popCompletion(uint64_t& userData, int& result) {
+        unsigned head = *cqHead;
+        if (head == __atomic_load_n(cqTail, __ATOMIC_ACQUIRE)) {
+            return false;
+        }
+        const io_uring_cqe& cqe = cqes[head & cqMask];
+        userData = cqe.user_data;
+        result = cqe.res;
+        __atomic_store_n(cqHead, head + 1, __ATOMIC_RELEASE);
+        return true;
+    }
+
+private:
+    int ringFd = -1;
+    void* sqRing = MAP_FAILED;
+    void* cqRing = MAP_FAILED;
+    void* sqes = MAP_FAILED;
+    size_t sqRingSize = 0;
+    size_t cqRingSize = 0;
+    size_t sqesSize = 0;
+    unsigned* sqHead = nullptr;
+    unsigned* sqTail = nullptr;
+    unsigned sqMask = 0;
+    unsigned* sqArray = nullptr;
+    unsigned sqEntries = 0;
+    unsigned* cqHead = nullptr;
+    unsigned* cqTail = nullptr;
+    unsigned cqMask = 0;
+    io_uring_cqe* cqes = nullptr;
+};
+
+// Returns 0 or errno of failed read, ENOSYS if io_uring cannot be used
+int readWithIoUring(int fd, char* data, size_t fileSize, const std::vector<Chunk>& chunks, unsigned queueDepth) {
+    IoUring ring;
+    int error = ring.init(queueDepth);
+    if (error != 0) {
+        SPDLOG_DEBUG("io_uring setup failed: {}", std::strerror(error));
+        return ENOSYS;
+    }
+    std::vector<iovec> iovecs(chunks.size());
+    std::vector<size_t> done(chunks.size(), 0);
+    std::vector<size_t> pending;
+    pending.reserve(chunks.size());
+    for (size_t i = chunks.size(); i > 0; i--) {
+        pending.push_back(i - 1);
+    }
+    // Reads submitted to the kernel target iovecs and data, so all of them have to complete before returning,
+    // also after the first error
+    size_t inFlight = 0;
+    unsigned unsubmitted = 0;
+    int firstError = 0;
+    while (inFlight > 0 || (firstError == 0 && (unsubmitted > 0 || !pending.empty()))) {
+        while (firstError == 0 && !pending.empty() && inFlight + unsubmitted < ring.getEntries()) {
+            size_t i = pending.back();
+            iovecs[i].iov_base = data + chunks[i].offset + done[i];
+            iovecs[i].iov_len = chunks[i].size - done[i];
+            if (!ring.queueRead(fd, &iovecs[i], chunks[i].offset + done[i], i)) {
+                break;
+            }
+            pending.pop_back();
+            unsubmitted++;
+        }
+        unsigned submitted = 0;
+        error = ring.submitAndWait(firstError == 0 ? unsubmitted : 0, submitted);
+        inFlight += submitted;
+        unsubmitted -= submitted;
+        if (error != 0) {
+            if (firstError == 0) {
+                firstError = error;
+            }
+            if (inFlight > 0) {
+                // completions are posted without io_uring_enter, so in-flight reads are still collected by polling
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+        uint64_t i;
+        int result;
+        while (ring.popCompletion(i, result)) {
+            inFlight--;
+            if (firstError != 0) {
+                continue;
+            }
+            if (result < 0) {
+                firstError = -result;
+                continue;
+            }
+            if (result == 0 && chunks[i].offset + done[i] < fileSize) {
+                firstError = EIO;
+                continue;
+            }
+            done[i] += result;
+            // short read in the middle of file
+            if (done[i] < chunks[i].size && chunks[i].offset + done[i] < fileSize) {
+                pending.push_back(i);
+            }
+        }
+    }
+    // reads queued but never consumed by the kernel are discarded with the ring
+    return firstError;
+}
+#endif
+
+int readChunks(int fd, char* data, size_t fileSize, const ModelFileReadOptions& options) {
+    const auto chunks = splitIntoChunks(fileSize, alignUp(std::max<size_t>(options.chunkSize, 1), DIRECT_IO_ALIGNMENT));
+    const unsigned queueDepth = std::max(options.queueDepth, 1u);
+#ifdef OVMS_IO_URING
+    if (options.method != ModelFileReadMethod::PREAD) {
+        int error = readWithIoUring(fd, data, fileSize, chunks, queueDepth);
+        if (error != ENOSYS || options.method == ModelFileReadMethod::IO_URING) {
+            return error;
+        }
+    }
+#else
+    if (options.method == ModelFileReadMethod::IO_URING) {
+        return ENOSYS;
+    }
+#endif
+    return readWithPread(fd, data, fileSize, chunks, queueDepth);
+}
+}  // namespace
+
+ModelFileBuffer::~ModelFileBuffer() {
+    if (mapping != nullptr) {
+        munmap(mapping, mappingSize);
+    }
+}
+
+std::unique_ptr<ModelFileBuffer> ModelFileBuffer::allocate(size_t size, bool hugePages) {
+    std::unique_ptr<ModelFileBuffer> buffer(new ModelFileBuffer());
+    const size_t alignment = hugePages ? HUGE_PAGE_SIZE : DIRECT_IO_ALIGNMENT;
+    // extra space to align start of the buffer to huge page and to read last chunk with direct I/O
+    buffer->mappingSize = alignUp(size, alignment) + alignment;
+    void* mapping = mmap(nullptr, buffer->mappingSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (mapping == MAP_FAILED) {
+        return nullptr;
+    }
+    buffer->mapping = mapping;
+    buffer->alignedData = reinterpret_cast<char*>(alignUp(reinterpret_cast<uintptr_t>(mapping), alignment));
+    buffer->fileSize = size;
+    if (hugePages && madvise(buffer->alignedData, alignUp(size, alignment), MADV_HUGEPAGE) != 0) {
+        SPDLOG_DEBUG("Transparent huge pages are not available for model file buffer: {}", std::strerror(errno));
+    }
+    return buffer;
+}
+
+bool isIoUringSupported() {
+#ifdef OVMS_IO_URING
+    IoUring ring;
+    return ring.init(1) == 0;
+#else
+    return false;
+#endif
+}
+
+Status readModelFile(const std::string& path, std::shared_ptr<ModelFileBuffer>& buffer, const ModelFileReadOptions& options) {
+    bool directIo = options.directIo;
+    int fd = ::open(path.c_str(), O_RDONLY | (directIo ? O_DIRECT : 0));
+    if (fd < 0 && directIo && errno == EINVAL) {
+        directIo = false;
+        fd = ::open(path.c_str(), O_RDONLY);
+    }
+    if (fd < 0) {
+        const int error = errno;
+        SPDLOG_ERROR("Failed to open model file: {}; error: {}", path, std::strerror(error));
+        return StatusCode::FILE_INVALID;
+    }
+    struct stat fileStat;
+    if (fstat(fd, &fileStat) != 0) {
+        const int error = errno;
+        SPDLOG_ERROR("Failed to get size of model file: {}; error: {}", path, std::strerror(error));
+        close(fd);
+        return StatusCode::FILE_INVALID;
+    }
+    std::shared_ptr<ModelFileBuffer> result = ModelFileBuffer::allocate(fileStat.st_size, options.hugePages);
+    if (!result) {
+        SPDLOG_ERROR("Failed to allocate {} bytes for model file: {}", fileStat.st_size, path);
+        close(fd);
+        return StatusCode::FILE_INVALID;
+    }
+    int error = readChunks(fd, result->data(), result->size(), options);
+    if (error == EINVAL && directIo) {
+        // file system accepted O_DIRECT flag but does not support direct reads
+        SPDLOG_DEBUG("Direct I/O is not supported for model file: {}, using buffered reads", path);
+        close(fd);
+        fd = ::open(path.c_str(), O_RDONLY);
+        error = fd < 0 ? errno : readChunks(fd, result->data(), result->size(), options);
+    }
+    if (fd >= 0) {
+        close(fd);
+    }
+    if (error != 0) {
+        SPDLOG_ERROR("Failed to read model file: {}; error: {}", path, std::strerror(error));
+        return StatusCode::FILE_INVALID;
+    }
+    buffer = std::move(result);
+    return StatusCode::OK;
+}
+
+}  // namespace ovms
@@ -0,0 +1,100 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "status.hpp"
+
+namespace ovms {
+
+/**
+ * @brief Model weights files smaller than this are read by OpenVINO directly
+ */
+const size_t MODEL_FILE_READER_MIN_SIZE = 64 * 1024 * 1024;
+
+enum class ModelFileReadMethod {
+    AUTO,     /*!< io_uring if supported by build and kernel, otherwise PREAD */
+    IO_URING, /*!< several reads in flight submitted through single io_uring */
+    PREAD     /*!< several threads issuing blocking reads */
+};
+
+struct ModelFileReadOptions {
+    ModelFileReadMethod method = ModelFileReadMethod::AUTO;
+    /**
+     * @brief Size of single read, multiple of 4096
+     */
+    size_t chunkSize = 4 * 1024 * 1024;
+    /**
+     * @brief Number of reads in flight
+     */
+    unsigned queueDepth = 16;
+    /**
+     * @brief Bypass page cache with O_DIRECT when file system supports it
+     */
+    bool directIo = true;
+    /**
+     * @brief Ask for transparent huge pages backing the buffer
+     */
+    bool hugePages = true;
+};
+
+/**
+ * @brief Memory holding whole model file, aligned for direct I/O
+ */
+class ModelFileBuffer {
+public:
+    ModelFileBuffer(const ModelFileBuffer&) = delete;
+    ModelFileBuffer& operator=(const ModelFileBuffer&) = delete;
+    ~ModelFileBuffer();
+
+    /**
+     * @return nullptr if memory could not be allocated
+     */
+    static std::unique_ptr<ModelFileBuffer> allocate(size_t size, bool hugePages);
+
+    char* data() const {
+        return alignedData;
+    }
+
+    size_t size() const {
+        return fileSize;
+    }
+
+private:
+    ModelFileBuffer() = default;
+
+    void* mapping = nullptr;
+    size_t mappingSize = 0;
+    char* alignedData = nullptr;
+    size_t fileSize = 0;
+};
+
+/**
+ * @brief Checks whether server was built with io_uring support and kernel allows to use it
+ */
+bool isIoUringSupported();
+
+/**
+ * @brief Reads whole file into memory with options.queueDepth large reads in flight,
+ * so that fast storage is not limited by single sequential read stream
+ *
+ * @return FILE_INVALID if file could not be opened or read
+ */
+Status readModelFile(const std::string& path, std::shared_ptr<ModelFileBuffer>& buffer, const ModelFileReadOptions& options = {});
+
+}  // namespace ovms
@@ -0,0 +1,233 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "model_package.hpp"
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <istream>
+#include <streambuf>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <spdlog/spdlog.h>
+
+namespace ovms {
+
+namespace {
+const char MODEL_PACKAGE_MAGIC[8] = {'O', 'V', 'M', 'S', 'P', 'K', 'G', '1'};
+const size_t MODEL_PACKAGE_HEADER_SIZE = sizeof(MODEL_PACKAGE_MAGIC) + 2 * sizeof(uint32_t);
+const size_t MODEL_PACKAGE_ENTRY_HEADER_SIZE = 2 * sizeof(uint64_t) + sizeof(uint32_t);
+const uint32_t MODEL_PACKAGE_MAX_NAME_LENGTH = 1024;
+
+template <typename T>
+T readLittleEndian(const char* data) {
+    T value;
+    std::memcpy(&value, data, sizeof(T));
+    return value;
+}
+
+template <typename T>
+void writeLittleEndian(std::ostream& stream, T value) {
+    stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+size_t alignUp(size_t offset) {
+    return (offset + MODEL_PACKAGE_ALIGNMENT - 1) / MODEL_PACKAGE_ALIGNMENT * MODEL_PACKAGE_ALIGNMENT;
+}
+
+// Lets plugins import compiled network from mapped memory without copying it into string stream
+class MemoryStreamBuf : public std::streambuf {
+public:
+    MemoryStreamBuf(std::string_view data) {
+        char* begin = const_cast<char*>(data.data());
+        setg(begin, begin, begin + data.size());
+    }
+
+protected:
+    pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which) override {
+        char* position = dir == std::ios_base::beg ? eback() : dir == std::ios_base::cur ? gptr() : egptr();
+        position += off;
+        if (position < eback() || position > egptr()) {
+            return pos_type(off_type(-1));
+        }
+        setg(eback(), position, egptr());
+        return pos_type(position - eback());
+    }
+
+    pos_type seekpos(pos_type pos, std::ios_base::openmode which) override {
+        return seekoff(off_type(pos), std::ios_base::beg, which);
+    }
+};
+}  // namespace
+
+ModelPackage::~ModelPackage() {
+    if (data != nullptr) {
+        munmap(data, size);
+    }
+}
+
+Status ModelPackage::open(const std::string& path, std::shared_ptr<ModelPackage>& package) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        SPDLOG_ERROR("Failed to open model package: {}; error: {}", path, std::strerror(errno));
+        return StatusCode::FILE_INVALID;
+    }
+    struct stat fileStat;
+    if (fstat(fd, &fileStat) != 0 || fileStat.st_size == 0) {
+        SPDLOG_ERROR("Failed to get size of model package: {}", path);
+        close(fd);
+        return StatusCode::FILE_INVALID;
+    }
+    std::shared_ptr<ModelPackage> result(new ModelPackage(path));
+    result->size = fileStat.st_size;
+    void* data = mmap(nullptr, result->size, PROT_READ, MAP_PRIVATE, fd, 0);
+    // mapping stays valid after closing descriptor
+    close(fd);
+    if (data == MAP_FAILED) {
+        SPDLOG_ERROR("Failed to map model package: {}; error: {}", path, std::strerror(errno));
+        return StatusCode::FILE_INVALID;
+    }
+    result->data = data;
+    auto status = result->parseIndex();
+    if (!status.ok()) {
+        SPDLOG_ERROR("{}: {}", status.string(), path);
+        return status;
+    }
+    auto weights = result->getEntry(MODEL_PACKAGE_BIN);
+    if (!weights.empty()) {
+        // weights are read once while reading network, prefetch them in background meanwhile
+        madvise(const_cast<char*>(weights.data()), weights.size(), MADV_WILLNEED);
+    }
+    package = std::move(result);
+    return StatusCode::OK;
+}
+
+Status ModelPackage::parseIndex() {
+    const char* begin = static_cast<const char*>(data);
+    if (size < MODEL_PACKAGE_HEADER_SIZE || std::memcmp(begin, MODEL_PACKAGE_MAGIC, sizeof(MODEL_PACKAGE_MAGIC)) != 0) {
+        return StatusCode::MODEL_PACKAGE_INVALID;
+    }
+    const auto entriesCount = readLittleEndian<uint32_t>(begin + sizeof(MODEL_PACKAGE_MAGIC));
+    size_t position = MODEL_PACKAGE_HEADER_SIZE;
+    for (uint32_t i = 0; i < entriesCount; i++) {
+        if (size - position < MODEL_PACKAGE_ENTRY_HEADER_SIZE) {
+            return StatusCode::MODEL_PACKAGE_INVALID;
+        }
+        const auto offset = readLittleEndian<uint64_t>(begin + position);
+        const auto entrySize = readLittleEndian<uint64_t>(begin + position + sizeof(uint64_t));
+        const auto nameLength = readLittleEndian<uint32_t>(begin + position + 2 * sizeof(uint64_t));
+        position += MODEL_PACKAGE_ENTRY_HEADER_SIZE;
+        if (nameLength == 0 || nameLength > MODEL_PACKAGE_MAX_NAME_LENGTH || size - position < nameLength) {
+            return StatusCode::MODEL_PACKAGE_INVALID;
+        }
+        std::string name(begin + position, nameLength);
+        position += nameLength;
+        if (offset % MODEL_PACKAGE_ALIGNMENT != 0 || offset > size || entrySize > size - offset) {
+            return StatusCode::MODEL_PACKAGE_INVALID;
+        }
+        if (!entries.emplace(name, std::string_view(begin + offset, entrySize)).second) {
+            return StatusCode::MODEL_PACKAGE_INVALID;
+        }
+        SPDLOG_DEBUG("Model package: {} entry: {} size: {}", path, name, entrySize);
+    }
+    return StatusCode::OK;
+}
+
+Status ModelPackage::write(const std::string& path, const std::vector<std::pair<std::string, std::string>>& entries) {
+    size_t offset = MODEL_PACKAGE_HEADER_SIZE;
+    for (const auto& [name, content] : entries) {
+        offset += MODEL_PACKAGE_ENTRY_HEADER_SIZE + name.size();
+    }
+    std::vector<uint64_t> offsets;
+    for (const auto& [name, content] : entries) {
+        offset = alignUp(offset);
+        offsets.push_back(offset);
+        offset += content.size();
+    }
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.good()) {
+        SPDLOG_ERROR("Failed to create model package: {}", path);
+        return StatusCode::FILE_INVALID;
+    }
+    file.write(MODEL_PACKAGE_MAGIC, sizeof(MODEL_PACKAGE_MAGIC));
+    writeLittleEndian<uint32_t>(file, entries.size());
+    writeLittleEndian<uint32_t>(file, 0);
+    for (size_t i = 0; i < entries.size(); i++) {
+        writeLittleEndian<uint64_t>(file, offsets[i]);
+        writeLittleEndian<uint64_t>(file, entries[i].second.size());
+        writeLittleEndian<uint32_t>(file, entries[i].first.size());
+        file.write(entries[i].first.data(), entries[i].first.size());
+    }
+    for (size_t i = 0; i < entries.size(); i++) {
+        const std::string padding(offsets[i] - static_cast<size_t>(file.tellp()), '\0');
+        file.write(padding.data(), padding.size());
+        file.write(entries[i].second.data(), entries[i].second.size());
+    }
+    file.close();
+    if (!file.good()) {
+        SPDLOG_ERROR("Failed to write model package: {}", path);
+        return StatusCode::FILE_INVALID;
+    }
+    return StatusCode::OK;
+}
+
+std::string ModelPackage::findInDirectory(const std::string& directory) {
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator(directory, ec)) {
+        if (entry.path().extension() == MODEL_PACKAGE_EXTENSION) {
+            return entry.path().string();
+        }
+    }
+    return std::string();
+}
+
+std::string_view ModelPackage::getEntry(const std::string& name) const {
+    auto it = entries.find(name);
+    if (it == entries.end()) {
+        return std::string_view();
+    }
+    return it->second;
+}
+
+bool ModelPackage::hasModel() const {
+    return (hasEntry(MODEL_PACKAGE_XML) && hasEntry(MODEL_PACKAGE_BIN)) || hasEntry(MODEL_PACKAGE_ONNX);
+}
+
+InferenceEngine::CNNNetwork ModelPackage::readNetwork(InferenceEngine::Core& engine) const {
+    if (!hasEntry(MODEL_PACKAGE_XML)) {
+        return engine.ReadNetwork(std::string(getEntry(MODEL_PACKAGE_ONNX)), InferenceEngine::Blob::CPtr());
+    }
+    auto bin = getEntry(MODEL_PACKAGE_BIN);
+    auto weights = InferenceEngine::make_shared_blob<uint8_t>(
+        InferenceEngine::TensorDesc(InferenceEngine::Precision::U8, {bin.size()}, InferenceEngine::Layout::C),
+        reinterpret_cast<uint8_t*>(const_cast<char*>(bin.data())),
+        bin.size());
+    return engine.ReadNetwork(std::string(getEntry(MODEL_PACKAGE_XML)), weights);
+}
+
+InferenceEngine::ExecutableNetwork ModelPackage::importNetwork(InferenceEngine::Core& engine, const std::string& device,
+    const std::map<std::string, std::string>& pluginConfig) const {
+    MemoryStreamBuf buffer(getEntry(MODEL_PACKAGE_PRECOMPILED_PREFIX + device));
+    std::istream stream(&buffer);
+    return engine.ImportNetwork(stream, device, pluginConfig);
+}
+
+}  // namespace ovms
@@ -0,0 +1,122 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <map>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <inference_engine.hpp>
+
+#include "status.hpp"
+
+namespace ovms {
+
+const std::string MODEL_PACKAGE_EXTENSION = ".ovmp";
+const std::string MODEL_PACKAGE_XML = "model.xml";
+const std::string MODEL_PACKAGE_BIN = "model.bin";
+const std::string MODEL_PACKAGE_ONNX = "model.onnx";
+const std::string MODEL_PACKAGE_PRECOMPILED_PREFIX = "precompiled/";
+
+/**
+ * @brief Sections of the package start at multiples of this value so that weights can be used directly from mapped memory
+ */
+const size_t MODEL_PACKAGE_ALIGNMENT = 4096;
+
+/**
+ * @brief Single file alternative to model version directory with separate model files.
+ *
+ * Little endian layout:
+ *   - header: 8 bytes magic "OVMSPKG1", uint32 number of entries, uint32 reserved
+ *   - index: for each entry uint64 offset, uint64 size, uint32 name length and name
+ *   - sections: entry data starting at offsets aligned to MODEL_PACKAGE_ALIGNMENT
+ *
+ * Entries are model.xml with model.bin or model.onnx, optional mapping_config.json and optional
+ * networks compiled for a target device named precompiled/<device>. The file is mapped into memory
+ * and entries are used without copying as long as the package is alive.
+ */
+class ModelPackage {
+public:
+    ModelPackage(const ModelPackage&) = delete;
+    ModelPackage& operator=(const ModelPackage&) = delete;
+    ~ModelPackage();
+
+    /**
+     * @brief Maps package file and validates its index
+     *
+     * @return FILE_INVALID if file cannot be mapped, MODEL_PACKAGE_INVALID if index is corrupted
+     */
+    static Status open(const std::string& path, std::shared_ptr<ModelPackage>& package);
+
+    /**
+     * @brief Writes package with entries in given order
+     */
+    static Status write(const std::string& path, const std::vector<std::pair<std::string, std::string>>& entries);
+
+    /**
+     * @brief Returns path of package file in model version directory or empty string if there is none
+     */
+    static std::string findInDirectory(const std::string& directory);
+
+    const std::string& getPath() const {
+        return path;
+    }
+
+    bool hasEntry(const std::string& name) const {
+        return entries.count(name) > 0;
+    }
+
+    /**
+     * @brief Returns entry data or empty view if there is no such entry
+     */
+    std::string_view getEntry(const std::string& name) const;
+
+    /**
+     * @brief Checks if package contains model in one of supported formats
+     */
+    bool hasModel() const;
+
+    /**
+     * @brief Reads network from model entries, weights are used directly from mapped memory
+     */
+    InferenceEngine::CNNNetwork readNetwork(InferenceEngine::Core& engine) const;
+
+    bool hasPrecompiledNetwork(const std::string& device) const {
+        return hasEntry(MODEL_PACKAGE_PRECOMPILED_PREFIX + device);
+    }
+
+    /**
+     * @brief Imports network compiled for target device
+     */
+    InferenceEngine::ExecutableNetwork importNetwork(InferenceEngine::Core& engine, const std::string& device,
+        const std::map<std::string, std::string>& pluginConfig) const;
+
+private:
+    explicit ModelPackage(const std::string& path) :
+        path(path) {}
+
+    Status parseIndex();
+
+    const std::string path;
+    void* data = nullptr;
+    size_t size = 0;
+    std::map<std::string, std::string_view> entries;
+};
+
+}  // namespace ovms
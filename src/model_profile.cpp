@@ -0,0 +1,61 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "model_profile.hpp"
+
+#include <spdlog/spdlog.h>
+
+namespace ovms {
+
+void ModelProfile::record(const InferenceEngine::InferRequest& inferRequest) {
+    std::map<std::string, InferenceEngine::InferenceEngineProfileInfo> performanceCounts;
+    try {
+        performanceCounts = inferRequest.GetPerformanceCounts();
+    } catch (const InferenceEngine::details::InferenceEngineException& e) {
+        SPDLOG_DEBUG("Could not get performance counts: {}", e.what());
+        return;
+    }
+    record(performanceCounts);
+}
+
+void ModelProfile::record(const std::map<std::string, InferenceEngine::InferenceEngineProfileInfo>& performanceCounts) {
+    std::lock_guard<std::mutex> lock(mtx);
+    inferencesCount++;
+    for (const auto& [name, info] : performanceCounts) {
+        if (info.status != InferenceEngine::InferenceEngineProfileInfo::EXECUTED) {
+            continue;
+        }
+        auto& layer = layers[name];
+        if (layer.count == 0) {
+            layer.layerType = info.layer_type;
+            layer.execType = info.exec_type;
+        }
+        layer.count++;
+        layer.realTimeUs += info.realTime_uSec;
+        layer.cpuTimeUs += info.cpu_uSec;
+    }
+}
+
+uint64_t ModelProfile::getInferencesCount() const {
+    std::lock_guard<std::mutex> lock(mtx);
+    return inferencesCount;
+}
+
+std::map<std::string, LayerProfile> ModelProfile::getLayers() const {
+    std::lock_guard<std::mutex> lock(mtx);
+    return layers;
+}
+
+}  // namespace ovms
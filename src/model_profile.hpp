@@ -0,0 +1,64 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+
+#include <inference_engine.hpp>
+
+namespace ovms {
+
+/**
+ * @brief Execution statistics of single network layer aggregated across inferences
+ */
+struct LayerProfile {
+    std::string layerType;
+    std::string execType;
+    uint64_t count = 0;
+    uint64_t realTimeUs = 0;
+    uint64_t cpuTimeUs = 0;
+};
+
+/**
+ * @brief Aggregates per layer performance counters of model version inferences.
+ * Requires PERF_COUNT enabled in plugin config.
+ */
+class ModelProfile {
+public:
+    /**
+     * @brief Adds performance counters of finished inference
+     */
+    void record(const InferenceEngine::InferRequest& inferRequest);
+
+    void record(const std::map<std::string, InferenceEngine::InferenceEngineProfileInfo>& performanceCounts);
+
+    uint64_t getInferencesCount() const;
+
+    /**
+     * @brief Copy of aggregated statistics keyed by layer name
+     */
+    std::map<std::string, LayerProfile> getLayers() const;
+
+private:
+    mutable std::mutex mtx;
+    uint64_t inferencesCount = 0;
+    std::map<std::string, LayerProfile> layers;
+};
+
+}  // namespace ovms
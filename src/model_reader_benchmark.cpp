@@ -0,0 +1,182 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+// Measures time of reading model weights and constructing network from them with different read methods.
+// Page cache is dropped for the file before every read, so that storage throughput is measured.
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <inference_engine.hpp>
+
+#include "model_file_reader.hpp"
+#include "stringutils.hpp"
+
+using namespace ovms;
+
+namespace {
+void dropPageCache(const std::string& path) {
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd >= 0) {
+        fdatasync(fd);
+        posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+        close(fd);
+    }
+}
+
+bool generateFile(const std::string& path, size_t sizeMb) {
+    std::ofstream file(path, std::ios::binary);
+    std::vector<char> block(1024 * 1024);
+    for (size_t i = 0; i < block.size(); i++) {
+        block[i] = static_cast<char>(i * 31 % 251);
+    }
+    for (size_t i = 0; i < sizeMb && file; i++) {
+        block[0] = static_cast<char>(i);
+        file.write(block.data(), block.size());
+    }
+    return static_cast<bool>(file);
+}
+
+std::string readText(const std::string& path) {
+    std::ifstream file(path);
+    return std::string((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+}
+
+void report(const std::string& name, std::chrono::steady_clock::time_point start, size_t bytes) {
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "  " << name << ": " << seconds * 1000 << " ms";
+    if (bytes > 0) {
+        std::cout << "; " << static_cast<double>(bytes) / seconds / (1024 * 1024) << " MB/s";
+    }
+    std::cout << std::endl;
+}
+
+void benchmarkFile(const std::string& path, const ModelFileReadOptions& baseOptions, InferenceEngine::Core* engine) {
+    std::cout << path << std::endl;
+    dropPageCache(path);
+    auto start = std::chrono::steady_clock::now();
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    std::vector<char> content(static_cast<size_t>(file.tellg()));
+    file.seekg(0);
+    file.read(content.data(), static_cast<std::streamsize>(content.size()));
+    report("ifstream", start, content.size());
+    content = std::vector<char>();
+
+    std::string xmlPath = endsWith(path, ".bin") ? path.substr(0, path.size() - 4) + ".xml" : "";
+    if (engine != nullptr && !xmlPath.empty() && access(xmlPath.c_str(), R_OK) == 0) {
+        dropPageCache(path);
+        start = std::chrono::steady_clock::now();
+        engine->ReadNetwork(xmlPath, path);
+        report("OpenVINO ReadNetwork", start, 0);
+    }
+
+    const std::vector<std::pair<std::string, ModelFileReadMethod>> methods{
+        {"pread", ModelFileReadMethod::PREAD},
+        {"io_uring", ModelFileReadMethod::IO_URING}};
+    for (const auto& method : methods) {
+        if (method.second == ModelFileReadMethod::IO_URING && !isIoUringSupported()) {
+            std::cout << "  io_uring: not supported" << std::endl;
+            continue;
+        }
+        ModelFileReadOptions options = baseOptions;
+        options.method = method.second;
+        dropPageCache(path);
+        start = std::chrono::steady_clock::now();
+        std::shared_ptr<ModelFileBuffer> buffer;
+        if (!readModelFile(path, buffer, options).ok()) {
+            std::cout << "  " << method.first << ": failed" << std::endl;
+            continue;
+        }
+        report(method.first, start, buffer->size());
+        if (engine != nullptr && !xmlPath.empty() && access(xmlPath.c_str(), R_OK) == 0) {
+            auto weights = InferenceEngine::make_shared_blob<uint8_t>(
+                InferenceEngine::TensorDesc(InferenceEngine::Precision::U8, {buffer->size()}, InferenceEngine::Layout::C),
+                reinterpret_cast<uint8_t*>(buffer->data()),
+                buffer->size());
+            engine->ReadNetwork(readText(xmlPath), weights);
+            report(method.first + " + ReadNetwork from memory", start, 0);
+        }
+    }
+}
+
+void printUsage(const char* name) {
+    std::cout << "Usage: " << name << " [options] <model file>...\n"
+              << "  --generate <path> <size MB>  create synthetic weights file and benchmark it\n"
+              << "  --chunk_size <KB>            size of single read, default: 4096\n"
+              << "  --queue_depth <N>            reads in flight, default: 16\n"
+              << "  --no_direct_io               read through page cache\n"
+              << "  --no_huge_pages              do not request transparent huge pages\n"
+              << "  --read_network               construct network when .xml file is next to .bin file\n";
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+    ModelFileReadOptions options;
+    bool readNetwork = false;
+    std::vector<std::string> files;
+    std::vector<std::string> generatedFiles;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--generate" && i + 2 < argc) {
+            std::string path = argv[i + 1];
+            if (!generateFile(path, std::stoul(argv[i + 2]))) {
+                std::cerr << "Failed to generate: " << path << std::endl;
+                return 1;
+            }
+            files.push_back(path);
+            generatedFiles.push_back(path);
+            i += 2;
+        } else if (arg == "--chunk_size" && i + 1 < argc) {
+            options.chunkSize = std::stoul(argv[++i]) * 1024;
+        } else if (arg == "--queue_depth" && i + 1 < argc) {
+            options.queueDepth = static_cast<unsigned>(std::stoul(argv[++i]));
+        } else if (arg == "--no_direct_io") {
+            options.directIo = false;
+        } else if (arg == "--no_huge_pages") {
+            options.hugePages = false;
+        } else if (arg == "--read_network") {
+            readNetwork = true;
+        } else if (arg.rfind("--", 0) == 0) {
+            printUsage(argv[0]);
+            return 1;
+        } else {
+            files.push_back(arg);
+        }
+    }
+    if (files.empty()) {
+        printUsage(argv[0]);
+        return 1;
+    }
+    std::unique_ptr<InferenceEngine::Core> engine;
+    if (readNetwork) {
+        engine = std::make_unique<InferenceEngine::Core>();
+    }
+    for (const auto& file : files) {
+        benchmarkFile(file, options, engine.get());
+    }
+    for (const auto& file : generatedFiles) {
+        std::remove(file.c_str());
+    }
+    return 0;
+}
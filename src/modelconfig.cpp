@@ -18,12 +18,15 @@
 #include <algorithm>
 #include <filesystem>
 #include <sstream>
+#include <utility>
+#include <vector>
 
 #include <rapidjson/istreamwrapper.h>
 #include <rapidjson/stringbuffer.h>
 #include <rapidjson/writer.h>
 #include <spdlog/spdlog.h>
 
+#include "model_package.hpp"
 #include "schema.hpp"
 #include "stringutils.hpp"
 
@@ -54,6 +57,46 @@ bool ModelConfig::isReloadRequired(const ModelConfig& rhs) const {
         spdlog::debug("ModelConfig {} reload required due to nireq mismatch", this->name);
         return true;
     }
+    if (this->pipelineBatchingTimeoutMs != rhs.pipelineBatchingTimeoutMs) {
+        spdlog::debug("ModelConfig {} reload required due to pipeline batching timeout mismatch", this->name);
+        return true;
+    }
+    if (this->resultsCacheSize != rhs.resultsCacheSize) {
+        spdlog::debug("ModelConfig {} reload required due to results cache size mismatch", this->name);
+        return true;
+    }
+    if (this->replicas != rhs.replicas) {
+        spdlog::debug("ModelConfig {} reload required due to replicas mismatch", this->name);
+        return true;
+    }
+    if (this->profiling != rhs.profiling) {
+        spdlog::debug("ModelConfig {} reload required due to profiling mismatch", this->name);
+        return true;
+    }
+    if (this->sparseInputs != rhs.sparseInputs) {
+        spdlog::debug("ModelConfig {} reload required due to sparse inputs mismatch", this->name);
+        return true;
+    }
+    if (this->stateful != rhs.stateful ||
+        this->maxSequenceNumber != rhs.maxSequenceNumber ||
+        this->sequenceTimeoutSeconds != rhs.sequenceTimeoutSeconds) {
+        spdlog::debug("ModelConfig {} reload required due to stateful parameters mismatch", this->name);
+        return true;
+    }
+    if (this->shapeBuckets != rhs.shapeBuckets ||
+        this->bucketPadding != rhs.bucketPadding ||
+        this->bucketFillValue != rhs.bucketFillValue) {
+        spdlog::debug("ModelConfig {} reload required due to shape buckets mismatch", this->name);
+        return true;
+    }
+    if (this->streamScheduling != rhs.streamScheduling) {
+        spdlog::debug("ModelConfig {} reload required due to stream scheduling mismatch", this->name);
+        return true;
+    }
+    if (this->cpuThreadsBudget != rhs.cpuThreadsBudget) {
+        spdlog::debug("ModelConfig {} reload required due to CPU threads budget mismatch", this->name);
+        return true;
+    }
     if (this->pluginConfig != rhs.pluginConfig) {
         spdlog::debug("ModelConfig {} reload required due to plugin config mismatch", this->name);
         return true;
@@ -184,6 +227,49 @@ Status ModelConfig::parsePluginConfig(const rapidjson::Value& node) {
     return StatusCode::OK;
 }
 
+Status ModelConfig::parseStreamScheduling(const rapidjson::Value& node) {
+    if (!node.IsObject()) {
+        return StatusCode::STREAM_SCHEDULING_WRONG_FORMAT;
+    }
+    StreamSchedulingConfig config;
+    if (node.HasMember("policy")) {
+        if (!node["policy"].IsString() || !StreamSchedulingConfig::parsePolicy(node["policy"].GetString(), config.policy)) {
+            return StatusCode::STREAM_SCHEDULING_WRONG_FORMAT;
+        }
+    }
+    const std::vector<std::pair<const char*, uint32_t*>> values{
+        {"predict_weight", &config.predictWeight},
+        {"pipeline_weight", &config.pipelineWeight},
+        {"predict_latency_target_ms", &config.predictLatencyTargetMs},
+        {"pipeline_latency_target_ms", &config.pipelineLatencyTargetMs}};
+    for (const auto& [key, value] : values) {
+        if (node.HasMember(key)) {
+            if (!node[key].IsUint()) {
+                return StatusCode::STREAM_SCHEDULING_WRONG_FORMAT;
+            }
+            *value = node[key].GetUint();
+        }
+    }
+    if (node.HasMember("reserved_streams_borrow_after_ms")) {
+        if (!node["reserved_streams_borrow_after_ms"].IsUint()) {
+            return StatusCode::STREAM_SCHEDULING_WRONG_FORMAT;
+        }
+        config.reservedStreamsBorrowAfterMs = node["reserved_streams_borrow_after_ms"].GetUint();
+    }
+    if (node.HasMember("reserved_streams_ratio")) {
+        if (!node["reserved_streams_ratio"].IsNumber()) {
+            return StatusCode::STREAM_SCHEDULING_WRONG_FORMAT;
+        }
+        config.reservedStreamsRatio = node["reserved_streams_ratio"].GetDouble();
+    }
+    if (config.predictWeight == 0 || config.pipelineWeight == 0 ||
+        config.reservedStreamsRatio < 0 || config.reservedStreamsRatio > 1) {
+        return StatusCode::STREAM_SCHEDULING_WRONG_FORMAT;
+    }
+    this->streamScheduling = config;
+    return StatusCode::OK;
+}
+
 Status ModelConfig::parseShapeParameter(const rapidjson::Value& node) {
     if (!node.IsObject()) {
         return StatusCode::SHAPE_WRONG_FORMAT;
@@ -272,13 +358,21 @@ Status ModelConfig::parseModelMapping() {
     path.append(MAPPING_CONFIG_JSON);
 
     std::ifstream ifs(path.c_str());
-    if (!ifs.good()) {
-        return StatusCode::FILE_INVALID;
-    }
-
     rapidjson::Document doc;
-    rapidjson::IStreamWrapper isw(ifs);
-    if (doc.ParseStream(isw).HasParseError()) {
+    if (ifs.good()) {
+        rapidjson::IStreamWrapper isw(ifs);
+        doc.ParseStream(isw);
+    } else {
+        // mapping can be also stored in single file model package
+        std::shared_ptr<ModelPackage> package;
+        auto packagePath = ModelPackage::findInDirectory(this->getPath());
+        if (packagePath.empty() || !ModelPackage::open(packagePath, package).ok() || !package->hasEntry(MAPPING_CONFIG_JSON)) {
+            return StatusCode::FILE_INVALID;
+        }
+        auto mapping = package->getEntry(MAPPING_CONFIG_JSON);
+        doc.Parse(mapping.data(), mapping.size());
+    }
+    if (doc.HasParseError()) {
         SPDLOG_ERROR("Configuration file is not a valid JSON file.");
         return StatusCode::JSON_INVALID;
     }
@@ -327,6 +421,51 @@ Status ModelConfig::parseNode(const rapidjson::Value& v) {
     }
     if (v.HasMember("nireq"))
         this->setNireq(v["nireq"].GetUint64());
+    if (v.HasMember("pipeline_batching_timeout_ms"))
+        this->setPipelineBatchingTimeoutMs(v["pipeline_batching_timeout_ms"].GetUint64());
+    if (v.HasMember("version_ramp_up_ms"))
+        this->setVersionRampUpMs(v["version_ramp_up_ms"].GetUint64());
+    if (v.HasMember("results_cache_size"))
+        this->setResultsCacheSize(v["results_cache_size"].GetUint64());
+    if (v.HasMember("replicas"))
+        this->setReplicas(v["replicas"].GetUint64());
+    if (v.HasMember("cpu_weight"))
+        this->setCpuWeight(v["cpu_weight"].GetUint64());
+    if (v.HasMember("profiling"))
+        this->setProfiling(v["profiling"].GetBool());
+    if (v.HasMember("sparse_inputs")) {
+        std::set<std::string> sparseInputs;
+        for (auto& input : v["sparse_inputs"].GetArray()) {
+            sparseInputs.insert(input.GetString());
+        }
+        this->setSparseInputs(sparseInputs);
+    }
+    if (v.HasMember("stateful"))
+        this->setStateful(v["stateful"].GetBool());
+    if (v.HasMember("max_sequence_number"))
+        this->setMaxSequenceNumber(v["max_sequence_number"].GetUint64());
+    if (v.HasMember("sequence_timeout_seconds"))
+        this->setSequenceTimeoutSeconds(v["sequence_timeout_seconds"].GetUint64());
+    if (v.HasMember("shape_buckets")) {
+        shape_buckets_map_t shapeBuckets;
+        for (auto& input : v["shape_buckets"].GetObject()) {
+            auto& buckets = shapeBuckets[input.name.GetString()];
+            for (auto& bucket : input.value.GetArray()) {
+                buckets.push_back(bucket.GetUint64());
+            }
+        }
+        this->setShapeBuckets(shapeBuckets);
+    }
+    if (v.HasMember("bucket_padding"))
+        this->setBucketPadding(v["bucket_padding"].GetString());
+    if (v.HasMember("bucket_fill_value"))
+        this->setBucketFillValue(v["bucket_fill_value"].GetDouble());
+    if (v.HasMember("stream_scheduling")) {
+        auto status = parseStreamScheduling(v["stream_scheduling"]);
+        if (!status.ok()) {
+            return status;
+        }
+    }
 
     if (v.HasMember("shape")) {
         // Legacy format as string
@@ -18,6 +18,7 @@
 #include <fstream>
 #include <map>
 #include <memory>
+#include <set>
 #include <string>
 #include <tuple>
 #include <unordered_map>
@@ -27,6 +28,7 @@
 
 #include "model_version_policy.hpp"
 #include "status.hpp"
+#include "stream_scheduling.hpp"
 
 namespace ovms {
 
@@ -51,6 +53,7 @@ using shapes_map_t = std::unordered_map<std::string, ShapeInfo>;
 using layouts_map_t = std::unordered_map<std::string, std::string>;
 using mapping_config_t = std::unordered_map<std::string, std::string>;
 using plugin_config_t = std::map<std::string, std::string>;
+using shape_buckets_map_t = std::map<std::string, std::vector<size_t>>;
 
 const std::string ANONYMOUS_INPUT_NAME = "ANONYMOUS_INPUT_NAME";
 const std::string MAPPING_CONFIG_JSON = "mapping_config.json";
@@ -100,6 +103,81 @@ private:
          */
     uint64_t nireq;
 
+    /**
+         * @brief Maximum time in milliseconds pipeline DL nodes wait to be merged into single batched inference
+         */
+    uint64_t pipelineBatchingTimeoutMs = 0;
+
+    /**
+         * @brief Time in milliseconds over which requests without version shift from previous to new default version
+         */
+    uint64_t versionRampUpMs = 0;
+
+    /**
+         * @brief Maximum number of memoized pipeline DL nodes results
+         */
+    uint64_t resultsCacheSize = 0;
+
+    /**
+         * @brief Number of independent executable network replicas
+         */
+    uint64_t replicas = 1;
+
+    /**
+         * @brief Weight of the model in global CPU threads budget
+         */
+    uint64_t cpuWeight = 1;
+
+    /**
+         * @brief Number of CPU threads assigned to the model from global budget, 0 when not limited
+         */
+    uint64_t cpuThreadsBudget = 0;
+
+    /**
+         * @brief Policy of serving predicts and pipeline nodes waiting for idle inference stream
+         */
+    StreamSchedulingConfig streamScheduling;
+
+    /**
+         * @brief Collect per layer performance counters of inferences
+         */
+    bool profiling = false;
+
+    /**
+         * @brief Inputs which can be sent in sparse COO or CSR format
+         */
+    std::set<std::string> sparseInputs;
+
+    /**
+         * @brief Keep model memory states on the server between requests of a sequence
+         */
+    bool stateful = false;
+
+    /**
+         * @brief Maximum number of sequences held by stateful model
+         */
+    uint64_t maxSequenceNumber = 500;
+
+    /**
+         * @brief Idle time after which sequence of stateful model is removed, 0 disables removal
+         */
+    uint64_t sequenceTimeoutSeconds = 60;
+
+    /**
+         * @brief Sizes of spatial dimensions of inputs requests are padded to instead of reshaping model
+         */
+    shape_buckets_map_t shapeBuckets;
+
+    /**
+         * @brief Placement of request data in shape bucket, pad or letterbox
+         */
+    std::string bucketPadding = "pad";
+
+    /**
+         * @brief Value of elements added when padding request to shape bucket
+         */
+    double bucketFillValue = 0;
+
     /**
          * @brief Plugin config
          */
@@ -409,6 +487,284 @@ public:
         this->nireq = nireq;
     }
 
+    /**
+         * @brief Get the pipeline batching timeout
+         * 
+         * @return uint64_t 
+         */
+    uint64_t getPipelineBatchingTimeoutMs() const {
+        return this->pipelineBatchingTimeoutMs;
+    }
+
+    /**
+         * @brief Set the pipeline batching timeout. Zero disables merging pipeline DL nodes into batched inference
+         * 
+         * @param pipelineBatchingTimeoutMs 
+         */
+    void setPipelineBatchingTimeoutMs(const uint64_t pipelineBatchingTimeoutMs) {
+        this->pipelineBatchingTimeoutMs = pipelineBatchingTimeoutMs;
+    }
+
+    /**
+         * @brief Get the version ramp-up time
+         * 
+         * @return uint64_t 
+         */
+    uint64_t getVersionRampUpMs() const {
+        return this->versionRampUpMs;
+    }
+
+    /**
+         * @brief Set the version ramp-up time. Zero switches all requests to new default version at once
+         * 
+         * @param versionRampUpMs 
+         */
+    void setVersionRampUpMs(const uint64_t versionRampUpMs) {
+        this->versionRampUpMs = versionRampUpMs;
+    }
+
+    /**
+         * @brief Get the pipeline DL nodes results cache size
+         * 
+         * @return uint64_t 
+         */
+    uint64_t getResultsCacheSize() const {
+        return this->resultsCacheSize;
+    }
+
+    /**
+         * @brief Set the pipeline DL nodes results cache size. Zero disables memoization of node results
+         * 
+         * @param resultsCacheSize 
+         */
+    void setResultsCacheSize(const uint64_t resultsCacheSize) {
+        this->resultsCacheSize = resultsCacheSize;
+    }
+
+    /**
+         * @brief Get the number of executable network replicas
+         * 
+         * @return uint64_t 
+         */
+    uint64_t getReplicas() const {
+        return this->replicas;
+    }
+
+    /**
+         * @brief Set the number of executable network replicas
+         * 
+         * @param replicas 
+         */
+    void setReplicas(const uint64_t replicas) {
+        this->replicas = replicas;
+    }
+
+    /**
+         * @brief Get the weight of the model in global CPU threads budget
+         * 
+         * @return uint64_t 
+         */
+    uint64_t getCpuWeight() const {
+        return this->cpuWeight;
+    }
+
+    /**
+         * @brief Set the weight of the model in global CPU threads budget
+         * 
+         * @param cpuWeight 
+         */
+    void setCpuWeight(const uint64_t cpuWeight) {
+        this->cpuWeight = cpuWeight;
+    }
+
+    /**
+         * @brief Get the number of CPU threads assigned from global budget
+         * 
+         * @return uint64_t 
+         */
+    uint64_t getCpuThreadsBudget() const {
+        return this->cpuThreadsBudget;
+    }
+
+    /**
+         * @brief Set the number of CPU threads assigned from global budget. Zero means not limited
+         * 
+         * @param cpuThreadsBudget 
+         */
+    void setCpuThreadsBudget(const uint64_t cpuThreadsBudget) {
+        this->cpuThreadsBudget = cpuThreadsBudget;
+    }
+
+    /**
+         * @brief Get the inference streams scheduling config
+         * 
+         * @return const StreamSchedulingConfig& 
+         */
+    const StreamSchedulingConfig& getStreamScheduling() const {
+        return this->streamScheduling;
+    }
+
+    /**
+         * @brief Set the inference streams scheduling config
+         * 
+         * @param streamScheduling 
+         */
+    void setStreamScheduling(const StreamSchedulingConfig& streamScheduling) {
+        this->streamScheduling = streamScheduling;
+    }
+
+    /**
+         * @brief Checks if per layer performance counters are collected
+         * 
+         * @return bool 
+         */
+    bool isProfilingEnabled() const {
+        return this->profiling;
+    }
+
+    /**
+         * @brief Enable collecting per layer performance counters
+         * 
+         * @param profiling 
+         */
+    void setProfiling(const bool profiling) {
+        this->profiling = profiling;
+    }
+
+    /**
+         * @brief Get the inputs which can be sent in sparse format
+         * 
+         * @return const std::set<std::string>& 
+         */
+    const std::set<std::string>& getSparseInputs() const {
+        return this->sparseInputs;
+    }
+
+    /**
+         * @brief Set the inputs which can be sent in sparse format
+         * 
+         * @param sparseInputs 
+         */
+    void setSparseInputs(const std::set<std::string>& sparseInputs) {
+        this->sparseInputs = sparseInputs;
+    }
+
+    /**
+         * @brief Checks if model keeps memory states between requests of a sequence
+         * 
+         * @return bool 
+         */
+    bool isStateful() const {
+        return this->stateful;
+    }
+
+    /**
+         * @brief Set if model keeps memory states between requests of a sequence
+         * 
+         * @param stateful 
+         */
+    void setStateful(const bool stateful) {
+        this->stateful = stateful;
+    }
+
+    /**
+         * @brief Get the maximum number of sequences of stateful model
+         * 
+         * @return uint64_t 
+         */
+    uint64_t getMaxSequenceNumber() const {
+        return this->maxSequenceNumber;
+    }
+
+    /**
+         * @brief Set the maximum number of sequences of stateful model
+         * 
+         * @param maxSequenceNumber 
+         */
+    void setMaxSequenceNumber(const uint64_t maxSequenceNumber) {
+        this->maxSequenceNumber = maxSequenceNumber;
+    }
+
+    /**
+         * @brief Get the idle time after which sequence is removed
+         * 
+         * @return uint64_t 
+         */
+    uint64_t getSequenceTimeoutSeconds() const {
+        return this->sequenceTimeoutSeconds;
+    }
+
+    /**
+         * @brief Set the idle time after which sequence is removed
+         * 
+         * @param sequenceTimeoutSeconds 
+         */
+    void setSequenceTimeoutSeconds(const uint64_t sequenceTimeoutSeconds) {
+        this->sequenceTimeoutSeconds = sequenceTimeoutSeconds;
+    }
+
+    /**
+         * @brief Get the shape buckets of inputs
+         * 
+         * @return const shape_buckets_map_t& 
+         */
+    const shape_buckets_map_t& getShapeBuckets() const {
+        return this->shapeBuckets;
+    }
+
+    /**
+         * @brief Set the shape buckets of inputs
+         * 
+         * @param shapeBuckets 
+         */
+    void setShapeBuckets(const shape_buckets_map_t& shapeBuckets) {
+        this->shapeBuckets = shapeBuckets;
+    }
+
+    /**
+         * @brief Get the placement of request data in shape bucket
+         * 
+         * @return const std::string& 
+         */
+    const std::string& getBucketPadding() const {
+        return this->bucketPadding;
+    }
+
+    /**
+         * @brief Set the placement of request data in shape bucket
+         * 
+         * @param bucketPadding 
+         */
+    void setBucketPadding(const std::string& bucketPadding) {
+        this->bucketPadding = bucketPadding;
+    }
+
+    /**
+         * @brief Get the value of elements added when padding request to shape bucket
+         * 
+         * @return double 
+         */
+    double getBucketFillValue() const {
+        return this->bucketFillValue;
+    }
+
+    /**
+         * @brief Set the value of elements added when padding request to shape bucket
+         * 
+         * @param bucketFillValue 
+         */
+    void setBucketFillValue(const double bucketFillValue) {
+        this->bucketFillValue = bucketFillValue;
+    }
+
+    /**
+         * @brief Parses inference streams scheduling config from json node
+         * 
+         * @param node 
+         * @return Status 
+         */
+    Status parseStreamScheduling(const rapidjson::Value& node);
+
     /**
          * @brief Get the plugin config
          * 
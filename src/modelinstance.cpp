@@ -17,6 +17,7 @@
 
 #include <algorithm>
 #include <cstdlib>
+#include <fstream>
 #include <iostream>
 #include <memory>
 #include <string>
@@ -25,9 +26,12 @@
 
 #include <dirent.h>
 #include <spdlog/spdlog.h>
+#include <sys/stat.h>
 #include <sys/types.h>
 
+#include "compilation_workers.hpp"
 #include "config.hpp"
+#include "shape_buckets.hpp"
 #include "stringutils.hpp"
 
 using namespace InferenceEngine;
@@ -218,18 +222,53 @@ uint ModelInstance::getNumOfParallelInferRequests(const ModelConfig& modelConfig
 }
 
 void ModelInstance::loadOVEngine() {
-    engine = std::make_unique<InferenceEngine::Core>();
+    // Single Core per process avoids loading device plugins for every model version
+    static std::shared_ptr<InferenceEngine::Core> sharedEngine = std::make_shared<InferenceEngine::Core>();
+    engine = sharedEngine;
 }
 
 std::unique_ptr<InferenceEngine::CNNNetwork> ModelInstance::loadOVCNNNetworkPtr(const std::string& modelFile) {
     return std::make_unique<InferenceEngine::CNNNetwork>(engine->ReadNetwork(modelFile));
 }
 
+std::unique_ptr<InferenceEngine::CNNNetwork> ModelInstance::loadOVCNNNetworkFromMemory(std::shared_ptr<ModelFileBuffer>& weights) {
+    if (modelFiles.size() != OV_MODEL_FILES_EXTENSIONS.size() || !endsWith(modelFiles[1], ".bin")) {
+        return nullptr;
+    }
+    struct stat binStat;
+    if (stat(modelFiles[1].c_str(), &binStat) != 0 || static_cast<size_t>(binStat.st_size) < modelFileReaderMinSize) {
+        return nullptr;
+    }
+    std::ifstream xmlFile(modelFiles[0]);
+    std::string xml((std::istreambuf_iterator<char>(xmlFile)), std::istreambuf_iterator<char>());
+    if (!xmlFile) {
+        return nullptr;
+    }
+    auto status = readModelFile(modelFiles[1], weights);
+    if (!status.ok()) {
+        spdlog::warn("Failed to read weights of model:{} version:{} into memory, OpenVINO will read them instead", getName(), getVersion());
+        return nullptr;
+    }
+    auto blob = InferenceEngine::make_shared_blob<uint8_t>(
+        InferenceEngine::TensorDesc(InferenceEngine::Precision::U8, {weights->size()}, InferenceEngine::Layout::C),
+        reinterpret_cast<uint8_t*>(weights->data()),
+        weights->size());
+    return std::make_unique<InferenceEngine::CNNNetwork>(engine->ReadNetwork(xml, blob));
+}
+
 Status ModelInstance::loadOVCNNNetwork() {
     auto& modelFile = modelFiles[0];
     spdlog::debug("Try reading model file:{}", modelFile);
     try {
-        network = loadOVCNNNetworkPtr(modelFile);
+        // previous network may still use previous weights until it is replaced
+        std::shared_ptr<ModelFileBuffer> newWeightsBuffer;
+        if (modelPackage) {
+            network = std::make_unique<InferenceEngine::CNNNetwork>(modelPackage->readNetwork(*engine));
+        } else {
+            auto newNetwork = loadOVCNNNetworkFromMemory(newWeightsBuffer);
+            network = newNetwork ? std::move(newNetwork) : loadOVCNNNetworkPtr(modelFile);
+        }
+        weightsBuffer = std::move(newWeightsBuffer);
     } catch (std::exception& e) {
         spdlog::error("Error:{}; occurred during loading CNNNetwork for model:{} version:{}", e.what(), getName(), getVersion());
         return StatusCode::INTERNAL_ERROR;
@@ -238,6 +277,16 @@ Status ModelInstance::loadOVCNNNetwork() {
 }
 
 void ModelInstance::loadExecutableNetworkPtr(const plugin_config_t& pluginConfig) {
+    if (usePrecompiledNetwork) {
+        try {
+            execNetwork = std::make_shared<InferenceEngine::ExecutableNetwork>(modelPackage->importNetwork(*engine, targetDevice, pluginConfig));
+            return;
+        } catch (std::exception& e) {
+            spdlog::warn("Failed to import precompiled network of model:{} version:{} for device:{}, it will be compiled instead; error:{}",
+                getName(), getVersion(), targetDevice, e.what());
+            usePrecompiledNetwork = false;
+        }
+    }
     execNetwork = std::make_shared<InferenceEngine::ExecutableNetwork>(engine->LoadNetwork(*network, targetDevice, pluginConfig));
 }
 
@@ -254,13 +303,33 @@ plugin_config_t ModelInstance::prepareDefaultPluginConfig(const ModelConfig& con
             pluginConfig["GPU_THROUGHPUT_STREAMS"] = "GPU_THROUGHPUT_AUTO";
         }
     }
+    // Model threads are limited by its share of global CPU budget and each CPU replica gets its own part of it.
+    // Threads are not pinned by default since every executable network would bind its threads starting from the same cores.
+    if ((config.getReplicas() > 1 || config.getCpuThreadsBudget() > 0) && config.isDeviceUsed("CPU")) {
+        if (pluginConfig.count("CPU_THREADS_NUM") == 0) {
+            const uint64_t threads = config.getCpuThreadsBudget() > 0 ? config.getCpuThreadsBudget() : std::thread::hardware_concurrency();
+            const uint64_t threadsPerReplica = std::max<uint64_t>(1, threads / config.getReplicas());
+            pluginConfig["CPU_THREADS_NUM"] = std::to_string(threadsPerReplica);
+        }
+        if (pluginConfig.count("CPU_BIND_THREAD") == 0) {
+            pluginConfig["CPU_BIND_THREAD"] = "NO";
+        }
+    }
+    if (config.isProfilingEnabled() && pluginConfig.count("PERF_COUNT") == 0) {
+        pluginConfig["PERF_COUNT"] = "YES";
+    }
     return pluginConfig;
 }
 
 Status ModelInstance::loadOVExecutableNetwork(const ModelConfig& config) {
     plugin_config_t pluginConfig = prepareDefaultPluginConfig(config);
+    execNetworkReplicas.clear();
     try {
-        loadExecutableNetworkPtr(pluginConfig);
+        for (uint64_t replica = 0; replica < config.getReplicas(); ++replica) {
+            loadExecutableNetworkPtr(pluginConfig);
+            execNetworkReplicas.push_back(execNetwork);
+        }
+        execNetwork = execNetworkReplicas.front();
     } catch (std::exception& e) {
         Status status = StatusCode::CANNOT_LOAD_NETWORK_INTO_TARGET_DEVICE;
         spdlog::error("{}; error: {}; model:{}; version:{}; device:{}",
@@ -287,6 +356,23 @@ Status ModelInstance::fetchModelFilepaths() {
         return StatusCode::PATH_INVALID;
     }
 
+    auto packageFile = findModelFilePathWithExtension(MODEL_PACKAGE_EXTENSION);
+    if (!packageFile.empty()) {
+        // network read from already mapped package may still use its weights
+        if (!modelPackage) {
+            auto status = ModelPackage::open(packageFile, modelPackage);
+            if (!status.ok()) {
+                return status;
+            }
+        }
+        if (!modelPackage->hasModel()) {
+            spdlog::error("Model package:{} of model:{} version:{} does not contain model files", packageFile, getName(), getVersion());
+            return StatusCode::FILE_INVALID;
+        }
+        modelFiles = {packageFile};
+        return StatusCode::OK;
+    }
+
     bool found = true;
     for (auto extension : OV_MODEL_FILES_EXTENSIONS) {
         auto file = findModelFilePathWithExtension(extension);
@@ -321,15 +407,123 @@ Status ModelInstance::prepareInferenceRequestsQueue(const ModelConfig& config) {
     if (numberOfParallelInferRequests == 0) {
         return Status(StatusCode::INVALID_NIREQ, "Exceeded allowed nireq value");
     }
-    inferRequestsQueue = std::make_unique<OVInferRequestsQueue>(*execNetwork, numberOfParallelInferRequests);
-    spdlog::info("Loaded model {}; version: {}; batch size: {}; No of InferRequests: {}",
+    nodeBatcher.reset();
+    // Infer requests of shared network are already created with the same settings
+    if (!sharedNetwork) {
+        std::vector<std::reference_wrapper<InferenceEngine::ExecutableNetwork>> replicas;
+        for (auto& replica : execNetworkReplicas) {
+            replicas.emplace_back(*replica);
+        }
+        inferRequestsQueue = std::make_shared<OVInferRequestsQueue>(replicas, numberOfParallelInferRequests, config.getStreamScheduling());
+    }
+    const size_t replicasCount = execNetworkReplicas.size();
+    spdlog::info("Loaded model {}; version: {}; batch size: {}; No of InferRequests: {}; No of replicas: {}",
         getName(),
         getVersion(),
         getBatchSize(),
-        numberOfParallelInferRequests);
+        numberOfParallelInferRequests * replicasCount,
+        replicasCount);
+    profile.reset();
+    if (config.isProfilingEnabled()) {
+        profile = std::make_unique<ModelProfile>();
+    }
+    sparseInputsPool.reset();
+    if (!config.getSparseInputs().empty()) {
+        sparseInputsPool = std::make_unique<SparseInputsPool>(config.getSparseInputs(), numberOfParallelInferRequests * replicasCount);
+    }
+    // Memory states are bound to infer requests which are recreated
+    sequenceManager.reset();
+    if (config.isStateful()) {
+        sequenceManager = std::make_unique<SequenceManager>(config.getMaxSequenceNumber(),
+            std::chrono::milliseconds(config.getSequenceTimeoutSeconds() * 1000), numberOfParallelInferRequests * replicasCount);
+    }
+    if (config.getPipelineBatchingTimeoutMs() > 0) {
+        auto batchableStatus = NodeBatcher::checkInputsBatchable(getInputsInfo(), getBatchSize());
+        if (getBatchSize() <= 1) {
+            spdlog::warn("Pipeline batching for model {} is ignored since model batch size is 1", getName());
+        } else if (!batchableStatus.ok()) {
+            spdlog::warn("Pipeline batching for model {} is ignored since inputs cannot be batched: {}", getName(), batchableStatus.string());
+        } else {
+            nodeBatcher = std::make_unique<NodeBatcher>(getName(), *inferRequestsQueue, getInputsInfo(), getBatchSize(),
+                std::chrono::milliseconds(config.getPipelineBatchingTimeoutMs()), profile.get());
+        }
+    }
+    // Results of previously loaded model are not valid anymore
+    nodeResultsCache.reset();
+    if (config.getResultsCacheSize() > 0) {
+        nodeResultsCache = std::make_unique<NodeResultsCache>(getName(), config.getResultsCacheSize());
+    }
     return StatusCode::OK;
 }
 
+std::string ModelInstance::getSharedNetworkKey(const ModelConfig& config) {
+    // Memory states of stateful models are bound to infer requests of a single model
+    if (!SharedNetworks::instance().isEnabled() || config.isStateful()) {
+        return "";
+    }
+    std::string hash;
+    if (!SharedNetworks::instance().hashFiles(modelFiles, hash).ok()) {
+        return "";
+    }
+    std::stringstream key;
+    key << hash << ";" << config.getTargetDevice() << ";replicas:" << config.getReplicas()
+        << ";nireq:" << config.getNireq() << ";precompiled:" << usePrecompiledNetwork;
+    const auto& scheduling = config.getStreamScheduling();
+    key << ";scheduling:" << static_cast<int>(scheduling.policy) << "," << scheduling.predictWeight << "," << scheduling.pipelineWeight
+        << "," << scheduling.predictLatencyTargetMs << "," << scheduling.pipelineLatencyTargetMs
+        << "," << scheduling.reservedStreamsRatio << "," << scheduling.reservedStreamsBorrowAfterMs;
+    for (const auto& pair : prepareDefaultPluginConfig(config)) {
+        key << ";" << pair.first << "=" << pair.second;
+    }
+    // Batch size, shape, layout and precision changes are applied to the network before compilation
+    for (const auto& pair : network->getInputsInfo()) {
+        const auto& desc = pair.second->getTensorDesc();
+        key << ";input:" << pair.first << "," << desc.getPrecision().name() << "," << desc.getLayout()
+            << "," << TensorInfo::shapeToString(desc.getDims());
+    }
+    for (const auto& pair : network->getOutputsInfo()) {
+        key << ";output:" << pair.first << "," << pair.second->getPrecision().name() << "," << pair.second->getLayout();
+    }
+    return key.str();
+}
+
+bool ModelInstance::attachSharedNetwork(const std::string& key) {
+    sharedNetwork = key.empty() ? nullptr : SharedNetworks::instance().find(key);
+    if (!sharedNetwork) {
+        return false;
+    }
+    execNetworkReplicas = sharedNetwork->execNetworkReplicas;
+    execNetwork = execNetworkReplicas.front();
+    inferRequestsQueue = sharedNetwork->inferRequestsQueue;
+    spdlog::info("Model:{} version:{} uses network compiled by identical model:{}", getName(), getVersion(), sharedNetwork->owner);
+    return true;
+}
+
+void ModelInstance::shareNetwork(const std::string& key) {
+    if (sharedNetwork) {
+        // Executable network uses weights kept by shared network, own copy is read again from files on reload
+        network.reset();
+        weightsBuffer.reset();
+        return;
+    }
+    if (key.empty()) {
+        return;
+    }
+    auto shared = std::make_shared<SharedNetwork>();
+    shared->owner = getName() + " version:" + std::to_string(getVersion());
+    shared->execNetworkReplicas = execNetworkReplicas;
+    shared->inferRequestsQueue = inferRequestsQueue;
+    if (SharedNetworks::instance().add(key, shared)) {
+        // Versions using the network may outlive this one, so weights are released together with its last user
+        shared->network = std::move(network);
+        shared->weightsBuffer = std::move(weightsBuffer);
+        shared->modelPackage = modelPackage;
+        sharedNetwork = std::move(shared);
+    } else {
+        spdlog::debug("Identical network for model:{} version:{} was compiled concurrently, it will not be shared", getName(), getVersion());
+    }
+}
+
 void ModelInstance::configureBatchSize(const ModelConfig& config, const DynamicModelParameter& parameter) {
     if (parameter.isBatchSizeRequested()) {
         network->setBatchSize(parameter.getBatchSize());
@@ -366,16 +560,26 @@ Status ModelInstance::loadModelImpl(const ModelConfig& config, const DynamicMode
             return status;
         }
         loadOutputTensors(this->config);
-        status = loadOVExecutableNetwork(this->config);
-        if (!status.ok()) {
-            this->status.setLoading(ModelVersionStatusErrorCode::UNKNOWN);
-            return status;
+        // Precompiled network matches only network as read from the package, without batch size, shape or layout changes
+        usePrecompiledNetwork = modelPackage && modelPackage->hasPrecompiledNetwork(targetDevice) &&
+                                config.getBatchSize() == 0 && config.getShapes().empty() &&
+                                config.getLayout().empty() && config.getLayouts().empty() &&
+                                !parameter.isBatchSizeRequested() && !parameter.isAnyShapeRequested();
+        const std::string sharedNetworkKey = getSharedNetworkKey(this->config);
+        if (!attachSharedNetwork(sharedNetworkKey)) {
+            status = loadOVExecutableNetwork(this->config);
+            if (!status.ok()) {
+                this->status.setLoading(ModelVersionStatusErrorCode::UNKNOWN);
+                return status;
+            }
         }
         status = prepareInferenceRequestsQueue(this->config);
         if (!status.ok()) {
             this->status.setLoading(ModelVersionStatusErrorCode::UNKNOWN);
             return status;
         }
+        shareNetwork(sharedNetworkKey);
+        executionPlan = std::make_unique<ExecutionPlan>(getInputsInfo(), getOutputsInfo(), &this->config);
     } catch (const InferenceEngine::details::InferenceEngineException& e) {
         spdlog::error("exception occurred while loading network: {}", e.what());
         this->status.setLoading(ModelVersionStatusErrorCode::UNKNOWN);
@@ -399,7 +603,7 @@ Status ModelInstance::loadModel(const ModelConfig& config) {
     this->status.setLoading();
     this->name = config.getName();
     this->version = config.getVersion();
-    return loadModelImpl(config);
+    return CompilationWorkers::instance().execute([this, &config]() { return loadModelImpl(config); });
 }
 
 Status ModelInstance::recoverFromReshapeError() {
@@ -416,6 +620,7 @@ Status ModelInstance::recoverFromReshapeError() {
         return status;
     }
     this->loadOutputTensors(this->config);
+    executionPlan = std::make_unique<ExecutionPlan>(getInputsInfo(), getOutputsInfo(), &this->config);
     this->status.setAvailable();
     this->modelLoadedNotify.notify_all();
     return StatusCode::OK;
@@ -429,7 +634,7 @@ Status ModelInstance::reloadModel(const ModelConfig& config, const DynamicModelP
             getName(), getVersion(), predictRequestsHandlesCount);
         std::this_thread::sleep_for(std::chrono::milliseconds(UNLOAD_AVAILABILITY_CHECKING_INTERVAL_MILLISECONDS));
     }
-    return loadModelImpl(config, parameter);
+    return CompilationWorkers::instance().execute([this, &config, &parameter]() { return loadModelImpl(config, parameter); });
 }
 
 Status ModelInstance::recoverFromReloadingError(const Status& status) {
@@ -468,6 +673,8 @@ Status ModelInstance::reloadModel(size_t batchSize, std::map<std::string, shape_
         return StatusCode::INTERNAL_ERROR;
     }
 
+    // Requests wait for the reload, so it runs in the requesting thread instead of queueing behind low priority loads
+    CompilationWorkers::CallingThreadGuard callingThreadLoads;
     auto status = reloadModel(config, parameter);
     if (!status.ok()) {
         return this->recoverFromReloadingError(status);
@@ -536,9 +743,20 @@ void ModelInstance::unloadModel() {
             getName(), getVersion(), predictRequestsHandlesCount);
         std::this_thread::sleep_for(std::chrono::milliseconds(UNLOAD_AVAILABILITY_CHECKING_INTERVAL_MILLISECONDS));
     }
+    nodeBatcher.reset();
+    nodeResultsCache.reset();
+    profile.reset();
+    sparseInputsPool.reset();
+    sequenceManager.reset();
+    executionPlan.reset();
     inferRequestsQueue.reset();
+    sharedNetwork.reset();
+    execNetworkReplicas.clear();
     execNetwork.reset();
     network.reset();
+    weightsBuffer.reset();
+    modelPackage.reset();
+    usePrecompiledNetwork = false;
     engine.reset();
     outputsInfo.clear();
     inputsInfo.clear();
@@ -599,7 +817,8 @@ const bool ModelInstance::checkShapeMismatch(const ovms::TensorInfo& networkInpu
 }
 
 const Status ModelInstance::validateTensorContentSize(const ovms::TensorInfo& networkInput,
-    const tensorflow::TensorProto& requestInput) {
+    const tensorflow::TensorProto& requestInput,
+    const std::string& content) {
     /*
     int8        data in request.tensor_content
     uint8       data in request.tensor_content
@@ -643,9 +862,9 @@ const Status ModelInstance::validateTensorContentSize(const ovms::TensorInfo& ne
         }
     } else {
         size_t expectedContentSize = expectedValueCount * networkInput.getPrecision().size();
-        if (expectedContentSize != requestInput.tensor_content().size()) {
+        if (expectedContentSize != content.size()) {
             std::stringstream ss;
-            ss << "Expected: " << expectedContentSize << " bytes; Actual: " << requestInput.tensor_content().size() << " bytes";
+            ss << "Expected: " << expectedContentSize << " bytes; Actual: " << content.size() << " bytes";
             const std::string details = ss.str();
             spdlog::debug("[Model:{} version:{}] Invalid content size of tensor proto - {}", getName(), getVersion(), details);
             return Status(StatusCode::INVALID_CONTENT_SIZE, details);
@@ -654,11 +873,15 @@ const Status ModelInstance::validateTensorContentSize(const ovms::TensorInfo& ne
     return StatusCode::OK;
 }
 
-const Status ModelInstance::validate(const tensorflow::serving::PredictRequest* request) {
+const Status ModelInstance::validate(const tensorflow::serving::PredictRequest* request, const DecodedInputs* decodedInputs) {
     Status finalStatus = StatusCode::OK;
 
     // Network and request must have the same amount of inputs
-    if (request->inputs_size() < 0 || getInputsInfo().size() != static_cast<size_t>(request->inputs_size())) {
+    // Sparse inputs are sent as several tensors and stateful models get sequence inputs,
+    // in such case number of inputs is checked after validating them
+    const auto& sparseInputs = getModelConfig().getSparseInputs();
+    const bool stateful = getModelConfig().isStateful();
+    if (request->inputs_size() < 0 || (sparseInputs.empty() && !stateful && getInputsInfo().size() != static_cast<size_t>(request->inputs_size()))) {
         std::stringstream ss;
         ss << "Expected: " << getInputsInfo().size() << "; Actual: " << request->inputs_size();
         const std::string details = ss.str();
@@ -666,11 +889,24 @@ const Status ModelInstance::validate(const tensorflow::serving::PredictRequest*
         return Status(StatusCode::INVALID_NO_OF_INPUTS, details);
     }
 
+    size_t expectedRequestInputs = 0;
     for (const auto& pair : getInputsInfo()) {
         const auto& name = pair.first;
         auto networkInput = pair.second;
         auto it = request->inputs().find(name);
 
+        if (it == request->inputs().end() && sparseInputs.count(name)) {
+            size_t components = 0;
+            auto status = validateSparseInput(*request, *networkInput, components);
+            if (!status.ok()) {
+                spdlog::debug("[Model:{} version:{}] Invalid sparse input - {}", getName(), getVersion(), status.string());
+                return status;
+            }
+            expectedRequestInputs += components;
+            continue;
+        }
+        expectedRequestInputs++;
+
         // Network and request must have the same names of inputs
         if (it == request->inputs().end()) {
             std::stringstream ss;
@@ -706,7 +942,11 @@ const Status ModelInstance::validate(const tensorflow::serving::PredictRequest*
 
         if (checkShapeMismatch(*networkInput, requestInput, batchingMode)) {
             if (shapeMode == AUTO) {
-                finalStatus = StatusCode::RESHAPE_REQUIRED;
+                // Requests fitting in current shape bucket are padded instead of reshaping
+                const bool bucketed = getModelConfig().getShapeBuckets().count(networkInput->getName()) > 0;
+                if (!bucketed || !fitsInShapeWithPadding(networkInput->getShape(), networkInput->getLayout(), requestInput.tensor_shape())) {
+                    finalStatus = StatusCode::RESHAPE_REQUIRED;
+                }
             } else {
                 std::stringstream ss;
                 ss << "Expected: " << TensorInfo::shapeToString(networkInput->getShape())
@@ -717,10 +957,27 @@ const Status ModelInstance::validate(const tensorflow::serving::PredictRequest*
             }
         }
 
-        status = validateTensorContentSize(*networkInput, requestInput);
+        status = validateTensorContentSize(*networkInput, requestInput, getInputContent(name, requestInput, decodedInputs));
         if (!status.ok())
             return status;
     }
+    if (stateful) {
+        uint64_t sequenceId;
+        uint32_t sequenceControl;
+        auto status = getSequenceParameters(*request, sequenceId, sequenceControl);
+        if (!status.ok()) {
+            spdlog::debug("[Model:{} version:{}] Invalid sequence inputs - {}", getName(), getVersion(), status.string());
+            return status;
+        }
+        expectedRequestInputs += request->inputs().count(SEQUENCE_ID_INPUT) + request->inputs().count(SEQUENCE_CONTROL_INPUT);
+    }
+    if (expectedRequestInputs != static_cast<size_t>(request->inputs_size())) {
+        std::stringstream ss;
+        ss << "Expected: " << expectedRequestInputs << "; Actual: " << request->inputs_size();
+        const std::string details = ss.str();
+        spdlog::debug("[Model:{} version:{}] Invalid number of inputs - {}", getName(), getVersion(), details);
+        return Status(StatusCode::INVALID_NO_OF_INPUTS, details);
+    }
     return finalStatus;
 }
 }  // namespace ovms
@@ -31,11 +31,21 @@
 #include "tensorflow_serving/apis/prediction_service.grpc.pb.h"
 #pragma GCC diagnostic pop
 
+#include "execution_plan.hpp"
 #include "modelconfig.hpp"
+#include "model_file_reader.hpp"
+#include "model_package.hpp"
+#include "model_profile.hpp"
 #include "modelinstanceunloadguard.hpp"
 #include "modelversionstatus.hpp"
+#include "node_batcher.hpp"
+#include "node_results_cache.hpp"
 #include "ovinferrequestsqueue.hpp"
+#include "sequence_manager.hpp"
+#include "shared_networks.hpp"
+#include "sparse_tensor.hpp"
 #include "status.hpp"
+#include "tensor_encoding.hpp"
 #include "tensorinfo.hpp"
 
 namespace ovms {
@@ -56,6 +66,7 @@ public:
 
     bool isBatchSizeRequested() const { return batchSize > 0; }
     bool isShapeRequested(const std::string& name) const { return shapes.count(name) && shapes.at(name).size() > 0; }
+    bool isAnyShapeRequested() const { return !shapes.empty(); }
 
     int getBatchSize() const { return batchSize; }
     const shape_t& getShape(const std::string& name) const { return shapes.at(name); }
@@ -71,20 +82,45 @@ private:
 class ModelInstance {
 protected:
     /**
-         * @brief Inference Engine core object
+         * @brief Inference Engine core object, shared by all model instances
          */
-    std::unique_ptr<InferenceEngine::Core> engine;
+    std::shared_ptr<InferenceEngine::Core> engine;
 
     /**
          * @brief Inference Engine CNNNetwork object
          */
     std::unique_ptr<InferenceEngine::CNNNetwork> network;
 
+    /**
+         * @brief Mapped single file model package, kept until network is released since it uses package weights
+         */
+    std::shared_ptr<ModelPackage> modelPackage;
+
+    /**
+         * @brief Whether executable network is imported from model package instead of compiled
+         */
+    bool usePrecompiledNetwork = false;
+
+    /**
+         * @brief Weights of large IR models read into memory, kept until network is released since it uses them
+         */
+    std::shared_ptr<ModelFileBuffer> weightsBuffer;
+
+    /**
+         * @brief Weights files of this size or larger are read into memory by model file reader
+         */
+    size_t modelFileReaderMinSize = MODEL_FILE_READER_MIN_SIZE;
+
     /**
          * @brief Inference Engine device network
          */
     std::shared_ptr<InferenceEngine::ExecutableNetwork> execNetwork;
 
+    /**
+         * @brief Inference Engine device network replicas, execNetwork is the first one
+         */
+    std::vector<std::shared_ptr<InferenceEngine::ExecutableNetwork>> execNetworkReplicas;
+
     /**
          * @brief Model name
          */
@@ -122,6 +158,15 @@ protected:
          */
     virtual std::unique_ptr<InferenceEngine::CNNNetwork> loadOVCNNNetworkPtr(const std::string& modelFile);
 
+    /**
+         * @brief Reads IR network with large weights file through model file reader
+         *
+         * @param weights buffer used by returned network
+         *
+         * @return CNNNetwork ptr, nullptr if model is not IR, weights are small or could not be read
+         */
+    std::unique_ptr<InferenceEngine::CNNNetwork> loadOVCNNNetworkFromMemory(std::shared_ptr<ModelFileBuffer>& weights);
+
     /**
          * @brief Load OV Engine
          */
@@ -151,6 +196,25 @@ protected:
          */
     Status prepareInferenceRequestsQueue(const ModelConfig& config);
 
+    /**
+         * @brief Builds key of compiled network from model files hash and settings affecting compilation and infer requests
+         *
+         * @return empty string if network cannot be shared
+         */
+    std::string getSharedNetworkKey(const ModelConfig& config);
+
+    /**
+         * @brief Uses executable network and infer requests compiled by identical model version
+         *
+         * @return false if there is no such network
+         */
+    bool attachSharedNetwork(const std::string& key);
+
+    /**
+         * @brief Registers own executable network and infer requests for identical model versions loaded later
+         */
+    void shareNetwork(const std::string& key);
+
     /**
          * @brief Fetch model file paths
          *
@@ -205,7 +269,42 @@ private:
     /**
          * @brief OpenVINO inference execution stream pool
          */
-    std::unique_ptr<OVInferRequestsQueue> inferRequestsQueue;
+    std::shared_ptr<OVInferRequestsQueue> inferRequestsQueue;
+
+    /**
+         * @brief Network and infer requests shared with identical model versions, held to keep them registered
+         */
+    std::shared_ptr<SharedNetwork> sharedNetwork;
+
+    /**
+         * @brief Merges pipeline DL nodes inferences into batches, enabled with pipeline_batching_timeout_ms
+         */
+    std::unique_ptr<NodeBatcher> nodeBatcher;
+
+    /**
+         * @brief Memoizes pipeline DL nodes results, enabled with results_cache_size
+         */
+    std::unique_ptr<NodeResultsCache> nodeResultsCache;
+
+    /**
+         * @brief Per layer performance counters aggregated across inferences, enabled with profiling
+         */
+    std::unique_ptr<ModelProfile> profile;
+
+    /**
+         * @brief Dense blobs of sparse capable inputs reused by inference streams
+         */
+    std::unique_ptr<SparseInputsPool> sparseInputsPool;
+
+    /**
+         * @brief Sequences of stateful model
+         */
+    std::unique_ptr<SequenceManager> sequenceManager;
+
+    /**
+         * @brief Request handling plan resolved from current inputs and outputs
+         */
+    std::unique_ptr<ExecutionPlan> executionPlan;
 
     /**
          * @brief Holds current usage count in predict requests
@@ -259,7 +358,8 @@ private:
         const Mode& batchingMode);
 
     const Status validateTensorContentSize(const ovms::TensorInfo& networkInput,
-        const tensorflow::TensorProto& requestInput);
+        const tensorflow::TensorProto& requestInput,
+        const std::string& content);
 
     uint32_t getNumOfParallelInferRequests(const ModelConfig& config);
     uint32_t getNumOfParallelInferRequestsUnbounded(const ModelConfig& config);
@@ -404,6 +504,60 @@ public:
         return *inferRequestsQueue;
     }
 
+    /**
+         * @brief Get pipeline DL nodes batcher
+         * 
+         * @return NodeBatcher or nullptr if pipeline batching is disabled
+         */
+    NodeBatcher* getNodeBatcher() {
+        return nodeBatcher.get();
+    }
+
+    /**
+         * @brief Get pipeline DL nodes results cache
+         * 
+         * @return NodeResultsCache or nullptr if results memoization is disabled
+         */
+    NodeResultsCache* getNodeResultsCache() {
+        return nodeResultsCache.get();
+    }
+
+    /**
+         * @brief Get per layer performance counters
+         * 
+         * @return ModelProfile or nullptr if profiling is disabled
+         */
+    ModelProfile* getProfile() {
+        return profile.get();
+    }
+
+    /**
+         * @brief Get request handling plan prepared at model load
+         * 
+         * @return ExecutionPlan or nullptr if model is not loaded
+         */
+    const ExecutionPlan* getExecutionPlan() const {
+        return executionPlan.get();
+    }
+
+    /**
+         * @brief Get pool of blobs for sparse inputs
+         * 
+         * @return SparseInputsPool or nullptr if model has no sparse capable inputs
+         */
+    SparseInputsPool* getSparseInputsPool() {
+        return sparseInputsPool.get();
+    }
+
+    /**
+         * @brief Get sequences of stateful model
+         * 
+         * @return SequenceManager or nullptr if model is not stateful
+         */
+    SequenceManager* getSequenceManager() {
+        return sequenceManager.get();
+    }
+
     /**
          * @brief Combines plugin config from user with default config calculated at runtime
          *
@@ -457,7 +611,12 @@ public:
     Status waitForLoaded(const uint waitForModelLoadedTimeoutMilliseconds,
         std::unique_ptr<ModelInstanceUnloadGuard>& modelInstanceUnloadGuard);
 
-    const Status validate(const tensorflow::serving::PredictRequest* request);
+    /**
+         * @brief Validates request inputs against network inputs
+         *
+         * @param decodedInputs optional decoded contents of encoded request inputs
+         */
+    const Status validate(const tensorflow::serving::PredictRequest* request, const DecodedInputs* decodedInputs = nullptr);
 
     static const int WAIT_FOR_MODEL_LOADED_TIMEOUT_MILLISECONDS = 100;
 };
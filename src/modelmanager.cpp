@@ -33,6 +33,8 @@
 
 #include "azurefilesystem.hpp"
 #include "config.hpp"
+#include "core_partitioning.hpp"
+#include "cpu_budget.hpp"
 #include "filesystem.hpp"
 #include "gcsfilesystem.hpp"
 #include "localfilesystem.hpp"
@@ -45,10 +47,16 @@ namespace ovms {
 
 static uint watcherIntervalSec = 1;
 static bool watcherStarted = false;
+static uint64_t cpuThreadsBudget = 0;
 
 Status ModelManager::start() {
     auto& config = ovms::Config::instance();
     watcherIntervalSec = config.filesystemPollWaitSeconds();
+    cpuThreadsBudget = config.cpuThreadsBudget();
+    if (cpuThreadsBudget == 0 && CorePartitioning::instance().isEnabled()) {
+        // models share cores assigned to inference threads
+        cpuThreadsBudget = CorePartitioning::instance().getCores(ThreadRole::INFERENCE).size();
+    }
 
     Status status;
     if (config.configPath() != "") {
@@ -113,6 +121,7 @@ Status ModelManager::startFromConfig() {
         modelConfig.setBatchSize(0);
     }
 
+    assignCpuThreadsBudget(servedModelConfigs, cpuThreadsBudget);
     return reloadModelWithVersions(modelConfig);
 }
 
@@ -159,6 +168,15 @@ void processPipelineConfig(rapidjson::Document& configJson, const rapidjson::Val
     const std::string pipelineName = pipelineConfig["name"].GetString();
     SPDLOG_INFO("Reading pipeline:{} configuration", pipelineName);
     auto itr2 = pipelineConfig.FindMember("nodes");
+    StreamRequester requester = StreamRequester::PIPELINE_NODE;
+    auto priorityItr = pipelineConfig.FindMember("priority");
+    if (priorityItr != pipelineConfig.MemberEnd()) {
+        if (!priorityItr->value.IsString() || !parsePipelinePriority(priorityItr->value.GetString(), requester)) {
+            SPDLOG_ERROR("Pipeline:{} has invalid priority", pipelineName);
+            return;
+        }
+        SPDLOG_INFO("Pipeline:{} priority:{}", pipelineName, priorityItr->value.GetString());
+    }
 
     std::vector<NodeInfo> info{
         {NodeKind::ENTRY, "request"}};
@@ -184,6 +202,16 @@ void processPipelineConfig(rapidjson::Document& configJson, const rapidjson::Val
         } else {
             modelVersion = std::nullopt;
         }
+        std::optional<NodeGate> gate;
+        auto nodeGateItr = nodeConfig.FindMember("gate");
+        if (nodeGateItr != nodeConfig.MemberEnd()) {
+            gate = NodeGate(nodeGateItr->value["data_item"].GetString());
+            if (nodeGateItr->value.HasMember("threshold")) {
+                gate->threshold = nodeGateItr->value["threshold"].GetFloat();
+            }
+            SPDLOG_INFO("Node:{} dependants will be executed only if output:{} exceeds threshold:{}",
+                nodeName, gate->dataItem, gate->threshold);
+        }
         NodeKind nodeKind;
         auto status = toNodeKind(nodeKindStr, nodeKind);
         if (!status.ok()) {
@@ -192,7 +220,8 @@ void processPipelineConfig(rapidjson::Document& configJson, const rapidjson::Val
         }
         SPDLOG_INFO("Creating node:{} type:{} model_name:{} modelVersion:{}",
             nodeName, nodeKindStr, modelName, modelVersion.value_or(0));
-        info.emplace_back(std::move(NodeInfo{nodeKind, nodeName, modelName, modelVersion, nodeOutputNameAlias}));
+        info.emplace_back(std::move(NodeInfo{nodeKind, nodeName, modelName, modelVersion, nodeOutputNameAlias, gate}));
+        info.back().requester = requester;
         auto nodeInputItr = nodeConfig.FindMember("inputs");
         processNodeInputs(nodeName, nodeInputItr, connections);
     }
@@ -238,6 +267,10 @@ Status ModelManager::loadModelsConfig(rapidjson::Document& configJson) {
             servedModelConfigs.pop_back();
             continue;
         }
+    }
+    // Budget depends on all served models, changed share triggers model reload
+    assignCpuThreadsBudget(servedModelConfigs, cpuThreadsBudget);
+    for (auto& modelConfig : servedModelConfigs) {
         reloadModelWithVersions(modelConfig);
         modelsInConfigFile.emplace(modelConfig.getName());
     }
@@ -63,4 +63,24 @@ Status Node::setInputs(const Node& dependency, BlobMap& inputs) {
     return StatusCode::OK;
 }
 
+Status Node::isGateOpen(const BlobMap& outputs, bool& isOpen) const {
+    isOpen = true;
+    if (!this->gate) {
+        return StatusCode::OK;
+    }
+    auto it = outputs.find(this->gate->dataItem);
+    if (it == outputs.end()) {
+        SPDLOG_INFO("Node::isGateOpen: (Node name {}) is missing gate output: {}", getName(), this->gate->dataItem);
+        return StatusCode::INVALID_MISSING_OUTPUT;
+    }
+    auto status = this->gate->evaluate(it->second, isOpen);
+    if (!status.ok()) {
+        SPDLOG_INFO("Node::isGateOpen: (Node name {}) failed to evaluate gate output: {}; {}", getName(), this->gate->dataItem, status.string());
+        return status;
+    }
+    SPDLOG_DEBUG("Node::isGateOpen: (Node name {}) gate output: {} threshold: {} is {}",
+        getName(), this->gate->dataItem, this->gate->threshold, isOpen ? "open" : "closed");
+    return StatusCode::OK;
+}
+
 }  // namespace ovms
@@ -15,6 +15,7 @@
 //*****************************************************************************
 #pragma once
 
+#include <optional>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -22,6 +23,7 @@
 
 #include <inference_engine.hpp>
 
+#include "node_gate.hpp"
 #include "status.hpp"
 #include "threadsafequeue.hpp"
 
@@ -46,6 +48,9 @@ protected:
     // Input/Output name mapping and list of required inputs from previous nodes
     std::unordered_map<std::string, InputPairs> blobNamesMapping;
 
+    // Condition on node output required to execute dependant nodes
+    std::optional<NodeGate> gate;
+
 public:
     Node(const std::string& nodeName) :
         nodeName(nodeName) {
@@ -60,6 +65,20 @@ public:
 
     Status setInputs(const Node& dependency, BlobMap& inputs);
 
+    /**
+     * @brief Marks dependency as finished without providing its outputs - used when dependency was skipped
+     */
+    void skipDependency() {
+        finishedDependenciesCount++;
+    }
+
+    const std::optional<NodeGate>& getGate() const { return this->gate; }
+
+    /**
+     * @brief Evaluates node gate on fetched node outputs. Node without gate is always open.
+     */
+    Status isGateOpen(const BlobMap& outputs, bool& isOpen) const;
+
     virtual void addDependency(Node& node, const InputPairs& blobNamesMapping) {
         this->previous.emplace_back(node);
         this->blobNamesMapping[node.getName()] = blobNamesMapping;
@@ -77,7 +96,6 @@ public:
         return next;
     }
     virtual void release() {}
-    virtual bool tryDisarmStreamIdGuard(const uint microseconds = 1) { return true; }
 
     static void printNodeConnections(const std::string& nodeName, const std::string& sourceNode, const InputPairs& pairs);
 };
@@ -0,0 +1,292 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "node_batcher.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+
+#include <spdlog/spdlog.h>
+
+#include "ov_utils.hpp"
+#include "tensorinfo.hpp"
+
+namespace ovms {
+
+Status NodeBatch::wait() {
+    std::lock_guard<std::mutex> lock(mtx);
+    if (finished) {
+        return waitStatus;
+    }
+    auto ovStatus = inferRequest.Wait(InferenceEngine::IInferRequest::RESULT_READY);
+    if (ovStatus != InferenceEngine::StatusCode::OK) {
+        waitStatus = StatusCode::OV_INTERNAL_INFERENCE_ERROR;
+        SPDLOG_DEBUG("Batched async infer on streamId:{} failed: {}; OV StatusCode: {}", getStreamId(), waitStatus.string(), ovStatus);
+    } else if (profile != nullptr) {
+        profile->record(inferRequest);
+    }
+    finished = true;
+    return waitStatus;
+}
+
+Status NodeBatch::getOutput(const std::string& name, InferenceEngine::Blob::Ptr& blob) {
+    std::lock_guard<std::mutex> lock(mtx);
+    auto it = outputs.find(name);
+    if (it != outputs.end()) {
+        blob = it->second;
+        return StatusCode::OK;
+    }
+    try {
+        blob = inferRequest.GetBlob(name);
+    } catch (const InferenceEngine::details::InferenceEngineException& e) {
+        Status status = StatusCode::OV_INTERNAL_SERIALIZATION_ERROR;
+        SPDLOG_DEBUG("Error during getting batched blob {}; {}; exception message: {}", name, status.string(), e.what());
+        return status;
+    }
+    outputs.emplace(name, blob);
+    return StatusCode::OK;
+}
+
+Status NodeBatchTask::getOutput(const std::string& name, InferenceEngine::Blob::Ptr& blob) {
+    auto status = batch->wait();
+    if (!status.ok()) {
+        return status;
+    }
+    InferenceEngine::Blob::Ptr batchedBlob;
+    status = batch->getOutput(name, batchedBlob);
+    if (!status.ok()) {
+        return status;
+    }
+    blob = blobSlice(batchedBlob, offset, batchSize);
+    if (blob == nullptr) {
+        std::stringstream ss;
+        ss << "Output: " << name << "; batched shape: " << TensorInfo::shapeToString(batchedBlob->getTensorDesc().getDims());
+        return Status(StatusCode::PIPELINE_NODE_BATCH_OUTPUT_NOT_SPLITTABLE, ss.str());
+    }
+    return StatusCode::OK;
+}
+
+NodeBatcher::NodeBatcher(const std::string& modelName, OVInferRequestsQueue& inferRequestsQueue, const tensor_map_t& inputsInfo, size_t maxBatchSize, std::chrono::milliseconds timeout, ModelProfile* profile) :
+    modelName(modelName),
+    inferRequestsQueue(inferRequestsQueue),
+    maxBatchSize(maxBatchSize),
+    timeout(timeout),
+    profile(profile) {
+    // Node tasks carry inputs keyed by real model input names
+    for (const auto& kv : inputsInfo) {
+        this->inputsInfo.emplace(kv.second->getName(), kv.second);
+    }
+    SPDLOG_INFO("Starting pipeline node batching for model: {}; max batch size: {}; timeout: {} ms", modelName, maxBatchSize, timeout.count());
+    worker = std::thread(&NodeBatcher::run, this);
+}
+
+NodeBatcher::~NodeBatcher() {
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        stopRequested = true;
+    }
+    pendingTasksNotify.notify_all();
+    if (worker.joinable()) {
+        worker.join();
+    }
+    SPDLOG_INFO("Stopped pipeline node batching for model: {}", modelName);
+}
+
+void NodeBatcher::submit(const std::shared_ptr<NodeBatchTask>& task) {
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        pendingTasks.push_back(task);
+    }
+    pendingTasksNotify.notify_one();
+}
+
+bool NodeBatcher::collectPendingTasks(std::vector<std::shared_ptr<NodeBatchTask>>& tasks, size_t& collectedBatchSize) {
+    while (!pendingTasks.empty()) {
+        auto& task = pendingTasks.front();
+        if (collectedBatchSize + task->getBatchSize() > maxBatchSize) {
+            return false;
+        }
+        collectedBatchSize += task->getBatchSize();
+        tasks.emplace_back(std::move(task));
+        pendingTasks.pop_front();
+    }
+    return true;
+}
+
+void NodeBatcher::failTasks(std::vector<std::shared_ptr<NodeBatchTask>>& tasks, const Status& status) {
+    for (auto& task : tasks) {
+        task->status = status;
+        task->batch.reset();
+        task->notifyFinished();
+    }
+}
+
+void NodeBatcher::run() {
+    while (true) {
+        std::vector<std::shared_ptr<NodeBatchTask>> tasks;
+        size_t collectedBatchSize = 0;
+        {
+            std::unique_lock<std::mutex> lock(mtx);
+            pendingTasksNotify.wait(lock, [this]() { return stopRequested || !pendingTasks.empty(); });
+            if (stopRequested) {
+                tasks.assign(pendingTasks.begin(), pendingTasks.end());
+                pendingTasks.clear();
+                lock.unlock();
+                failTasks(tasks, StatusCode::MODEL_VERSION_NOT_LOADED_ANYMORE);
+                return;
+            }
+            // Wait up to timeout for more tasks to fill the batch
+            const auto deadline = std::chrono::steady_clock::now() + timeout;
+            bool fits = collectPendingTasks(tasks, collectedBatchSize);
+            while (fits && collectedBatchSize < maxBatchSize) {
+                if (!pendingTasksNotify.wait_until(lock, deadline, [this]() { return stopRequested || !pendingTasks.empty(); })) {
+                    break;
+                }
+                if (stopRequested) {
+                    break;
+                }
+                fits = collectPendingTasks(tasks, collectedBatchSize);
+            }
+        }
+        SPDLOG_DEBUG("Model: {} waiting for idle stream to execute batch of {} node tasks; batch size: {}", modelName, tasks.size(), collectedBatchSize);
+        auto batch = std::make_shared<NodeBatch>(inferRequestsQueue, profile);
+        {
+            // Tasks that arrived while waiting for idle stream can join this batch
+            std::lock_guard<std::mutex> lock(mtx);
+            collectPendingTasks(tasks, collectedBatchSize);
+        }
+        executeBatch(batch, tasks);
+    }
+}
+
+Status NodeBatcher::checkInputsBatchable(const tensor_map_t& inputsInfo, size_t batchSize) {
+    for (const auto& kv : inputsInfo) {
+        const auto& input = *kv.second;
+        switch (input.getLayout()) {
+        case InferenceEngine::Layout::NC:
+        case InferenceEngine::Layout::NCHW:
+        case InferenceEngine::Layout::NHWC:
+        case InferenceEngine::Layout::NCDHW:
+        case InferenceEngine::Layout::NDHWC:
+            break;
+        default:
+            return Status(StatusCode::INVALID_SHAPE, "Input: " + kv.first + " does not have batch first layout");
+        }
+        if (input.getShape().empty() || input.getShape()[0] != batchSize) {
+            return Status(StatusCode::INVALID_BATCH_SIZE, "Input: " + kv.first + "; shape: " + TensorInfo::shapeToString(input.getShape()));
+        }
+    }
+    return StatusCode::OK;
+}
+
+Status NodeBatcher::validateTask(const NodeBatchTask& task) const {
+    if (task.inputs.size() != inputsInfo.size()) {
+        return StatusCode::INVALID_NO_OF_INPUTS;
+    }
+    for (const auto& kv : inputsInfo) {
+        auto it = task.inputs.find(kv.first);
+        if (it == task.inputs.end()) {
+            return Status(StatusCode::INVALID_MISSING_INPUT, kv.first);
+        }
+        const auto& desc = it->second->getTensorDesc();
+        if (desc.getPrecision() != kv.second->getPrecision()) {
+            return Status(StatusCode::INVALID_PRECISION, kv.first);
+        }
+        const auto& dims = desc.getDims();
+        const auto& shape = kv.second->getShape();
+        if (dims.size() != shape.size() || dims[0] != task.getBatchSize() || !std::equal(dims.begin() + 1, dims.end(), shape.begin() + 1)) {
+            return Status(StatusCode::INVALID_SHAPE, "Input: " + kv.first + "; shape: " + TensorInfo::shapeToString(dims));
+        }
+    }
+    return StatusCode::OK;
+}
+
+const std::unordered_map<std::string, InferenceEngine::Blob::Ptr>& NodeBatcher::getStreamInputs(int streamId) {
+    if (streamInputs.size() <= static_cast<size_t>(streamId)) {
+        streamInputs.resize(streamId + 1);
+    }
+    auto& inputs = streamInputs[streamId];
+    if (inputs.empty()) {
+        for (const auto& kv : inputsInfo) {
+            auto blob = InferenceEngine::Blob::CreateFromData(std::make_shared<InferenceEngine::Data>(kv.first, kv.second->getTensorDesc()));
+            blob->allocate();
+            inputs.emplace(kv.first, blob);
+        }
+    }
+    return inputs;
+}
+
+void NodeBatcher::executeBatch(const std::shared_ptr<NodeBatch>& batch, std::vector<std::shared_ptr<NodeBatchTask>>& tasks) {
+    auto& inferRequest = batch->getInferRequest();
+    SPDLOG_DEBUG("Model: {} executing batch of {} node tasks on streamId:{}", modelName, tasks.size(), batch->getStreamId());
+    std::vector<std::shared_ptr<NodeBatchTask>> validTasks;
+    for (auto& task : tasks) {
+        auto status = validateTask(*task);
+        if (status.ok()) {
+            validTasks.emplace_back(std::move(task));
+            continue;
+        }
+        SPDLOG_DEBUG("Model: {} cannot batch node task: {}", modelName, status.string());
+        std::vector<std::shared_ptr<NodeBatchTask>> rejected{std::move(task)};
+        failTasks(rejected, status);
+    }
+    tasks = std::move(validTasks);
+    if (tasks.empty()) {
+        return;
+    }
+    size_t offset = 0;
+    for (auto& task : tasks) {
+        task->offset = offset;
+        task->batch = batch;
+        offset += task->getBatchSize();
+    }
+    try {
+        for (const auto& kv : getStreamInputs(batch->getStreamId())) {
+            const auto& inputName = kv.first;
+            const auto& batchedBlob = kv.second;
+            const size_t sampleByteSize = batchedBlob->byteSize() / maxBatchSize;
+            char* destination = (char*)batchedBlob->buffer();
+            for (auto& task : tasks) {
+                const auto& taskBlob = task->inputs.at(inputName);
+                std::memcpy(destination + task->offset * sampleByteSize, (char*)taskBlob->buffer(), sampleByteSize * task->getBatchSize());
+            }
+            // Remaining samples are padding
+            std::memset(destination + offset * sampleByteSize, 0, (maxBatchSize - offset) * sampleByteSize);
+            inferRequest.SetBlob(inputName, batchedBlob);
+        }
+        std::vector<std::weak_ptr<NodeBatchTask>> tasksToNotify;
+        for (auto& task : tasks) {
+            task->inputs.clear();
+            tasksToNotify.emplace_back(task);
+        }
+        inferRequest.SetCompletionCallback([tasksToNotify]() {
+            for (auto& weakTask : tasksToNotify) {
+                if (auto task = weakTask.lock()) {
+                    task->notifyFinished();
+                }
+            }
+        });
+        inferRequest.StartAsync();
+    } catch (const InferenceEngine::details::InferenceEngineException& e) {
+        SPDLOG_DEBUG("Exception occured when starting batched async inference on model: {}, error: {}", modelName, e.what());
+        failTasks(tasks, StatusCode::OV_INTERNAL_INFERENCE_ERROR);
+    } catch (const std::exception& e) {
+        SPDLOG_DEBUG("Exception occured when starting batched async inference on model: {}, error: {}", modelName, e.what());
+        failTasks(tasks, StatusCode::OV_INTERNAL_INFERENCE_ERROR);
+    }
+}
+
+}  // namespace ovms
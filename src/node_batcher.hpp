@@ -0,0 +1,217 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <inference_engine.hpp>
+
+#include "executinstreamidguard.hpp"
+#include "model_profile.hpp"
+#include "ovinferrequestsqueue.hpp"
+#include "status.hpp"
+#include "tensorinfo.hpp"
+
+namespace ovms {
+
+/**
+ * @brief Single batched inference shared by several DL nodes.
+ * Holds infer request stream id until all participating nodes fetched their results.
+ */
+class NodeBatch {
+public:
+    NodeBatch(OVInferRequestsQueue& inferRequestsQueue, ModelProfile* profile = nullptr) :
+        streamIdGuard(inferRequestsQueue, StreamRequester::PIPELINE_NODE),
+        inferRequest(inferRequestsQueue.getInferRequest(streamIdGuard.getId())),
+        profile(profile) {}
+
+    InferenceEngine::InferRequest& getInferRequest() {
+        return inferRequest;
+    }
+
+    int getStreamId() {
+        return streamIdGuard.getId();
+    }
+
+    /**
+     * @brief Waits for batched inference to finish. Safe to call from multiple nodes.
+     */
+    Status wait();
+
+    /**
+     * @brief Gets batched output blob, owned by infer request
+     */
+    Status getOutput(const std::string& name, InferenceEngine::Blob::Ptr& blob);
+
+private:
+    ExecutingStreamIdGuard streamIdGuard;
+    InferenceEngine::InferRequest& inferRequest;
+    ModelProfile* profile;
+    /**
+     * @brief Model inputs keyed by real input names
+     */
+    tensor_map_t inputsInfo;
+
+    /**
+     * @brief Batched input blobs of each stream, used only by worker thread
+     */
+    std::vector<std::unordered_map<std::string, InferenceEngine::Blob::Ptr>> streamInputs;
+
+    std::mutex mtx;
+    bool finished = false;
+    Status waitStatus;
+    std::unordered_map<std::string, InferenceEngine::Blob::Ptr> outputs;
+};
+
+/**
+ * @brief Part of batched inference requested by a single DL node
+ */
+class NodeBatchTask {
+public:
+    NodeBatchTask(std::unordered_map<std::string, InferenceEngine::Blob::Ptr> inputs, size_t batchSize, std::function<void()> notifyFinished) :
+        inputs(std::move(inputs)),
+        batchSize(batchSize),
+        notifyFinished(std::move(notifyFinished)) {}
+
+    size_t getBatchSize() const {
+        return batchSize;
+    }
+
+    const Status& getStatus() const {
+        return status;
+    }
+
+    /**
+     * @brief Waits for batched inference and copies this task's part of output blob
+     *
+     * @param name real model output name
+     * @param blob result
+     *
+     * @return Status
+     */
+    Status getOutput(const std::string& name, InferenceEngine::Blob::Ptr& blob);
+
+private:
+    friend class NodeBatcher;
+
+    /**
+     * @brief Inputs keyed by real model input names
+     */
+    std::unordered_map<std::string, InferenceEngine::Blob::Ptr> inputs;
+
+    const size_t batchSize;
+
+    /**
+     * @brief Position of this task's first sample in batched inference
+     */
+    size_t offset = 0;
+
+    Status status;
+
+    std::shared_ptr<NodeBatch> batch;
+
+    std::function<void()> notifyFinished;
+};
+
+/**
+ * @brief Merges inference requests of DL nodes from concurrently executing pipelines
+ * targeting the same model version into single batched inference.
+ */
+class NodeBatcher {
+public:
+    /**
+     * @param inputsInfo model inputs, all of them have to be batch first with batch size equal to maxBatchSize
+     */
+    NodeBatcher(const std::string& modelName, OVInferRequestsQueue& inferRequestsQueue, const tensor_map_t& inputsInfo, size_t maxBatchSize, std::chrono::milliseconds timeout, ModelProfile* profile = nullptr);
+
+    ~NodeBatcher();
+
+    /**
+     * @brief Schedules task for batched execution. Task's notifyFinished is called when results are ready or error occurred.
+     */
+    void submit(const std::shared_ptr<NodeBatchTask>& task);
+
+    size_t getMaxBatchSize() const {
+        return maxBatchSize;
+    }
+
+    /**
+     * @brief Checks if node tasks can be merged along first dimension of all model inputs
+     *
+     * @return Status::OK if all inputs have batch first layout and given batch size
+     */
+    static Status checkInputsBatchable(const tensor_map_t& inputsInfo, size_t batchSize);
+
+private:
+    void run();
+
+    /**
+     * @brief Moves pending tasks to batch as long as they fit in model batch size
+     *
+     * @return false if there are pending tasks which do not fit
+     */
+    bool collectPendingTasks(std::vector<std::shared_ptr<NodeBatchTask>>& tasks, size_t& collectedBatchSize);
+
+    void executeBatch(const std::shared_ptr<NodeBatch>& batch, std::vector<std::shared_ptr<NodeBatchTask>>& tasks);
+
+    /**
+     * @brief Checks if task has exactly model inputs with model precision and sample shape
+     */
+    Status validateTask(const NodeBatchTask& task) const;
+
+    /**
+     * @brief Gets batched input blobs of stream, allocated on first use.
+     * Infer requests are shared with predicts and DL nodes which set external blobs,
+     * so batcher writes only to blobs it owns and sets them before each batched inference.
+     */
+    const std::unordered_map<std::string, InferenceEngine::Blob::Ptr>& getStreamInputs(int streamId);
+
+    static void failTasks(std::vector<std::shared_ptr<NodeBatchTask>>& tasks, const Status& status);
+
+    const std::string modelName;
+    OVInferRequestsQueue& inferRequestsQueue;
+    const size_t maxBatchSize;
+    const std::chrono::milliseconds timeout;
+    ModelProfile* profile;
+    /**
+     * @brief Model inputs keyed by real input names
+     */
+    tensor_map_t inputsInfo;
+
+    /**
+     * @brief Batched input blobs of each stream, used only by worker thread
+     */
+    std::vector<std::unordered_map<std::string, InferenceEngine::Blob::Ptr>> streamInputs;
+
+    std::mutex mtx;
+    std::condition_variable pendingTasksNotify;
+    std::deque<std::shared_ptr<NodeBatchTask>> pendingTasks;
+    bool stopRequested = false;
+
+    std::thread worker;
+};
+
+}  // namespace ovms
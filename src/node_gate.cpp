@@ -0,0 +1,69 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "node_gate.hpp"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace ovms {
+
+template <typename T>
+static bool anyGreaterThan(const InferenceEngine::Blob::Ptr& blob, float threshold) {
+    const T* data = blob->cbuffer().as<const T*>();
+    return std::any_of(data, data + blob->size(), [threshold](const T& value) { return static_cast<float>(value) > threshold; });
+}
+
+bool NodeGate::isPrecisionSupported(InferenceEngine::Precision precision) {
+    switch (precision) {
+    case InferenceEngine::Precision::FP32:
+    case InferenceEngine::Precision::I32:
+    case InferenceEngine::Precision::I16:
+    case InferenceEngine::Precision::U16:
+    case InferenceEngine::Precision::I8:
+    case InferenceEngine::Precision::U8:
+        return true;
+    default:
+        return false;
+    }
+}
+
+Status NodeGate::evaluate(const InferenceEngine::Blob::Ptr& blob, bool& isOpen) const {
+    switch (blob->getTensorDesc().getPrecision()) {
+    case InferenceEngine::Precision::FP32:
+        isOpen = anyGreaterThan<float>(blob, threshold);
+        break;
+    case InferenceEngine::Precision::I32:
+        isOpen = anyGreaterThan<int32_t>(blob, threshold);
+        break;
+    case InferenceEngine::Precision::I16:
+        isOpen = anyGreaterThan<int16_t>(blob, threshold);
+        break;
+    case InferenceEngine::Precision::U16:
+        isOpen = anyGreaterThan<uint16_t>(blob, threshold);
+        break;
+    case InferenceEngine::Precision::I8:
+        isOpen = anyGreaterThan<int8_t>(blob, threshold);
+        break;
+    case InferenceEngine::Precision::U8:
+        isOpen = anyGreaterThan<uint8_t>(blob, threshold);
+        break;
+    default:
+        return StatusCode::PIPELINE_NODE_GATE_UNSUPPORTED_PRECISION;
+    }
+    return StatusCode::OK;
+}
+
+}  // namespace ovms
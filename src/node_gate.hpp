@@ -0,0 +1,51 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <string>
+
+#include <inference_engine.hpp>
+
+#include "status.hpp"
+
+namespace ovms {
+
+/**
+ * @brief Condition on node output deciding whether dependant nodes are executed.
+ * Gate is open when any element of gating output is greater than threshold.
+ */
+struct NodeGate {
+    std::string dataItem;
+    float threshold;
+
+    NodeGate(const std::string& dataItem, float threshold = 0.0f) :
+        dataItem(dataItem),
+        threshold(threshold) {}
+
+    static bool isPrecisionSupported(InferenceEngine::Precision precision);
+
+    /**
+     * @brief Evaluates gate predicate on gating output blob
+     *
+     * @param blob gating output
+     * @param isOpen result
+     *
+     * @return Status
+     */
+    Status evaluate(const InferenceEngine::Blob::Ptr& blob, bool& isOpen) const;
+};
+
+}  // namespace ovms
@@ -0,0 +1,139 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "node_results_cache.hpp"
+
+#include <cstring>
+#include <iterator>
+#include <string_view>
+#include <utility>
+
+#include <spdlog/spdlog.h>
+
+#include "ov_utils.hpp"
+
+namespace ovms {
+
+size_t NodeResultsCache::hashInputs(const BlobMap& inputs) {
+    size_t hash = 0;
+    // xor keeps hash independent of inputs order
+    for (const auto& kv : inputs) {
+        const auto& blob = kv.second;
+        size_t inputHash = std::hash<std::string>{}(kv.first);
+        inputHash ^= std::hash<std::string_view>{}(std::string_view(blob->cbuffer().as<const char*>(), blob->byteSize())) + 0x9e3779b9 + (inputHash << 6) + (inputHash >> 2);
+        hash ^= inputHash;
+    }
+    return hash;
+}
+
+bool NodeResultsCache::inputsEqual(const BlobMap& lhs, const BlobMap& rhs) {
+    if (lhs.size() != rhs.size()) {
+        return false;
+    }
+    for (const auto& kv : lhs) {
+        auto it = rhs.find(kv.first);
+        if (it == rhs.end()) {
+            return false;
+        }
+        const auto& lhsDesc = kv.second->getTensorDesc();
+        const auto& rhsDesc = it->second->getTensorDesc();
+        if (lhsDesc.getPrecision() != rhsDesc.getPrecision() ||
+            lhsDesc.getDims() != rhsDesc.getDims() ||
+            kv.second->byteSize() != it->second->byteSize()) {
+            return false;
+        }
+        if (std::memcmp(kv.second->cbuffer().as<const char*>(), it->second->cbuffer().as<const char*>(), kv.second->byteSize()) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+NodeResultsCache::Lookup NodeResultsCache::acquire(const BlobMap& inputs, std::shared_ptr<NodeResultsCacheEntry>& entry, std::function<void()> onFinished) {
+    const size_t hash = hashInputs(inputs);
+    std::lock_guard<std::mutex> lock(mtx);
+    auto range = entries.equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it) {
+        if (!inputsEqual(inputs, it->second->inputs)) {
+            continue;
+        }
+        entry = it->second;
+        entriesLru.splice(entriesLru.begin(), entriesLru, entry->position);
+        if (entry->finished) {
+            SPDLOG_DEBUG("Model: {} node results cache hit", modelName);
+            return Lookup::HIT;
+        }
+        SPDLOG_DEBUG("Model: {} node results cache hit, waiting for inference in progress", modelName);
+        entry->waiters.emplace_back(std::move(onFinished));
+        return Lookup::PENDING;
+    }
+    evictIfFull();
+    entry = std::make_shared<NodeResultsCacheEntry>();
+    entry->hash = hash;
+    for (const auto& kv : inputs) {
+        // inputs may point to memory owned by request, keep own copy for comparison
+        entry->inputs.emplace(kv.first, blobClone(kv.second));
+    }
+    entriesLru.push_front(entry);
+    entry->position = entriesLru.begin();
+    entries.emplace(hash, entry);
+    SPDLOG_DEBUG("Model: {} node results cache miss", modelName);
+    return Lookup::MISS;
+}
+
+void NodeResultsCache::complete(const std::shared_ptr<NodeResultsCacheEntry>& entry, const Status& status, BlobMap outputs) {
+    std::vector<std::function<void()>> waiters;
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        entry->finished = true;
+        entry->status = status;
+        entry->outputs = std::move(outputs);
+        waiters.swap(entry->waiters);
+        if (!status.ok()) {
+            SPDLOG_DEBUG("Model: {} node results cache entry failed: {}", modelName, status.string());
+            remove(entry);
+        }
+    }
+    for (auto& waiter : waiters) {
+        waiter();
+    }
+}
+
+void NodeResultsCache::remove(const std::shared_ptr<NodeResultsCacheEntry>& entry) {
+    auto range = entries.equal_range(entry->hash);
+    for (auto it = range.first; it != range.second; ++it) {
+        if (it->second == entry) {
+            entriesLru.erase(entry->position);
+            entries.erase(it);
+            return;
+        }
+    }
+}
+
+void NodeResultsCache::evictIfFull() {
+    // entries in progress are not evicted since other nodes may be waiting for them
+    auto it = entriesLru.end();
+    while (entriesLru.size() >= capacity && it != entriesLru.begin()) {
+        auto candidate = std::prev(it);
+        if ((*candidate)->finished) {
+            auto entry = *candidate;
+            remove(entry);
+        } else {
+            it = candidate;
+        }
+    }
+}
+
+}  // namespace ovms
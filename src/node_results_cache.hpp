@@ -0,0 +1,144 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <inference_engine.hpp>
+
+#include "node.hpp"
+#include "status.hpp"
+
+namespace ovms {
+
+class NodeResultsCache;
+
+/**
+ * @brief Results of single inference stored in NodeResultsCache.
+ * Results are available once entry is finished.
+ */
+class NodeResultsCacheEntry {
+public:
+    const Status& getStatus() const {
+        return status;
+    }
+
+    /**
+     * @brief Gets output blobs keyed by real model output names
+     */
+    const BlobMap& getOutputs() const {
+        return outputs;
+    }
+
+private:
+    friend class NodeResultsCache;
+
+    size_t hash = 0;
+    BlobMap inputs;
+    bool finished = false;
+    Status status;
+    BlobMap outputs;
+    std::vector<std::function<void()>> waiters;
+    std::list<std::shared_ptr<NodeResultsCacheEntry>>::iterator position;
+};
+
+/**
+ * @brief Memoizes DL nodes results of single model version, keyed by node input blobs.
+ * Shared by all pipelines referencing the model version. Concurrent nodes with the same inputs
+ * wait for the first one to finish instead of running the same inference.
+ */
+class NodeResultsCache {
+public:
+    enum class Lookup {
+        HIT,      /*!< Results are ready */
+        PENDING,  /*!< The same inference is in progress, onFinished will be called when results are ready */
+        MISS      /*!< Caller is responsible for running inference and completing entry */
+    };
+
+    NodeResultsCache(const std::string& modelName, size_t capacity) :
+        modelName(modelName),
+        capacity(capacity) {}
+
+    /**
+     * @brief Finds entry matching inputs or creates new one
+     *
+     * @param inputs node input blobs
+     * @param entry result
+     * @param onFinished called when pending entry is finished, not called for HIT and MISS
+     *
+     * @return Lookup
+     */
+    Lookup acquire(const BlobMap& inputs, std::shared_ptr<NodeResultsCacheEntry>& entry, std::function<void()> onFinished);
+
+    /**
+     * @brief Stores results of entry acquired with MISS and notifies waiting nodes. Failed entries are removed from cache.
+     */
+    void complete(const std::shared_ptr<NodeResultsCacheEntry>& entry, const Status& status, BlobMap outputs = {});
+
+    size_t getSize() {
+        std::lock_guard<std::mutex> lock(mtx);
+        return entriesLru.size();
+    }
+
+private:
+    static size_t hashInputs(const BlobMap& inputs);
+    static bool inputsEqual(const BlobMap& lhs, const BlobMap& rhs);
+    void remove(const std::shared_ptr<NodeResultsCacheEntry>& entry);
+    void evictIfFull();
+
+    const std::string modelName;
+    const size_t capacity;
+
+    std::mutex mtx;
+    // most recently used first
+    std::list<std::shared_ptr<NodeResultsCacheEntry>> entriesLru;
+    std::unordered_multimap<size_t, std::shared_ptr<NodeResultsCacheEntry>> entries;
+};
+
+/**
+ * @brief Completes cache entry acquired with MISS. Entry is removed from cache with error
+ * if it was not completed before guard destruction, so that waiting nodes are not blocked.
+ */
+class NodeResultsCacheProducer {
+public:
+    NodeResultsCacheProducer(NodeResultsCache& cache, std::shared_ptr<NodeResultsCacheEntry> entry) :
+        cache(cache),
+        entry(std::move(entry)) {}
+
+    ~NodeResultsCacheProducer() {
+        if (!completed) {
+            cache.complete(entry, StatusCode::PIPELINE_NODE_CACHED_RESULTS_ABANDONED);
+        }
+    }
+
+    void complete(const Status& status, BlobMap outputs = {}) {
+        completed = true;
+        cache.complete(entry, status, std::move(outputs));
+    }
+
+private:
+    NodeResultsCache& cache;
+    std::shared_ptr<NodeResultsCacheEntry> entry;
+    bool completed = false;
+};
+
+}  // namespace ovms
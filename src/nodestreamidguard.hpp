@@ -15,8 +15,10 @@
 //*****************************************************************************
 #pragma once
 
+#include <functional>
 #include <future>
 #include <optional>
+#include <utility>
 
 #include <spdlog/spdlog.h>
 
@@ -24,19 +26,23 @@
 
 namespace ovms {
 struct NodeStreamIdGuard {
-    NodeStreamIdGuard(ovms::OVInferRequestsQueue& inferRequestsQueue) :
+    /**
+     * @brief Requests idle stream for pipeline node
+     *
+     * @param onReady called once stream is assigned to node
+     * @param requester pipeline node requester, high priority pipelines use PRIORITY_PIPELINE_NODE
+     */
+    NodeStreamIdGuard(ovms::OVInferRequestsQueue& inferRequestsQueue, std::function<void()> onReady, StreamRequester requester = StreamRequester::PIPELINE_NODE) :
         inferRequestsQueue_(inferRequestsQueue),
-        futureStreamId(inferRequestsQueue_.getIdleStream()) {}
+        futureStreamId(inferRequestsQueue_.getIdleStream(requester, std::move(onReady))) {}
 
     ~NodeStreamIdGuard() {
-        if (!disarmed) {
-            if (!streamId) {
-                SPDLOG_DEBUG("Trying to disarm stream Id that is not needed anymore...");
-                streamId = futureStreamId.get();
-            }
-            SPDLOG_DEBUG("Returning streamId:{}", streamId.value());
-            inferRequestsQueue_.returnStream(streamId.value());
+        if (!streamId) {
+            SPDLOG_DEBUG("Trying to disarm stream Id that is not needed anymore...");
+            streamId = futureStreamId.get();
         }
+        SPDLOG_DEBUG("Returning streamId:{}", streamId.value());
+        inferRequestsQueue_.returnStream(streamId.value());
     }
 
     std::optional<int> tryGetId(const uint microseconds = 1) {
@@ -48,20 +54,9 @@ struct NodeStreamIdGuard {
         return streamId;
     }
 
-    bool tryDisarm(const uint microseconds = 1) {
-        if (std::future_status::ready == futureStreamId.wait_for(std::chrono::microseconds(microseconds))) {
-            streamId = futureStreamId.get();
-            SPDLOG_DEBUG("Returning streamId:", streamId.value());
-            inferRequestsQueue_.returnStream(streamId.value());
-            disarmed = true;
-        }
-        return disarmed;
-    }
-
 private:
     ovms::OVInferRequestsQueue& inferRequestsQueue_;
     std::future<int> futureStreamId;
     std::optional<int> streamId = std::nullopt;
-    bool disarmed = false;
 };
 }  // namespace ovms
@@ -29,4 +29,19 @@ InferenceEngine::Blob::Ptr blobClone(const InferenceEngine::Blob::Ptr sourceBlob
     return copyBlob;
 }
 
+InferenceEngine::Blob::Ptr blobSlice(const InferenceEngine::Blob::Ptr sourceBlob, size_t offset, size_t count) {
+    const auto& sourceDesc = sourceBlob->getTensorDesc();
+    auto dims = sourceDesc.getDims();
+    if (dims.size() == 0 || count == 0 || offset + count > dims[0]) {
+        return nullptr;
+    }
+    const size_t sampleByteSize = sourceBlob->byteSize() / dims[0];
+    dims[0] = count;
+    auto sliceBlob = InferenceEngine::Blob::CreateFromData(std::make_shared<InferenceEngine::Data>("",
+        InferenceEngine::TensorDesc(sourceDesc.getPrecision(), dims, sourceDesc.getLayout())));
+    sliceBlob->allocate();
+    std::memcpy((void*)sliceBlob->buffer(), (char*)sourceBlob->buffer() + offset * sampleByteSize, count * sampleByteSize);
+    return sliceBlob;
+}
+
 }  // namespace ovms
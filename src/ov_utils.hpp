@@ -21,4 +21,11 @@ namespace ovms {
 
 InferenceEngine::Blob::Ptr blobClone(const InferenceEngine::Blob::Ptr sourceBlob);
 
+/**
+ * @brief Creates a copy of [offset, offset + count) range of source blob along the batch (0-th) dimension
+ *
+ * @return copied blob or nullptr if requested range exceeds source blob batch size
+ */
+InferenceEngine::Blob::Ptr blobSlice(const InferenceEngine::Blob::Ptr sourceBlob, size_t offset, size_t count);
+
 }  // namespace ovms
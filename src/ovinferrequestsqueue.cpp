@@ -16,43 +16,272 @@
 
 #include "ovinferrequestsqueue.hpp"
 
+#include <algorithm>
 #include <utility>
 
 namespace ovms {
-std::future<int> OVInferRequestsQueue::getIdleStream() {
-    int value;
+OVInferRequestsQueue::~OVInferRequestsQueue() {
+    if (!borrowDispatcher.joinable()) {
+        return;
+    }
+    {
+        std::unique_lock<std::mutex> lk(mtx);
+        stopRequested = true;
+    }
+    borrowNotify.notify_one();
+    borrowDispatcher.join();
+}
+
+std::future<int> OVInferRequestsQueue::getIdleStream(StreamRequester requester, std::function<void()> onReady, int preferredStreamId) {
     std::promise<int> idleStreamPromise;
     std::future<int> idleStreamFuture = idleStreamPromise.get_future();
-    std::unique_lock<std::mutex> lk(front_mut);
-    if (streams[front_idx] < 0) {  // we need to wait for any idle stream to be returned
-        std::unique_lock<std::mutex> queueLock(queue_mutex);
-        promises.push(std::move(idleStreamPromise));
-    } else {  // we can give idle stream right away
-        value = streams[front_idx];
-        streams[front_idx] = -1;  // negative value indicate consumed vector index
-        front_idx = (front_idx + 1) % streams.size();
+    std::vector<ReadyRequest> ready;
+    std::unique_lock<std::mutex> lk(mtx);
+    const bool highPriority = requester == StreamRequester::PRIORITY_PIPELINE_NODE;
+    const auto now = std::chrono::steady_clock::now();
+    if (highPriority) {
+        lastHighPriorityActivity = now;
+    }
+    const bool canUseReserved = highPriority || canBorrowReservedStreams(now);
+    if (!highPriority) {
+        // reserved streams which became usable are given to requests waiting for them before the new one
+        dispatchIdleStreams(now, ready);
+    }
+    // new request does not overtake requests already waiting, high priority ones only wait behind each other
+    const bool mustWait = highPriority ? !waiting[static_cast<size_t>(requester)].empty() : waitingCount > 0;
+    int streamId = -1;
+    if (!mustWait && preferredStreamId >= 0 && static_cast<size_t>(preferredStreamId) < inferRequests.size() &&
+        (canUseReserved || !reservedStreams[preferredStreamId])) {
+        auto& preferredReplica = idleStreams[preferredStreamId / streamsPerReplica];
+        auto it = std::find(preferredReplica.begin(), preferredReplica.end(), preferredStreamId);
+        if (it != preferredReplica.end()) {
+            preferredReplica.erase(it);
+            streamId = preferredStreamId;
+        }
+    }
+    if (!mustWait && streamId < 0) {
+        streamId = takeIdleStream(highPriority, canUseReserved);
+    }
+    if (streamId < 0) {  // we need to wait for any idle stream to be returned
+        const size_t index = static_cast<size_t>(requester);
+        if (waiting[index].empty()) {
+            // requester which was idle does not get credit for the time it did not use streams
+            virtualTime[index] = std::max(virtualTime[index], lastServedVirtualTime);
+        }
+        waiting[index].push_back({std::move(idleStreamPromise),
+            std::move(onReady),
+            nextSequence++,
+            now + getLatencyTarget(index)});
+        waitingCount++;
         lk.unlock();
-        idleStreamPromise.set_value(value);
+        if (borrowDispatcher.joinable()) {
+            borrowNotify.notify_one();
+        }
+        notifyReady(ready);
+        return std::move(idleStreamFuture);
+    }
+    // we can give idle stream right away
+    assignStream(streamId, highPriority);
+    lk.unlock();
+    notifyReady(ready);
+    idleStreamPromise.set_value(streamId);
+    if (onReady) {
+        onReady();
     }
     return std::move(idleStreamFuture);
 }
 
 void OVInferRequestsQueue::returnStream(int streamID) {
-    std::unique_lock<std::mutex> lk(queue_mutex);
-    if (promises.size()) {
-        std::promise<int> promise = std::move(promises.front());
-        promises.pop();
-        lk.unlock();
-        promise.set_value(streamID);
+    std::unique_lock<std::mutex> lk(mtx);
+    const auto now = std::chrono::steady_clock::now();
+    if (highPriorityStreams[streamID]) {
+        highPriorityStreams[streamID] = false;
+        highPriorityInFlight--;
+        lastHighPriorityActivity = now;
+    }
+    if (waitingCount > 0) {
+        const size_t index = selectRequester(reservedStreams[streamID] && !canBorrowReservedStreams(now));
+        if (index < waiting.size()) {
+            std::vector<ReadyRequest> ready;
+            ready.push_back({popWaitingRequest(index, streamID), streamID});
+            lk.unlock();
+            notifyReady(ready);
+            return;
+        }
+    }
+    idleStreams[streamID / streamsPerReplica].push_back(streamID);
+    const bool dispatchLater = waitingCount > 0 && borrowDispatcher.joinable();
+    lk.unlock();
+    if (dispatchLater) {
+        // reserved stream stays idle until borrowing is allowed, dispatcher gives it to waiting requests then
+        borrowNotify.notify_one();
+    }
+}
+
+OVInferRequestsQueue::StreamRequest OVInferRequestsQueue::popWaitingRequest(size_t index, int streamID) {
+    StreamRequest request = std::move(waiting[index].front());
+    waiting[index].pop_front();
+    waitingCount--;
+    lastServedVirtualTime = virtualTime[index];
+    virtualTime[index] += 1.0 / getWeight(index);
+    assignStream(streamID, index == static_cast<size_t>(StreamRequester::PRIORITY_PIPELINE_NODE));
+    return request;
+}
+
+void OVInferRequestsQueue::dispatchIdleStreams(std::chrono::steady_clock::time_point now, std::vector<ReadyRequest>& ready) {
+    // requests wait while idle streams exist only when those streams are reserved
+    if (waitingCount == 0 || !canBorrowReservedStreams(now)) {
         return;
     }
-    std::uint32_t old_back = back_idx.load();
-    while (!back_idx.compare_exchange_weak(
-        old_back,
-        (old_back + 1) % streams.size(),
-        std::memory_order_relaxed)) {
+    while (waitingCount > 0) {
+        const int streamId = takeIdleStream(false, true);
+        if (streamId < 0) {
+            return;
+        }
+        const size_t index = selectRequester();
+        ready.push_back({popWaitingRequest(index, streamId), streamId});
+    }
+}
+
+void OVInferRequestsQueue::notifyReady(std::vector<ReadyRequest>& ready) {
+    for (auto& request : ready) {
+        request.request.promise.set_value(request.streamId);
+        if (request.request.onReady) {
+            request.request.onReady();
+        }
+    }
+}
+
+void OVInferRequestsQueue::borrowDispatcherLoop() {
+    std::unique_lock<std::mutex> lk(mtx);
+    while (!stopRequested) {
+        const auto now = std::chrono::steady_clock::now();
+        std::vector<ReadyRequest> ready;
+        dispatchIdleStreams(now, ready);
+        if (!ready.empty()) {
+            lk.unlock();
+            notifyReady(ready);
+            lk.lock();
+            continue;
+        }
+        const auto borrowAllowedAt = lastHighPriorityActivity + std::chrono::milliseconds(schedulingConfig.reservedStreamsBorrowAfterMs);
+        if (waitingCount > 0 && waiting[static_cast<size_t>(StreamRequester::PRIORITY_PIPELINE_NODE)].empty() &&
+            highPriorityInFlight == 0 && borrowAllowedAt > now) {
+            borrowNotify.wait_until(lk, borrowAllowedAt);
+        } else {
+            borrowNotify.wait(lk);
+        }
+    }
+}
+
+void OVInferRequestsQueue::reserveStreams() {
+    reservedStreams.assign(inferRequests.size(), false);
+    highPriorityStreams.assign(inferRequests.size(), false);
+    reservedStreamsCount = schedulingConfig.getReservedStreamsCount(inferRequests.size());
+    const size_t replicas = idleStreams.size();
+    for (size_t i = 0; i < reservedStreamsCount; ++i) {
+        const size_t replica = i % replicas;
+        const size_t stream = streamsPerReplica - 1 - i / replicas;
+        reservedStreams[replica * streamsPerReplica + stream] = true;
+    }
+}
+
+int OVInferRequestsQueue::takeIdleStream(bool highPriority, bool canUseReserved) {
+    auto isUsable = [this, canUseReserved](int id) { return canUseReserved || !reservedStreams[id]; };
+    // replica with most idle streams has the least outstanding work
+    std::deque<int>* replica = nullptr;
+    size_t mostIdle = 0;
+    for (auto& candidate : idleStreams) {
+        const size_t idle = reservedStreamsCount == 0 ? candidate.size() : static_cast<size_t>(std::count_if(candidate.begin(), candidate.end(), isUsable));
+        if (idle > mostIdle) {
+            mostIdle = idle;
+            replica = &candidate;
+        }
+    }
+    if (replica == nullptr) {
+        return -1;
+    }
+    auto it = replica->begin();
+    if (reservedStreamsCount > 0) {
+        // high priority takes reserved streams first, leaving the rest for other requesters
+        it = std::find_if(replica->begin(), replica->end(), [this, highPriority](int id) { return reservedStreams[id] == highPriority; });
+        if (it == replica->end()) {
+            it = replica->begin();
+        }
+    }
+    const int streamId = *it;
+    replica->erase(it);
+    return streamId;
+}
+
+bool OVInferRequestsQueue::canBorrowReservedStreams(std::chrono::steady_clock::time_point now) const {
+    return waiting[static_cast<size_t>(StreamRequester::PRIORITY_PIPELINE_NODE)].empty() &&
+           highPriorityInFlight == 0 &&
+           lastHighPriorityActivity + std::chrono::milliseconds(schedulingConfig.reservedStreamsBorrowAfterMs) <= now;
+}
+
+void OVInferRequestsQueue::assignStream(int streamID, bool highPriority) {
+    if (highPriority) {
+        highPriorityStreams[streamID] = true;
+        highPriorityInFlight++;
+    }
+}
+
+size_t OVInferRequestsQueue::selectRequester(bool highPriorityOnly) const {
+    const size_t highPriority = static_cast<size_t>(StreamRequester::PRIORITY_PIPELINE_NODE);
+    if (!waiting[highPriority].empty()) {
+        return highPriority;
+    }
+    if (highPriorityOnly) {
+        return waiting.size();
+    }
+    size_t selected = waiting.size();
+    for (size_t index = 0; index < waiting.size(); ++index) {
+        if (waiting[index].empty()) {
+            continue;
+        }
+        if (selected == waiting.size()) {
+            selected = index;
+            continue;
+        }
+        const auto& candidate = waiting[index].front();
+        const auto& best = waiting[selected].front();
+        switch (schedulingConfig.policy) {
+        case StreamSchedulingPolicy::FIFO:
+            if (candidate.sequence < best.sequence) {
+                selected = index;
+            }
+            break;
+        case StreamSchedulingPolicy::WEIGHTED_FAIR:
+            if (virtualTime[index] < virtualTime[selected] ||
+                (virtualTime[index] == virtualTime[selected] && candidate.sequence < best.sequence)) {
+                selected = index;
+            }
+            break;
+        case StreamSchedulingPolicy::DEADLINE:
+            // latency target is constant per requester so each waiting queue is ordered by deadline
+            if (candidate.deadline < best.deadline ||
+                (candidate.deadline == best.deadline && candidate.sequence < best.sequence)) {
+                selected = index;
+            }
+            break;
+        }
+    }
+    return selected;
+}
+
+uint32_t OVInferRequestsQueue::getWeight(size_t requester) const {
+    if (requester != static_cast<size_t>(StreamRequester::PREDICT)) {
+        return std::max(1u, schedulingConfig.pipelineWeight);
+    }
+    return std::max(1u, schedulingConfig.predictWeight);
+}
+
+std::chrono::milliseconds OVInferRequestsQueue::getLatencyTarget(size_t requester) const {
+    if (requester != static_cast<size_t>(StreamRequester::PREDICT)) {
+        return std::chrono::milliseconds(schedulingConfig.pipelineLatencyTargetMs);
     }
-    streams[old_back] = streamID;
+    return std::chrono::milliseconds(schedulingConfig.predictLatencyTargetMs);
 }
 
 }  // namespace ovms
@@ -15,27 +15,39 @@
 //*****************************************************************************
 #pragma once
 
-#include <atomic>
+#include <chrono>
 #include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
 #include <future>
 #include <mutex>
-#include <queue>
 #include <thread>
 #include <vector>
 
 #include <inference_engine.hpp>
 #include <spdlog/spdlog.h>
 
+#include "stream_scheduling.hpp"
+
 namespace ovms {
 /**
-* @brief Class representing circular buffer for managing IE streams
+* @brief Class managing IE streams of one or more replicas of executable network.
+* Streams are numbered consecutively across replicas. Idle stream is taken from replica
+* with the least outstanding work. When all streams are busy, direct predicts and pipeline
+* nodes wait in the same scheduler and are served according to configured policy.
+* High priority pipeline nodes are served first and a fraction of streams can be reserved for them.
 */
 class OVInferRequestsQueue {
 public:
     /**
     * @brief Allocating idle stream for execution
+    *
+    * @param requester kind of request used by scheduling policy
+    * @param onReady optional notification called once stream is assigned to the request, also when it was idle right away
+    * @param preferredStreamId stream given to the request if it is idle, used to keep data bound to infer request
     */
-    std::future<int> getIdleStream();
+    std::future<int> getIdleStream(StreamRequester requester = StreamRequester::PREDICT, std::function<void()> onReady = nullptr, int preferredStreamId = -1);
 
     /**
     * @brief Release stream after execution
@@ -46,15 +58,31 @@ public:
     * @brief Constructor with initialization
     */
     OVInferRequestsQueue(InferenceEngine::ExecutableNetwork& network, int streamsLength) :
-        streams(streamsLength),
-        front_idx{0},
-        back_idx{0} {
-        for (int i = 0; i < streamsLength; ++i) {
-            streams[i] = i;
-            inferRequests.push_back(network.CreateInferRequest());
+        OVInferRequestsQueue(std::vector<std::reference_wrapper<InferenceEngine::ExecutableNetwork>>{network}, streamsLength) {}
+
+    /**
+    * @brief Constructor with initialization of streamsPerReplica streams for each network replica
+    */
+    OVInferRequestsQueue(const std::vector<std::reference_wrapper<InferenceEngine::ExecutableNetwork>>& replicas, int streamsPerReplica, const StreamSchedulingConfig& schedulingConfig = {}) :
+        streamsPerReplica(streamsPerReplica),
+        schedulingConfig(schedulingConfig),
+        idleStreams(replicas.size()),
+        waiting(static_cast<size_t>(StreamRequester::COUNT)),
+        virtualTime(static_cast<size_t>(StreamRequester::COUNT), 0) {
+        for (size_t replica = 0; replica < replicas.size(); ++replica) {
+            for (int i = 0; i < streamsPerReplica; ++i) {
+                idleStreams[replica].push_back(inferRequests.size());
+                inferRequests.push_back(replicas[replica].get().CreateInferRequest());
+            }
+        }
+        reserveStreams();
+        if (reservedStreamsCount > 0) {
+            borrowDispatcher = std::thread(&OVInferRequestsQueue::borrowDispatcherLoop, this);
         }
     }
 
+    ~OVInferRequestsQueue();
+
     /**
      * @brief Give InferRequest
      */
@@ -62,31 +90,134 @@ public:
         return inferRequests[streamID];
     }
 
+    size_t getReplicasCount() const {
+        return idleStreams.size();
+    }
+
+    bool isStreamReserved(int streamID) const {
+        return reservedStreams[streamID];
+    }
+
 protected:
     /**
-    * @brief Vector representing circular buffer for infer queue
+    * @brief Request waiting for any idle stream
     */
-    std::vector<int> streams;
+    struct StreamRequest {
+        std::promise<int> promise;
+        std::function<void()> onReady;
+        uint64_t sequence;
+        std::chrono::steady_clock::time_point deadline;
+    };
 
     /**
-    * @brief Index of the front of the idle streams list
+    * @brief Waiting request with assigned stream, notified after queue lock is released
     */
-    std::uint32_t front_idx;
+    struct ReadyRequest {
+        StreamRequest request;
+        int streamId;
+    };
 
     /**
-    * @brief Index of the back of the idle streams list
+    * @brief Picks requester whose waiting request is served next. High priority pipeline nodes go first,
+    * other requesters are ordered according to scheduling policy.
+    *
+    * @param highPriorityOnly only high priority requester can be selected, eg. for reserved stream
+    *
+    * @return index of requester with non empty waiting queue, number of requesters if none can be selected
     */
-    std::atomic<std::uint32_t> back_idx;
+    size_t selectRequester(bool highPriorityOnly = false) const;
 
     /**
-    * @brief Vector representing OV streams and used for notification about completed inference operations
+    * @brief Marks configured fraction of streams as reserved, spread evenly across replicas
     */
-    std::mutex front_mut;
-    std::mutex queue_mutex;
+    void reserveStreams();
+
     /**
-     * 
-     */
+    * @brief Takes idle stream from replica with the least outstanding work
+    *
+    * @return stream id or -1 if there is no idle stream the requester can use
+    */
+    int takeIdleStream(bool highPriority, bool canUseReserved);
+
+    /**
+    * @brief Other requesters can use reserved streams when no high priority request waits, runs
+    * or arrived within reservedStreamsBorrowAfterMs
+    */
+    bool canBorrowReservedStreams(std::chrono::steady_clock::time_point now) const;
+
+    void assignStream(int streamID, bool highPriority);
+
+    /**
+    * @brief Removes first request of requester from waiting queue and assigns stream to it
+    */
+    StreamRequest popWaitingRequest(size_t index, int streamID);
+
+    /**
+    * @brief Gives idle reserved streams to waiting requests once other requesters can borrow them
+    */
+    void dispatchIdleStreams(std::chrono::steady_clock::time_point now, std::vector<ReadyRequest>& ready);
+
+    static void notifyReady(std::vector<ReadyRequest>& ready);
+
+    /**
+    * @brief Waits until borrowing of idle reserved streams is allowed while requests wait, since no returned stream
+    * triggers dispatching then
+    */
+    void borrowDispatcherLoop();
+
+    uint32_t getWeight(size_t requester) const;
+
+    std::chrono::milliseconds getLatencyTarget(size_t requester) const;
+
+    const int streamsPerReplica;
+
+    const StreamSchedulingConfig schedulingConfig;
+
+    std::mutex mtx;
+
+    /**
+    * @brief Idle streams ids of each replica
+    */
+    std::vector<std::deque<int>> idleStreams;
+
     std::vector<InferenceEngine::InferRequest> inferRequests;
-    std::queue<std::promise<int>> promises;
+
+    /**
+    * @brief Requests waiting for any idle stream, separately for each requester kind
+    */
+    std::vector<std::deque<StreamRequest>> waiting;
+
+    uint64_t waitingCount = 0;
+
+    uint64_t nextSequence = 0;
+
+    /**
+    * @brief Virtual finish time of each requester used by weighted fair policy
+    */
+    std::vector<double> virtualTime;
+
+    double lastServedVirtualTime = 0;
+
+    std::vector<bool> reservedStreams;
+
+    size_t reservedStreamsCount = 0;
+
+    /**
+    * @brief Streams currently used by high priority requests
+    */
+    std::vector<bool> highPriorityStreams;
+
+    size_t highPriorityInFlight = 0;
+
+    std::chrono::steady_clock::time_point lastHighPriorityActivity = std::chrono::steady_clock::time_point::min();
+
+    std::condition_variable borrowNotify;
+
+    bool stopRequested = false;
+
+    /**
+    * @brief Started only when some streams are reserved
+    */
+    std::thread borrowDispatcher;
 };
 }  // namespace ovms
@@ -0,0 +1,60 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+
+#include "parallel_workers.hpp"
+
+namespace ovms {
+
+/**
+ * @brief Minimal number of values processed by single thread when REST payloads are parsed or encoded in parallel.
+ * Smaller payloads are handled by calling thread only since handing work over to other threads would cost more than it saves.
+ */
+const size_t PARALLEL_CHUNK_MIN_VALUES = 1 << 16;
+
+/**
+ * @brief Returns number of chunks items holding totalValues values in total should be split into,
+ * 1 if payload is too small to be processed in parallel
+ */
+inline size_t getParallelChunksCount(size_t items, size_t totalValues) {
+    size_t threads = ParallelWorkers::instance().getWorkersCount() + 1;
+    return std::max<size_t>(std::min({threads, items, totalValues / PARALLEL_CHUNK_MIN_VALUES}), 1);
+}
+
+/**
+ * @brief Splits range [begin, end) into chunks contiguous subranges and calls func(chunk, chunkBegin, chunkEnd) for each of them.
+ * Chunks are processed by calling thread and idle threads of shared ParallelWorkers pool, func must not throw.
+ *
+ * @return false if func returned false for any chunk
+ */
+template <typename Func>
+bool runInParallelChunks(size_t begin, size_t end, size_t chunks, const Func& func) {
+    const size_t size = end - begin;
+    chunks = std::max<size_t>(std::min(chunks, size), 1);
+    std::atomic<bool> result{true};
+    ParallelWorkers::instance().run(chunks, [&](size_t i) {
+        if (!func(i, begin + size * i / chunks, begin + size * (i + 1) / chunks)) {
+            result = false;
+        }
+    });
+    return result;
+}
+
+}  // namespace ovms
@@ -0,0 +1,98 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "parallel_workers.hpp"
+
+#include <algorithm>
+
+namespace ovms {
+
+ParallelWorkers::ParallelWorkers(size_t workersCount) {
+    workers.reserve(workersCount);
+    for (size_t i = 0; i < workersCount; i++) {
+        workers.emplace_back(&ParallelWorkers::workerLoop, this);
+    }
+}
+
+ParallelWorkers::~ParallelWorkers() {
+    {
+        std::unique_lock<std::mutex> lock(mtx);
+        stopRequested = true;
+    }
+    jobsNotify.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+void ParallelWorkers::run(size_t count, const std::function<void(size_t)>& func) {
+    if (count <= 1 || workers.empty()) {
+        for (size_t i = 0; i < count; i++) {
+            func(i);
+        }
+        return;
+    }
+    auto job = std::make_shared<Job>(count, func);
+    const size_t helpers = std::min(count - 1, workers.size());
+    {
+        std::unique_lock<std::mutex> lock(mtx);
+        jobs.insert(jobs.end(), helpers, job);
+    }
+    for (size_t i = 0; i < helpers; i++) {
+        jobsNotify.notify_one();
+    }
+    process(*job);
+    {
+        std::unique_lock<std::mutex> lock(job->mtx);
+        job->finishedNotify.wait(lock, [&job]() { return job->finished == job->count; });
+    }
+    // Drop entries of workers which did not manage to join before all items were taken
+    std::unique_lock<std::mutex> lock(mtx);
+    jobs.erase(std::remove(jobs.begin(), jobs.end(), job), jobs.end());
+}
+
+void ParallelWorkers::workerLoop() {
+    while (true) {
+        std::shared_ptr<Job> job;
+        {
+            std::unique_lock<std::mutex> lock(mtx);
+            jobsNotify.wait(lock, [this]() { return stopRequested || !jobs.empty(); });
+            if (stopRequested) {
+                return;
+            }
+            job = std::move(jobs.front());
+            jobs.pop_front();
+        }
+        process(*job);
+    }
+}
+
+void ParallelWorkers::process(Job& job) {
+    size_t processed = 0;
+    for (size_t i = job.next++; i < job.count; i = job.next++) {
+        job.func(i);
+        processed++;
+    }
+    if (processed == 0) {
+        return;
+    }
+    std::unique_lock<std::mutex> lock(job.mtx);
+    job.finished += processed;
+    if (job.finished == job.count) {
+        job.finishedNotify.notify_all();
+    }
+}
+
+}  // namespace ovms
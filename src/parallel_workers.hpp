@@ -0,0 +1,84 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ovms {
+
+/**
+ * @brief Pool of threads helping request threads with work split into independent items. Process wide instance
+ * serves CPU bound work such as REST payload chunks, blocking work like elements of batch predict request uses own pool.
+ * Calling thread always processes items too, so nested and concurrent calls complete even when all workers are busy
+ * and number of threads working for all requests together stays bounded by workers count.
+ */
+class ParallelWorkers {
+public:
+    static ParallelWorkers& instance() {
+        static ParallelWorkers instance(std::max(std::thread::hardware_concurrency(), 1u) - 1);
+        return instance;
+    }
+
+    explicit ParallelWorkers(size_t workersCount);
+
+    ~ParallelWorkers();
+
+    size_t getWorkersCount() const {
+        return workers.size();
+    }
+
+    /**
+     * @brief Calls func(i) for each i in [0, count) in calling thread and idle workers, returns when all calls finished.
+     * Func must not throw.
+     */
+    void run(size_t count, const std::function<void(size_t)>& func);
+
+private:
+    struct Job {
+        Job(size_t count, const std::function<void(size_t)>& func) :
+            count(count),
+            func(func) {}
+
+        const size_t count;
+        const std::function<void(size_t)>& func;
+        std::atomic<size_t> next{0};
+        std::mutex mtx;
+        std::condition_variable finishedNotify;
+        size_t finished = 0;
+    };
+
+    void workerLoop();
+
+    static void process(Job& job);
+
+    std::mutex mtx;
+    std::condition_variable jobsNotify;
+    // Each entry lets one worker join the job
+    std::deque<std::shared_ptr<Job>> jobs;
+    bool stopRequested = false;
+    std::vector<std::thread> workers;
+};
+
+}  // namespace ovms
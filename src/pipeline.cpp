@@ -79,17 +79,33 @@ Status Pipeline::execute() {
             getName(), entry.getName(), status.string());
         return status;
     }
-    std::vector<std::reference_wrapper<Node>> nodesWaitingForIdleInferenceStreamId;  // consider replacing with std::vector
-    // even though we can remove with random sequence it is probable that we will remove those in sequence
+    // Nodes waiting for idle inference stream, pushed to the queue again by stream scheduler when stream is assigned
+    std::vector<std::reference_wrapper<Node>> nodesWaitingForIdleInferenceStreamId;
     const uint WAIT_FOR_FINISHED_NODE_TIMEOUT_MICROSECONDS = 500;
-    const uint WAIT_FOR_DEFERRED_NODE_DISARM_TIMEOUT_MICROSECONDS = 500;
-    // process finished nodes and if no one is finished check if any node with deffered execution
-    // has necessary resources already
     while (true) {
         SPDLOG_DEBUG("Pipeline:{} waiting for message that node finished.", getName());
         auto optionallyFinishedNode = finishedNodeQueue.tryPull(WAIT_FOR_FINISHED_NODE_TIMEOUT_MICROSECONDS);
         if (optionallyFinishedNode) {
             Node& finishedNode = optionallyFinishedNode.value().get();
+            auto deferred = std::find_if(nodesWaitingForIdleInferenceStreamId.begin(), nodesWaitingForIdleInferenceStreamId.end(),
+                [&finishedNode](const auto& node) { return &node.get() == &finishedNode; });
+            if (deferred != nodesWaitingForIdleInferenceStreamId.end()) {
+                nodesWaitingForIdleInferenceStreamId.erase(deferred);
+                if (!firstErrorStatus.ok()) {
+                    SPDLOG_DEBUG("Returning stream id of deferred pipeline:{} node:{} due to previous error in pipeline", getName(), finishedNode.getName());
+                    finishedExecute.at(finishedNode.getName()) = true;
+                    finishedNode.release();
+                    IF_ERROR_OCCURRED_EARLIER_THEN_BREAK_IF_ALL_STARTED_FINISHED_CONTINUE_OTHERWISE
+                }
+                SPDLOG_DEBUG("Pipeline:{} got message that deferred node:{} acquired stream id.", getName(), finishedNode.getName());
+                status = finishedNode.execute(finishedNodeQueue);
+                if (status == StatusCode::PIPELINE_STREAM_ID_NOT_READY_YET) {
+                    SPDLOG_ERROR("Pipeline:{} node:{} was notified about stream id which is not ready", getName(), finishedNode.getName());
+                    status = StatusCode::INTERNAL_ERROR;
+                }
+                CHECK_AND_LOG_ERROR(finishedNode)
+                continue;
+            }
             SPDLOG_DEBUG("Pipeline:{} got message that node:{} finished.", getName(), finishedNode.getName());
             finishedExecute.at(finishedNode.getName()) = true;
             if (!firstErrorStatus.ok()) {
@@ -104,8 +120,33 @@ Status Pipeline::execute() {
             if (std::all_of(finishedExecute.begin(), finishedExecute.end(), [](auto pair) { return pair.second; })) {
                 break;
             }
+            bool isGateOpen = true;
+            status = finishedNode.isGateOpen(finishedNodeOutputBlobMap, isGateOpen);
+            CHECK_AND_LOG_ERROR(finishedNode)
+            IF_ERROR_OCCURRED_EARLIER_THEN_BREAK_IF_ALL_STARTED_FINISHED_CONTINUE_OTHERWISE
+            if (!isGateOpen) {
+                SPDLOG_DEBUG("Pipeline:{} node:{} gate is closed, skipping dependant nodes", getName(), finishedNode.getName());
+            }
+            if (outputsWriter) {
+                status = writeNodeOutputs(finishedNode, finishedNodeOutputBlobMap);
+                CHECK_AND_LOG_ERROR(finishedNode)
+                IF_ERROR_OCCURRED_EARLIER_THEN_BREAK_IF_ALL_STARTED_FINISHED_CONTINUE_OTHERWISE
+            }
             auto& nextNodesFromFinished = finishedNode.getNextNodes();
             for (auto& nextNode : nextNodesFromFinished) {
+                if (startedExecute.at(nextNode.get().getName())) {
+                    // node was skipped due to closed gate of its other dependency
+                    continue;
+                }
+                // gate controls only dependant nodes, outputs of gated node are still returned
+                if (!isGateOpen && &nextNode.get() != &exit) {
+                    status = skipNode(nextNode.get(), startedExecute, finishedExecute, finishedNodeQueue);
+                    CHECK_AND_LOG_ERROR(nextNode.get())
+                    if (!firstErrorStatus.ok()) {
+                        break;
+                    }
+                    continue;
+                }
                 SPDLOG_DEBUG("setting pipeline:{} node:{} outputs as inputs for node:{}",
                     getName(), finishedNode.getName(), nextNode.get().getName());
                 status = nextNode.get().setInputs(finishedNode, finishedNodeOutputBlobMap);
@@ -116,7 +157,7 @@ Status Pipeline::execute() {
             }
             finishedNodeOutputBlobMap.clear();
             for (auto& nextNode : nextNodesFromFinished) {
-                if (nextNode.get().isReady()) {
+                if (nextNode.get().isReady() && !startedExecute.at(nextNode.get().getName())) {
                     SPDLOG_DEBUG("Started execution of pipeline:{} node:{}", getName(), nextNode.get().getName());
                     startedExecute.at(nextNode.get().getName()) = true;
                     status = nextNode.get().execute(finishedNodeQueue);
@@ -131,56 +172,72 @@ Status Pipeline::execute() {
                     }
                 }
             }
-        } else {
-            // If error occurred earlier, disarm stream id guards of all deferred nodes and exit
-            if (!firstErrorStatus.ok()) {
-                SPDLOG_DEBUG("Will try to disarm all stream id guards of all {} deferred nodes due to previous error in pipeline", nodesWaitingForIdleInferenceStreamId.size());
-                // Check if there are deferred nodes in queue to free
-                if (nodesWaitingForIdleInferenceStreamId.size() > 0) {
-                    SPDLOG_DEBUG("Trying to disarm {} remaining deferred nodes...", nodesWaitingForIdleInferenceStreamId.size());
-                    for (auto it = nodesWaitingForIdleInferenceStreamId.begin(); it != nodesWaitingForIdleInferenceStreamId.end();) {
-                        auto& node = (*it).get();
-                        if (node.tryDisarmStreamIdGuard(WAIT_FOR_DEFERRED_NODE_DISARM_TIMEOUT_MICROSECONDS)) {
-                            SPDLOG_DEBUG("Stream id guard disarm of node {} has succeeded", node.getName());
-                            finishedExecute.at(node.getName()) = true;
-                            it = nodesWaitingForIdleInferenceStreamId.erase(it);
-                        } else {
-                            SPDLOG_DEBUG("Cannot disarm stream id guard of node {} yet, will try again later", node.getName());
-                            it++;
-                        }
-                    }
-                    SPDLOG_DEBUG("Disarming iteration completed, remaining deferred nodes count: {}", nodesWaitingForIdleInferenceStreamId.size());
-                }
-                // Check for deferred node queue size again to indicate if all nodes got freed
-                if (nodesWaitingForIdleInferenceStreamId.size() > 0) {
-                    continue;
-                } else {
-                    SPDLOG_DEBUG("Disarming all stream id guards of deferred nodes completed, pipeline will shut down");
-                    IF_ERROR_OCCURRED_EARLIER_THEN_BREAK_IF_ALL_STARTED_FINISHED_CONTINUE_OTHERWISE
-                }
-            }
+        }
+    }
+    return firstErrorStatus;
+}
 
-            // else scope could be executed always however it seems most reasonable at the time to
-            // free blocked inferRequests from exeuction first rather than free models for reloading
-            for (auto it = nodesWaitingForIdleInferenceStreamId.begin(); it != nodesWaitingForIdleInferenceStreamId.end();) {
-                auto& node = (*it).get();
-                SPDLOG_DEBUG("Trying to trigger node:{} execution", node.getName());
-                status = node.execute(finishedNodeQueue);
-                if (status.ok()) {
-                    SPDLOG_DEBUG("Node:{} ready yet:", node.getName());
-                    it = nodesWaitingForIdleInferenceStreamId.erase(it);
-                    continue;
-                }
-                it++;
-                if (status == StatusCode::PIPELINE_STREAM_ID_NOT_READY_YET) {
-                    SPDLOG_DEBUG("Node:{} not ready for execution yet", node.getName());
-                    status = StatusCode::OK;
-                } else {
-                    CHECK_AND_LOG_ERROR(node)
+Status Pipeline::writeNodeOutputs(Node& node, const BlobMap& outputs) {
+    const auto& nextNodes = node.getNextNodes();
+    if (std::none_of(nextNodes.begin(), nextNodes.end(), [this](const auto& nextNode) { return &nextNode.get() == &exit; })) {
+        return StatusCode::OK;
+    }
+    BlobMap pipelineOutputs;
+    for (const auto& pair : exit.getMappingByDependency(node)) {
+        auto it = outputs.find(pair.first);
+        if (it == outputs.end()) {
+            SPDLOG_INFO("Pipeline:{} node:{} is missing output:{}", getName(), node.getName(), pair.first);
+            return StatusCode::INVALID_MISSING_OUTPUT;
+        }
+        pipelineOutputs.emplace(pair.second, it->second);
+    }
+    tensorflow::serving::PredictResponse response;
+    auto status = exit.serializeOutputs(pipelineOutputs, response);
+    if (!status.ok()) {
+        return status;
+    }
+    SPDLOG_DEBUG("Pipeline:{} streaming {} outputs of node:{}", getName(), pipelineOutputs.size(), node.getName());
+    return outputsWriter(response);
+}
+
+Status Pipeline::skipDependants(Node& node,
+    std::map<const std::string, bool>& startedExecute,
+    std::map<const std::string, bool>& finishedExecute,
+    ThreadSafeQueue<std::reference_wrapper<Node>>& finishedNodeQueue) {
+    for (auto& nextNode : node.getNextNodes()) {
+        Node& dependant = nextNode.get();
+        dependant.skipDependency();
+        if (&dependant == &exit) {
+            if (exit.isReady()) {
+                SPDLOG_DEBUG("Started execution of pipeline:{} node:{} with partial outputs", getName(), exit.getName());
+                startedExecute.at(exit.getName()) = true;
+                auto status = exit.execute(finishedNodeQueue);
+                if (!status.ok()) {
+                    return status;
                 }
             }
+            continue;
+        }
+        if (startedExecute.at(dependant.getName())) {
+            // already skipped through other dependency
+            continue;
+        }
+        auto status = skipNode(dependant, startedExecute, finishedExecute, finishedNodeQueue);
+        if (!status.ok()) {
+            return status;
         }
     }
-    return firstErrorStatus;
+    return StatusCode::OK;
+}
+
+Status Pipeline::skipNode(Node& node,
+    std::map<const std::string, bool>& startedExecute,
+    std::map<const std::string, bool>& finishedExecute,
+    ThreadSafeQueue<std::reference_wrapper<Node>>& finishedNodeQueue) {
+    SPDLOG_DEBUG("Skipping execution of pipeline:{} node:{}", getName(), node.getName());
+    startedExecute.at(node.getName()) = true;
+    finishedExecute.at(node.getName()) = true;
+    node.release();
+    return skipDependants(node, startedExecute, finishedExecute, finishedNodeQueue);
 }
 }  // namespace ovms
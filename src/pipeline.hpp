@@ -15,6 +15,7 @@
 //*****************************************************************************
 #pragma once
 
+#include <functional>
 #include <map>
 #include <memory>
 #include <string>
@@ -30,11 +31,17 @@ namespace ovms {
 
 void printNodeConnections(const std::string& nodeName, const std::string& sourceNode, const InputPairs& pairs);
 
+/**
+ * @brief Sends part of pipeline response, called once per node producing pipeline outputs
+ */
+using PipelineOutputsWriter = std::function<Status(tensorflow::serving::PredictResponse&)>;
+
 class Pipeline {
     std::vector<std::unique_ptr<Node>> nodes;
     const std::string name;
     EntryNode& entry;
     ExitNode& exit;
+    PipelineOutputsWriter outputsWriter;
 
 public:
     Pipeline(EntryNode& entry, ExitNode& exit, const std::string& name = "default_name") :
@@ -56,6 +63,14 @@ public:
         to.addDependency(from, blobNamesMapping);
     }
 
+    /**
+     * @brief Streams pipeline outputs as soon as nodes producing them finish instead of serializing them in exit node
+     */
+    void setOutputsWriter(PipelineOutputsWriter writer) {
+        outputsWriter = std::move(writer);
+        exit.setOutputsStreamed(outputsWriter != nullptr);
+    }
+
     Status execute();
     const std::string& getName() const {
         return name;
@@ -63,6 +78,28 @@ public:
 
 private:
     std::map<const std::string, bool> prepareStatusMap() const;
+
+    /**
+     * @brief Serializes outputs of finished node mapped to pipeline outputs and passes them to outputs writer
+     */
+    Status writeNodeOutputs(Node& node, const BlobMap& outputs);
+
+    /**
+     * @brief Marks node behind closed gate and all nodes depending on it as started and finished without executing them.
+     * Exit node is executed with partial outputs once all its dependencies are finished or skipped.
+     */
+    Status skipNode(Node& node,
+        std::map<const std::string, bool>& startedExecute,
+        std::map<const std::string, bool>& finishedExecute,
+        ThreadSafeQueue<std::reference_wrapper<Node>>& finishedNodeQueue);
+
+    /**
+     * @brief Skips all nodes depending on skipped node
+     */
+    Status skipDependants(Node& node,
+        std::map<const std::string, bool>& startedExecute,
+        std::map<const std::string, bool>& finishedExecute,
+        ThreadSafeQueue<std::reference_wrapper<Node>>& finishedNodeQueue);
 };
 
 }  // namespace ovms
@@ -51,7 +51,9 @@ Status PipelineDefinition::create(std::unique_ptr<Pipeline>& pipeline,
                                                            info.modelName,
                                                            info.modelVersion,
                                                            manager,
-                                                           info.outputNameAliases))));
+                                                           info.outputNameAliases,
+                                                           info.gate,
+                                                           info.requester))));
             break;
         case NodeKind::EXIT: {
             auto node = std::make_unique<ExitNode>(response);
@@ -94,6 +96,10 @@ Status PipelineDefinition::validateNode(ModelManager& manager, NodeInfo& node) {
         }
 
         auto& config = nodeModelInstance->getModelConfig();
+        if (config.isStateful()) {
+            SPDLOG_ERROR("Validation of pipeline({}) definition failed. Node name {} used stateful model name {} which is forbidden.", this->pipelineName, node.nodeName, node.modelName);
+            return StatusCode::PIPELINE_NODE_STATEFUL_MODEL_FORBIDDEN;
+        }
         if (config.getBatchingMode() == Mode::AUTO) {
             SPDLOG_ERROR("Validation of pipeline({}) definition failed. Node name {} used model name {} with dynamic batch size which is forbidden.", this->pipelineName, node.nodeName, node.modelName);
             return StatusCode::FORBIDDEN_MODEL_DYNAMIC_PARAMETER;
@@ -108,6 +114,21 @@ Status PipelineDefinition::validateNode(ModelManager& manager, NodeInfo& node) {
         }
 
         nodeInputs = nodeModelInstance->getInputsInfo();
+
+        if (node.gate) {
+            const auto& gateOutputName = node.outputNameAliases.count(node.gate->dataItem) ? node.outputNameAliases.at(node.gate->dataItem) : node.gate->dataItem;
+            const auto& nodeOutputs = nodeModelInstance->getOutputsInfo();
+            auto gateOutput = nodeOutputs.find(gateOutputName);
+            if (gateOutput == nodeOutputs.end()) {
+                SPDLOG_ERROR("Validation of pipeline({}) definition failed. Missing gate output: {} of node: {}", this->pipelineName, node.gate->dataItem, node.nodeName);
+                return StatusCode::INVALID_MISSING_OUTPUT;
+            }
+            if (!NodeGate::isPrecisionSupported(gateOutput->second->getPrecision())) {
+                SPDLOG_ERROR("Validation of pipeline({}) definition failed. Gate output: {} of node: {} has unsupported precision: {}",
+                    this->pipelineName, node.gate->dataItem, node.nodeName, gateOutput->second->getPrecisionAsString());
+                return StatusCode::PIPELINE_NODE_GATE_UNSUPPORTED_PRECISION;
+            }
+        }
     }
 
     for (auto& connection : connections[node.nodeName]) {
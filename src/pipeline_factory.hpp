@@ -30,6 +30,7 @@
 
 #include "pipeline.hpp"
 #include "status.hpp"
+#include "stream_scheduling.hpp"
 
 namespace ovms {
 
@@ -53,17 +54,22 @@ struct NodeInfo {
     std::string modelName;
     std::optional<model_version_t> modelVersion;
     std::unordered_map<std::string, std::string> outputNameAliases;
+    std::optional<NodeGate> gate;
+    // Requester used by DL node waiting for inference stream, set from pipeline priority
+    StreamRequester requester = StreamRequester::PIPELINE_NODE;
 
     NodeInfo(NodeKind kind,
         const std::string& nodeName,
         const std::string& modelName = "",
         std::optional<model_version_t> modelVersion = std::nullopt,
-        std::unordered_map<std::string, std::string> outputNameAliases = {}) :
+        std::unordered_map<std::string, std::string> outputNameAliases = {},
+        std::optional<NodeGate> gate = std::nullopt) :
         kind(kind),
         nodeName(nodeName),
         modelName(modelName),
         modelVersion(modelVersion),
-        outputNameAliases(outputNameAliases) {}
+        outputNameAliases(outputNameAliases),
+        gate(gate) {}
 };
 
 class PipelineDefinition {
@@ -0,0 +1,69 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "pipeline_streaming_service.hpp"
+
+#include <memory>
+
+#include <spdlog/spdlog.h>
+
+#include "modelmanager.hpp"
+#include "pipeline.hpp"
+#include "prediction_service_utils.hpp"
+#include "status.hpp"
+
+#define DEBUG
+#include "timer.hpp"
+
+using tensorflow::serving::PredictRequest;
+using tensorflow::serving::PredictResponse;
+
+namespace ovms {
+
+grpc::Status PipelineStreamingServiceImpl::PredictStream(
+    grpc::ServerContext* context,
+    const PredictRequest* request,
+    grpc::ServerWriter<PredictResponse>* writer) {
+    Timer timer;
+    timer.start("total");
+    using std::chrono::microseconds;
+    spdlog::debug("Processing gRPC streaming request for pipeline: {}", request->model_spec().name());
+
+    // Pipeline serializes its outputs directly to the stream, exit node response stays empty
+    PredictResponse unusedResponse;
+    std::unique_ptr<Pipeline> pipelinePtr;
+    auto status = getPipeline(ModelManager::getInstance(), pipelinePtr, request, &unusedResponse);
+    if (!status.ok()) {
+        SPDLOG_INFO("Getting pipeline failed. {}", status.string());
+        return status.grpc();
+    }
+    pipelinePtr->setOutputsWriter([context, writer](PredictResponse& response) -> Status {
+        if (context->IsCancelled() || !writer->Write(response)) {
+            SPDLOG_DEBUG("Could not write pipeline outputs, client closed the stream");
+            return StatusCode::PIPELINE_STREAM_CLOSED;
+        }
+        return StatusCode::OK;
+    });
+    status = pipelinePtr->execute();
+    if (!status.ok()) {
+        return status.grpc();
+    }
+
+    timer.stop("total");
+    spdlog::debug("Total gRPC streaming request processing time: {} ms", timer.elapsed<microseconds>("total") / 1000);
+    return grpc::Status::OK;
+}
+
+}  // namespace ovms
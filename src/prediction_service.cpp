@@ -16,6 +16,7 @@
 #include "prediction_service.hpp"
 
 #include <condition_variable>
+#include <map>
 #include <memory>
 #include <string>
 #include <utility>
@@ -34,6 +35,7 @@
 #include "ovinferrequestsqueue.hpp"
 #include "prediction_service_utils.hpp"
 #include "status.hpp"
+#include "tensor_encoding.hpp"
 
 #define DEBUG
 #include "timer.hpp"
@@ -57,6 +59,15 @@ Status getModelInstance(const PredictRequest* request,
     return getModelInstance(manager, request->model_spec().name(), request->model_spec().version().value(), modelInstance, modelInstanceUnloadGuardPtr);
 }
 
+static std::string getClientMetadata(const ServerContext* context, const std::string& key) {
+    const auto& metadata = context->client_metadata();
+    auto it = metadata.find(key);
+    if (it == metadata.end()) {
+        return "";
+    }
+    return std::string(it->second.data(), it->second.size());
+}
+
 Status getPipeline(const PredictRequest* request,
     PredictResponse* response,
     std::unique_ptr<ovms::Pipeline>& pipelinePtr) {
@@ -75,11 +86,30 @@ grpc::Status ovms::PredictionServiceImpl::Predict(
         request->model_spec().name(),
         request->model_spec().version().value());
 
+    std::map<std::string, TensorEncoding> inputEncodings;
+    auto status = parseTensorEncodings(getClientMetadata(context, TENSOR_ENCODING_METADATA), inputEncodings);
+    if (!status.ok()) {
+        return status.grpc();
+    }
+    // Only encoded inputs are decoded aside, other inputs are read from the request
+    DecodedInputs decodedInputs;
+    if (!inputEncodings.empty()) {
+        status = decodeRequestInputs(inputEncodings, *request, decodedInputs);
+        if (!status.ok()) {
+            return status.grpc();
+        }
+    }
+    TensorEncoding outputEncoding = TensorEncoding::NONE;
+    const auto acceptedEncoding = getClientMetadata(context, ACCEPT_TENSOR_ENCODING_METADATA);
+    if (!acceptedEncoding.empty() && !parseTensorEncoding(acceptedEncoding, outputEncoding)) {
+        return Status(StatusCode::TENSOR_ENCODING_WRONG_FORMAT).grpc();
+    }
+
     std::shared_ptr<ovms::ModelInstance> modelInstance;
     std::unique_ptr<ovms::Pipeline> pipelinePtr;
 
     std::unique_ptr<ModelInstanceUnloadGuard> modelInstanceUnloadGuard;
-    auto status = getModelInstance(request, modelInstance, modelInstanceUnloadGuard);
+    status = getModelInstance(request, modelInstance, modelInstanceUnloadGuard);
 
     if (status == StatusCode::MODEL_NAME_MISSING) {
         SPDLOG_INFO("Requested model: {} does not exist. Searching for pipeline with that name...", request->model_spec().name());
@@ -91,15 +121,22 @@ grpc::Status ovms::PredictionServiceImpl::Predict(
     }
 
     if (pipelinePtr) {
+        pipelinePtr->getEntry().setDecodedInputs(&decodedInputs);
         status = pipelinePtr->execute();
     } else {
-        status = inference(*modelInstance, request, response, modelInstanceUnloadGuard);
+        status = inference(*modelInstance, request, response, modelInstanceUnloadGuard, &decodedInputs);
     }
 
     if (!status.ok()) {
         return status.grpc();
     }
 
+    std::string encodedOutputs;
+    encodeResponseOutputs(outputEncoding, *response, encodedOutputs);
+    if (!encodedOutputs.empty()) {
+        context->AddInitialMetadata(TENSOR_ENCODING_METADATA, encodedOutputs);
+    }
+
     timer.stop("total");
     spdlog::debug("Total gRPC request processing time: {} ms", timer.elapsed<microseconds>("total") / 1000);
     return grpc::Status::OK;
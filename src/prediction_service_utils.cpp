@@ -112,26 +112,53 @@ Status inference(
     ModelInstance& modelVersion,
     const PredictRequest* requestProto,
     PredictResponse* responseProto,
-    std::unique_ptr<ModelInstanceUnloadGuard>& modelUnloadGuardPtr) {
+    std::unique_ptr<ModelInstanceUnloadGuard>& modelUnloadGuardPtr,
+    const DecodedInputs* decodedInputs) {
     Timer timer;
     using std::chrono::microseconds;
 
-    auto status = modelVersion.validate(requestProto);
+    auto status = modelVersion.validate(requestProto, decodedInputs);
     status = reloadModelIfRequired(status, modelVersion, requestProto, modelUnloadGuardPtr);
     if (!status.ok())
         return status;
 
+    // Requests of the same sequence are processed one at a time, preferably on the stream holding its memory states
+    SequenceManager* sequenceManager = modelVersion.getSequenceManager();
+    std::shared_ptr<Sequence> sequence;
+    std::unique_lock<std::mutex> sequenceLock;
+    uint64_t sequenceId = 0;
+    uint32_t sequenceControl = SequenceControl::NO_CONTROL;
+    int preferredStreamId = -1;
+    if (sequenceManager != nullptr) {
+        status = getSequenceParameters(*requestProto, sequenceId, sequenceControl);
+        if (!status.ok())
+            return status;
+        status = sequenceManager->acquireSequence(sequenceId, sequenceControl, sequence);
+        if (!status.ok())
+            return status;
+        sequenceLock = std::unique_lock<std::mutex>(sequence->getMutex());
+        preferredStreamId = sequenceManager->getPreferredStream(*sequence);
+    }
+    SequenceEndGuard sequenceEndGuard(sequenceManager, sequenceId, sequenceControl);
+
     timer.start("get infer request");
     ovms::OVInferRequestsQueue& inferRequestsQueue = modelVersion.getInferRequestsQueue();
-    ExecutingStreamIdGuard executingStreamIdGuard(inferRequestsQueue);
+    ExecutingStreamIdGuard executingStreamIdGuard(inferRequestsQueue, StreamRequester::PREDICT, preferredStreamId);
     int executingInferId = executingStreamIdGuard.getId();
     InferenceEngine::InferRequest& inferRequest = inferRequestsQueue.getInferRequest(executingInferId);
     timer.stop("get infer request");
     spdlog::debug("Getting infer req duration in model {}, version {}, nireq {}: {:.3f} ms",
         requestProto->model_spec().name(), modelVersion.getVersion(), executingInferId, timer.elapsed<microseconds>("get infer request") / 1000);
 
+    if (sequence != nullptr) {
+        status = sequenceManager->bindSequenceState(*sequence, executingInferId, inferRequestsQueue, sequenceControl == SequenceControl::SEQUENCE_START);
+        if (!status.ok())
+            return status;
+    }
+
     timer.start("deserialize");
-    status = deserializePredictRequest<ConcreteTensorProtoDeserializator>(*requestProto, modelVersion.getInputsInfo(), inferRequest);
+    const ExecutionPlan& executionPlan = *modelVersion.getExecutionPlan();
+    status = executionPlan.deserialize(*requestProto, inferRequest, modelVersion.getSparseInputsPool(), executingInferId, decodedInputs);
     timer.stop("deserialize");
     if (!status.ok())
         return status;
@@ -142,17 +169,25 @@ Status inference(
     timer.stop("prediction");
     if (!status.ok())
         return status;
+    if (modelVersion.getProfile() != nullptr) {
+        modelVersion.getProfile()->record(inferRequest);
+    }
     spdlog::debug("Prediction duration in model {}, version {}, nireq {}: {:.3f} ms",
         requestProto->model_spec().name(), modelVersion.getVersion(), executingInferId, timer.elapsed<microseconds>("prediction") / 1000);
 
     timer.start("serialize");
-    status = serializePredictResponse(inferRequest, modelVersion.getOutputsInfo(), responseProto);
+    status = executionPlan.serialize(inferRequest, responseProto);
     timer.stop("serialize");
     if (!status.ok())
         return status;
     spdlog::debug("Serialization duration in model {}, version {}, nireq {}: {:.3f} ms",
         requestProto->model_spec().name(), modelVersion.getVersion(), executingInferId, timer.elapsed<microseconds>("serialize") / 1000);
 
+    executionPlan.addBucketPaddings(*requestProto, *responseProto);
+
+    if (sequence != nullptr) {
+        addSequenceIdToResponse(sequenceId, *responseProto);
+    }
     return StatusCode::OK;
 }
 
@@ -168,7 +203,13 @@ Status reloadModelIfRequired(
             SPDLOG_ERROR("Model instance reload (batch size change) failed. Status Code: {}, Error {}", status.getCode(), status.string());
         }
     } else if (status.reshapeRequired()) {
-        status = modelInstance.reloadModel(0, getRequestShapes(requestProto), modelUnloadGuardPtr);
+        auto requestShapes = getRequestShapes(requestProto);
+        status = modelInstance.getExecutionPlan()->getBucketShapes(*requestProto, requestShapes);
+        if (!status.ok()) {
+            SPDLOG_INFO("Validation of inferRequest failed. Status Code: {}, Error: {}", status.getCode(), status.string());
+            return status;
+        }
+        status = modelInstance.reloadModel(0, requestShapes, modelUnloadGuardPtr);
         if (!status.ok() && status != StatusCode::RESHAPE_ERROR) {
             SPDLOG_ERROR("Model instance reload (reshape) failed. Status Code: {}, Error: {}", status.getCode(), status.string());
         }
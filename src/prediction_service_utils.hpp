@@ -26,6 +26,7 @@
 
 #include "modelinstance.hpp"
 #include "modelmanager.hpp"
+#include "tensor_encoding.hpp"
 
 namespace ovms {
 
@@ -51,7 +52,8 @@ Status inference(
     ModelInstance& modelVersion,
     const tensorflow::serving::PredictRequest* requestProto,
     tensorflow::serving::PredictResponse* responseProto,
-    std::unique_ptr<ModelInstanceUnloadGuard>& modelUnloadGuardPtr);
+    std::unique_ptr<ModelInstanceUnloadGuard>& modelUnloadGuardPtr,
+    const DecodedInputs* decodedInputs = nullptr);
 
 Status reloadModelIfRequired(
     Status validationStatus,
@@ -15,8 +15,13 @@
 //*****************************************************************************
 #include "rest_parser.hpp"
 
+#include <cstring>
 #include <functional>
 #include <string>
+#include <vector>
+
+#include "parallel_chunks.hpp"
+#include "sequence_manager.hpp"
 
 namespace ovms {
 
@@ -106,6 +111,210 @@ bool RestParser::isBatchSizeEqualForAllInputs() const {
     return true;
 }
 
+template <typename T>
+bool getNumber(const rapidjson::Value& value, T& number) {
+    if (value.IsDouble()) {
+        number = static_cast<T>(value.GetDouble());
+        return true;
+    }
+    if (value.IsInt64()) {
+        number = static_cast<T>(value.GetInt64());
+        return true;
+    }
+    if (value.IsUint64()) {
+        number = static_cast<T>(value.GetUint64());
+        return true;
+    }
+    if (value.IsInt()) {
+        number = static_cast<T>(value.GetInt());
+        return true;
+    }
+    if (value.IsUint()) {
+        number = static_cast<T>(value.GetUint());
+        return true;
+    }
+    return false;
+}
+
+bool isParsedIntoTensorContent(tensorflow::DataType dtype) {
+    switch (dtype) {
+    case tensorflow::DataType::DT_FLOAT:
+    case tensorflow::DataType::DT_DOUBLE:
+    case tensorflow::DataType::DT_INT32:
+    case tensorflow::DataType::DT_INT16:
+    case tensorflow::DataType::DT_INT8:
+    case tensorflow::DataType::DT_UINT8:
+    case tensorflow::DataType::DT_INT64:
+    case tensorflow::DataType::DT_UINT32:
+    case tensorflow::DataType::DT_UINT64:
+        return true;
+    default:
+        return false;
+    }
+}
+
+// Unlike parseArray it does not modify shape, each instance has to match exactly the shape set by the first one
+template <typename T>
+bool writeArray(const rapidjson::Value& doc, int dim, const tensorflow::TensorShapeProto& shape, char*& out) {
+    if (!doc.IsArray() || static_cast<int64_t>(doc.GetArray().Size()) != shape.dim(dim).size()) {
+        return false;
+    }
+    if (dim + 1 < shape.dim_size()) {
+        for (const auto& itr : doc.GetArray()) {
+            if (!writeArray<T>(itr, dim + 1, shape, out)) {
+                return false;
+            }
+        }
+        return true;
+    }
+    for (const auto& value : doc.GetArray()) {
+        T number;
+        if (!value.IsNumber() || !getNumber(value, number)) {
+            return false;
+        }
+        std::memcpy(out, &number, sizeof(T));
+        out += sizeof(T);
+    }
+    return true;
+}
+
+template <typename T>
+bool writeInstances(const std::vector<const rapidjson::Value*>& instances, size_t chunks, tensorflow::TensorProto& proto) {
+    const size_t instanceSize = proto.tensor_content().size();
+    proto.mutable_tensor_content()->resize(instanceSize * instances.size());
+    char* data = &(*proto.mutable_tensor_content())[0];
+    const auto& shape = proto.tensor_shape();
+    bool result = runInParallelChunks(1, instances.size(), chunks, [&](size_t, size_t begin, size_t end) {
+        char* out = data + begin * instanceSize;
+        for (size_t i = begin; i < end; i++) {
+            if (!writeArray<T>(*instances[i], 1, shape, out)) {
+                return false;
+            }
+        }
+        return true;
+    });
+    if (!result) {
+        proto.mutable_tensor_content()->resize(instanceSize);
+    }
+    return result;
+}
+
+// Fills tensor_content with all instances but the first one, which has to be already parsed.
+// On failure tensor_content is truncated back to the first instance so that parsing can continue serially.
+bool parseInstancesInParallel(const std::vector<const rapidjson::Value*>& instances, size_t chunks, tensorflow::TensorProto& proto) {
+    switch (proto.dtype()) {
+    case tensorflow::DataType::DT_FLOAT:
+        return writeInstances<float>(instances, chunks, proto);
+    case tensorflow::DataType::DT_DOUBLE:
+        return writeInstances<double>(instances, chunks, proto);
+    case tensorflow::DataType::DT_INT32:
+        return writeInstances<int32_t>(instances, chunks, proto);
+    case tensorflow::DataType::DT_INT16:
+        return writeInstances<int16_t>(instances, chunks, proto);
+    case tensorflow::DataType::DT_INT8:
+        return writeInstances<int8_t>(instances, chunks, proto);
+    case tensorflow::DataType::DT_UINT8:
+        return writeInstances<uint8_t>(instances, chunks, proto);
+    case tensorflow::DataType::DT_INT64:
+        return writeInstances<int64_t>(instances, chunks, proto);
+    case tensorflow::DataType::DT_UINT32:
+        return writeInstances<uint32_t>(instances, chunks, proto);
+    case tensorflow::DataType::DT_UINT64:
+        return writeInstances<uint64_t>(instances, chunks, proto);
+    default:
+        return false;
+    }
+}
+
+size_t getParsedValuesCount(const tensorflow::TensorProto& proto) {
+    return proto.tensor_content().size() / DataTypeSize(proto.dtype());
+}
+
+bool RestParser::parseRemainingNamedInstancesInParallel(rapidjson::Value& node) {
+    struct Tensor {
+        std::string name;
+        tensorflow::TensorProto* proto;
+        std::vector<const rapidjson::Value*> instances;
+    };
+    const auto& first = node.GetArray()[0];
+    const size_t batchSize = node.GetArray().Size();
+    std::vector<Tensor> tensors;
+    size_t totalValues = 0;
+    for (const auto& itr : first.GetObject()) {
+        std::string tensorName = itr.name.GetString();
+        auto& proto = (*requestProto.mutable_inputs())[tensorName];
+        // batch size is increased more than once for duplicated names
+        if (!isParsedIntoTensorContent(proto.dtype()) || proto.tensor_shape().dim(0).size() != 1) {
+            return false;
+        }
+        totalValues += getParsedValuesCount(proto) * batchSize;
+        tensors.push_back(Tensor{tensorName, &proto, {&itr.value}});
+    }
+    const size_t chunks = getParallelChunksCount(batchSize - 1, totalValues);
+    if (chunks < 2) {
+        return false;
+    }
+    for (size_t i = 1; i < batchSize; i++) {
+        const auto& instance = node.GetArray()[i];
+        if (!instance.IsObject() || instance.GetObject().MemberCount() != first.GetObject().MemberCount()) {
+            return false;
+        }
+        for (auto& tensor : tensors) {
+            auto memberItr = instance.FindMember(tensor.name.c_str());
+            if (memberItr == instance.MemberEnd()) {
+                return false;
+            }
+            tensor.instances.push_back(&memberItr->value);
+        }
+    }
+    for (size_t i = 0; i < tensors.size(); i++) {
+        if (!parseInstancesInParallel(tensors[i].instances, chunks, *tensors[i].proto)) {
+            for (size_t j = 0; j < i; j++) {
+                auto& content = *tensors[j].proto->mutable_tensor_content();
+                content.resize(content.size() / batchSize);
+            }
+            return false;
+        }
+    }
+    for (auto& tensor : tensors) {
+        tensor.proto->mutable_tensor_shape()->mutable_dim(0)->set_size(batchSize);
+    }
+    return true;
+}
+
+bool RestParser::parseNoNamedInstances(rapidjson::Value& node, tensorflow::TensorProto& proto, const std::string& tensorName) {
+    if (!node.GetArray()[0].IsArray()) {
+        return parseArray(node, 0, proto, tensorName);
+    }
+    // equivalent of parseArray called on whole node with the first instance parsed upfront to learn its size
+    const size_t batchSize = node.GetArray().Size();
+    if (!setDimOrValidate(proto, 0, batchSize)) {
+        return false;
+    }
+    if (!parseArray(node.GetArray()[0], 1, proto, tensorName)) {
+        return false;
+    }
+    if (isParsedIntoTensorContent(proto.dtype())) {
+        const size_t chunks = getParallelChunksCount(batchSize - 1, getParsedValuesCount(proto) * batchSize);
+        if (chunks > 1) {
+            std::vector<const rapidjson::Value*> instances;
+            instances.reserve(batchSize);
+            for (const auto& instance : node.GetArray()) {
+                instances.push_back(&instance);
+            }
+            if (parseInstancesInParallel(instances, chunks, proto)) {
+                return true;
+            }
+        }
+    }
+    for (size_t i = 1; i < batchSize; i++) {
+        if (!parseArray(node.GetArray()[i], 1, proto, tensorName)) {
+            return false;
+        }
+    }
+    return true;
+}
+
 Status RestParser::parseRowFormat(rapidjson::Value& node) {
     order = Order::ROW;
     if (!node.IsArray()) {
@@ -116,12 +325,18 @@ Status RestParser::parseRowFormat(rapidjson::Value& node) {
     }
     if (node.GetArray()[0].IsObject()) {
         // named format
-        for (auto& instance : node.GetArray()) {
-            if (!instance.IsObject()) {
-                return StatusCode::REST_NAMED_INSTANCE_NOT_AN_OBJECT;
-            }
-            if (!this->parseInstance(instance)) {
-                return StatusCode::REST_COULD_NOT_PARSE_INSTANCE;
+        if (!this->parseInstance(node.GetArray()[0])) {
+            return StatusCode::REST_COULD_NOT_PARSE_INSTANCE;
+        }
+        if (!parseRemainingNamedInstancesInParallel(node)) {
+            for (size_t i = 1; i < node.GetArray().Size(); i++) {
+                auto& instance = node.GetArray()[i];
+                if (!instance.IsObject()) {
+                    return StatusCode::REST_NAMED_INSTANCE_NOT_AN_OBJECT;
+                }
+                if (!this->parseInstance(instance)) {
+                    return StatusCode::REST_COULD_NOT_PARSE_INSTANCE;
+                }
             }
         }
     } else if (node.GetArray()[0].IsArray() || node.GetArray()[0].IsNumber()) {
@@ -135,7 +350,7 @@ Status RestParser::parseRowFormat(rapidjson::Value& node) {
             SPDLOG_ERROR("Internal error occured: {}", details);
             return Status(StatusCode::INTERNAL_ERROR, details);
         }
-        if (!parseArray(node, 0, inputsIterator->second, inputsIterator->first)) {
+        if (!parseNoNamedInstances(node, inputsIterator->second, inputsIterator->first)) {
             return StatusCode::REST_COULD_NOT_PARSE_INSTANCE;
         } else {
             format = Format::NONAMED;
@@ -195,18 +410,22 @@ Status RestParser::parse(const char* json) {
     if (doc.Parse(json).HasParseError()) {
         return StatusCode::JSON_INVALID;
     }
-    if (!doc.IsObject()) {
+    return parse(doc);
+}
+
+Status RestParser::parse(rapidjson::Value& request) {
+    if (!request.IsObject()) {
         return StatusCode::REST_BODY_IS_NOT_AN_OBJECT;
     }
-    auto instancesItr = doc.FindMember("instances");
-    auto inputsItr = doc.FindMember("inputs");
-    if (instancesItr != doc.MemberEnd() && inputsItr != doc.MemberEnd()) {
+    auto instancesItr = request.FindMember("instances");
+    auto inputsItr = request.FindMember("inputs");
+    if (instancesItr != request.MemberEnd() && inputsItr != request.MemberEnd()) {
         return StatusCode::REST_PREDICT_UNKNOWN_ORDER;
     }
-    if (instancesItr != doc.MemberEnd()) {
+    if (instancesItr != request.MemberEnd()) {
         return parseRowFormat(instancesItr->value);
     }
-    if (inputsItr != doc.MemberEnd()) {
+    if (inputsItr != request.MemberEnd()) {
         return parseColumnFormat(inputsItr->value);
     }
     return StatusCode::REST_PREDICT_UNKNOWN_ORDER;
@@ -242,22 +461,11 @@ bool addToTensorContent(tensorflow::TensorProto& proto, T value) {
 
 template <typename T>
 bool addToTensorContent(tensorflow::TensorProto& proto, const rapidjson::Value& value) {
-    if (value.IsDouble()) {
-        return addToTensorContent<T>(proto, static_cast<T>(value.GetDouble()));
-    }
-    if (value.IsInt64()) {
-        return addToTensorContent<T>(proto, static_cast<T>(value.GetInt64()));
-    }
-    if (value.IsUint64()) {
-        return addToTensorContent<T>(proto, static_cast<T>(value.GetUint64()));
-    }
-    if (value.IsInt()) {
-        return addToTensorContent<T>(proto, static_cast<T>(value.GetInt()));
-    }
-    if (value.IsUint()) {
-        return addToTensorContent<T>(proto, static_cast<T>(value.GetUint()));
+    T number;
+    if (!getNumber(value, number)) {
+        return false;
     }
-    return false;
+    return addToTensorContent<T>(proto, number);
 }
 
 bool addToHalfVal(tensorflow::TensorProto& proto, const rapidjson::Value& value) {
@@ -346,6 +554,9 @@ bool RestParser::setPrecisionIfNotSet(const rapidjson::Value& value, tensorflow:
 
     if (value.IsInt())
         tensorPrecisionMap[tensorName] = InferenceEngine::Precision::I32;
+    else if (tensorName == SEQUENCE_ID_INPUT && value.IsUint64())
+        // Sequence id is the only untyped input which may exceed int32 range
+        tensorPrecisionMap[tensorName] = InferenceEngine::Precision::U64;
     else if (value.IsDouble())
         tensorPrecisionMap[tensorName] = InferenceEngine::Precision::FP32;
     else
@@ -126,6 +126,28 @@ class RestParser {
      */
     bool parseInstance(rapidjson::Value& doc);
 
+    /**
+     * @brief Parses all named instances but the first one, which has to be already parsed, in parallel chunks.
+     * Each instance is written into its own slice of tensor_content sized after the first instance.
+     *
+     * @param doc rapidjson array of named instances
+     *
+     * @return false if payload is too small, instances differ in structure or any of them could not be parsed,
+     * in which case inputs are left with the first instance only
+     */
+    bool parseRemainingNamedInstancesInParallel(rapidjson::Value& doc);
+
+    /**
+     * @brief Parses no named instances, large ones in parallel chunks
+     *
+     * @param doc rapidjson array of instances
+     * @param proto output tensor proto
+     * @param tensorName name of the input
+     *
+     * @return true if parsing succeeded
+     */
+    bool parseNoNamedInstances(rapidjson::Value& doc, tensorflow::TensorProto& proto, const std::string& tensorName);
+
     /**
      * @brief Checks whether all inputs have equal batch size, 0th-dimension
      * 
@@ -211,6 +233,15 @@ public:
      * }
      */
     Status parse(const char* json);
+
+    /**
+     * @brief Parses already parsed JSON request object, eg. single element of batch request
+     *
+     * @param request JSON object with instances or inputs member
+     *
+     * @return Status indicating error code or success
+     */
+    Status parse(rapidjson::Value& request);
 };
 
 }  // namespace ovms
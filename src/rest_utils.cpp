@@ -15,13 +15,21 @@
 //*****************************************************************************
 #include "rest_utils.hpp"
 
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <optional>
+#include <vector>
+
 #include <spdlog/spdlog.h>
+#include <zlib.h>
 
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wall"
 #include "tensorflow_serving/util/json_tensor.h"
 #pragma GCC diagnostic pop
 
+#include "parallel_chunks.hpp"
 #define DEBUG
 #include "timer.hpp"
 
@@ -32,6 +40,231 @@ using tensorflow::serving::MakeJsonFromTensors;
 using tensorflow::serving::PredictResponse;
 
 namespace ovms {
+namespace {
+Status addValuesFromContent(const char* data, size_t size, tensorflow::TensorProto& tensor) {
+    switch (tensor.dtype()) {
+    case DataType::DT_FLOAT:
+        for (size_t i = 0; i < size; i += sizeof(float)) {
+            tensor.add_float_val(*reinterpret_cast<const float*>(data + i));
+        }
+        break;
+    case DataType::DT_DOUBLE:
+        for (size_t i = 0; i < size; i += sizeof(double)) {
+            tensor.add_double_val(*reinterpret_cast<const double*>(data + i));
+        }
+        break;
+    case DataType::DT_INT32:
+        for (size_t i = 0; i < size; i += sizeof(int32_t)) {
+            tensor.add_int_val(*reinterpret_cast<const int32_t*>(data + i));
+        }
+        break;
+    case DataType::DT_INT16:
+        for (size_t i = 0; i < size; i += sizeof(int16_t)) {
+            tensor.add_int_val(*reinterpret_cast<const int16_t*>(data + i));
+        }
+        break;
+    case DataType::DT_INT8:
+        for (size_t i = 0; i < size; i += sizeof(int8_t)) {
+            tensor.add_int_val(*reinterpret_cast<const int8_t*>(data + i));
+        }
+        break;
+    case DataType::DT_UINT8:
+        for (size_t i = 0; i < size; i += sizeof(uint8_t)) {
+            tensor.add_int_val(*reinterpret_cast<const uint8_t*>(data + i));
+        }
+        break;
+    case DataType::DT_INT64:
+        for (size_t i = 0; i < size; i += sizeof(int64_t)) {
+            tensor.add_int64_val(*reinterpret_cast<const int64_t*>(data + i));
+        }
+        break;
+    case DataType::DT_UINT32:
+        for (size_t i = 0; i < size; i += sizeof(uint32_t)) {
+            tensor.add_uint32_val(*reinterpret_cast<const uint32_t*>(data + i));
+        }
+        break;
+    case DataType::DT_UINT64:
+        for (size_t i = 0; i < size; i += sizeof(uint64_t)) {
+            tensor.add_uint64_val(*reinterpret_cast<const uint64_t*>(data + i));
+        }
+        break;
+    default:
+        return StatusCode::REST_UNSUPPORTED_PRECISION;
+    }
+    return StatusCode::OK;
+}
+
+Status makeJsonFromTensors(const google::protobuf::Map<std::string, tensorflow::TensorProto>& tensors, Order order, std::string* json) {
+    const auto& tf_status = MakeJsonFromTensors(
+        tensors,
+        order == Order::ROW ? JsonPredictRequestFormat::kRow : JsonPredictRequestFormat::kColumnar,
+        json);
+    if (!tf_status.ok()) {
+        SPDLOG_ERROR("MakeJsonFromTensors error: {}", tf_status.error_message());
+        return StatusCode::REST_PROTO_TO_STRING_ERROR;
+    }
+    return StatusCode::OK;
+}
+
+// Row order predictions are independent per batch element so large responses are split along batch dimension,
+// encoded in parallel and joined. Returns 1 if response is too small or outputs do not share batch size.
+size_t getRowOrderChunksCount(const PredictResponse& response_proto, size_t& batchSize) {
+    batchSize = 0;
+    size_t totalValues = 0;
+    for (const auto& kv : response_proto.outputs()) {
+        const auto& tensor = kv.second;
+        if (tensor.tensor_shape().dim_size() < 1 || DataTypeSize(tensor.dtype()) == 0) {
+            return 1;
+        }
+        size_t size = tensor.tensor_shape().dim(0).size();
+        if (batchSize == 0) {
+            batchSize = size;
+        } else if (size != batchSize) {
+            return 1;
+        }
+        totalValues += tensor.tensor_content().size() / DataTypeSize(tensor.dtype());
+    }
+    if (batchSize < 2) {
+        return 1;
+    }
+    return getParallelChunksCount(batchSize, totalValues);
+}
+
+Status makeJsonFromRowOrderChunk(const PredictResponse& response_proto, size_t begin, size_t end, std::string* json) {
+    google::protobuf::Map<std::string, tensorflow::TensorProto> tensors;
+    for (const auto& kv : response_proto.outputs()) {
+        const auto& source = kv.second;
+        auto& tensor = tensors[kv.first];
+        tensor.set_dtype(source.dtype());
+        *tensor.mutable_tensor_shape() = source.tensor_shape();
+        tensor.mutable_tensor_shape()->mutable_dim(0)->set_size(end - begin);
+        const size_t rowSize = source.tensor_content().size() / source.tensor_shape().dim(0).size();
+        auto status = addValuesFromContent(source.tensor_content().data() + begin * rowSize, (end - begin) * rowSize, tensor);
+        if (!status.ok()) {
+            return status;
+        }
+    }
+    return makeJsonFromTensors(tensors, Order::ROW, json);
+}
+
+const char* const JSON_WHITESPACE = " \n\r\t";
+
+// Finds predictions array of row order response: positions of its opening bracket and the matching closing one.
+// Brackets inside strings, e.g. in output names, are skipped.
+bool findPredictionsArray(const std::string& json, size_t& begin, size_t& end) {
+    // predictions is the only member of response object, so its key is the first string in the document
+    const std::string key = "\"predictions\"";
+    begin = json.find(key);
+    if (begin == std::string::npos) {
+        return false;
+    }
+    begin = json.find_first_not_of(JSON_WHITESPACE, begin + key.size());
+    if (begin == std::string::npos || json[begin] != ':') {
+        return false;
+    }
+    begin = json.find_first_not_of(JSON_WHITESPACE, begin + 1);
+    if (begin == std::string::npos || json[begin] != '[') {
+        return false;
+    }
+    size_t depth = 0;
+    bool inString = false;
+    for (size_t i = begin; i < json.size(); i++) {
+        const char c = json[i];
+        if (inString) {
+            if (c == '\\') {
+                i++;
+            } else if (c == '"') {
+                inString = false;
+            }
+        } else if (c == '"') {
+            inString = true;
+        } else if (c == '[' || c == '{') {
+            depth++;
+        } else if ((c == ']' || c == '}') && --depth == 0) {
+            end = i;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Appends predictions of subsequent chunks to predictions array of the first one:
+// {"predictions": [<chunk 0 predictions>, <chunk 1 predictions>, ...]}
+// Predictions are separated the same way as within a chunk, so the result matches response encoded in one pass.
+bool joinRowOrderChunks(const std::vector<std::string>& chunks, std::string* json) {
+    size_t totalSize = 0;
+    for (const auto& chunk : chunks) {
+        totalSize += chunk.size();
+    }
+    json->clear();
+    json->reserve(totalSize);
+    size_t headSize = 0;
+    std::string separator;
+    std::string tail;
+    for (size_t i = 0; i < chunks.size(); i++) {
+        const auto& chunk = chunks[i];
+        size_t begin, end;
+        if (!findPredictionsArray(chunk, begin, end)) {
+            return false;
+        }
+        const size_t valuesBegin = chunk.find_first_not_of(JSON_WHITESPACE, begin + 1);
+        const size_t valuesEnd = chunk.find_last_not_of(JSON_WHITESPACE, end - 1) + 1;
+        if (valuesBegin >= end) {
+            return false;
+        }
+        if (i == 0) {
+            headSize = begin;
+            json->append(chunk, 0, valuesBegin);
+            tail = chunk.substr(valuesEnd);
+            // Single line arrays separate values with ", ", otherwise each value starts in new line with the same indentation
+            separator = valuesBegin == begin + 1 ? ", " : "," + chunk.substr(begin + 1, valuesBegin - begin - 1);
+        } else {
+            if (begin != headSize || chunk.compare(0, headSize, chunks[0], 0, headSize) != 0 ||
+                chunk.compare(valuesEnd, std::string::npos, tail) != 0) {
+                return false;
+            }
+            json->append(separator);
+        }
+        json->append(chunk, valuesBegin, valuesEnd - valuesBegin);
+    }
+    json->append(tail);
+    return true;
+}
+}  // namespace
+
+Status makeJsonFromRowOrderResponseInChunks(
+    const PredictResponse& response_proto,
+    std::string* response_json,
+    size_t chunks) {
+    if (response_proto.outputs().empty() || response_proto.outputs().begin()->second.tensor_shape().dim_size() < 1) {
+        return StatusCode::REST_PROTO_TO_STRING_ERROR;
+    }
+    const size_t batchSize = response_proto.outputs().begin()->second.tensor_shape().dim(0).size();
+    for (const auto& kv : response_proto.outputs()) {
+        const auto& shape = kv.second.tensor_shape();
+        if (shape.dim_size() < 1 || static_cast<size_t>(shape.dim(0).size()) != batchSize) {
+            return StatusCode::REST_PROTO_TO_STRING_ERROR;
+        }
+    }
+    chunks = std::max<size_t>(std::min(chunks, batchSize), 1);
+    std::vector<std::string> jsons(chunks);
+    std::vector<Status> statuses(chunks);
+    runInParallelChunks(0, batchSize, chunks, [&](size_t chunk, size_t begin, size_t end) {
+        statuses[chunk] = makeJsonFromRowOrderChunk(response_proto, begin, end, &jsons[chunk]);
+        return statuses[chunk].ok();
+    });
+    for (const auto& status : statuses) {
+        if (!status.ok()) {
+            return status;
+        }
+    }
+    if (!joinRowOrderChunks(jsons, response_json)) {
+        SPDLOG_ERROR("Failed to join {} row order response chunks", chunks);
+        return StatusCode::REST_PROTO_TO_STRING_ERROR;
+    }
+    return StatusCode::OK;
+}
+
 Status makeJsonFromPredictResponse(
     PredictResponse& response_proto,
     std::string* response_json,
@@ -43,10 +276,8 @@ Status makeJsonFromPredictResponse(
     Timer timer;
     using std::chrono::microseconds;
 
-    timer.start("convert");
-
-    for (auto& kv : *response_proto.mutable_outputs()) {
-        auto& tensor = kv.second;
+    for (const auto& kv : response_proto.outputs()) {
+        const auto& tensor = kv.second;
 
         size_t expected_content_size = DataTypeSize(tensor.dtype());
         for (int i = 0; i < tensor.tensor_shape().dim_size(); i++) {
@@ -56,75 +287,92 @@ Status makeJsonFromPredictResponse(
         if (tensor.tensor_content().size() != expected_content_size) {
             return StatusCode::REST_SERIALIZE_TENSOR_CONTENT_INVALID_SIZE;
         }
+    }
 
-        switch (tensor.dtype()) {
-        case DataType::DT_FLOAT:
-            for (size_t i = 0; i < tensor.tensor_content().size(); i += sizeof(float)) {
-                tensor.add_float_val(*reinterpret_cast<float*>(tensor.mutable_tensor_content()->data() + i));
-            }
-            break;
-        case DataType::DT_DOUBLE:
-            for (size_t i = 0; i < tensor.tensor_content().size(); i += sizeof(double)) {
-                tensor.add_double_val(*reinterpret_cast<double*>(tensor.mutable_tensor_content()->data() + i));
-            }
-            break;
-        case DataType::DT_INT32:
-            for (size_t i = 0; i < tensor.tensor_content().size(); i += sizeof(int32_t)) {
-                tensor.add_int_val(*reinterpret_cast<int32_t*>(tensor.mutable_tensor_content()->data() + i));
-            }
-            break;
-        case DataType::DT_INT16:
-            for (size_t i = 0; i < tensor.tensor_content().size(); i += sizeof(int16_t)) {
-                tensor.add_int_val(*reinterpret_cast<int16_t*>(tensor.mutable_tensor_content()->data() + i));
-            }
-            break;
-        case DataType::DT_INT8:
-            for (size_t i = 0; i < tensor.tensor_content().size(); i += sizeof(int8_t)) {
-                tensor.add_int_val(*reinterpret_cast<int8_t*>(tensor.mutable_tensor_content()->data() + i));
-            }
-            break;
-        case DataType::DT_UINT8:
-            for (size_t i = 0; i < tensor.tensor_content().size(); i += sizeof(uint8_t)) {
-                tensor.add_int_val(*reinterpret_cast<uint8_t*>(tensor.mutable_tensor_content()->data() + i));
-            }
-            break;
-        case DataType::DT_INT64:
-            for (size_t i = 0; i < tensor.tensor_content().size(); i += sizeof(int64_t)) {
-                tensor.add_int64_val(*reinterpret_cast<int64_t*>(tensor.mutable_tensor_content()->data() + i));
-            }
-            break;
-        case DataType::DT_UINT32:
-            for (size_t i = 0; i < tensor.tensor_content().size(); i += sizeof(uint32_t)) {
-                tensor.add_uint32_val(*reinterpret_cast<uint32_t*>(tensor.mutable_tensor_content()->data() + i));
-            }
-            break;
-        case DataType::DT_UINT64:
-            for (size_t i = 0; i < tensor.tensor_content().size(); i += sizeof(uint64_t)) {
-                tensor.add_uint64_val(*reinterpret_cast<uint64_t*>(tensor.mutable_tensor_content()->data() + i));
-            }
-            break;
-        default:
-            return StatusCode::REST_UNSUPPORTED_PRECISION;
+    size_t batchSize = 0;
+    const size_t chunks = order == Order::ROW ? getRowOrderChunksCount(response_proto, batchSize) : 1;
+    if (chunks > 1) {
+        timer.start("parallel");
+        auto status = makeJsonFromRowOrderResponseInChunks(response_proto, response_json, chunks);
+        timer.stop("parallel");
+        if (status.ok()) {
+            spdlog::debug("Parallel conversion and MakeJsonFromTensors call in {} chunks: {:.3f} ms", chunks, timer.elapsed<microseconds>("parallel") / 1000);
+            return status;
+        }
+        SPDLOG_DEBUG("Encoding row order response in {} chunks failed: {}; encoding in single pass", chunks, status.string());
+    }
+
+    timer.start("convert");
+
+    for (auto& kv : *response_proto.mutable_outputs()) {
+        auto& tensor = kv.second;
+        auto status = addValuesFromContent(tensor.tensor_content().data(), tensor.tensor_content().size(), tensor);
+        if (!status.ok()) {
+            return status;
         }
     }
 
     timer.stop("convert");
     timer.start("MakeJsonFromTensors");
 
-    const auto& tf_status = MakeJsonFromTensors(
-        response_proto.outputs(),
-        order == Order::ROW ? JsonPredictRequestFormat::kRow : JsonPredictRequestFormat::kColumnar,
-        response_json);
+    auto status = makeJsonFromTensors(response_proto.outputs(), order, response_json);
 
     timer.stop("MakeJsonFromTensors");
     spdlog::debug("tensor_content to *_val container conversion: {:.3f} ms", timer.elapsed<microseconds>("convert") / 1000);
     spdlog::debug("MakeJsonFromTensors call: {:.3f} ms", timer.elapsed<microseconds>("MakeJsonFromTensors") / 1000);
 
-    if (!tf_status.ok()) {
-        SPDLOG_ERROR("MakeJsonFromTensors error: {}", tf_status.error_message());
-        return StatusCode::REST_PROTO_TO_STRING_ERROR;
+    return status;
+}
+
+bool isGzipEncodingAccepted(std::string_view acceptEncoding) {
+    // Accept-Encoding: deflate, gzip;q=1.0, *;q=0.5
+    // Explicit gzip entry takes precedence over wildcard regardless of their order
+    std::optional<bool> gzipAccepted;
+    std::optional<bool> wildcardAccepted;
+    while (!acceptEncoding.empty()) {
+        auto end = acceptEncoding.find(',');
+        auto coding = acceptEncoding.substr(0, end);
+        acceptEncoding.remove_prefix(end == std::string_view::npos ? acceptEncoding.size() : end + 1);
+
+        auto paramsStart = coding.find(';');
+        auto params = paramsStart == std::string_view::npos ? std::string_view() : coding.substr(paramsStart + 1);
+        coding = coding.substr(0, paramsStart);
+        coding.remove_prefix(std::min(coding.find_first_not_of(' '), coding.size()));
+        coding.remove_suffix(coding.size() - std::min(coding.find_last_not_of(' ') + 1, coding.size()));
+        std::string name(coding);
+        std::transform(name.begin(), name.end(), name.begin(), [](unsigned char c) { return std::tolower(c); });
+        if (name != "gzip" && name != "*") {
+            continue;
+        }
+        auto qualityStart = params.find("q=");
+        bool accepted = qualityStart == std::string_view::npos || std::strtod(std::string(params.substr(qualityStart + 2)).c_str(), nullptr) > 0.0;
+        (name == "gzip" ? gzipAccepted : wildcardAccepted) = accepted;
     }
+    return gzipAccepted.value_or(wildcardAccepted.value_or(false));
+}
 
-    return StatusCode::OK;
+bool compressGzip(const std::string& input, std::string* output) {
+    z_stream stream{};
+    // 16 added to window bits makes zlib write gzip header and trailer
+    const int windowBits = 15 + 16;
+    const int memLevel = 8;
+    if (deflateInit2(&stream, Z_BEST_SPEED, Z_DEFLATED, windowBits, memLevel, Z_DEFAULT_STRATEGY) != Z_OK) {
+        spdlog::debug("Failed to initialize gzip compression");
+        return false;
+    }
+    output->resize(deflateBound(&stream, input.size()));
+    stream.next_in = (Bytef*)input.data();
+    stream.avail_in = input.size();
+    stream.next_out = (Bytef*)output->data();
+    stream.avail_out = output->size();
+    const int result = deflate(&stream, Z_FINISH);
+    deflateEnd(&stream);
+    if (result != Z_STREAM_END) {
+        spdlog::debug("Failed to compress response with gzip; zlib error: {}", result);
+        return false;
+    }
+    output->resize(stream.total_out);
+    return true;
 }
+
 }  // namespace ovms
@@ -16,6 +16,7 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wall"
@@ -30,4 +31,38 @@ Status makeJsonFromPredictResponse(
     tensorflow::serving::PredictResponse& response_proto,
     std::string* response_json,
     Order order);
+
+/**
+ * @brief Encodes row order response split along batch dimension into chunks encoded in parallel and joined.
+ * Result is the same as of makeJsonFromPredictResponse, which uses it for large responses.
+ *
+ * @param response_proto response with outputs sharing batch size
+ * @param response_json
+ * @param chunks number of chunks, limited by batch size
+ *
+ * @return Status
+ */
+Status makeJsonFromRowOrderResponseInChunks(
+    const tensorflow::serving::PredictResponse& response_proto,
+    std::string* response_json,
+    size_t chunks);
+
+/**
+ * @brief Checks if client accepts gzip encoded response
+ *
+ * @param acceptEncoding value of Accept-Encoding request header
+ *
+ * @return bool
+ */
+bool isGzipEncodingAccepted(std::string_view acceptEncoding);
+
+/**
+ * @brief Compresses input with gzip
+ *
+ * @param input
+ * @param output
+ *
+ * @return false if compression failed
+ */
+bool compressGzip(const std::string& input, std::string* output);
 }  // namespace ovms
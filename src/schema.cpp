@@ -53,6 +53,99 @@ const char* MODELS_CONFIG_SCHEMA = R"({
 						"nireq": {
 							"type": "integer"
 						},
+						"pipeline_batching_timeout_ms": {
+							"type": "integer",
+							"minimum": 0
+						},
+						"version_ramp_up_ms": {
+							"type": "integer",
+							"minimum": 0
+						},
+						"results_cache_size": {
+							"type": "integer",
+							"minimum": 0
+						},
+						"replicas": {
+							"type": "integer",
+							"minimum": 1
+						},
+						"cpu_weight": {
+							"type": "integer",
+							"minimum": 1
+						},
+						"profiling": {
+							"type": "boolean"
+						},
+						"sparse_inputs": {
+							"type": "array",
+							"items": {
+								"type": "string"
+							}
+						},
+						"stateful": {
+							"type": "boolean"
+						},
+						"max_sequence_number": {
+							"type": "integer",
+							"minimum": 1
+						},
+						"sequence_timeout_seconds": {
+							"type": "integer",
+							"minimum": 0
+						},
+						"shape_buckets": {
+							"type": "object",
+							"additionalProperties": {
+								"type": "array",
+								"minItems": 1,
+								"items": {
+									"type": "integer",
+									"minimum": 1
+								}
+							}
+						},
+						"bucket_padding": {
+							"type": "string",
+							"enum": ["pad", "letterbox"]
+						},
+						"bucket_fill_value": {
+							"type": "number"
+						},
+						"stream_scheduling": {
+							"type": "object",
+							"properties": {
+								"policy": {
+									"type": "string",
+									"enum": ["fifo", "weighted_fair", "deadline"]
+								},
+								"predict_weight": {
+									"type": "integer",
+									"minimum": 1
+								},
+								"pipeline_weight": {
+									"type": "integer",
+									"minimum": 1
+								},
+								"predict_latency_target_ms": {
+									"type": "integer",
+									"minimum": 0
+								},
+								"pipeline_latency_target_ms": {
+									"type": "integer",
+									"minimum": 0
+								},
+								"reserved_streams_ratio": {
+									"type": "number",
+									"minimum": 0,
+									"maximum": 1
+								},
+								"reserved_streams_borrow_after_ms": {
+									"type": "integer",
+									"minimum": 0
+								}
+							},
+							"additionalProperties": false
+						},
 						"target_device": {
 							"type": "string"
 						},
@@ -99,6 +192,19 @@ const char* MODELS_CONFIG_SCHEMA = R"({
 			},
 			"additionalProperties": false
 		},
+		"node_gate": {
+			"type": "object",
+			"required": ["data_item"],
+			"properties": {
+				"data_item": {
+					"type": "string"
+				},
+				"threshold": {
+					"type": "number"
+				}
+			},
+			"additionalProperties": false
+		},
 		"node_config": {
 			"type": "object",
 			"required": ["name", "model_name", "inputs", "outputs"],
@@ -128,6 +234,9 @@ const char* MODELS_CONFIG_SCHEMA = R"({
 					"items": {
 						"$ref": "#/definitions/output_alias"
 					}
+				},
+				"gate": {
+					"$ref": "#/definitions/node_gate"
 				}
 			},
 			"additionalProperties": false
@@ -156,6 +265,10 @@ const char* MODELS_CONFIG_SCHEMA = R"({
 					"items": {
 						"$ref": "#/definitions/source_node"
 					}
+				},
+				"priority": {
+					"type": "string",
+					"enum": ["normal", "high"]
 				}
 			},
 			"additionalProperties": false
@@ -0,0 +1,255 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "sequence_manager.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+#include <spdlog/spdlog.h>
+
+#include "ov_utils.hpp"
+
+namespace ovms {
+
+template <typename T, typename R>
+static bool readScalar(const tensorflow::TensorProto& proto, const R& values, uint64_t& value) {
+    T scalar;
+    if (values.size() == 1) {
+        scalar = values.Get(0);
+    } else if (values.size() == 0 && proto.tensor_content().size() == sizeof(T)) {
+        std::memcpy(&scalar, proto.tensor_content().data(), sizeof(T));
+    } else {
+        return false;
+    }
+    if constexpr (std::is_signed<T>::value) {
+        if (scalar < 0) {
+            return false;
+        }
+    }
+    value = static_cast<uint64_t>(scalar);
+    return true;
+}
+
+/**
+ * Sequence inputs are unsigned, signed integers are accepted too since REST API cannot specify tensor type
+ */
+static bool readUnsignedScalar(const tensorflow::TensorProto& proto, uint64_t& value) {
+    if (proto.tensor_shape().dim_size() != 1 || proto.tensor_shape().dim(0).size() != 1) {
+        return false;
+    }
+    switch (proto.dtype()) {
+    case tensorflow::DataType::DT_UINT64:
+        return readScalar<uint64_t>(proto, proto.uint64_val(), value);
+    case tensorflow::DataType::DT_INT64:
+        return readScalar<int64_t>(proto, proto.int64_val(), value);
+    case tensorflow::DataType::DT_UINT32:
+        return readScalar<uint32_t>(proto, proto.uint32_val(), value);
+    case tensorflow::DataType::DT_INT32:
+        return readScalar<int32_t>(proto, proto.int_val(), value);
+    default:
+        return false;
+    }
+}
+
+Status getSequenceParameters(const tensorflow::serving::PredictRequest& request, uint64_t& sequenceId, uint32_t& sequenceControl) {
+    sequenceId = 0;
+    sequenceControl = SequenceControl::NO_CONTROL;
+    auto it = request.inputs().find(SEQUENCE_ID_INPUT);
+    if (it != request.inputs().end() && !readUnsignedScalar(it->second, sequenceId)) {
+        return StatusCode::INVALID_SEQUENCE_ID;
+    }
+    it = request.inputs().find(SEQUENCE_CONTROL_INPUT);
+    if (it != request.inputs().end()) {
+        uint64_t control;
+        if (!readUnsignedScalar(it->second, control) || control > SequenceControl::SEQUENCE_END) {
+            return StatusCode::INVALID_SEQUENCE_CONTROL_INPUT;
+        }
+        sequenceControl = static_cast<uint32_t>(control);
+    }
+    return StatusCode::OK;
+}
+
+void addSequenceIdToResponse(uint64_t sequenceId, tensorflow::serving::PredictResponse& response) {
+    auto& proto = (*response.mutable_outputs())[SEQUENCE_ID_INPUT];
+    proto.Clear();
+    proto.set_dtype(tensorflow::DataType::DT_UINT64);
+    proto.mutable_tensor_shape()->add_dim()->set_size(1);
+    // Written to tensor_content like other outputs, so that REST serialization can convert it
+    proto.mutable_tensor_content()->assign(reinterpret_cast<const char*>(&sequenceId), sizeof(sequenceId));
+}
+
+Status SequenceManager::acquireSequence(uint64_t& sequenceId, uint32_t sequenceControl, std::shared_ptr<Sequence>& sequence) {
+    std::lock_guard<std::mutex> lock(mtx);
+    removeIdleSequences();
+    if (sequenceControl == SequenceControl::SEQUENCE_START) {
+        if (sequenceId == 0) {
+            do {
+                sequenceId = ++lastGeneratedId;
+            } while (sequenceId == 0 || sequences.count(sequenceId));
+        } else if (sequences.count(sequenceId)) {
+            SPDLOG_DEBUG("Sequence: {} is already started", sequenceId);
+            return StatusCode::SEQUENCE_ALREADY_EXISTS;
+        }
+        if (sequences.size() >= maxSequenceNumber) {
+            SPDLOG_DEBUG("Cannot start sequence: {}, maximum number of sequences: {} reached", sequenceId, maxSequenceNumber);
+            return StatusCode::MAX_SEQUENCE_NUMBER_REACHED;
+        }
+        sequence = std::make_shared<Sequence>(sequenceId);
+        sequences.emplace(sequenceId, sequence);
+        SPDLOG_DEBUG("Started sequence: {}", sequenceId);
+    } else {
+        if (sequenceId == 0) {
+            return StatusCode::SEQUENCE_ID_MISSING;
+        }
+        auto it = sequences.find(sequenceId);
+        if (it == sequences.end()) {
+            SPDLOG_DEBUG("Sequence: {} does not exist", sequenceId);
+            return StatusCode::SEQUENCE_MISSING;
+        }
+        sequence = it->second;
+    }
+    sequence->lastActivity = std::chrono::steady_clock::now();
+    nextIdleCheck = std::min(nextIdleCheck, sequence->lastActivity + timeout);
+    return StatusCode::OK;
+}
+
+int SequenceManager::getPreferredStream(const Sequence& sequence) {
+    std::lock_guard<std::mutex> lock(mtx);
+    return sequence.streamId;
+}
+
+Status SequenceManager::saveStates(Sequence& sequence, InferenceEngine::InferRequest& inferRequest) {
+    sequence.savedStates.clear();
+    for (auto& state : inferRequest.QueryState()) {
+        auto blob = state.GetState();
+        if (blob == nullptr) {
+            return StatusCode::SEQUENCE_STATE_ERROR;
+        }
+        auto copy = blobClone(std::const_pointer_cast<InferenceEngine::Blob>(blob));
+        if (copy == nullptr) {
+            return StatusCode::SEQUENCE_STATE_ERROR;
+        }
+        sequence.savedStates.emplace(state.GetName(), std::move(copy));
+    }
+    return StatusCode::OK;
+}
+
+Status SequenceManager::bindSequenceState(Sequence& sequence, int streamId, OVInferRequestsQueue& inferRequestsQueue, bool start) {
+    std::lock_guard<std::mutex> lock(mtx);
+    if (sequence.removed) {
+        SPDLOG_DEBUG("Sequence: {} was removed while waiting for execution", sequence.id);
+        return StatusCode::SEQUENCE_MISSING;
+    }
+    auto& inferRequest = inferRequestsQueue.getInferRequest(streamId);
+    try {
+        // Save states of sequence which used this stream before
+        const uint64_t owner = streamOwners[streamId];
+        if (owner != 0 && owner != sequence.id) {
+            auto it = sequences.find(owner);
+            if (it != sequences.end()) {
+                auto status = saveStates(*it->second, inferRequest);
+                if (!status.ok()) {
+                    SPDLOG_ERROR("Could not save memory states of sequence: {}", owner);
+                    return status;
+                }
+                it->second->streamId = -1;
+            }
+            streamOwners[streamId] = 0;
+        }
+        // Take states of this sequence from stream which executed its previous request
+        if (sequence.streamId >= 0 && sequence.streamId != streamId) {
+            auto status = saveStates(sequence, inferRequestsQueue.getInferRequest(sequence.streamId));
+            if (!status.ok()) {
+                SPDLOG_ERROR("Could not save memory states of sequence: {}", sequence.id);
+                return status;
+            }
+            streamOwners[sequence.streamId] = 0;
+            sequence.streamId = -1;
+        }
+        if (start || sequence.streamId != streamId) {
+            for (auto& state : inferRequest.QueryState()) {
+                auto it = sequence.savedStates.find(state.GetName());
+                if (start || it == sequence.savedStates.end()) {
+                    state.Reset();
+                } else {
+                    state.SetState(it->second);
+                }
+            }
+        }
+    } catch (const InferenceEngine::details::InferenceEngineException& e) {
+        SPDLOG_ERROR("Exception occurred when binding memory states of sequence: {}; {}", sequence.id, e.what());
+        return StatusCode::SEQUENCE_STATE_ERROR;
+    }
+    sequence.savedStates.clear();
+    sequence.streamId = streamId;
+    streamOwners[streamId] = sequence.id;
+    return StatusCode::OK;
+}
+
+void SequenceManager::releaseStream(Sequence& sequence) {
+    if (sequence.streamId >= 0 && streamOwners[sequence.streamId] == sequence.id) {
+        streamOwners[sequence.streamId] = 0;
+    }
+    sequence.streamId = -1;
+    sequence.savedStates.clear();
+}
+
+void SequenceManager::removeSequence(uint64_t sequenceId) {
+    std::lock_guard<std::mutex> lock(mtx);
+    auto it = sequences.find(sequenceId);
+    if (it == sequences.end()) {
+        return;
+    }
+    releaseStream(*it->second);
+    it->second->removed = true;
+    sequences.erase(it);
+    SPDLOG_DEBUG("Ended sequence: {}", sequenceId);
+}
+
+void SequenceManager::removeIdleSequences() {
+    if (timeout.count() == 0) {
+        return;
+    }
+    const auto now = std::chrono::steady_clock::now();
+    if (now < nextIdleCheck) {
+        return;
+    }
+    nextIdleCheck = std::chrono::steady_clock::time_point::max();
+    for (auto it = sequences.begin(); it != sequences.end();) {
+        auto& sequence = *it->second;
+        if (now - sequence.lastActivity <= timeout) {
+            nextIdleCheck = std::min(nextIdleCheck, sequence.lastActivity + timeout);
+            ++it;
+            continue;
+        }
+        // Sequence which request is being processed is not idle
+        std::unique_lock<std::mutex> processingLock(sequence.processingMtx, std::try_to_lock);
+        if (!processingLock.owns_lock()) {
+            nextIdleCheck = now;
+            ++it;
+            continue;
+        }
+        SPDLOG_DEBUG("Removing sequence: {} idle for more than {} ms", sequence.id, timeout.count());
+        releaseStream(sequence);
+        sequence.removed = true;
+        processingLock.unlock();
+        it = sequences.erase(it);
+    }
+}
+
+}  // namespace ovms
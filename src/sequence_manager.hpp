@@ -0,0 +1,189 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <inference_engine.hpp>
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wall"
+#include "tensorflow_serving/apis/prediction_service.grpc.pb.h"
+#pragma GCC diagnostic pop
+
+#include "ovinferrequestsqueue.hpp"
+#include "status.hpp"
+
+namespace ovms {
+
+const std::string SEQUENCE_ID_INPUT = "sequence_id";
+const std::string SEQUENCE_CONTROL_INPUT = "sequence_control_input";
+
+enum SequenceControl : uint32_t {
+    NO_CONTROL = 0,
+    SEQUENCE_START = 1,
+    SEQUENCE_END = 2
+};
+
+/**
+ * @brief Reads sequence id and control from special request inputs. Missing inputs are returned as 0.
+ */
+Status getSequenceParameters(const tensorflow::serving::PredictRequest& request, uint64_t& sequenceId, uint32_t& sequenceControl);
+
+/**
+ * @brief Adds sequence id output to the response
+ */
+void addSequenceIdToResponse(uint64_t sequenceId, tensorflow::serving::PredictResponse& response);
+
+/**
+ * @brief Memory states of stateful model kept between requests of a single client sequence.
+ * Requests of the same sequence are processed one at a time.
+ */
+class Sequence {
+public:
+    Sequence(uint64_t id) :
+        id(id) {}
+
+    uint64_t getId() const {
+        return id;
+    }
+
+    /**
+     * @brief Held during processing of the sequence request
+     */
+    std::mutex& getMutex() {
+        return processingMtx;
+    }
+
+private:
+    friend class SequenceManager;
+
+    const uint64_t id;
+
+    std::mutex processingMtx;
+
+    /**
+     * @brief Stream which infer request holds current memory states, -1 if states are saved in sequence
+     */
+    int streamId = -1;
+
+    /**
+     * @brief Copies of memory states made when stream was taken by other sequence
+     */
+    std::unordered_map<std::string, InferenceEngine::Blob::Ptr> savedStates;
+
+    std::chrono::steady_clock::time_point lastActivity;
+
+    bool removed = false;
+};
+
+/**
+ * @brief Sequences of stateful model instance.
+ * Memory states stay in infer request of the stream which executed last request of the sequence.
+ * Next request prefers the same stream, states are copied only when the sequence moves to another stream
+ * or its stream is taken by other sequence.
+ */
+class SequenceManager {
+public:
+    SequenceManager(size_t maxSequenceNumber, std::chrono::milliseconds timeout, size_t streamsCount) :
+        maxSequenceNumber(maxSequenceNumber),
+        timeout(timeout),
+        streamOwners(streamsCount, 0) {}
+
+    /**
+     * @brief Gets existing sequence or creates new one when request starts the sequence
+     *
+     * @param sequenceId requested id, when 0 is used to start the sequence it is replaced by generated id
+     */
+    Status acquireSequence(uint64_t& sequenceId, uint32_t sequenceControl, std::shared_ptr<Sequence>& sequence);
+
+    /**
+     * @brief Stream holding memory states of the sequence or -1
+     */
+    int getPreferredStream(const Sequence& sequence);
+
+    /**
+     * @brief Moves memory states of the sequence into infer request of the stream. Has to be called with sequence mutex held.
+     *
+     * @param start resets memory states to initial values
+     */
+    Status bindSequenceState(Sequence& sequence, int streamId, OVInferRequestsQueue& inferRequestsQueue, bool start);
+
+    void removeSequence(uint64_t sequenceId);
+
+    size_t getSequencesCount() {
+        std::lock_guard<std::mutex> lock(mtx);
+        return sequences.size();
+    }
+
+private:
+    /**
+     * @brief Removes sequences idle for longer than timeout which are not being processed.
+     * Sequences are scanned only when the earliest of them could have become idle.
+     */
+    void removeIdleSequences();
+
+    void releaseStream(Sequence& sequence);
+
+    static Status saveStates(Sequence& sequence, InferenceEngine::InferRequest& inferRequest);
+
+    const size_t maxSequenceNumber;
+    const std::chrono::milliseconds timeout;
+
+    std::mutex mtx;
+    std::map<uint64_t, std::shared_ptr<Sequence>> sequences;
+
+    /**
+     * @brief Id of sequence which memory states are held by each stream, 0 if none
+     */
+    std::vector<uint64_t> streamOwners;
+
+    uint64_t lastGeneratedId = 0;
+
+    /**
+     * @brief Time when the least recently used sequence exceeds timeout, last activity of sequences only moves forward
+     */
+    std::chrono::steady_clock::time_point nextIdleCheck;
+};
+
+/**
+ * @brief Removes sequence when request ending it finishes, also when processing of the request failed
+ */
+class SequenceEndGuard {
+public:
+    SequenceEndGuard(SequenceManager* sequenceManager, uint64_t sequenceId, uint32_t sequenceControl) :
+        sequenceManager(sequenceControl == SequenceControl::SEQUENCE_END ? sequenceManager : nullptr),
+        sequenceId(sequenceId) {}
+
+    ~SequenceEndGuard() {
+        if (sequenceManager != nullptr) {
+            sequenceManager->removeSequence(sequenceId);
+        }
+    }
+
+private:
+    SequenceManager* const sequenceManager;
+    const uint64_t sequenceId;
+};
+
+}  // namespace ovms
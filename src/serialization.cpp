@@ -15,6 +15,8 @@
 //*****************************************************************************
 #include "serialization.hpp"
 
+#include "execution_plan.hpp"
+
 namespace ovms {
 
 Status serializeBlobToTensorProto(
@@ -22,46 +24,13 @@ Status serializeBlobToTensorProto(
     const std::shared_ptr<TensorInfo>& networkOutput,
     InferenceEngine::Blob::Ptr blob) {
     responseOutput.Clear();
-    switch (networkOutput->getPrecision()) {
-    case InferenceEngine::Precision::FP32:
-        responseOutput.set_dtype(tensorflow::DataTypeToEnum<float>::value);
-        break;
-    case InferenceEngine::Precision::I32:
-        responseOutput.set_dtype(tensorflow::DataTypeToEnum<int>::value);
-        break;
-    case InferenceEngine::Precision::I16:
-        responseOutput.set_dtype(tensorflow::DataTypeToEnum<int16_t>::value);
-        break;
-    case InferenceEngine::Precision::U8:
-        responseOutput.set_dtype(tensorflow::DataTypeToEnum<uint8_t>::value);
-        break;
-    case InferenceEngine::Precision::I8:
-        responseOutput.set_dtype(tensorflow::DataTypeToEnum<int8_t>::value);
-        break;
-
-    // 2 byte padding [v1, v0, 0, 0, u1, u0, 0, 0, ...]
-    case InferenceEngine::Precision::U16:
-        responseOutput.set_dtype(tensorflow::DataTypeToEnum<uint32_t>::value);
-        break;
-    case InferenceEngine::Precision::FP16:
-        responseOutput.set_dtype(tensorflow::DataTypeToEnum<float>::value);
-        break;
-
-    case InferenceEngine::Precision::I64:
-        responseOutput.set_dtype(tensorflow::DataTypeToEnum<int32_t>::value);
-        break;
-
-    case InferenceEngine::Precision::Q78:
-    case InferenceEngine::Precision::BIN:
-    case InferenceEngine::Precision::BOOL:
-    case InferenceEngine::Precision::MIXED:
-    case InferenceEngine::Precision::CUSTOM:
-    default: {
+    tensorflow::DataType dtype;
+    if (!getOutputDataType(networkOutput->getPrecision(), dtype)) {
         Status status = StatusCode::OV_UNSUPPORTED_SERIALIZATION_PRECISION;
         SPDLOG_ERROR(status.string());
         return status;
     }
-    }
+    responseOutput.set_dtype(dtype);
     responseOutput.mutable_tensor_shape()->Clear();
     for (auto dim : networkOutput->getShape()) {
         responseOutput.mutable_tensor_shape()->add_dim()->set_size(dim);
@@ -33,11 +33,16 @@
 #include <sys/socket.h>
 #include <unistd.h>
 
+#include "compilation_workers.hpp"
 #include "config.hpp"
+#include "core_partitioning.hpp"
+#include "cpu_profiler.hpp"
 #include "http_server.hpp"
 #include "model_service.hpp"
 #include "modelmanager.hpp"
+#include "pipeline_streaming_service.hpp"
 #include "prediction_service.hpp"
+#include "shared_networks.hpp"
 #include "stringutils.hpp"
 
 using grpc::Server;
@@ -180,7 +185,8 @@ void installSignalHandlers() {
 
 std::vector<std::unique_ptr<Server>> startGRPCServer(
     PredictionServiceImpl& predict_service,
-    ModelServiceImpl& model_service) {
+    ModelServiceImpl& model_service,
+    PipelineStreamingServiceImpl& pipeline_streaming_service) {
     const int GIGABYTE = 1024 * 1024 * 1024;
 
     std::vector<GrpcChannelArgument> channel_arguments;
@@ -192,12 +198,29 @@ std::vector<std::unique_ptr<Server>> startGRPCServer(
     }
 
     logConfig(config);
+    auto& corePartitioning = CorePartitioning::instance();
+    status = corePartitioning.configure(config.corePartitioning());
+    if (!status.ok()) {
+        spdlog::error("core partitioning passed in wrong format: {}", config.corePartitioning());
+        exit(1);
+    }
+    CpuProfiler::instance().setEnabled(config.cpuProfiler());
+    SharedNetworks::instance().setEnabled(config.shareIdenticalModels());
+    status = CompilationWorkers::instance().configure(config.maxConcurrentCompilations(), config.compilationCores(),
+        config.compilationNice(), corePartitioning.getCores(ThreadRole::INFERENCE));
+    if (!status.ok()) {
+        spdlog::error("model compilation workers cannot be started: {}", status.string());
+        exit(1);
+    }
+    // Threads created while loading models inherit inference cores affinity
+    corePartitioning.applyToCurrentThread(ThreadRole::INFERENCE);
     auto& manager = ModelManager::getInstance();
     status = manager.start();
     if (!status.ok()) {
         spdlog::error("ovms::ModelManager::Start() Error: {}", status.string());
         exit(1);
     }
+    corePartitioning.applyToCurrentThread(ThreadRole::IO);
 
     ServerBuilder builder;
     builder.SetMaxReceiveMessageSize(GIGABYTE);
@@ -205,6 +228,7 @@ std::vector<std::unique_ptr<Server>> startGRPCServer(
     builder.AddListeningPort("0.0.0.0:" + std::to_string(config.port()), grpc::InsecureServerCredentials());
     builder.RegisterService(&predict_service);
     builder.RegisterService(&model_service);
+    builder.RegisterService(&pipeline_streaming_service);
     for (const GrpcChannelArgument& channel_argument : channel_arguments) {
         // gRPC accept arguments of two types, int and string. We will attempt to
         // parse each arg as int and pass it on as such if successful. Otherwise we
@@ -250,7 +274,7 @@ std::unique_ptr<ovms::http_server> startRESTServer() {
         int workers = config.restWorkers() ? config.restWorkers() : 10;
         spdlog::info("Will start {} REST workers", workers);
 
-        std::unique_ptr<ovms::http_server> restServer = ovms::createAndStartHttpServer(config.restPort(), workers, REST_TIMEOUT);
+        std::unique_ptr<ovms::http_server> restServer = ovms::createAndStartHttpServer(config.restPort(), workers, REST_TIMEOUT, config.restCompressionThreshold());
         if (restServer != nullptr) {
             spdlog::info("Started REST server at {}", server_address);
         } else {
@@ -271,8 +295,9 @@ int server_main(int argc, char** argv) {
 
         PredictionServiceImpl predict_service;
         ModelServiceImpl model_service;
+        PipelineStreamingServiceImpl pipeline_streaming_service;
 
-        auto grpc = startGRPCServer(predict_service, model_service);
+        auto grpc = startGRPCServer(predict_service, model_service, pipeline_streaming_service);
         auto rest = startRESTServer();
 
         while (!shutdown_request) {
@@ -291,6 +316,7 @@ int server_main(int argc, char** argv) {
         }
 
         ModelManager::getInstance().join();
+        CompilationWorkers::instance().stop();
     } catch (std::exception& e) {
         SPDLOG_ERROR("Exception catch: {} - will now terminate.", e.what());
         return EXIT_FAILURE;
@@ -0,0 +1,206 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "shape_buckets.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <sstream>
+
+#include <precision_utils.h>
+#include <spdlog/spdlog.h>
+
+namespace ovms {
+
+const std::string BUCKET_PADDING_OUTPUT_SUFFIX = "/padding";
+
+BucketPaddingMode getBucketPaddingModeFromString(const std::string& mode) {
+    if (mode == "letterbox") {
+        return BucketPaddingMode::LETTERBOX;
+    }
+    return BucketPaddingMode::PAD;
+}
+
+bool getSpatialDimensions(size_t rank, InferenceEngine::Layout layout, size_t& heightIndex, size_t& widthIndex) {
+    if (rank != 4) {
+        return false;
+    }
+    switch (layout) {
+    case InferenceEngine::Layout::NCHW:
+        heightIndex = 2;
+        widthIndex = 3;
+        return true;
+    case InferenceEngine::Layout::NHWC:
+        heightIndex = 1;
+        widthIndex = 2;
+        return true;
+    default:
+        return false;
+    }
+}
+
+bool fitsInShapeWithPadding(const shape_t& shape, InferenceEngine::Layout layout, const tensorflow::TensorShapeProto& requestShape) {
+    size_t heightIndex, widthIndex;
+    if (shape.size() != static_cast<size_t>(requestShape.dim_size()) ||
+        !getSpatialDimensions(shape.size(), layout, heightIndex, widthIndex)) {
+        return false;
+    }
+    for (size_t i = 0; i < shape.size(); i++) {
+        auto dim = requestShape.dim(i).size();
+        if (dim <= 0) {
+            return false;
+        }
+        if (i == heightIndex || i == widthIndex) {
+            if (static_cast<size_t>(dim) > shape[i]) {
+                return false;
+            }
+        } else if (static_cast<size_t>(dim) != shape[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+Status getBucketShape(const std::vector<size_t>& buckets, InferenceEngine::Layout layout,
+    const tensorflow::TensorShapeProto& requestShape, shape_t& bucketShape) {
+    size_t heightIndex, widthIndex;
+    if (!getSpatialDimensions(requestShape.dim_size(), layout, heightIndex, widthIndex)) {
+        return Status(StatusCode::INVALID_NO_OF_SHAPE_DIMENSIONS, "Shape buckets require 4 dimensional NCHW or NHWC input");
+    }
+    bucketShape.clear();
+    for (int i = 0; i < requestShape.dim_size(); i++) {
+        bucketShape.push_back(requestShape.dim(i).size());
+    }
+    for (auto index : {heightIndex, widthIndex}) {
+        size_t fitting = std::numeric_limits<size_t>::max();
+        for (auto bucket : buckets) {
+            if (bucket >= bucketShape[index] && bucket < fitting) {
+                fitting = bucket;
+            }
+        }
+        if (fitting == std::numeric_limits<size_t>::max()) {
+            std::stringstream ss;
+            ss << "Request shape: " << TensorInfo::tensorShapeToString(requestShape) << " exceeds the largest shape bucket";
+            return Status(StatusCode::INVALID_SHAPE, ss.str());
+        }
+        bucketShape[index] = fitting;
+    }
+    return StatusCode::OK;
+}
+
+BucketPadding getBucketPadding(const shape_t& shape, InferenceEngine::Layout layout,
+    const tensorflow::TensorShapeProto& requestShape, BucketPaddingMode mode) {
+    BucketPadding padding;
+    size_t heightIndex, widthIndex;
+    if (!getSpatialDimensions(shape.size(), layout, heightIndex, widthIndex)) {
+        return padding;
+    }
+    const size_t verticalPadding = shape[heightIndex] - requestShape.dim(heightIndex).size();
+    const size_t horizontalPadding = shape[widthIndex] - requestShape.dim(widthIndex).size();
+    if (mode == BucketPaddingMode::LETTERBOX) {
+        padding.top = verticalPadding / 2;
+        padding.left = horizontalPadding / 2;
+    }
+    padding.bottom = verticalPadding - padding.top;
+    padding.right = horizontalPadding - padding.left;
+    return padding;
+}
+
+namespace {
+
+template <typename T>
+InferenceEngine::Blob::Ptr padRows(const InferenceEngine::Blob::Ptr& source, const InferenceEngine::TensorDesc& desc,
+    size_t heightIndex, const BucketPadding& padding, T fill) {
+    const auto& sourceDims = source->getTensorDesc().getDims();
+    const auto& dims = desc.getDims();
+    const size_t widthIndex = heightIndex + 1;
+    size_t outer = 1;
+    for (size_t i = 0; i < heightIndex; i++) {
+        outer *= sourceDims[i];
+    }
+    size_t inner = 1;
+    for (size_t i = widthIndex + 1; i < dims.size(); i++) {
+        inner *= dims[i];
+    }
+    auto blob = InferenceEngine::make_shared_blob<T>(desc);
+    blob->allocate();
+    T* destination = blob->buffer().template as<T*>();
+    const T* data = source->buffer().template as<const T*>();
+    std::fill(destination, destination + blob->size(), fill);
+    const size_t rowSize = sourceDims[widthIndex] * inner;
+    for (size_t o = 0; o < outer; o++) {
+        for (size_t row = 0; row < sourceDims[heightIndex]; row++) {
+            const size_t offset = ((o * dims[heightIndex] + row + padding.top) * dims[widthIndex] + padding.left) * inner;
+            std::memcpy(destination + offset, data + (o * sourceDims[heightIndex] + row) * rowSize, rowSize * sizeof(T));
+        }
+    }
+    return blob;
+}
+
+}  // namespace
+
+Status padBlob(const InferenceEngine::Blob::Ptr& source, const InferenceEngine::TensorDesc& desc,
+    const BucketPadding& padding, double fillValue, InferenceEngine::Blob::Ptr& padded) {
+    size_t heightIndex, widthIndex;
+    if (!getSpatialDimensions(desc.getDims().size(), desc.getLayout(), heightIndex, widthIndex)) {
+        return Status(StatusCode::INVALID_NO_OF_SHAPE_DIMENSIONS, "Shape buckets require 4 dimensional NCHW or NHWC input");
+    }
+    switch (desc.getPrecision()) {
+    case InferenceEngine::Precision::FP32:
+        padded = padRows<float>(source, desc, heightIndex, padding, static_cast<float>(fillValue));
+        break;
+    case InferenceEngine::Precision::FP16:
+        padded = padRows<uint16_t>(source, desc, heightIndex, padding,
+            static_cast<uint16_t>(InferenceEngine::PrecisionUtils::f32tof16(static_cast<float>(fillValue))));
+        break;
+    case InferenceEngine::Precision::U8:
+        padded = padRows<uint8_t>(source, desc, heightIndex, padding, static_cast<uint8_t>(fillValue));
+        break;
+    case InferenceEngine::Precision::I8:
+        padded = padRows<int8_t>(source, desc, heightIndex, padding, static_cast<int8_t>(fillValue));
+        break;
+    case InferenceEngine::Precision::U16:
+        padded = padRows<uint16_t>(source, desc, heightIndex, padding, static_cast<uint16_t>(fillValue));
+        break;
+    case InferenceEngine::Precision::I16:
+        padded = padRows<int16_t>(source, desc, heightIndex, padding, static_cast<int16_t>(fillValue));
+        break;
+    case InferenceEngine::Precision::I32:
+        padded = padRows<int32_t>(source, desc, heightIndex, padding, static_cast<int32_t>(fillValue));
+        break;
+    default:
+        return StatusCode::OV_UNSUPPORTED_DESERIALIZATION_PRECISION;
+    }
+    return StatusCode::OK;
+}
+
+void addBucketPaddingToResponse(const std::string& inputName, const BucketPadding& padding, size_t batchSize, tensorflow::serving::PredictResponse& response) {
+    auto& proto = (*response.mutable_outputs())[inputName + BUCKET_PADDING_OUTPUT_SUFFIX];
+    proto.Clear();
+    proto.set_dtype(tensorflow::DataType::DT_INT32);
+    proto.mutable_tensor_shape()->add_dim()->set_size(batchSize);
+    proto.mutable_tensor_shape()->add_dim()->set_size(4);
+    // Written to tensor_content like other outputs, so that REST serialization can convert it
+    const int32_t values[] = {static_cast<int32_t>(padding.top), static_cast<int32_t>(padding.left),
+        static_cast<int32_t>(padding.bottom), static_cast<int32_t>(padding.right)};
+    auto& content = *proto.mutable_tensor_content();
+    content.reserve(batchSize * sizeof(values));
+    for (size_t i = 0; i < batchSize; i++) {
+        content.append(reinterpret_cast<const char*>(values), sizeof(values));
+    }
+}
+
+}  // namespace ovms
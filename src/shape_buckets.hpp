@@ -0,0 +1,94 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <inference_engine.hpp>
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wall"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow_serving/apis/prediction_service.grpc.pb.h"
+#pragma GCC diagnostic pop
+
+#include "status.hpp"
+#include "tensorinfo.hpp"
+
+namespace ovms {
+
+/**
+ * @brief Suffix of response output with padding applied to bucketed input
+ */
+extern const std::string BUCKET_PADDING_OUTPUT_SUFFIX;
+
+enum class BucketPaddingMode {
+    PAD,
+    LETTERBOX
+};
+
+/**
+ * @brief Converts bucket_padding config value, pad places data in top left corner and letterbox centers it
+ */
+BucketPaddingMode getBucketPaddingModeFromString(const std::string& mode);
+
+/**
+ * @brief Number of fill rows and columns around request data placed in larger shape
+ */
+struct BucketPadding {
+    size_t top = 0;
+    size_t left = 0;
+    size_t bottom = 0;
+    size_t right = 0;
+};
+
+/**
+ * @brief Gets indexes of height and width dimensions of 4D NCHW or NHWC shape
+ *
+ * @return false if shape has no spatial dimensions
+ */
+bool getSpatialDimensions(size_t rank, InferenceEngine::Layout layout, size_t& heightIndex, size_t& widthIndex);
+
+/**
+ * @brief Checks if request tensor can be padded to shape,
+ * request must not exceed shape in spatial dimensions and match it in other dimensions
+ */
+bool fitsInShapeWithPadding(const shape_t& shape, InferenceEngine::Layout layout, const tensorflow::TensorShapeProto& requestShape);
+
+/**
+ * @brief Replaces request spatial dimensions with smallest fitting buckets
+ */
+Status getBucketShape(const std::vector<size_t>& buckets, InferenceEngine::Layout layout,
+    const tensorflow::TensorShapeProto& requestShape, shape_t& bucketShape);
+
+BucketPadding getBucketPadding(const shape_t& shape, InferenceEngine::Layout layout,
+    const tensorflow::TensorShapeProto& requestShape, BucketPaddingMode mode);
+
+/**
+ * @brief Copies request data into new blob described by desc, filling remaining elements with fillValue
+ *
+ * @param source blob with request data in network precision and layout
+ */
+Status padBlob(const InferenceEngine::Blob::Ptr& source, const InferenceEngine::TensorDesc& desc,
+    const BucketPadding& padding, double fillValue, InferenceEngine::Blob::Ptr& padded);
+
+/**
+ * @brief Adds <input>/padding output with [top, left, bottom, right] padding repeated for each sample of the batch
+ */
+void addBucketPaddingToResponse(const std::string& inputName, const BucketPadding& padding, size_t batchSize, tensorflow::serving::PredictResponse& response);
+
+}  // namespace ovms
@@ -0,0 +1,128 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "shared_networks.hpp"
+
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+#include <openssl/evp.h>
+#include <spdlog/spdlog.h>
+#include <sys/stat.h>
+
+namespace ovms {
+
+namespace {
+const size_t HASH_READ_SIZE = 4 * 1024 * 1024;
+
+bool hashFile(EVP_MD_CTX* context, const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+    std::vector<char> buffer(HASH_READ_SIZE);
+    while (file) {
+        file.read(buffer.data(), buffer.size());
+        if (file.gcount() > 0 && EVP_DigestUpdate(context, buffer.data(), file.gcount()) != 1) {
+            return false;
+        }
+    }
+    return file.eof();
+}
+
+std::string toHex(const unsigned char* data, unsigned int size) {
+    std::stringstream ss;
+    ss << std::hex << std::setfill('0');
+    for (unsigned int i = 0; i < size; i++) {
+        ss << std::setw(2) << static_cast<int>(data[i]);
+    }
+    return ss.str();
+}
+}  // namespace
+
+Status SharedNetworks::hashFiles(const std::vector<std::string>& files, std::string& hash) {
+    std::string combined;
+    for (const auto& file : files) {
+        struct stat fileStat;
+        if (stat(file.c_str(), &fileStat) != 0) {
+            SPDLOG_ERROR("Failed to get status of model file: {}", file);
+            return StatusCode::FILE_INVALID;
+        }
+        const int64_t modificationTime = fileStat.st_mtim.tv_sec * 1000000000LL + fileStat.st_mtim.tv_nsec;
+        {
+            std::lock_guard<std::mutex> lock(hashesMtx);
+            auto it = fileHashes.find(file);
+            if (it != fileHashes.end() && it->second.size == fileStat.st_size && it->second.modificationTime == modificationTime) {
+                combined += it->second.hash;
+                continue;
+            }
+        }
+        std::unique_ptr<EVP_MD_CTX, decltype(&EVP_MD_CTX_free)> context(EVP_MD_CTX_new(), EVP_MD_CTX_free);
+        unsigned char digest[EVP_MAX_MD_SIZE];
+        unsigned int digestSize = 0;
+        if (!context ||
+            EVP_DigestInit_ex(context.get(), EVP_sha256(), nullptr) != 1 ||
+            !hashFile(context.get(), file) ||
+            EVP_DigestFinal_ex(context.get(), digest, &digestSize) != 1) {
+            SPDLOG_ERROR("Failed to calculate hash of model file: {}", file);
+            return StatusCode::FILE_INVALID;
+        }
+        std::string fileHash = toHex(digest, digestSize);
+        SPDLOG_DEBUG("Model file: {} SHA-256: {}", file, fileHash);
+        combined += fileHash;
+        std::lock_guard<std::mutex> lock(hashesMtx);
+        fileHashes[file] = {fileStat.st_size, modificationTime, fileHash};
+    }
+    hash = std::move(combined);
+    return StatusCode::OK;
+}
+
+std::shared_ptr<SharedNetwork> SharedNetworks::find(const std::string& key) {
+    std::lock_guard<std::mutex> lock(mtx);
+    auto it = networks.find(key);
+    if (it == networks.end()) {
+        return nullptr;
+    }
+    auto network = it->second.lock();
+    if (!network) {
+        networks.erase(it);
+    }
+    return network;
+}
+
+bool SharedNetworks::add(const std::string& key, const std::shared_ptr<SharedNetwork>& network) {
+    std::lock_guard<std::mutex> lock(mtx);
+    auto& entry = networks[key];
+    if (!entry.expired()) {
+        return false;
+    }
+    entry = network;
+    return true;
+}
+
+size_t SharedNetworks::getNetworksCount() {
+    std::lock_guard<std::mutex> lock(mtx);
+    for (auto it = networks.begin(); it != networks.end();) {
+        if (it->second.expired()) {
+            it = networks.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    return networks.size();
+}
+
+}  // namespace ovms
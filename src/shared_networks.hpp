@@ -0,0 +1,115 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <inference_engine.hpp>
+
+#include "model_file_reader.hpp"
+#include "model_package.hpp"
+#include "ovinferrequestsqueue.hpp"
+#include "status.hpp"
+
+namespace ovms {
+
+/**
+ * @brief Executable network replicas and infer requests backing all model versions with identical files and load settings
+ */
+struct SharedNetwork {
+    /**
+     * @brief Name and version of model which compiled the network, used in logs
+     */
+    std::string owner;
+    std::vector<std::shared_ptr<InferenceEngine::ExecutableNetwork>> execNetworkReplicas;
+    std::shared_ptr<OVInferRequestsQueue> inferRequestsQueue;
+    /**
+     * @brief Network and memory holding its weights, compiled networks may still use them so they live as long as the last user
+     */
+    std::shared_ptr<InferenceEngine::CNNNetwork> network;
+    std::shared_ptr<ModelFileBuffer> weightsBuffer;
+    std::shared_ptr<ModelPackage> modelPackage;
+};
+
+/**
+ * @brief Registry of compiled networks shared between model versions, so that byte identical versions and aliases
+ * are compiled once. Model instances hold shared pointers, network is released together with its last user.
+ */
+class SharedNetworks {
+public:
+    static SharedNetworks& instance() {
+        static SharedNetworks instance;
+        return instance;
+    }
+
+    void setEnabled(bool enabled) {
+        this->enabled = enabled;
+    }
+
+    bool isEnabled() const {
+        return enabled;
+    }
+
+    /**
+     * @brief Calculates SHA-256 of model files contents. Hashes are cached until file size or modification time changes.
+     *
+     * @param files model files in order used to read the network
+     * @param hash hex encoded digest
+     *
+     * @return FILE_INVALID if any file could not be read
+     */
+    Status hashFiles(const std::vector<std::string>& files, std::string& hash);
+
+    /**
+     * @brief Finds network compiled for given key
+     *
+     * @return nullptr if there is no network or all its users were unloaded
+     */
+    std::shared_ptr<SharedNetwork> find(const std::string& key);
+
+    /**
+     * @brief Registers network so that next loads with the same key use it
+     *
+     * @return false if network with the same key is still in use, eg. when identical models were compiled concurrently
+     */
+    bool add(const std::string& key, const std::shared_ptr<SharedNetwork>& network);
+
+    /**
+     * @brief Gets number of registered networks still in use
+     */
+    size_t getNetworksCount();
+
+private:
+    SharedNetworks() = default;
+
+    struct FileHash {
+        int64_t size;
+        int64_t modificationTime;
+        std::string hash;
+    };
+
+    bool enabled = false;
+    std::mutex mtx;
+    std::map<std::string, std::weak_ptr<SharedNetwork>> networks;
+    std::mutex hashesMtx;
+    std::map<std::string, FileHash> fileHashes;
+};
+
+}  // namespace ovms
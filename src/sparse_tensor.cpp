@@ -0,0 +1,257 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "sparse_tensor.hpp"
+
+#include <cstring>
+#include <sstream>
+
+#include <spdlog/spdlog.h>
+
+namespace ovms {
+
+static const size_t INDEX_SIZE = sizeof(int64_t);
+
+static int64_t readIndex(const char* indices, size_t position) {
+    int64_t index;
+    // tensor_content is not guaranteed to be aligned
+    std::memcpy(&index, indices + position * INDEX_SIZE, INDEX_SIZE);
+    return index;
+}
+
+static Status sparseIndexOutOfBounds(int64_t index, size_t dimension, size_t size) {
+    std::stringstream ss;
+    ss << "Index: " << index << " in dimension: " << dimension << " of size: " << size;
+    return Status(StatusCode::INVALID_SPARSE_INDEX, ss.str());
+}
+
+SparseFormat getSparseFormat(const tensorflow::serving::PredictRequest& request, const std::string& name) {
+    const auto& inputs = request.inputs();
+    if (inputs.count(name + SPARSE_INDICES_SUFFIX)) {
+        return SparseFormat::COO;
+    }
+    if (inputs.count(name + SPARSE_ROW_PTR_SUFFIX) && inputs.count(name + SPARSE_COL_INDICES_SUFFIX)) {
+        return SparseFormat::CSR;
+    }
+    return SparseFormat::NONE;
+}
+
+static bool isSparsePrecisionSupported(InferenceEngine::Precision precision) {
+    switch (precision) {
+    case InferenceEngine::Precision::FP32:
+    case InferenceEngine::Precision::I32:
+    case InferenceEngine::Precision::I16:
+    case InferenceEngine::Precision::I8:
+    case InferenceEngine::Precision::U8:
+        return true;
+    default:
+        return false;
+    }
+}
+
+static Status validateSparseComponent(const tensorflow::serving::PredictRequest& request, const std::string& name,
+    tensorflow::DataType dataType, const std::vector<size_t>& shape, size_t elementSize) {
+    auto it = request.inputs().find(name);
+    if (it == request.inputs().end()) {
+        return Status(StatusCode::INVALID_MISSING_INPUT, "Required input: " + name);
+    }
+    const auto& tensor = it->second;
+    if (tensor.dtype() != dataType) {
+        std::stringstream ss;
+        ss << name << " expected: " << TensorInfo::getDataTypeAsString(dataType)
+           << "; Actual: " << TensorInfo::getDataTypeAsString(tensor.dtype());
+        return Status(StatusCode::INVALID_PRECISION, ss.str());
+    }
+    bool shapeMatches = tensor.tensor_shape().dim_size() == static_cast<int>(shape.size());
+    for (size_t i = 0; shapeMatches && i < shape.size(); i++) {
+        shapeMatches = tensor.tensor_shape().dim(i).size() == static_cast<int64_t>(shape[i]);
+    }
+    if (!shapeMatches) {
+        std::stringstream ss;
+        ss << name << " expected: " << TensorInfo::shapeToString(shape)
+           << "; Actual: " << TensorInfo::tensorShapeToString(tensor.tensor_shape());
+        return Status(StatusCode::INVALID_SHAPE, ss.str());
+    }
+    size_t expectedSize = elementSize;
+    for (auto dim : shape) {
+        expectedSize *= dim;
+    }
+    if (tensor.tensor_content().size() != expectedSize) {
+        std::stringstream ss;
+        ss << name << " expected: " << expectedSize << " bytes; Actual: " << tensor.tensor_content().size() << " bytes";
+        return Status(StatusCode::INVALID_CONTENT_SIZE, ss.str());
+    }
+    return StatusCode::OK;
+}
+
+Status validateSparseInput(const tensorflow::serving::PredictRequest& request, const TensorInfo& networkInput, size_t& components) {
+    const auto& name = networkInput.getName();
+    auto format = getSparseFormat(request, name);
+    if (format == SparseFormat::NONE) {
+        return Status(StatusCode::INVALID_MISSING_INPUT, "Required input: " + name);
+    }
+    if (!isSparsePrecisionSupported(networkInput.getPrecision())) {
+        return Status(StatusCode::INVALID_PRECISION, "Sparse input precision not supported: " + networkInput.getPrecisionAsString());
+    }
+    auto valuesIt = request.inputs().find(name + SPARSE_VALUES_SUFFIX);
+    if (valuesIt == request.inputs().end() || valuesIt->second.tensor_shape().dim_size() != 1) {
+        return Status(StatusCode::INVALID_MISSING_INPUT, "Required input: " + name + SPARSE_VALUES_SUFFIX + " with shape (nnz)");
+    }
+    const size_t nnz = valuesIt->second.tensor_shape().dim(0).size();
+    auto status = validateSparseComponent(request, name + SPARSE_VALUES_SUFFIX, networkInput.getPrecisionAsDataType(), {nnz}, networkInput.getPrecision().size());
+    if (!status.ok()) {
+        return status;
+    }
+    const auto& shape = networkInput.getShape();
+    if (format == SparseFormat::COO) {
+        components = 2;
+        return validateSparseComponent(request, name + SPARSE_INDICES_SUFFIX, tensorflow::DataType::DT_INT64, {nnz, shape.size()}, INDEX_SIZE);
+    }
+    if (shape.empty()) {
+        return Status(StatusCode::INVALID_NO_OF_SHAPE_DIMENSIONS, "CSR format requires input with at least one dimension");
+    }
+    size_t rows = 1;
+    for (size_t i = 0; i + 1 < shape.size(); i++) {
+        rows *= shape[i];
+    }
+    components = 3;
+    status = validateSparseComponent(request, name + SPARSE_ROW_PTR_SUFFIX, tensorflow::DataType::DT_INT64, {rows + 1}, INDEX_SIZE);
+    if (!status.ok()) {
+        return status;
+    }
+    return validateSparseComponent(request, name + SPARSE_COL_INDICES_SUFFIX, tensorflow::DataType::DT_INT64, {nnz}, INDEX_SIZE);
+}
+
+Status densifyCoo(const char* indices, const char* values, size_t nnz, size_t elementSize,
+    const shape_t& shape, char* destination, std::vector<size_t>& writtenOffsets) {
+    const size_t rank = shape.size();
+    std::vector<size_t> strides(rank, 1);
+    for (size_t i = rank; i > 1; i--) {
+        strides[i - 2] = strides[i - 1] * shape[i - 1];
+    }
+    writtenOffsets.reserve(writtenOffsets.size() + nnz);
+    for (size_t i = 0; i < nnz; i++) {
+        size_t offset = 0;
+        for (size_t dimension = 0; dimension < rank; dimension++) {
+            const int64_t index = readIndex(indices, i * rank + dimension);
+            if (index < 0 || static_cast<size_t>(index) >= shape[dimension]) {
+                return sparseIndexOutOfBounds(index, dimension, shape[dimension]);
+            }
+            offset += index * strides[dimension];
+        }
+        std::memcpy(destination + offset * elementSize, values + i * elementSize, elementSize);
+        writtenOffsets.push_back(offset);
+    }
+    return StatusCode::OK;
+}
+
+Status densifyCsr(const char* rowPtr, const char* colIndices, const char* values, size_t nnz, size_t elementSize,
+    const shape_t& shape, char* destination, std::vector<size_t>& writtenOffsets) {
+    const size_t columns = shape.back();
+    size_t rows = 1;
+    for (size_t i = 0; i + 1 < shape.size(); i++) {
+        rows *= shape[i];
+    }
+    if (readIndex(rowPtr, 0) != 0 || readIndex(rowPtr, rows) != static_cast<int64_t>(nnz)) {
+        return Status(StatusCode::INVALID_SPARSE_INDEX, "Row pointers must start with 0 and end with number of values");
+    }
+    writtenOffsets.reserve(writtenOffsets.size() + nnz);
+    for (size_t row = 0; row < rows; row++) {
+        const int64_t begin = readIndex(rowPtr, row);
+        const int64_t end = readIndex(rowPtr, row + 1);
+        if (begin > end || end > static_cast<int64_t>(nnz)) {
+            return Status(StatusCode::INVALID_SPARSE_INDEX, "Row pointers must be non decreasing");
+        }
+        for (int64_t i = begin; i < end; i++) {
+            const int64_t column = readIndex(colIndices, i);
+            if (column < 0 || static_cast<size_t>(column) >= columns) {
+                return sparseIndexOutOfBounds(column, shape.size() - 1, columns);
+            }
+            const size_t offset = row * columns + column;
+            std::memcpy(destination + offset * elementSize, values + i * elementSize, elementSize);
+            writtenOffsets.push_back(offset);
+        }
+    }
+    return StatusCode::OK;
+}
+
+static InferenceEngine::Blob::Ptr allocateBlob(const InferenceEngine::TensorDesc& desc) {
+    InferenceEngine::Blob::Ptr blob;
+    switch (desc.getPrecision()) {
+    case InferenceEngine::Precision::FP32:
+        blob = InferenceEngine::make_shared_blob<float>(desc);
+        break;
+    case InferenceEngine::Precision::I32:
+        blob = InferenceEngine::make_shared_blob<int32_t>(desc);
+        break;
+    case InferenceEngine::Precision::I16:
+        blob = InferenceEngine::make_shared_blob<int16_t>(desc);
+        break;
+    case InferenceEngine::Precision::I8:
+        blob = InferenceEngine::make_shared_blob<int8_t>(desc);
+        break;
+    case InferenceEngine::Precision::U8:
+        blob = InferenceEngine::make_shared_blob<uint8_t>(desc);
+        break;
+    default:
+        return nullptr;
+    }
+    blob->allocate();
+    std::memset(blob->buffer().as<char*>(), 0, blob->byteSize());
+    return blob;
+}
+
+Status SparseInputsPool::densify(const tensorflow::serving::PredictRequest& request, const TensorInfo& networkInput, int streamId, InferenceEngine::Blob::Ptr& blob) {
+    if (streamId < 0 || static_cast<size_t>(streamId) >= streams.size()) {
+        SPDLOG_ERROR("Sparse input: {} densification requested for invalid streamId: {}", networkInput.getName(), streamId);
+        return StatusCode::INTERNAL_ERROR;
+    }
+    auto& pooled = streams[streamId][networkInput.getName()];
+    const auto desc = networkInput.getTensorDesc();
+    const size_t elementSize = desc.getPrecision().size();
+    if (pooled.blob == nullptr || pooled.blob->getTensorDesc().getDims() != desc.getDims()) {
+        pooled.blob = allocateBlob(desc);
+        pooled.writtenOffsets.clear();
+        if (pooled.blob == nullptr) {
+            return StatusCode::OV_UNSUPPORTED_DESERIALIZATION_PRECISION;
+        }
+    }
+    char* destination = pooled.blob->buffer().as<char*>();
+    for (auto offset : pooled.writtenOffsets) {
+        std::memset(destination + offset * elementSize, 0, elementSize);
+    }
+    pooled.writtenOffsets.clear();
+
+    const auto& name = networkInput.getName();
+    const auto& values = request.inputs().at(name + SPARSE_VALUES_SUFFIX);
+    const size_t nnz = values.tensor_shape().dim(0).size();
+    Status status;
+    if (getSparseFormat(request, name) == SparseFormat::COO) {
+        status = densifyCoo(request.inputs().at(name + SPARSE_INDICES_SUFFIX).tensor_content().data(),
+            values.tensor_content().data(), nnz, elementSize, networkInput.getShape(), destination, pooled.writtenOffsets);
+    } else {
+        status = densifyCsr(request.inputs().at(name + SPARSE_ROW_PTR_SUFFIX).tensor_content().data(),
+            request.inputs().at(name + SPARSE_COL_INDICES_SUFFIX).tensor_content().data(),
+            values.tensor_content().data(), nnz, elementSize, networkInput.getShape(), destination, pooled.writtenOffsets);
+    }
+    if (!status.ok()) {
+        SPDLOG_DEBUG("Sparse input: {} densification failed: {}", name, status.string());
+        return status;
+    }
+    blob = pooled.blob;
+    return StatusCode::OK;
+}
+
+}  // namespace ovms
@@ -0,0 +1,108 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <memory>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <inference_engine.hpp>
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wall"
+#include "tensorflow_serving/apis/prediction_service.grpc.pb.h"
+#pragma GCC diagnostic pop
+
+#include "status.hpp"
+#include "tensorinfo.hpp"
+
+namespace ovms {
+
+/**
+ * @brief Representation of sparse input sent as several request tensors named <input>/<component>
+ */
+enum class SparseFormat {
+    NONE,
+    COO,  // <input>/indices int64 [nnz, rank], <input>/values [nnz]
+    CSR   // <input>/row_ptr int64 [rows + 1], <input>/col_indices int64 [nnz], <input>/values [nnz]
+};
+
+const std::string SPARSE_INDICES_SUFFIX = "/indices";
+const std::string SPARSE_ROW_PTR_SUFFIX = "/row_ptr";
+const std::string SPARSE_COL_INDICES_SUFFIX = "/col_indices";
+const std::string SPARSE_VALUES_SUFFIX = "/values";
+
+/**
+ * @brief Detects format of sparse input in request
+ */
+SparseFormat getSparseFormat(const tensorflow::serving::PredictRequest& request, const std::string& name);
+
+/**
+ * @brief Validates sparse input components against network input
+ *
+ * @param components number of request tensors used by sparse input
+ */
+Status validateSparseInput(const tensorflow::serving::PredictRequest& request, const TensorInfo& networkInput, size_t& components);
+
+/**
+ * @brief Scatters COO values into zeroed dense buffer
+ *
+ * @param writtenOffsets offsets of written elements, used to zero them before next request
+ */
+Status densifyCoo(const char* indices, const char* values, size_t nnz, size_t elementSize,
+    const shape_t& shape, char* destination, std::vector<size_t>& writtenOffsets);
+
+/**
+ * @brief Scatters CSR values into zeroed dense buffer. Last dimension is treated as columns, all others as rows.
+ */
+Status densifyCsr(const char* rowPtr, const char* colIndices, const char* values, size_t nnz, size_t elementSize,
+    const shape_t& shape, char* destination, std::vector<size_t>& writtenOffsets);
+
+/**
+ * @brief Dense blobs of sparse capable inputs reused by each inference stream.
+ * Blobs are zeroed once at allocation, afterwards only elements written by previous request are cleared,
+ * so densification cost depends on number of nonzero values instead of tensor volume.
+ */
+class SparseInputsPool {
+public:
+    SparseInputsPool(const std::set<std::string>& sparseInputs, size_t streamsCount) :
+        sparseInputs(sparseInputs),
+        streams(streamsCount) {}
+
+    bool isSparseCapable(const std::string& name) const {
+        return sparseInputs.count(name) > 0;
+    }
+
+    /**
+     * @brief Densifies sparse input from request into blob owned by stream
+     *
+     * @param streamId stream executing request, its blobs are accessed exclusively
+     */
+    Status densify(const tensorflow::serving::PredictRequest& request, const TensorInfo& networkInput, int streamId, InferenceEngine::Blob::Ptr& blob);
+
+private:
+    struct PooledBlob {
+        InferenceEngine::Blob::Ptr blob;
+        std::vector<size_t> writtenOffsets;
+    };
+
+    const std::set<std::string> sparseInputs;
+    std::vector<std::unordered_map<std::string, PooledBlob>> streams;
+};
+
+}  // namespace ovms
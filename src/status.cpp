@@ -23,12 +23,17 @@ const std::map<const StatusCode, const std::string> Status::statusMessageMap = {
 
     {StatusCode::PATH_INVALID, "The provided base path is invalid or doesn't exists"},
     {StatusCode::FILE_INVALID, "File not found or cannot open"},
+    {StatusCode::MODEL_PACKAGE_INVALID, "Model package is corrupted or has unsupported format"},
     {StatusCode::NO_MODEL_VERSION_AVAILABLE, "Not a single model version directory has valid numeric name"},
     {StatusCode::NETWORK_NOT_LOADED, "Error while loading a network"},
     {StatusCode::JSON_INVALID, "The file is not valid json"},
     {StatusCode::MODELINSTANCE_NOT_FOUND, "ModelInstance not found"},
     {StatusCode::SHAPE_WRONG_FORMAT, "The provided shape is in wrong format"},
     {StatusCode::PLUGIN_CONFIG_WRONG_FORMAT, "Plugin config is in wrong format"},
+    {StatusCode::STREAM_SCHEDULING_WRONG_FORMAT, "Stream scheduling config is in wrong format"},
+    {StatusCode::CORE_PARTITIONING_WRONG_FORMAT, "Core partitioning ratios are in wrong format"},
+    {StatusCode::COMPILATION_CORES_WRONG_FORMAT, "Compilation cores are in wrong format or not available to the process"},
+    {StatusCode::COMPILATION_PRIORITY_NOT_PERMITTED, "Priority of threads created during model compilation cannot be restored, CAP_SYS_NICE or RLIMIT_NICE is required"},
     {StatusCode::MODEL_VERSION_POLICY_WRONG_FORMAT, "Model version policy is in wrong format"},
     {StatusCode::MODEL_VERSION_POLICY_UNSUPPORTED_KEY, "Model version policy contains unsupported key"},
     {StatusCode::RESHAPE_ERROR, "Model could not be reshaped with requested shape"},
@@ -38,6 +43,7 @@ const std::map<const StatusCode, const std::string> Status::statusMessageMap = {
     {StatusCode::MODEL_NAME_MISSING, "Model with requested name is not found"},
     {StatusCode::PIPELINE_DEFINITION_NAME_MISSING, "Model with requested name is not found"},
     {StatusCode::MODEL_VERSION_MISSING, "Model with requested version is not found"},
+    {StatusCode::MODEL_PROFILING_DISABLED, "Profiling is not enabled for requested model"},
     {StatusCode::MODEL_VERSION_NOT_LOADED_ANYMORE, "Model with requested version is retired"},
     {StatusCode::MODEL_VERSION_NOT_LOADED_YET, "Model with requested version is not loaded yet"},
     {StatusCode::MODEL_SPEC_MISSING, "model_spec missing in request"},
@@ -54,6 +60,19 @@ const std::map<const StatusCode, const std::string> Status::statusMessageMap = {
     {StatusCode::INVALID_PRECISION, "Invalid input precision"},
     {StatusCode::INVALID_VALUE_COUNT, "Invalid number of values in tensor proto container"},
     {StatusCode::INVALID_CONTENT_SIZE, "Invalid content size of tensor proto"},
+    {StatusCode::INVALID_SPARSE_INDEX, "Invalid sparse input indices"},
+    {StatusCode::TENSOR_ENCODING_WRONG_FORMAT, "Tensor encoding metadata is in wrong format"},
+    {StatusCode::TENSOR_DECODING_ERROR, "Could not decode tensor content"},
+    {StatusCode::TENSOR_ENCODING_ERROR, "Could not encode tensor content"},
+
+    // Stateful models
+    {StatusCode::INVALID_SEQUENCE_ID, "Sequence id should be non negative integer with shape [1]"},
+    {StatusCode::INVALID_SEQUENCE_CONTROL_INPUT, "Sequence control input should have shape [1] and value 0, 1 or 2"},
+    {StatusCode::SEQUENCE_ID_MISSING, "Sequence id is required by stateful model"},
+    {StatusCode::SEQUENCE_MISSING, "Sequence with requested id does not exist"},
+    {StatusCode::SEQUENCE_ALREADY_EXISTS, "Sequence with requested id already exists"},
+    {StatusCode::MAX_SEQUENCE_NUMBER_REACHED, "Maximum number of sequences reached"},
+    {StatusCode::SEQUENCE_STATE_ERROR, "Could not transfer sequence memory state"},
 
     // Deserialization
     {StatusCode::OV_UNSUPPORTED_DESERIALIZATION_PRECISION, "Unsupported deserialization precision"},
@@ -89,6 +108,8 @@ const std::map<const StatusCode, const std::string> Status::statusMessageMap = {
     {StatusCode::REST_PROTO_TO_STRING_ERROR, "Response parsing to JSON error"},
     {StatusCode::REST_UNSUPPORTED_PRECISION, "Could not parse input content. Unsupported data precision detected"},
     {StatusCode::REST_SERIALIZE_TENSOR_CONTENT_INVALID_SIZE, "Tensor serialization error"},
+    {StatusCode::REST_BATCH_REQUESTS_NOT_AN_ARRAY, "Invalid JSON structure. Missing requests array in batch predict"},
+    {StatusCode::REST_BATCH_TOO_MANY_REQUESTS, "Too many requests in batch predict"},
 
     // Storage errors
     // S3
@@ -124,6 +145,19 @@ const std::map<const StatusCode, const std::string> Status::statusMessageMap = {
     {StatusCode::AS_FILE_INVALID, "AS File path is invalid"},
     {StatusCode::AS_FAILED_GET_OBJECT, "AS Failed to get object from path"},
     {StatusCode::AS_INCORRECT_REQUESTED_OBJECT_TYPE, "AS invalid object type in path"},
+
+    // CPU profiler
+    {StatusCode::CPU_PROFILER_DISABLED, "CPU profiler is not enabled"},
+    {StatusCode::CPU_PROFILER_ALREADY_RUNNING, "CPU profiling is already in progress"},
+    {StatusCode::CPU_PROFILER_INVALID_PARAMETERS, "Invalid CPU profiling duration or frequency"},
+    {StatusCode::CPU_PROFILER_START_FAILED, "Could not start CPU profiling"},
+
+    // Pipeline
+    {StatusCode::PIPELINE_NODE_BATCH_OUTPUT_NOT_SPLITTABLE, "Batched node output cannot be split along batch dimension"},
+    {StatusCode::PIPELINE_NODE_GATE_UNSUPPORTED_PRECISION, "Unsupported precision of node gate output"},
+    {StatusCode::PIPELINE_NODE_CACHED_RESULTS_ABANDONED, "Node producing cached results did not finish inference"},
+    {StatusCode::PIPELINE_NODE_STATEFUL_MODEL_FORBIDDEN, "Stateful model cannot be used in pipeline"},
+    {StatusCode::PIPELINE_STREAM_CLOSED, "Stream of pipeline outputs was closed"},
 };
 
 const std::map<const StatusCode, grpc::StatusCode> Status::grpcStatusMap = {
@@ -131,12 +165,17 @@ const std::map<const StatusCode, grpc::StatusCode> Status::grpcStatusMap = {
 
     {StatusCode::PATH_INVALID, grpc::StatusCode::INTERNAL},
     {StatusCode::FILE_INVALID, grpc::StatusCode::INTERNAL},
+    {StatusCode::MODEL_PACKAGE_INVALID, grpc::StatusCode::INTERNAL},
     {StatusCode::NO_MODEL_VERSION_AVAILABLE, grpc::StatusCode::INTERNAL},
     {StatusCode::NETWORK_NOT_LOADED, grpc::StatusCode::INTERNAL},
     {StatusCode::JSON_INVALID, grpc::StatusCode::INTERNAL},
     {StatusCode::MODELINSTANCE_NOT_FOUND, grpc::StatusCode::INTERNAL},
     {StatusCode::SHAPE_WRONG_FORMAT, grpc::StatusCode::INTERNAL},
     {StatusCode::PLUGIN_CONFIG_WRONG_FORMAT, grpc::StatusCode::INTERNAL},
+    {StatusCode::STREAM_SCHEDULING_WRONG_FORMAT, grpc::StatusCode::INTERNAL},
+    {StatusCode::CORE_PARTITIONING_WRONG_FORMAT, grpc::StatusCode::INTERNAL},
+    {StatusCode::COMPILATION_CORES_WRONG_FORMAT, grpc::StatusCode::INTERNAL},
+    {StatusCode::COMPILATION_PRIORITY_NOT_PERMITTED, grpc::StatusCode::INTERNAL},
     {StatusCode::MODEL_VERSION_POLICY_WRONG_FORMAT, grpc::StatusCode::INTERNAL},
     {StatusCode::MODEL_VERSION_POLICY_UNSUPPORTED_KEY, grpc::StatusCode::INTERNAL},
     {StatusCode::RESHAPE_ERROR, grpc::StatusCode::FAILED_PRECONDITION},
@@ -144,6 +183,7 @@ const std::map<const StatusCode, grpc::StatusCode> Status::grpcStatusMap = {
     {StatusCode::MODEL_NAME_MISSING, grpc::StatusCode::NOT_FOUND},
     {StatusCode::PIPELINE_DEFINITION_NAME_MISSING, grpc::StatusCode::NOT_FOUND},
     {StatusCode::MODEL_VERSION_MISSING, grpc::StatusCode::NOT_FOUND},
+    {StatusCode::MODEL_PROFILING_DISABLED, grpc::StatusCode::FAILED_PRECONDITION},
     {StatusCode::MODEL_VERSION_NOT_LOADED_ANYMORE, grpc::StatusCode::NOT_FOUND},
     {StatusCode::MODEL_VERSION_NOT_LOADED_YET, grpc::StatusCode::NOT_FOUND},
     {StatusCode::MODEL_SPEC_MISSING, grpc::StatusCode::INVALID_ARGUMENT},
@@ -158,6 +198,17 @@ const std::map<const StatusCode, grpc::StatusCode> Status::grpcStatusMap = {
     {StatusCode::INVALID_PRECISION, grpc::StatusCode::INVALID_ARGUMENT},
     {StatusCode::INVALID_VALUE_COUNT, grpc::StatusCode::INVALID_ARGUMENT},
     {StatusCode::INVALID_CONTENT_SIZE, grpc::StatusCode::INVALID_ARGUMENT},
+    {StatusCode::INVALID_SPARSE_INDEX, grpc::StatusCode::INVALID_ARGUMENT},
+    {StatusCode::TENSOR_ENCODING_WRONG_FORMAT, grpc::StatusCode::INVALID_ARGUMENT},
+    {StatusCode::TENSOR_DECODING_ERROR, grpc::StatusCode::INVALID_ARGUMENT},
+    {StatusCode::TENSOR_ENCODING_ERROR, grpc::StatusCode::INTERNAL},
+    {StatusCode::INVALID_SEQUENCE_ID, grpc::StatusCode::INVALID_ARGUMENT},
+    {StatusCode::INVALID_SEQUENCE_CONTROL_INPUT, grpc::StatusCode::INVALID_ARGUMENT},
+    {StatusCode::SEQUENCE_ID_MISSING, grpc::StatusCode::INVALID_ARGUMENT},
+    {StatusCode::SEQUENCE_MISSING, grpc::StatusCode::NOT_FOUND},
+    {StatusCode::SEQUENCE_ALREADY_EXISTS, grpc::StatusCode::ALREADY_EXISTS},
+    {StatusCode::MAX_SEQUENCE_NUMBER_REACHED, grpc::StatusCode::UNAVAILABLE},
+    {StatusCode::SEQUENCE_STATE_ERROR, grpc::StatusCode::INTERNAL},
 
     // Deserialization
 
@@ -176,6 +227,19 @@ const std::map<const StatusCode, grpc::StatusCode> Status::grpcStatusMap = {
 
     // GetModelStatus
     {StatusCode::INTERNAL_ERROR, grpc::StatusCode::INTERNAL},
+
+    // Pipeline
+    {StatusCode::PIPELINE_NODE_BATCH_OUTPUT_NOT_SPLITTABLE, grpc::StatusCode::INTERNAL},
+    {StatusCode::PIPELINE_NODE_GATE_UNSUPPORTED_PRECISION, grpc::StatusCode::INTERNAL},
+    {StatusCode::PIPELINE_NODE_CACHED_RESULTS_ABANDONED, grpc::StatusCode::INTERNAL},
+    {StatusCode::PIPELINE_NODE_STATEFUL_MODEL_FORBIDDEN, grpc::StatusCode::FAILED_PRECONDITION},
+    {StatusCode::PIPELINE_STREAM_CLOSED, grpc::StatusCode::CANCELLED},
+
+    // CPU profiler
+    {StatusCode::CPU_PROFILER_DISABLED, grpc::StatusCode::FAILED_PRECONDITION},
+    {StatusCode::CPU_PROFILER_ALREADY_RUNNING, grpc::StatusCode::UNAVAILABLE},
+    {StatusCode::CPU_PROFILER_INVALID_PARAMETERS, grpc::StatusCode::INVALID_ARGUMENT},
+    {StatusCode::CPU_PROFILER_START_FAILED, grpc::StatusCode::INTERNAL},
 };
 
 const std::map<const StatusCode, net_http::HTTPStatusCode> Status::httpStatusMap = {
@@ -201,15 +265,22 @@ const std::map<const StatusCode, net_http::HTTPStatusCode> Status::httpStatusMap
     {StatusCode::REST_PROTO_TO_STRING_ERROR, net_http::HTTPStatusCode::ERROR},
     {StatusCode::REST_UNSUPPORTED_PRECISION, net_http::HTTPStatusCode::BAD_REQUEST},
     {StatusCode::REST_SERIALIZE_TENSOR_CONTENT_INVALID_SIZE, net_http::HTTPStatusCode::ERROR},
+    {StatusCode::REST_BATCH_REQUESTS_NOT_AN_ARRAY, net_http::HTTPStatusCode::BAD_REQUEST},
+    {StatusCode::REST_BATCH_TOO_MANY_REQUESTS, net_http::HTTPStatusCode::BAD_REQUEST},
 
     {StatusCode::PATH_INVALID, net_http::HTTPStatusCode::ERROR},
     {StatusCode::FILE_INVALID, net_http::HTTPStatusCode::ERROR},
+    {StatusCode::MODEL_PACKAGE_INVALID, net_http::HTTPStatusCode::ERROR},
     {StatusCode::NO_MODEL_VERSION_AVAILABLE, net_http::HTTPStatusCode::ERROR},
     {StatusCode::NETWORK_NOT_LOADED, net_http::HTTPStatusCode::ERROR},
     {StatusCode::JSON_INVALID, net_http::HTTPStatusCode::ERROR},
     {StatusCode::MODELINSTANCE_NOT_FOUND, net_http::HTTPStatusCode::ERROR},
     {StatusCode::SHAPE_WRONG_FORMAT, net_http::HTTPStatusCode::ERROR},
     {StatusCode::PLUGIN_CONFIG_WRONG_FORMAT, net_http::HTTPStatusCode::ERROR},
+    {StatusCode::STREAM_SCHEDULING_WRONG_FORMAT, net_http::HTTPStatusCode::ERROR},
+    {StatusCode::CORE_PARTITIONING_WRONG_FORMAT, net_http::HTTPStatusCode::ERROR},
+    {StatusCode::COMPILATION_CORES_WRONG_FORMAT, net_http::HTTPStatusCode::ERROR},
+    {StatusCode::COMPILATION_PRIORITY_NOT_PERMITTED, net_http::HTTPStatusCode::ERROR},
     {StatusCode::MODEL_VERSION_POLICY_WRONG_FORMAT, net_http::HTTPStatusCode::ERROR},
     {StatusCode::MODEL_VERSION_POLICY_UNSUPPORTED_KEY, net_http::HTTPStatusCode::ERROR},
     {StatusCode::RESHAPE_ERROR, net_http::HTTPStatusCode::PRECOND_FAILED},
@@ -217,6 +288,7 @@ const std::map<const StatusCode, net_http::HTTPStatusCode> Status::httpStatusMap
     {StatusCode::MODEL_NAME_MISSING, net_http::HTTPStatusCode::NOT_FOUND},
     {StatusCode::PIPELINE_DEFINITION_NAME_MISSING, net_http::HTTPStatusCode::NOT_FOUND},
     {StatusCode::MODEL_VERSION_MISSING, net_http::HTTPStatusCode::NOT_FOUND},
+    {StatusCode::MODEL_PROFILING_DISABLED, net_http::HTTPStatusCode::PRECOND_FAILED},
     {StatusCode::MODEL_VERSION_NOT_LOADED_ANYMORE, net_http::HTTPStatusCode::NOT_FOUND},
     {StatusCode::MODEL_VERSION_NOT_LOADED_YET, net_http::HTTPStatusCode::NOT_FOUND},
     {StatusCode::MODEL_SPEC_MISSING, net_http::HTTPStatusCode::BAD_REQUEST},
@@ -231,6 +303,17 @@ const std::map<const StatusCode, net_http::HTTPStatusCode> Status::httpStatusMap
     {StatusCode::INVALID_PRECISION, net_http::HTTPStatusCode::BAD_REQUEST},
     {StatusCode::INVALID_VALUE_COUNT, net_http::HTTPStatusCode::BAD_REQUEST},
     {StatusCode::INVALID_CONTENT_SIZE, net_http::HTTPStatusCode::BAD_REQUEST},
+    {StatusCode::INVALID_SPARSE_INDEX, net_http::HTTPStatusCode::BAD_REQUEST},
+    {StatusCode::TENSOR_ENCODING_WRONG_FORMAT, net_http::HTTPStatusCode::BAD_REQUEST},
+    {StatusCode::TENSOR_DECODING_ERROR, net_http::HTTPStatusCode::BAD_REQUEST},
+    {StatusCode::TENSOR_ENCODING_ERROR, net_http::HTTPStatusCode::ERROR},
+    {StatusCode::INVALID_SEQUENCE_ID, net_http::HTTPStatusCode::BAD_REQUEST},
+    {StatusCode::INVALID_SEQUENCE_CONTROL_INPUT, net_http::HTTPStatusCode::BAD_REQUEST},
+    {StatusCode::SEQUENCE_ID_MISSING, net_http::HTTPStatusCode::BAD_REQUEST},
+    {StatusCode::SEQUENCE_MISSING, net_http::HTTPStatusCode::NOT_FOUND},
+    {StatusCode::SEQUENCE_ALREADY_EXISTS, net_http::HTTPStatusCode::CONFLICT},
+    {StatusCode::MAX_SEQUENCE_NUMBER_REACHED, net_http::HTTPStatusCode::SERVICE_UNAV},
+    {StatusCode::SEQUENCE_STATE_ERROR, net_http::HTTPStatusCode::ERROR},
 
     // Deserialization
 
@@ -249,6 +332,19 @@ const std::map<const StatusCode, net_http::HTTPStatusCode> Status::httpStatusMap
 
     // GetModelStatus
     {StatusCode::INTERNAL_ERROR, net_http::HTTPStatusCode::ERROR},
+
+    // Pipeline
+    {StatusCode::PIPELINE_NODE_BATCH_OUTPUT_NOT_SPLITTABLE, net_http::HTTPStatusCode::ERROR},
+    {StatusCode::PIPELINE_NODE_GATE_UNSUPPORTED_PRECISION, net_http::HTTPStatusCode::ERROR},
+    {StatusCode::PIPELINE_NODE_CACHED_RESULTS_ABANDONED, net_http::HTTPStatusCode::ERROR},
+    {StatusCode::PIPELINE_NODE_STATEFUL_MODEL_FORBIDDEN, net_http::HTTPStatusCode::PRECOND_FAILED},
+    {StatusCode::PIPELINE_STREAM_CLOSED, net_http::HTTPStatusCode::ERROR},
+
+    // CPU profiler
+    {StatusCode::CPU_PROFILER_DISABLED, net_http::HTTPStatusCode::NOT_FOUND},
+    {StatusCode::CPU_PROFILER_ALREADY_RUNNING, net_http::HTTPStatusCode::PRECOND_FAILED},
+    {StatusCode::CPU_PROFILER_INVALID_PARAMETERS, net_http::HTTPStatusCode::BAD_REQUEST},
+    {StatusCode::CPU_PROFILER_START_FAILED, net_http::HTTPStatusCode::ERROR},
 };
 
 }  // namespace ovms
@@ -33,18 +33,23 @@ namespace net_http = tensorflow::serving::net_http;
 enum class StatusCode {
     OK, /*!< Success */
 
-    PATH_INVALID,     /*!< The provided path is invalid or doesn't exists */
-    FILE_INVALID,     /*!< File not found or cannot open */
-    FILESYSTEM_ERROR, /*!< Underlaying filesystem error */
+    PATH_INVALID,          /*!< The provided path is invalid or doesn't exists */
+    FILE_INVALID,          /*!< File not found or cannot open */
+    MODEL_PACKAGE_INVALID, /*!< Model package is corrupted or has unsupported format */
+    FILESYSTEM_ERROR,      /*!< Underlaying filesystem error */
     NETWORK_NOT_LOADED,
     JSON_INVALID,             /*!< The file/content is not valid json */
     JSON_SERIALIZATION_ERROR, /*!< Data serialization to json format failed */
     MODELINSTANCE_NOT_FOUND,
     SHAPE_WRONG_FORMAT,                   /*!< The provided shape param is in wrong format */
     PLUGIN_CONFIG_WRONG_FORMAT,           /*!< Plugin config is in wrong format */
+    STREAM_SCHEDULING_WRONG_FORMAT,       /*!< Stream scheduling config is in wrong format */
     MODEL_VERSION_POLICY_WRONG_FORMAT,    /*!< Model version policy is in wrong format */
     MODEL_VERSION_POLICY_UNSUPPORTED_KEY, /*!< Model version policy contains invalid key */
     GRPC_CHANNEL_ARG_WRONG_FORMAT,
+    CORE_PARTITIONING_WRONG_FORMAT,         /*!< Core partitioning ratios are in wrong format */
+    COMPILATION_CORES_WRONG_FORMAT,         /*!< Compilation cores are in wrong format or not available */
+    COMPILATION_PRIORITY_NOT_PERMITTED,     /*!< Niceness of compilation threads cannot be restored */
     NO_MODEL_VERSION_AVAILABLE,             /*!< No model version found in path */
     RESHAPE_ERROR,                          /*!< Impossible to perform reshape */
     RESHAPE_REQUIRED,                       /*!< Model instance needs to be reloaded with new shape */
@@ -58,6 +63,7 @@ enum class StatusCode {
     MODEL_MISSING,                    /*!< Model with such name and/or version does not exist */
     MODEL_NAME_MISSING,               /*!< Model with requested name is not found */
     MODEL_VERSION_MISSING,            /*!< Model with requested version is not found */
+    MODEL_PROFILING_DISABLED,         /*!< Profiling is not enabled for requested model */
     MODEL_VERSION_NOT_LOADED_ANYMORE, /*!< Model with requested version is retired */
     MODEL_VERSION_NOT_LOADED_YET,     /*!< Model with requested version is not loaded yet */
     INVALID_NIREQ,                    /*!< Invalid NIREQ requested */
@@ -72,6 +78,19 @@ enum class StatusCode {
     INVALID_PRECISION,              /*!< Invalid precision */
     INVALID_VALUE_COUNT,            /*!< Invalid value count error status for uint16 and half float data types */
     INVALID_CONTENT_SIZE,           /*!< Invalid content size error status for types using tensor_content() */
+    INVALID_SPARSE_INDEX,           /*!< Sparse input index out of bounds or row pointers not ordered */
+    TENSOR_ENCODING_WRONG_FORMAT,   /*!< Tensor encoding metadata is in wrong format */
+    TENSOR_DECODING_ERROR,          /*!< Encoded tensor_content could not be decoded to size required by tensor shape */
+    TENSOR_ENCODING_ERROR,          /*!< Error occurred during tensor_content encoding */
+
+    // Stateful models
+    INVALID_SEQUENCE_ID,            /*!< Sequence id input has invalid type or shape */
+    INVALID_SEQUENCE_CONTROL_INPUT, /*!< Sequence control input has invalid type, shape or value */
+    SEQUENCE_ID_MISSING,            /*!< Request to stateful model lacks sequence id */
+    SEQUENCE_MISSING,               /*!< Sequence with requested id does not exist */
+    SEQUENCE_ALREADY_EXISTS,        /*!< Sequence with requested id is already started */
+    MAX_SEQUENCE_NUMBER_REACHED,    /*!< Stateful model holds maximum number of sequences */
+    SEQUENCE_STATE_ERROR,           /*!< Error occurred when moving sequence memory states */
 
     // Deserialization
     OV_UNSUPPORTED_DESERIALIZATION_PRECISION, /*!< Unsupported deserialization precision, theoretically should never be returned since ModelInstance::validation checks against network precision */
@@ -130,6 +149,12 @@ enum class StatusCode {
     AS_FAILED_GET_OBJECT,
     AS_INCORRECT_REQUESTED_OBJECT_TYPE,
 
+    // CPU profiler
+    CPU_PROFILER_DISABLED,           /*!< CPU profiler endpoint is not enabled */
+    CPU_PROFILER_ALREADY_RUNNING,    /*!< Another CPU profiling is in progress */
+    CPU_PROFILER_INVALID_PARAMETERS, /*!< Invalid CPU profiling duration or frequency */
+    CPU_PROFILER_START_FAILED,       /*!< Could not install profiling signal handler or timer */
+
     // REST handler
     REST_NOT_FOUND,               /*!< Requested REST resource not found */
     REST_COULD_NOT_PARSE_VERSION, /*!< Could not parse model version in request */
@@ -153,6 +178,8 @@ enum class StatusCode {
     REST_PROTO_TO_STRING_ERROR,          /*!< Error while parsing ResponseProto to JSON string */
     REST_UNSUPPORTED_PRECISION,          /*!< Unsupported conversion from tensor_content to _val container */
     REST_SERIALIZE_TENSOR_CONTENT_INVALID_SIZE,
+    REST_BATCH_REQUESTS_NOT_AN_ARRAY, /*!< Batch predict requests member is missing, empty or not an array */
+    REST_BATCH_TOO_MANY_REQUESTS,     /*!< Batch predict contains too many requests */
 
     PIPELINE_DEFINITION_ALREADY_EXIST,
     PIPELINE_NODE_WRONG_KIND_CONFIGURATION,
@@ -165,6 +192,11 @@ enum class StatusCode {
     PIPELINE_CYCLE_FOUND,
     PIPELINE_CONTAINS_UNCONNECTED_NODES,
     PIPELINE_DEFINITION_MISSING_DEPENDENCY_MAPPING,
+    PIPELINE_NODE_BATCH_OUTPUT_NOT_SPLITTABLE, /*!< Batched node output 0-th dimension does not match model batch size */
+    PIPELINE_NODE_GATE_UNSUPPORTED_PRECISION,  /*!< Node gate output precision cannot be compared with threshold */
+    PIPELINE_NODE_CACHED_RESULTS_ABANDONED,    /*!< Node producing cached results finished without results */
+    PIPELINE_NODE_STATEFUL_MODEL_FORBIDDEN,    /*!< Stateful models cannot be used in pipelines */
+    PIPELINE_STREAM_CLOSED,                    /*!< Client closed stream of pipeline outputs */
 };
 
 class Status {
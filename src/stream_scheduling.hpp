@@ -0,0 +1,118 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <string>
+
+namespace ovms {
+
+/**
+ * @brief Order in which requests waiting for idle inference stream of a model are served
+ */
+enum class StreamSchedulingPolicy {
+    FIFO,           // in order of arrival
+    WEIGHTED_FAIR,  // streams shared between requesters proportionally to their weights
+    DEADLINE        // earliest deadline first, deadline is arrival time plus requester latency target
+};
+
+/**
+ * @brief Kind of request waiting for idle inference stream
+ */
+enum class StreamRequester {
+    PREDICT,                 // direct model inference
+    PIPELINE_NODE,           // DL node of pipeline
+    PRIORITY_PIPELINE_NODE,  // DL node of pipeline with high priority, served before other requesters
+    COUNT
+};
+
+struct StreamSchedulingConfig {
+    StreamSchedulingPolicy policy = StreamSchedulingPolicy::FIFO;
+    uint32_t predictWeight = 1;
+    uint32_t pipelineWeight = 1;
+    uint32_t predictLatencyTargetMs = 0;
+    uint32_t pipelineLatencyTargetMs = 0;
+    /**
+     * @brief Fraction of streams kept for high priority pipeline nodes
+     */
+    double reservedStreamsRatio = 0;
+    /**
+     * @brief Time without high priority requests after which other requesters can borrow idle reserved streams
+     */
+    uint32_t reservedStreamsBorrowAfterMs = 1000;
+
+    bool operator==(const StreamSchedulingConfig& rhs) const {
+        return policy == rhs.policy &&
+               predictWeight == rhs.predictWeight &&
+               pipelineWeight == rhs.pipelineWeight &&
+               predictLatencyTargetMs == rhs.predictLatencyTargetMs &&
+               pipelineLatencyTargetMs == rhs.pipelineLatencyTargetMs &&
+               reservedStreamsRatio == rhs.reservedStreamsRatio &&
+               reservedStreamsBorrowAfterMs == rhs.reservedStreamsBorrowAfterMs;
+    }
+
+    bool operator!=(const StreamSchedulingConfig& rhs) const {
+        return !(*this == rhs);
+    }
+
+    /**
+     * @brief Parses policy name: fifo, weighted_fair or deadline
+     *
+     * @return false if name is not recognized
+     */
+    static bool parsePolicy(const std::string& name, StreamSchedulingPolicy& policy) {
+        if (name == "fifo") {
+            policy = StreamSchedulingPolicy::FIFO;
+        } else if (name == "weighted_fair") {
+            policy = StreamSchedulingPolicy::WEIGHTED_FAIR;
+        } else if (name == "deadline") {
+            policy = StreamSchedulingPolicy::DEADLINE;
+        } else {
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Gets number of reserved streams out of all streams of model, at least one when any fraction is reserved
+     */
+    size_t getReservedStreamsCount(size_t streamsCount) const {
+        if (reservedStreamsRatio <= 0) {
+            return 0;
+        }
+        return std::min(streamsCount, static_cast<size_t>(std::ceil(reservedStreamsRatio * streamsCount)));
+    }
+};
+
+/**
+ * @brief Parses pipeline priority name into requester of its DL nodes: normal or high
+ *
+ * @return false if name is not recognized
+ */
+inline bool parsePipelinePriority(const std::string& name, StreamRequester& requester) {
+    if (name == "normal") {
+        requester = StreamRequester::PIPELINE_NODE;
+    } else if (name == "high") {
+        requester = StreamRequester::PRIORITY_PIPELINE_NODE;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+}  // namespace ovms
@@ -0,0 +1,219 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "tensor_encoding.hpp"
+
+#include <algorithm>
+#include <sstream>
+#include <utility>
+
+#include <spdlog/spdlog.h>
+#include <zlib.h>
+
+#include "stringutils.hpp"
+
+namespace ovms {
+
+static const std::map<TensorEncoding, std::string> encodingNames = {
+    {TensorEncoding::NONE, "none"},
+    {TensorEncoding::DEFLATE, "deflate"},
+    {TensorEncoding::SHUFFLE_DEFLATE, "shuffle-deflate"},
+};
+
+bool parseTensorEncoding(const std::string& name, TensorEncoding& encoding) {
+    for (const auto& [value, valueName] : encodingNames) {
+        if (valueName == name) {
+            encoding = value;
+            return true;
+        }
+    }
+    return false;
+}
+
+const std::string& tensorEncodingToString(TensorEncoding encoding) {
+    return encodingNames.at(encoding);
+}
+
+Status parseTensorEncodings(const std::string& metadata, std::map<std::string, TensorEncoding>& encodings) {
+    for (auto& entry : tokenize(metadata, ',')) {
+        erase_spaces(entry);
+        auto separator = entry.find('=');
+        if (separator == std::string::npos || separator == 0) {
+            return StatusCode::TENSOR_ENCODING_WRONG_FORMAT;
+        }
+        TensorEncoding encoding;
+        if (!parseTensorEncoding(entry.substr(separator + 1), encoding)) {
+            return StatusCode::TENSOR_ENCODING_WRONG_FORMAT;
+        }
+        encodings[entry.substr(0, separator)] = encoding;
+    }
+    return StatusCode::OK;
+}
+
+/**
+ * @brief Groups n-th bytes of all elements together, eg. for 4 byte floats all exponent bytes end up next to each other
+ */
+static void shuffleBytes(const char* input, size_t size, size_t elementSize, char* output) {
+    const size_t elements = size / elementSize;
+    for (size_t i = 0; i < elements; i++) {
+        for (size_t byte = 0; byte < elementSize; byte++) {
+            output[byte * elements + i] = input[i * elementSize + byte];
+        }
+    }
+    // Trailing bytes not forming whole element are copied as they are
+    std::copy(input + elements * elementSize, input + size, output + elements * elementSize);
+}
+
+static void unshuffleBytes(const char* input, size_t size, size_t elementSize, char* output) {
+    const size_t elements = size / elementSize;
+    for (size_t i = 0; i < elements; i++) {
+        for (size_t byte = 0; byte < elementSize; byte++) {
+            output[i * elementSize + byte] = input[byte * elements + i];
+        }
+    }
+    std::copy(input + elements * elementSize, input + size, output + elements * elementSize);
+}
+
+Status encodeTensorContent(TensorEncoding encoding, size_t elementSize, const std::string& content, std::string& encoded) {
+    if (encoding == TensorEncoding::NONE) {
+        encoded = content;
+        return StatusCode::OK;
+    }
+    const std::string* source = &content;
+    std::string shuffled;
+    if (encoding == TensorEncoding::SHUFFLE_DEFLATE && elementSize > 1) {
+        shuffled.resize(content.size());
+        shuffleBytes(content.data(), content.size(), elementSize, shuffled.data());
+        source = &shuffled;
+    }
+    uLongf encodedSize = compressBound(source->size());
+    encoded.resize(encodedSize);
+    const int result = compress2((Bytef*)encoded.data(), &encodedSize, (const Bytef*)source->data(), source->size(), Z_BEST_SPEED);
+    if (result != Z_OK) {
+        SPDLOG_DEBUG("Failed to encode tensor content; zlib error: {}", result);
+        return StatusCode::TENSOR_ENCODING_ERROR;
+    }
+    encoded.resize(encodedSize);
+    return StatusCode::OK;
+}
+
+Status decodeTensorContent(TensorEncoding encoding, size_t elementSize, const std::string& encoded, size_t decodedSize, std::string& content) {
+    if (encoding == TensorEncoding::NONE) {
+        content = encoded;
+        return StatusCode::OK;
+    }
+    const bool shuffled = encoding == TensorEncoding::SHUFFLE_DEFLATE && elementSize > 1;
+    std::string inflated;
+    std::string& destination = shuffled ? inflated : content;
+    destination.resize(decodedSize);
+    uLongf inflatedSize = decodedSize;
+    const int result = uncompress((Bytef*)destination.data(), &inflatedSize, (const Bytef*)encoded.data(), encoded.size());
+    if (result != Z_OK || inflatedSize != decodedSize) {
+        SPDLOG_DEBUG("Failed to decode tensor content; zlib error: {}; decoded size: {}; expected: {}", result, inflatedSize, decodedSize);
+        return StatusCode::TENSOR_DECODING_ERROR;
+    }
+    if (shuffled) {
+        content.resize(decodedSize);
+        unshuffleBytes(inflated.data(), decodedSize, elementSize, content.data());
+    }
+    return StatusCode::OK;
+}
+
+/**
+ * @brief Calculates content size from tensor shape and precision
+ *
+ * @return false if shape is invalid or size does not fit in size_t
+ */
+static bool getContentSize(const tensorflow::TensorProto& tensor, size_t& size) {
+    size = tensorflow::DataTypeSize(tensor.dtype());
+    for (int i = 0; i < tensor.tensor_shape().dim_size(); i++) {
+        const auto dim = tensor.tensor_shape().dim(i).size();
+        if (dim < 0 || __builtin_mul_overflow(size, static_cast<size_t>(dim), &size)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+const std::string& getInputContent(const std::string& name, const tensorflow::TensorProto& requestInput, const DecodedInputs* decodedInputs) {
+    if (decodedInputs != nullptr) {
+        auto it = decodedInputs->find(name);
+        if (it != decodedInputs->end()) {
+            return it->second;
+        }
+    }
+    return requestInput.tensor_content();
+}
+
+Status decodeRequestInputs(const std::map<std::string, TensorEncoding>& encodings, const tensorflow::serving::PredictRequest& request, DecodedInputs& decodedInputs) {
+    size_t totalDecodedSize = 0;
+    for (const auto& [name, encoding] : encodings) {
+        auto it = request.inputs().find(name);
+        if (it == request.inputs().end()) {
+            SPDLOG_DEBUG("Encoded input: {} is missing in request", name);
+            return StatusCode::INVALID_MISSING_INPUT;
+        }
+        if (encoding == TensorEncoding::NONE) {
+            continue;
+        }
+        const auto& tensor = it->second;
+        const size_t elementSize = tensorflow::DataTypeSize(tensor.dtype());
+        size_t decodedSize = 0;
+        if (!getContentSize(tensor, decodedSize) || decodedSize == 0) {
+            SPDLOG_DEBUG("Invalid shape of encoded input: {}", name);
+            return StatusCode::TENSOR_DECODING_ERROR;
+        }
+        // Reject sizes which could not be produced from received data before allocating decoding buffer
+        if (decodedSize / MAX_DEFLATE_RATIO > tensor.tensor_content().size() ||
+            __builtin_add_overflow(totalDecodedSize, decodedSize, &totalDecodedSize) ||
+            totalDecodedSize > MAX_DECODED_REQUEST_SIZE) {
+            SPDLOG_DEBUG("Decoded size: {} of input: {} exceeds limit; encoded size: {}", decodedSize, name, tensor.tensor_content().size());
+            return StatusCode::TENSOR_DECODING_ERROR;
+        }
+        auto status = decodeTensorContent(encoding, elementSize, tensor.tensor_content(), decodedSize, decodedInputs[name]);
+        if (!status.ok()) {
+            SPDLOG_DEBUG("Failed to decode input: {}", name);
+            return status;
+        }
+    }
+    return StatusCode::OK;
+}
+
+void encodeResponseOutputs(TensorEncoding encoding, tensorflow::serving::PredictResponse& response, std::string& encodedOutputs) {
+    encodedOutputs.clear();
+    if (encoding == TensorEncoding::NONE) {
+        return;
+    }
+    std::stringstream ss;
+    for (auto& [name, tensor] : *response.mutable_outputs()) {
+        if (tensor.tensor_content().size() < MIN_ENCODED_TENSOR_SIZE) {
+            continue;
+        }
+        std::string encoded;
+        auto status = encodeTensorContent(encoding, tensorflow::DataTypeSize(tensor.dtype()), tensor.tensor_content(), encoded);
+        if (!status.ok() || encoded.size() >= tensor.tensor_content().size()) {
+            continue;
+        }
+        SPDLOG_DEBUG("Encoded output: {} from {} to {} bytes", name, tensor.tensor_content().size(), encoded.size());
+        tensor.mutable_tensor_content()->swap(encoded);
+        if (ss.tellp() > 0) {
+            ss << ",";
+        }
+        ss << name << "=" << tensorEncodingToString(encoding);
+    }
+    encodedOutputs = ss.str();
+}
+
+}  // namespace ovms
@@ -0,0 +1,108 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <map>
+#include <string>
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wall"
+#include "tensorflow_serving/apis/prediction_service.grpc.pb.h"
+#pragma GCC diagnostic pop
+
+#include "status.hpp"
+
+namespace ovms {
+
+/**
+ * @brief Compression of tensor_content of single tensor
+ */
+enum class TensorEncoding {
+    NONE,
+    DEFLATE,         // zlib deflate of raw bytes
+    SHUFFLE_DEFLATE  // bytes of elements grouped by significance before deflate, better ratio for floats
+};
+
+/**
+ * @brief gRPC request metadata listing encoded inputs, eg. input_a=shuffle-deflate,input_b=deflate.
+ * Set by server in response initial metadata for encoded outputs.
+ */
+const std::string TENSOR_ENCODING_METADATA = "ovms-tensor-encoding";
+
+/**
+ * @brief gRPC request metadata with encoding client accepts for outputs
+ */
+const std::string ACCEPT_TENSOR_ENCODING_METADATA = "ovms-accept-tensor-encoding";
+
+/**
+ * @brief Outputs smaller than this are not worth encoding
+ */
+const size_t MIN_ENCODED_TENSOR_SIZE = 4096;
+
+bool parseTensorEncoding(const std::string& name, TensorEncoding& encoding);
+
+const std::string& tensorEncodingToString(TensorEncoding encoding);
+
+/**
+ * @brief Parses encodings of tensors in format name=encoding,name=encoding
+ */
+Status parseTensorEncodings(const std::string& metadata, std::map<std::string, TensorEncoding>& encodings);
+
+Status encodeTensorContent(TensorEncoding encoding, size_t elementSize, const std::string& content, std::string& encoded);
+
+/**
+ * @brief Decodes tensor content
+ *
+ * @param decodedSize expected size of decoded content calculated from tensor shape and precision
+ */
+Status decodeTensorContent(TensorEncoding encoding, size_t elementSize, const std::string& encoded, size_t decodedSize, std::string& content);
+
+/**
+ * @brief Limit of total decoded size of request inputs, the same as maximal size of gRPC message
+ */
+const size_t MAX_DECODED_REQUEST_SIZE = 1024 * 1024 * 1024;
+
+/**
+ * @brief Maximal compression ratio of deflate, content declared larger than that is rejected before decoding
+ */
+const size_t MAX_DEFLATE_RATIO = 1032;
+
+/**
+ * @brief Decoded contents of encoded request inputs by input name, used instead of their tensor_content
+ */
+using DecodedInputs = std::map<std::string, std::string>;
+
+/**
+ * @brief Returns decoded content of request input if it was encoded, its tensor_content otherwise
+ *
+ * @param decodedInputs optional decoded contents of encoded inputs
+ */
+const std::string& getInputContent(const std::string& name, const tensorflow::TensorProto& requestInput, const DecodedInputs* decodedInputs);
+
+/**
+ * @brief Decodes encoded inputs of request, other inputs are not touched and stay in the request.
+ * Decoded buffer is later wrapped by input blob without copying.
+ */
+Status decodeRequestInputs(const std::map<std::string, TensorEncoding>& encodings, const tensorflow::serving::PredictRequest& request, DecodedInputs& decodedInputs);
+
+/**
+ * @brief Encodes large response outputs if it reduces their size
+ *
+ * @param encodedOutputs metadata value listing encoded outputs, empty if none was encoded
+ */
+void encodeResponseOutputs(TensorEncoding encoding, tensorflow::serving::PredictResponse& response, std::string& encodedOutputs);
+
+}  // namespace ovms
@@ -17,6 +17,7 @@
 
 #include <map>
 #include <memory>
+#include <sstream>
 #include <string>
 
 #include <inference_engine.hpp>
@@ -0,0 +1,176 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <tbb/parallel_for.h>
+#include <tbb/task_arena.h>
+
+#include "../compilation_workers.hpp"
+#include "../core_partitioning.hpp"
+
+using ovms::CompilationWorkers;
+
+class CompilationWorkersTest : public ::testing::Test {
+protected:
+    void TearDown() override {
+        CompilationWorkers::instance().configure(0, "", 0, {});
+    }
+};
+
+TEST(CompilationWorkers, ParseCores) {
+    std::vector<int> cores;
+    ASSERT_EQ(CompilationWorkers::parseCores("0-2, 5,4", cores), ovms::StatusCode::OK);
+    EXPECT_EQ(cores, (std::vector<int>{0, 1, 2, 4, 5}));
+    ASSERT_EQ(CompilationWorkers::parseCores("", cores), ovms::StatusCode::OK);
+    EXPECT_TRUE(cores.empty());
+    EXPECT_EQ(CompilationWorkers::parseCores("3-1", cores), ovms::StatusCode::COMPILATION_CORES_WRONG_FORMAT);
+    EXPECT_EQ(CompilationWorkers::parseCores("a", cores), ovms::StatusCode::COMPILATION_CORES_WRONG_FORMAT);
+    EXPECT_EQ(CompilationWorkers::parseCores("1-2-3", cores), ovms::StatusCode::COMPILATION_CORES_WRONG_FORMAT);
+}
+
+TEST_F(CompilationWorkersTest, LoadsRunInCallingThreadWhenDisabled) {
+    auto& workers = CompilationWorkers::instance();
+    ASSERT_EQ(workers.configure(0, "", 0, {}), ovms::StatusCode::OK);
+    EXPECT_FALSE(workers.isEnabled());
+    const auto caller = std::this_thread::get_id();
+    std::thread::id executor;
+    EXPECT_EQ(workers.execute([&executor]() { executor = std::this_thread::get_id(); return ovms::Status(ovms::StatusCode::OK); }), ovms::StatusCode::OK);
+    EXPECT_EQ(executor, caller);
+}
+
+TEST_F(CompilationWorkersTest, ResultAndExceptionArePassedToCaller) {
+    auto& workers = CompilationWorkers::instance();
+    ASSERT_EQ(workers.configure(1, "", 0, {}), ovms::StatusCode::OK);
+    ASSERT_TRUE(workers.isEnabled());
+    const auto caller = std::this_thread::get_id();
+    std::thread::id executor;
+    EXPECT_EQ(workers.execute([&executor]() { executor = std::this_thread::get_id(); return ovms::Status(ovms::StatusCode::RESHAPE_ERROR); }), ovms::StatusCode::RESHAPE_ERROR);
+    EXPECT_NE(executor, caller);
+    EXPECT_THROW(workers.execute([]() -> ovms::Status { throw std::runtime_error("compilation failed"); }), std::runtime_error);
+    // Nested loads do not wait for other worker
+    EXPECT_EQ(workers.execute([&workers]() { return workers.execute([]() { return ovms::Status(ovms::StatusCode::OK); }); }), ovms::StatusCode::OK);
+}
+
+TEST_F(CompilationWorkersTest, ConcurrentCompilationsAreLimited) {
+    auto& workers = CompilationWorkers::instance();
+    ASSERT_EQ(workers.configure(2, "", 0, {}), ovms::StatusCode::OK);
+    std::atomic<int> running{0};
+    std::atomic<int> maxRunning{0};
+    std::vector<std::thread> callers;
+    for (int i = 0; i < 6; i++) {
+        callers.emplace_back([&]() {
+            workers.execute([&]() {
+                int current = ++running;
+                int expected = maxRunning.load();
+                while (current > expected && !maxRunning.compare_exchange_weak(expected, current)) {
+                }
+                std::this_thread::sleep_for(std::chrono::milliseconds(20));
+                --running;
+                return ovms::Status(ovms::StatusCode::OK);
+            });
+        });
+    }
+    for (auto& caller : callers) {
+        caller.join();
+    }
+    EXPECT_EQ(maxRunning.load(), 2);
+}
+
+TEST_F(CompilationWorkersTest, ThreadsCreatedDuringCompilationGetServingCores) {
+    auto available = ovms::CorePartitioning::getAvailableCores();
+    if (available.size() < 2) {
+        GTEST_SKIP() << "At least 2 cores are required";
+    }
+    auto& workers = CompilationWorkers::instance();
+    ASSERT_EQ(workers.configure(1, std::to_string(available.front()), 0, {}), ovms::StatusCode::OK);
+    int workerCores = 0;
+    std::atomic<pid_t> createdThreadId{0};
+    std::atomic<bool> release{false};
+    std::thread created;
+    workers.execute([&]() {
+        cpu_set_t set;
+        sched_getaffinity(0, sizeof(set), &set);
+        workerCores = CPU_COUNT(&set);
+        // Simulates inference stream thread created by plugin while compiling
+        created = std::thread([&]() {
+            createdThreadId = static_cast<pid_t>(syscall(SYS_gettid));
+            while (!release) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        });
+        while (createdThreadId == 0) {
+            std::this_thread::yield();
+        }
+        return ovms::Status(ovms::StatusCode::OK);
+    });
+    // Affinity is restored before the result is returned, so inference started right after load uses serving cores
+    cpu_set_t set;
+    ASSERT_EQ(sched_getaffinity(createdThreadId, sizeof(set), &set), 0);
+    release = true;
+    created.join();
+    EXPECT_EQ(workerCores, 1);
+    EXPECT_EQ(CPU_COUNT(&set), static_cast<int>(available.size()));
+}
+
+TEST_F(CompilationWorkersTest, LoadsInCallingThreadGuardRunInCallingThread) {
+    auto& workers = CompilationWorkers::instance();
+    ASSERT_EQ(workers.configure(1, "", 0, {}), ovms::StatusCode::OK);
+    const auto caller = std::this_thread::get_id();
+    std::thread::id executor;
+    {
+        CompilationWorkers::CallingThreadGuard guard;
+        EXPECT_EQ(workers.execute([&executor]() { executor = std::this_thread::get_id(); return ovms::Status(ovms::StatusCode::OK); }), ovms::StatusCode::OK);
+    }
+    EXPECT_EQ(executor, caller);
+    EXPECT_EQ(workers.execute([&executor]() { executor = std::this_thread::get_id(); return ovms::Status(ovms::StatusCode::OK); }), ovms::StatusCode::OK);
+    EXPECT_NE(executor, caller);
+}
+
+TEST_F(CompilationWorkersTest, CompilationParallelismIsBoundByCompilationCores) {
+    auto available = ovms::CorePartitioning::getAvailableCores();
+    auto& workers = CompilationWorkers::instance();
+    ASSERT_EQ(workers.configure(1, std::to_string(available.front()), 0, {}), ovms::StatusCode::OK);
+    int concurrency = 0;
+    std::mutex mtx;
+    std::set<int> usedCoresCounts;
+    workers.execute([&]() {
+        concurrency = tbb::this_task_arena::max_concurrency();
+        // Simulates parallel part of compilation
+        tbb::parallel_for(0, 64, [&](int) {
+            cpu_set_t set;
+            sched_getaffinity(0, sizeof(set), &set);
+            std::lock_guard<std::mutex> lock(mtx);
+            usedCoresCounts.insert(CPU_COUNT(&set));
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        });
+        return ovms::Status(ovms::StatusCode::OK);
+    });
+    EXPECT_EQ(concurrency, 1);
+    EXPECT_EQ(usedCoresCounts, std::set<int>{1});
+}
@@ -0,0 +1,66 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include <map>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "../core_partitioning.hpp"
+
+using ovms::CorePartitioning;
+using ovms::ThreadRole;
+
+TEST(CorePartitioning, ParseRatios) {
+    std::map<ThreadRole, uint32_t> ratios;
+    ASSERT_EQ(CorePartitioning::parseRatios("io=1, serialization=2,inference=5", ratios), ovms::StatusCode::OK);
+    EXPECT_EQ(ratios[ThreadRole::IO], 1);
+    EXPECT_EQ(ratios[ThreadRole::SERIALIZATION], 2);
+    EXPECT_EQ(ratios[ThreadRole::INFERENCE], 5);
+    ASSERT_EQ(CorePartitioning::parseRatios("io=1,inference=3", ratios), ovms::StatusCode::OK);
+    EXPECT_EQ(ratios[ThreadRole::SERIALIZATION], 0);
+    EXPECT_EQ(CorePartitioning::parseRatios("io=1", ratios), ovms::StatusCode::CORE_PARTITIONING_WRONG_FORMAT);
+    EXPECT_EQ(CorePartitioning::parseRatios("network=1,inference=3", ratios), ovms::StatusCode::CORE_PARTITIONING_WRONG_FORMAT);
+    EXPECT_EQ(CorePartitioning::parseRatios("io=a,inference=3", ratios), ovms::StatusCode::CORE_PARTITIONING_WRONG_FORMAT);
+    EXPECT_EQ(CorePartitioning::parseRatios("io:1,inference:3", ratios), ovms::StatusCode::CORE_PARTITIONING_WRONG_FORMAT);
+}
+
+TEST(CorePartitioning, CoresAreSplitByRatios) {
+    std::vector<int> cores{0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    std::map<ThreadRole, std::vector<int>> result;
+    ASSERT_TRUE(CorePartitioning::partition(cores, {{ThreadRole::IO, 1}, {ThreadRole::SERIALIZATION, 1}, {ThreadRole::INFERENCE, 3}}, result));
+    EXPECT_EQ(result[ThreadRole::IO], (std::vector<int>{0, 1}));
+    EXPECT_EQ(result[ThreadRole::SERIALIZATION], (std::vector<int>{2, 3}));
+    EXPECT_EQ(result[ThreadRole::INFERENCE], (std::vector<int>{4, 5, 6, 7, 8, 9}));
+}
+
+TEST(CorePartitioning, EachRoleGetsAtLeastOneCore) {
+    std::vector<int> cores{4, 5, 6, 7};
+    std::map<ThreadRole, std::vector<int>> result;
+    ASSERT_TRUE(CorePartitioning::partition(cores, {{ThreadRole::IO, 1}, {ThreadRole::SERIALIZATION, 1}, {ThreadRole::INFERENCE, 30}}, result));
+    EXPECT_EQ(result[ThreadRole::IO], (std::vector<int>{4}));
+    EXPECT_EQ(result[ThreadRole::SERIALIZATION], (std::vector<int>{5}));
+    EXPECT_EQ(result[ThreadRole::INFERENCE], (std::vector<int>{6, 7}));
+    EXPECT_FALSE(CorePartitioning::partition({0, 1}, {{ThreadRole::IO, 1}, {ThreadRole::SERIALIZATION, 1}, {ThreadRole::INFERENCE, 1}}, result));
+}
+
+TEST(CorePartitioning, RoleWithoutRatioSharesInferenceCores) {
+    std::vector<int> cores{0, 1, 2, 3};
+    std::map<ThreadRole, std::vector<int>> result;
+    ASSERT_TRUE(CorePartitioning::partition(cores, {{ThreadRole::IO, 1}, {ThreadRole::SERIALIZATION, 0}, {ThreadRole::INFERENCE, 3}}, result));
+    EXPECT_EQ(result[ThreadRole::IO], (std::vector<int>{0}));
+    EXPECT_EQ(result[ThreadRole::SERIALIZATION], (std::vector<int>{1, 2, 3}));
+    EXPECT_EQ(result[ThreadRole::INFERENCE], (std::vector<int>{1, 2, 3}));
+}
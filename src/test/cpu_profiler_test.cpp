@@ -0,0 +1,120 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "../cpu_profiler.hpp"
+
+using ovms::CpuProfiler;
+using ovms::CpuProfilerSample;
+using ovms::StatusCode;
+
+TEST(CpuProfiler, ParseRequestDefaults) {
+    std::chrono::seconds duration;
+    uint32_t frequency;
+    ASSERT_EQ(CpuProfiler::parseRequest("", duration, frequency), StatusCode::OK);
+    EXPECT_EQ(duration.count(), CpuProfiler::DEFAULT_DURATION_SECONDS);
+    EXPECT_EQ(frequency, CpuProfiler::DEFAULT_FREQUENCY);
+    ASSERT_EQ(CpuProfiler::parseRequest(R"({"duration_seconds": 2, "frequency": 500})", duration, frequency), StatusCode::OK);
+    EXPECT_EQ(duration.count(), 2);
+    EXPECT_EQ(frequency, 500);
+}
+
+TEST(CpuProfiler, ParseRequestInvalid) {
+    std::chrono::seconds duration;
+    uint32_t frequency;
+    EXPECT_EQ(CpuProfiler::parseRequest("{", duration, frequency), StatusCode::CPU_PROFILER_INVALID_PARAMETERS);
+    EXPECT_EQ(CpuProfiler::parseRequest(R"({"duration_seconds": 0})", duration, frequency), StatusCode::CPU_PROFILER_INVALID_PARAMETERS);
+    EXPECT_EQ(CpuProfiler::parseRequest(R"({"duration_seconds": 301})", duration, frequency), StatusCode::CPU_PROFILER_INVALID_PARAMETERS);
+    EXPECT_EQ(CpuProfiler::parseRequest(R"({"frequency": -5})", duration, frequency), StatusCode::CPU_PROFILER_INVALID_PARAMETERS);
+    EXPECT_EQ(CpuProfiler::parseRequest(R"({"frequency": "99"})", duration, frequency), StatusCode::CPU_PROFILER_INVALID_PARAMETERS);
+}
+
+TEST(CpuProfiler, FoldStacks) {
+    std::vector<std::vector<std::string>> stacks{
+        {"ovms", "main", "run"},
+        {"ovms", "main", "run"},
+        {"grpcpp_sync_ser", "infer"}};
+    EXPECT_EQ(CpuProfiler::foldStacks(stacks), "grpcpp_sync_ser;infer 1\novms;main;run 2\n");
+}
+
+TEST(CpuProfiler, WalkFramePointers) {
+    // Frames of three nested calls as laid out by function prologues: saved frame pointer followed by return address
+    uintptr_t stack[8] = {};
+    stack[2] = reinterpret_cast<uintptr_t>(&stack[4]);
+    stack[3] = 0x2000;
+    stack[4] = reinterpret_cast<uintptr_t>(&stack[6]);
+    stack[5] = 0x3000;
+    stack[6] = 0;
+    stack[7] = 0x4000;
+    void* frames[CpuProfilerSample::MAX_DEPTH];
+    const auto stackPointer = reinterpret_cast<uintptr_t>(&stack[0]);
+    const auto framePointer = reinterpret_cast<uintptr_t>(&stack[2]);
+    ASSERT_EQ(CpuProfiler::walkFramePointers(0x1000, framePointer, stackPointer, frames, CpuProfilerSample::MAX_DEPTH), 4);
+    EXPECT_EQ(frames[0], reinterpret_cast<void*>(0x1000));
+    EXPECT_EQ(frames[1], reinterpret_cast<void*>(0x2000));
+    EXPECT_EQ(frames[2], reinterpret_cast<void*>(0x3000));
+    EXPECT_EQ(frames[3], reinterpret_cast<void*>(0x4000));
+    EXPECT_EQ(CpuProfiler::walkFramePointers(0x1000, framePointer, stackPointer, frames, 2), 2);
+
+    // Frame pointer below stack pointer, misaligned or pointing to unmapped memory ends the walk without faulting
+    EXPECT_EQ(CpuProfiler::walkFramePointers(0x1000, stackPointer - sizeof(uintptr_t), stackPointer, frames, CpuProfilerSample::MAX_DEPTH), 1);
+    EXPECT_EQ(CpuProfiler::walkFramePointers(0x1000, framePointer + 1, stackPointer, frames, CpuProfilerSample::MAX_DEPTH), 1);
+    EXPECT_EQ(CpuProfiler::walkFramePointers(0x1000, 0x10, 0x8, frames, CpuProfilerSample::MAX_DEPTH), 1);
+    // Frame pointing back down the stack ends the walk
+    stack[4] = reinterpret_cast<uintptr_t>(&stack[2]);
+    EXPECT_EQ(CpuProfiler::walkFramePointers(0x1000, framePointer, stackPointer, frames, CpuProfilerSample::MAX_DEPTH), 3);
+}
+
+TEST(CpuProfiler, DisabledByDefault) {
+    std::string foldedStacks;
+    EXPECT_EQ(CpuProfiler::instance().profile(std::chrono::seconds(1), 99, foldedStacks), StatusCode::CPU_PROFILER_DISABLED);
+}
+
+TEST(CpuProfiler, SamplesBusyThread) {
+    auto& profiler = CpuProfiler::instance();
+    profiler.setEnabled(true);
+    std::atomic<bool> stop{false};
+    std::thread busy([&stop]() {
+        volatile uint64_t counter = 0;
+        while (!stop) {
+            counter = counter + 1;
+        }
+    });
+    std::string foldedStacks;
+    auto status = profiler.profile(std::chrono::seconds(1), 100, foldedStacks);
+    stop = true;
+    busy.join();
+    profiler.setEnabled(false);
+    ASSERT_EQ(status, StatusCode::OK);
+    EXPECT_FALSE(foldedStacks.empty());
+    EXPECT_NE(foldedStacks.find(" "), std::string::npos);
+}
+
+TEST(CpuProfiler, StartsWithMinimalFrequency) {
+    auto& profiler = CpuProfiler::instance();
+    profiler.setEnabled(true);
+    std::string foldedStacks;
+    auto status = profiler.profile(std::chrono::seconds(1), 1, foldedStacks);
+    profiler.setEnabled(false);
+    EXPECT_EQ(status, StatusCode::OK);
+}
@@ -260,6 +260,72 @@ TEST_F(EnsembleFlowTest, SeriesOfDummyModels) {
     std::cout << "compare results: " << timer.elapsed<std::chrono::microseconds>("compare results") / 1000 << "ms\n";
 }
 
+TEST_F(EnsembleFlowTest, StreamedOutputsAreWrittenWhenProducingNodeFinishes) {
+    // input   dummy    dummy   output
+    //  O------->O------->O------>O
+    //           |________________^ intermediate output
+    ConstructorEnabledModelManager managerWithDummyModel;
+    managerWithDummyModel.reloadModelWithVersions(config);
+
+    auto input_node = std::make_unique<EntryNode>(&request);
+    auto output_node = std::make_unique<ExitNode>(&response);
+    auto first_node = std::make_unique<DLNode>("dummy_node_0", dummyModelName, requestedModelVersion, managerWithDummyModel);
+    auto second_node = std::make_unique<DLNode>("dummy_node_1", dummyModelName, requestedModelVersion, managerWithDummyModel);
+
+    const std::string intermediateOutputName = "intermediate_dummy_output";
+    Pipeline pipeline(*input_node, *output_node);
+    pipeline.connect(*input_node, *first_node, {{customPipelineInputName, DUMMY_MODEL_INPUT_NAME}});
+    pipeline.connect(*first_node, *second_node, {{DUMMY_MODEL_OUTPUT_NAME, DUMMY_MODEL_INPUT_NAME}});
+    pipeline.connect(*first_node, *output_node, {{DUMMY_MODEL_OUTPUT_NAME, intermediateOutputName}});
+    pipeline.connect(*second_node, *output_node, {{DUMMY_MODEL_OUTPUT_NAME, customPipelineOutputName}});
+    pipeline.push(std::move(input_node));
+    pipeline.push(std::move(output_node));
+    pipeline.push(std::move(first_node));
+    pipeline.push(std::move(second_node));
+
+    std::vector<PredictResponse> streamedResponses;
+    pipeline.setOutputsWriter([&streamedResponses](PredictResponse& streamedResponse) -> ovms::Status {
+        streamedResponses.push_back(streamedResponse);
+        return ovms::StatusCode::OK;
+    });
+    ASSERT_EQ(pipeline.execute(), ovms::StatusCode::OK);
+
+    // Outputs are not serialized again to the response of exit node
+    EXPECT_EQ(response.outputs().size(), 0);
+    ASSERT_EQ(streamedResponses.size(), 2);
+    ASSERT_EQ(streamedResponses[0].outputs().size(), 1);
+    ASSERT_EQ(streamedResponses[0].outputs().count(intermediateOutputName), 1);
+    response = streamedResponses[1];
+    checkResponse(2);
+
+    auto expectedIntermediateData = requestData;
+    std::for_each(expectedIntermediateData.begin(), expectedIntermediateData.end(), [](float& v) { v += 1.0; });
+    const auto& intermediateProto = streamedResponses[0].outputs().at(intermediateOutputName);
+    ASSERT_EQ(intermediateProto.tensor_content().size(), DUMMY_MODEL_OUTPUT_SIZE * sizeof(float));
+    EXPECT_EQ(0, std::memcmp(intermediateProto.tensor_content().data(), expectedIntermediateData.data(), DUMMY_MODEL_OUTPUT_SIZE * sizeof(float)));
+}
+
+TEST_F(EnsembleFlowTest, ClosedOutputsStreamFailsPipeline) {
+    ConstructorEnabledModelManager managerWithDummyModel;
+    managerWithDummyModel.reloadModelWithVersions(config);
+
+    auto input_node = std::make_unique<EntryNode>(&request);
+    auto output_node = std::make_unique<ExitNode>(&response);
+    auto dummy_node = std::make_unique<DLNode>("dummy_node", dummyModelName, requestedModelVersion, managerWithDummyModel);
+
+    Pipeline pipeline(*input_node, *output_node);
+    pipeline.connect(*input_node, *dummy_node, {{customPipelineInputName, DUMMY_MODEL_INPUT_NAME}});
+    pipeline.connect(*dummy_node, *output_node, {{DUMMY_MODEL_OUTPUT_NAME, customPipelineOutputName}});
+    pipeline.push(std::move(input_node));
+    pipeline.push(std::move(output_node));
+    pipeline.push(std::move(dummy_node));
+
+    pipeline.setOutputsWriter([](PredictResponse&) -> ovms::Status {
+        return ovms::StatusCode::PIPELINE_STREAM_CLOSED;
+    });
+    EXPECT_EQ(pipeline.execute(), ovms::StatusCode::PIPELINE_STREAM_CLOSED);
+}
+
 TEST_F(EnsembleFlowTest, ExecutePipelineWithDynamicBatchSize) {
     // Scenario
 
@@ -546,6 +612,254 @@ TEST_F(EnsembleFlowTest, ParallelDummyModels) {
     }
 }
 
+TEST_F(EnsembleFlowTest, ParallelDummyModelsWithPipelineBatching) {
+    // Nodes with batch size 1 inputs are merged into batched inferences of dummy model with batch size 4
+    const int N = 10;
+    /* input      dummy x N      output
+        O---------->O------------->O
+        ...        ...            /\
+        L---------->O-------------_|
+    */
+    config.setBatchingParams("4");
+    config.setPipelineBatchingTimeoutMs(5);
+    ConstructorEnabledModelManager managerWithDummyModel;
+    managerWithDummyModel.reloadModelWithVersions(config);
+    ASSERT_NE(managerWithDummyModel.findModelInstance(dummyModelName)->getNodeBatcher(), nullptr);
+    // Configure pipeline
+    auto input_node = std::make_unique<EntryNode>(&request);
+    auto output_node = std::make_unique<ExitNode>(&response);
+    Pipeline pipeline(*input_node, *output_node);
+    std::unique_ptr<DLNode> dummy_nodes[N];
+
+    for (int i = 0; i < N; i++) {
+        dummy_nodes[i] = std::make_unique<DLNode>("dummy_node_" + std::to_string(i), dummyModelName, requestedModelVersion, managerWithDummyModel);
+        pipeline.connect(*input_node, *(dummy_nodes[i]), {{customPipelineInputName + std::to_string(i), DUMMY_MODEL_INPUT_NAME}});
+        pipeline.connect(*(dummy_nodes[i]), *output_node, {{DUMMY_MODEL_OUTPUT_NAME, customPipelineOutputName + std::to_string(i)}});
+        pipeline.push(std::move(dummy_nodes[i]));
+    }
+    pipeline.push(std::move(input_node));
+    pipeline.push(std::move(output_node));
+
+    // Prepare request
+    std::vector<float> requestDataT(N * DUMMY_MODEL_INPUT_SIZE);
+    for (int i = 0; i < N; ++i) {
+        std::transform(requestData.begin(),
+            requestData.end(),
+            requestDataT.begin() + DUMMY_MODEL_INPUT_SIZE * i,
+            [i](int x) { return x + i; });
+    }
+    for (int i = 0; i < N; i++) {
+        tensorflow::TensorProto& proto = (*request.mutable_inputs())[customPipelineInputName + std::to_string(i)];
+        proto.set_dtype(tensorflow::DataType::DT_FLOAT);
+        proto.mutable_tensor_content()->assign((char*)(requestDataT.data() + i * DUMMY_MODEL_INPUT_SIZE),
+            DUMMY_MODEL_INPUT_SIZE * sizeof(float));
+        proto.mutable_tensor_shape()->add_dim()->set_size(1);
+        proto.mutable_tensor_shape()->add_dim()->set_size(10);
+    }
+    ASSERT_EQ(pipeline.execute(), ovms::StatusCode::OK);
+    std::transform(requestDataT.begin(), requestDataT.end(), requestDataT.begin(), [](float& v) { return v + 1.0; });
+
+    float* expected_output = requestDataT.data();
+    for (int i = 0; i < N; i++) {
+        ASSERT_EQ(response.outputs().count(customPipelineOutputName + std::to_string(i)), 1);
+        const auto& output_proto = response.outputs().at(customPipelineOutputName + std::to_string(i));
+        ASSERT_EQ(output_proto.tensor_shape().dim(0).size(), 1);
+        float* actual_output = (float*)output_proto.tensor_content().data();
+        const int dataLengthToCheck = DUMMY_MODEL_OUTPUT_SIZE * sizeof(float);
+        const float* expected_output_address_to_check = expected_output + i * DUMMY_MODEL_OUTPUT_SIZE;
+        EXPECT_EQ(0, std::memcmp(actual_output, expected_output_address_to_check, dataLengthToCheck))
+            << "Comparison on node:" << i << " output failed" << std::endl
+            << readableError(expected_output_address_to_check, actual_output, DUMMY_MODEL_OUTPUT_SIZE);
+    }
+}
+
+TEST_F(EnsembleFlowTest, PipelineBatchingDoesNotWriteToBlobsSetByOtherRequests) {
+    // Predicts and non batched nodes set blobs they own on shared infer requests, batched inference must not write to them
+    const int N = 3;
+    config.setBatchingParams("4");
+    config.setNireq(1);
+    config.setPipelineBatchingTimeoutMs(5);
+    ConstructorEnabledModelManager managerWithDummyModel;
+    managerWithDummyModel.reloadModelWithVersions(config);
+    auto modelInstance = managerWithDummyModel.findModelInstance(dummyModelName);
+    ASSERT_NE(modelInstance->getNodeBatcher(), nullptr);
+    std::vector<float> externalData(4 * DUMMY_MODEL_INPUT_SIZE, 7.0);
+    modelInstance->getInferRequestsQueue().getInferRequest(0).SetBlob(DUMMY_MODEL_INPUT_NAME,
+        InferenceEngine::make_shared_blob<float>(
+            InferenceEngine::TensorDesc(InferenceEngine::Precision::FP32, {4, DUMMY_MODEL_INPUT_SIZE}, InferenceEngine::Layout::NC),
+            externalData.data()));
+
+    auto input_node = std::make_unique<EntryNode>(&request);
+    auto output_node = std::make_unique<ExitNode>(&response);
+    Pipeline pipeline(*input_node, *output_node);
+    for (int i = 0; i < N; i++) {
+        auto dummy_node = std::make_unique<DLNode>("dummy_node_" + std::to_string(i), dummyModelName, requestedModelVersion, managerWithDummyModel);
+        pipeline.connect(*input_node, *dummy_node, {{customPipelineInputName + std::to_string(i), DUMMY_MODEL_INPUT_NAME}});
+        pipeline.connect(*dummy_node, *output_node, {{DUMMY_MODEL_OUTPUT_NAME, customPipelineOutputName + std::to_string(i)}});
+        pipeline.push(std::move(dummy_node));
+    }
+    pipeline.push(std::move(input_node));
+    pipeline.push(std::move(output_node));
+    for (int i = 0; i < N; i++) {
+        std::vector<float> data(DUMMY_MODEL_INPUT_SIZE, static_cast<float>(i));
+        tensorflow::TensorProto& proto = (*request.mutable_inputs())[customPipelineInputName + std::to_string(i)];
+        proto.set_dtype(tensorflow::DataType::DT_FLOAT);
+        proto.mutable_tensor_content()->assign((char*)data.data(), data.size() * sizeof(float));
+        proto.mutable_tensor_shape()->add_dim()->set_size(1);
+        proto.mutable_tensor_shape()->add_dim()->set_size(DUMMY_MODEL_INPUT_SIZE);
+    }
+    ASSERT_EQ(pipeline.execute(), ovms::StatusCode::OK);
+    for (int i = 0; i < N; i++) {
+        ASSERT_EQ(response.outputs().count(customPipelineOutputName + std::to_string(i)), 1);
+        EXPECT_EQ(asVector<float>(response.outputs().at(customPipelineOutputName + std::to_string(i)).tensor_content()),
+            std::vector<float>(DUMMY_MODEL_OUTPUT_SIZE, i + 1.0f));
+    }
+    EXPECT_EQ(externalData, std::vector<float>(4 * DUMMY_MODEL_INPUT_SIZE, 7.0));
+}
+
+TEST(NodeBatcher, OnlyBatchFirstInputsCanBeBatched) {
+    ovms::tensor_map_t inputs;
+    inputs["b"] = std::make_shared<ovms::TensorInfo>("b", InferenceEngine::Precision::FP32, ovms::shape_t{4, 10}, InferenceEngine::Layout::NC);
+    EXPECT_EQ(ovms::NodeBatcher::checkInputsBatchable(inputs, 4), ovms::StatusCode::OK);
+    EXPECT_EQ(ovms::NodeBatcher::checkInputsBatchable(inputs, 2), ovms::StatusCode::INVALID_BATCH_SIZE);
+    inputs["c"] = std::make_shared<ovms::TensorInfo>("c", InferenceEngine::Precision::FP32, ovms::shape_t{10, 4}, InferenceEngine::Layout::CN);
+    EXPECT_EQ(ovms::NodeBatcher::checkInputsBatchable(inputs, 4), ovms::StatusCode::INVALID_SHAPE);
+}
+
+TEST_F(EnsembleFlowTest, ClosedGateSkipsDependantNodes) {
+    // Dummy node 2 is executed only if any of dummy node 1 outputs exceeds threshold
+    // input   dummy_1    dummy_2    output
+    //  O------->O---[gate]-->O------->O
+    //           |                     ^
+    //           +---------------------+
+    ConstructorEnabledModelManager managerWithDummyModel;
+    managerWithDummyModel.reloadModelWithVersions(config);
+
+    const std::string gatedPipelineOutputName = "gated_dummy_output";
+    for (float threshold : {0.0f, 1000.0f}) {
+        response.Clear();
+        auto input_node = std::make_unique<EntryNode>(&request);
+        auto dummy_node_1 = std::make_unique<DLNode>("dummy_node_1", dummyModelName, requestedModelVersion, managerWithDummyModel,
+            std::unordered_map<std::string, std::string>{}, NodeGate(DUMMY_MODEL_OUTPUT_NAME, threshold));
+        auto dummy_node_2 = std::make_unique<DLNode>("dummy_node_2", dummyModelName, requestedModelVersion, managerWithDummyModel);
+        auto output_node = std::make_unique<ExitNode>(&response);
+
+        Pipeline pipeline(*input_node, *output_node);
+        pipeline.connect(*input_node, *dummy_node_1, {{customPipelineInputName, DUMMY_MODEL_INPUT_NAME}});
+        pipeline.connect(*dummy_node_1, *dummy_node_2, {{DUMMY_MODEL_OUTPUT_NAME, DUMMY_MODEL_INPUT_NAME}});
+        pipeline.connect(*dummy_node_1, *output_node, {{DUMMY_MODEL_OUTPUT_NAME, customPipelineOutputName}});
+        pipeline.connect(*dummy_node_2, *output_node, {{DUMMY_MODEL_OUTPUT_NAME, gatedPipelineOutputName}});
+
+        pipeline.push(std::move(input_node));
+        pipeline.push(std::move(dummy_node_1));
+        pipeline.push(std::move(dummy_node_2));
+        pipeline.push(std::move(output_node));
+
+        ASSERT_EQ(pipeline.execute(), StatusCode::OK);
+        checkResponse(1);
+        const bool isGateOpen = threshold < *std::max_element(requestData.begin(), requestData.end()) + 1.0f;
+        EXPECT_EQ(response.outputs().count(gatedPipelineOutputName), isGateOpen ? 1 : 0) << "threshold: " << threshold;
+    }
+}
+
+TEST_F(EnsembleFlowTest, PipelineDefinitionNodesWithGateOutputMissingValidation) {
+    ConstructorEnabledModelManager managerWithDummyModel;
+    managerWithDummyModel.reloadModelWithVersions(config);
+
+    std::vector<NodeInfo> info{
+        {NodeKind::ENTRY, "request"},
+        {NodeKind::DL, "dummy_node", "dummy", std::nullopt, {}, NodeGate("MISSING")},
+        {NodeKind::EXIT, "response"},
+    };
+
+    std::unordered_map<std::string, std::unordered_map<std::string, InputPairs>> connections;
+
+    connections["dummy_node"] = {
+        {"request", {{customPipelineInputName, DUMMY_MODEL_INPUT_NAME}}}};
+
+    connections["response"] = {
+        {"dummy_node", {{DUMMY_MODEL_OUTPUT_NAME, customPipelineOutputName}}}};
+
+    std::unique_ptr<PipelineDefinition> pipelineDefinition = std::make_unique<PipelineDefinition>("my_new_pipeline", info, connections);
+    ASSERT_EQ(pipelineDefinition->validateNodes(managerWithDummyModel), StatusCode::INVALID_MISSING_OUTPUT);
+}
+
+TEST_F(EnsembleFlowTest, ParallelDummyModelsWithResultsCache) {
+    // Nodes with the same model and inputs share single inference
+    // input    dummy x 2    output
+    //  O---------->O---------->O
+    //  |                       ^
+    //  L---------->O-----------|
+    config.setResultsCacheSize(10);
+    ConstructorEnabledModelManager managerWithDummyModel;
+    managerWithDummyModel.reloadModelWithVersions(config);
+    auto cache = managerWithDummyModel.findModelInstance(dummyModelName)->getNodeResultsCache();
+    ASSERT_NE(cache, nullptr);
+
+    const std::string secondPipelineOutputName = "second_dummy_output";
+    for (int i = 0; i < 2; i++) {
+        response.Clear();
+        auto input_node = std::make_unique<EntryNode>(&request);
+        auto dummy_node_1 = std::make_unique<DLNode>("dummy_node_1", dummyModelName, requestedModelVersion, managerWithDummyModel);
+        auto dummy_node_2 = std::make_unique<DLNode>("dummy_node_2", dummyModelName, requestedModelVersion, managerWithDummyModel);
+        auto output_node = std::make_unique<ExitNode>(&response);
+
+        Pipeline pipeline(*input_node, *output_node);
+        pipeline.connect(*input_node, *dummy_node_1, {{customPipelineInputName, DUMMY_MODEL_INPUT_NAME}});
+        pipeline.connect(*input_node, *dummy_node_2, {{customPipelineInputName, DUMMY_MODEL_INPUT_NAME}});
+        pipeline.connect(*dummy_node_1, *output_node, {{DUMMY_MODEL_OUTPUT_NAME, customPipelineOutputName}});
+        pipeline.connect(*dummy_node_2, *output_node, {{DUMMY_MODEL_OUTPUT_NAME, secondPipelineOutputName}});
+
+        pipeline.push(std::move(input_node));
+        pipeline.push(std::move(dummy_node_1));
+        pipeline.push(std::move(dummy_node_2));
+        pipeline.push(std::move(output_node));
+
+        ASSERT_EQ(pipeline.execute(), StatusCode::OK);
+        checkResponse(1);
+        ASSERT_EQ(response.outputs().count(secondPipelineOutputName), 1);
+        EXPECT_EQ(response.outputs().at(secondPipelineOutputName).tensor_content(), response.outputs().at(customPipelineOutputName).tensor_content());
+        EXPECT_EQ(cache->getSize(), 1);
+    }
+}
+
+TEST_F(EnsembleFlowTest, BatchedDummyModelRunsInferenceWhenCachedResultsProducerFails) {
+    // Node waiting for results of the same inference runs batched inference itself when producer fails
+    config.setResultsCacheSize(10);
+    config.setBatchingParams("4");
+    config.setPipelineBatchingTimeoutMs(5);
+    ConstructorEnabledModelManager managerWithDummyModel;
+    managerWithDummyModel.reloadModelWithVersions(config);
+    auto cache = managerWithDummyModel.findModelInstance(dummyModelName)->getNodeResultsCache();
+    ASSERT_NE(cache, nullptr);
+    ASSERT_NE(managerWithDummyModel.findModelInstance(dummyModelName)->getNodeBatcher(), nullptr);
+
+    // Simulate other pipeline producing results for the same inputs
+    const InferenceEngine::TensorDesc desc{InferenceEngine::Precision::FP32, {1, DUMMY_MODEL_INPUT_SIZE}, InferenceEngine::Layout::NC};
+    std::shared_ptr<NodeResultsCacheEntry> producerEntry;
+    ASSERT_EQ(cache->acquire({{DUMMY_MODEL_INPUT_NAME, InferenceEngine::make_shared_blob<float>(desc, requestData.data())}}, producerEntry, []() {}),
+        NodeResultsCache::Lookup::MISS);
+
+    auto input_node = std::make_unique<EntryNode>(&request);
+    auto dummy_node = std::make_unique<DLNode>("dummy_node", dummyModelName, requestedModelVersion, managerWithDummyModel);
+    auto output_node = std::make_unique<ExitNode>(&response);
+    Pipeline pipeline(*input_node, *output_node);
+    pipeline.connect(*input_node, *dummy_node, {{customPipelineInputName, DUMMY_MODEL_INPUT_NAME}});
+    pipeline.connect(*dummy_node, *output_node, {{DUMMY_MODEL_OUTPUT_NAME, customPipelineOutputName}});
+    pipeline.push(std::move(input_node));
+    pipeline.push(std::move(dummy_node));
+    pipeline.push(std::move(output_node));
+
+    Status status;
+    std::thread pipelineThread([&pipeline, &status]() { status = pipeline.execute(); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    cache->complete(producerEntry, StatusCode::OV_INTERNAL_INFERENCE_ERROR);
+    pipelineThread.join();
+
+    ASSERT_EQ(status, StatusCode::OK);
+    checkResponse(1);
+}
+
 TEST_F(EnsembleFlowTest, FailInDLNodeSetInputsMissingInput) {
     // Most basic configuration, just process single dummy model request
 
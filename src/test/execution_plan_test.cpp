@@ -0,0 +1,134 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include <memory>
+#include <string>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wall"
+#include "tensorflow_serving/apis/prediction_service.grpc.pb.h"
+#pragma GCC diagnostic pop
+
+#include "../execution_plan.hpp"
+#include "ovtestutils.hpp"
+
+using tensorflow::TensorProto;
+
+using tensorflow::serving::PredictRequest;
+using tensorflow::serving::PredictResponse;
+
+using InferenceEngine::Precision;
+
+using namespace ovms;
+
+using testing::_;
+using testing::NiceMock;
+
+class ExecutionPlanTest : public ::testing::Test {
+protected:
+    std::shared_ptr<TensorInfo> makeTensorInfo(const std::string& name, const std::string& mapping, Precision precision) {
+        return std::make_shared<TensorInfo>(name, mapping, precision, shape_t{1, 2}, InferenceEngine::Layout::NC);
+    }
+
+    tensor_map_t inputsInfo;
+    tensor_map_t outputsInfo;
+};
+
+TEST_F(ExecutionPlanTest, ConversionKernelSelectedForSupportedInputPrecisions) {
+    for (auto precision : {Precision::FP32, Precision::FP16, Precision::U8, Precision::I8, Precision::U16, Precision::I16, Precision::I32}) {
+        EXPECT_NE(getInputConversionKernel(precision), nullptr) << precision;
+    }
+    for (auto precision : {Precision::I64, Precision::MIXED, Precision::Q78, Precision::BIN, Precision::BOOL}) {
+        EXPECT_EQ(getInputConversionKernel(precision), nullptr) << precision;
+    }
+}
+
+TEST_F(ExecutionPlanTest, DeserializeMissingInputShouldFail) {
+    inputsInfo["input"] = makeTensorInfo("input", "", Precision::FP32);
+    ExecutionPlan plan(inputsInfo, outputsInfo);
+    std::shared_ptr<MockIInferRequest> mInferRequestPtr = std::make_shared<MockIInferRequest>();
+    InferenceEngine::InferRequest inferRequest(mInferRequestPtr);
+    PredictRequest request;
+    EXPECT_EQ(plan.deserialize(request, inferRequest), StatusCode::INTERNAL_ERROR);
+}
+
+TEST_F(ExecutionPlanTest, DeserializeUnsupportedPrecisionShouldFail) {
+    inputsInfo["input"] = makeTensorInfo("input", "", Precision::I64);
+    ExecutionPlan plan(inputsInfo, outputsInfo);
+    std::shared_ptr<MockIInferRequest> mInferRequestPtr = std::make_shared<MockIInferRequest>();
+    InferenceEngine::InferRequest inferRequest(mInferRequestPtr);
+    PredictRequest request;
+    (*request.mutable_inputs())["input"].mutable_tensor_content()->assign(16, '1');
+    EXPECT_EQ(plan.deserialize(request, inferRequest), StatusCode::OV_UNSUPPORTED_DESERIALIZATION_PRECISION);
+}
+
+TEST_F(ExecutionPlanTest, DeserializeShouldSetBlobOfNetworkInput) {
+    inputsInfo["input_mapped"] = makeTensorInfo("input", "input_mapped", Precision::FP32);
+    ExecutionPlan plan(inputsInfo, outputsInfo);
+    std::shared_ptr<MockIInferRequest> mInferRequestPtr = std::make_shared<MockIInferRequest>();
+    InferenceEngine::InferRequest inferRequest(mInferRequestPtr);
+    PredictRequest request;
+    (*request.mutable_inputs())["input_mapped"].mutable_tensor_content()->assign(2 * sizeof(float), '1');
+    EXPECT_CALL(*mInferRequestPtr, SetBlob(testing::StrEq("input"), _, _));
+    EXPECT_EQ(plan.deserialize(request, inferRequest), StatusCode::OK);
+}
+
+TEST_F(ExecutionPlanTest, DeserializeShouldUseDecodedContentOfEncodedInput) {
+    inputsInfo["input"] = makeTensorInfo("input", "", Precision::FP32);
+    ExecutionPlan plan(inputsInfo, outputsInfo);
+    std::shared_ptr<MockIInferRequest> mInferRequestPtr = std::make_shared<MockIInferRequest>();
+    InferenceEngine::InferRequest inferRequest(mInferRequestPtr);
+    PredictRequest request;
+    (*request.mutable_inputs())["input"].mutable_tensor_content()->assign("encoded");
+    DecodedInputs decodedInputs{{"input", std::string(2 * sizeof(float), '1')}};
+    const void* blobData = nullptr;
+    EXPECT_CALL(*mInferRequestPtr, SetBlob(testing::StrEq("input"), _, _))
+        .WillOnce(testing::Invoke([&blobData](const char*, const InferenceEngine::Blob::Ptr& blob, InferenceEngine::ResponseDesc*) {
+            blobData = blob->cbuffer().as<const void*>();
+            return InferenceEngine::StatusCode::OK;
+        }));
+    EXPECT_EQ(plan.deserialize(request, inferRequest, nullptr, 0, &decodedInputs), StatusCode::OK);
+    EXPECT_EQ(blobData, decodedInputs.at("input").data());
+}
+
+TEST_F(ExecutionPlanTest, SerializeShouldUsePrebuiltDtypeAndShape) {
+    outputsInfo["output"] = makeTensorInfo("output", "output_mapped", Precision::FP32);
+    ExecutionPlan plan(inputsInfo, outputsInfo);
+    InferenceEngine::TensorDesc tensorDesc(Precision::FP32, shape_t{1, 2}, InferenceEngine::Layout::NC);
+    std::shared_ptr<MockIInferRequestProperGetBlob> mInferRequestPtr =
+        std::make_shared<MockIInferRequestProperGetBlob>(tensorDesc);
+    InferenceEngine::InferRequest inferRequest(mInferRequestPtr);
+    EXPECT_CALL(*mInferRequestPtr, GetBlob_mocked(_, _, _));
+    PredictResponse response;
+    ASSERT_EQ(plan.serialize(inferRequest, &response), StatusCode::OK);
+    ASSERT_EQ(response.outputs().count("output_mapped"), 1);
+    const auto& output = response.outputs().at("output_mapped");
+    EXPECT_EQ(output.dtype(), tensorflow::DT_FLOAT);
+    ASSERT_EQ(output.tensor_shape().dim_size(), 2);
+    EXPECT_EQ(output.tensor_shape().dim(0).size(), 1);
+    EXPECT_EQ(output.tensor_shape().dim(1).size(), 2);
+}
+
+TEST_F(ExecutionPlanTest, SerializeUnsupportedPrecisionShouldFail) {
+    outputsInfo["output"] = makeTensorInfo("output", "", Precision::BOOL);
+    ExecutionPlan plan(inputsInfo, outputsInfo);
+    std::shared_ptr<MockIInferRequest> mInferRequestPtr = std::make_shared<MockIInferRequest>();
+    InferenceEngine::InferRequest inferRequest(mInferRequestPtr);
+    PredictResponse response;
+    EXPECT_EQ(plan.serialize(inferRequest, &response), StatusCode::OV_UNSUPPORTED_SERIALIZATION_PRECISION);
+}
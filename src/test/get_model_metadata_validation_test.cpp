@@ -57,3 +57,9 @@ TEST_F(GetModelMetadataValidation, RequestMetadataInvalidSignatureName) {
     auto status = ovms::GetModelMetadataImpl::validate(&request);
     EXPECT_EQ(status, ovms::StatusCode::INVALID_SIGNATURE_DEF);
 }
+
+TEST_F(GetModelMetadataValidation, ValidProfileRequest) {
+    request.mutable_metadata_field()->at(0) = "profile";
+    auto status = ovms::GetModelMetadataImpl::validate(&request);
+    EXPECT_TRUE(status.ok());
+}
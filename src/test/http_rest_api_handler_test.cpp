@@ -0,0 +1,278 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <rapidjson/document.h>
+
+#include "../http_rest_api_handler.hpp"
+#include "../status.hpp"
+#include "test_utils.hpp"
+
+using namespace ovms;
+
+namespace {
+std::string createDummyPredictItem(float value, const std::string& modelName = "dummy", const std::string& extraFields = "") {
+    std::string item = "{\"model_name\": \"" + modelName + "\"" + extraFields + ", \"inputs\": {\"b\": [[";
+    for (int i = 0; i < DUMMY_MODEL_INPUT_SIZE; i++) {
+        item += (i > 0 ? ", " : "") + std::to_string(value);
+    }
+    return item + "]]}}";
+}
+
+std::string createBatchPredictRequest(const std::vector<std::string>& items) {
+    std::string request = "{\"requests\": [";
+    for (size_t i = 0; i < items.size(); i++) {
+        request += (i > 0 ? ", " : "") + items[i];
+    }
+    return request + "]}";
+}
+}  // namespace
+
+class HttpRestApiHandlerBatchPredictTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        ModelConfig config = DUMMY_MODEL_CONFIG;
+        ASSERT_EQ(manager.reloadModelWithVersions(config), StatusCode::OK);
+    }
+
+    void processBatch(const std::vector<std::string>& items) {
+        std::string response;
+        ASSERT_EQ(handler.processBatchPredictRequest(createBatchPredictRequest(items), &response), StatusCode::OK);
+        ASSERT_FALSE(responseDoc.Parse(response.c_str()).HasParseError()) << response;
+        ASSERT_TRUE(responseDoc.HasMember("responses"));
+        ASSERT_TRUE(responseDoc["responses"].IsArray());
+        ASSERT_EQ(responseDoc["responses"].Size(), items.size());
+    }
+
+    void checkDummyOutput(rapidjson::SizeType index, float requestValue) {
+        const auto& item = responseDoc["responses"][index];
+        ASSERT_TRUE(item.HasMember("outputs")) << "item: " << index;
+        const auto& outputs = item["outputs"];
+        ASSERT_TRUE(outputs.IsArray());
+        ASSERT_EQ(outputs.Size(), 1u);
+        ASSERT_EQ(outputs[0].Size(), static_cast<rapidjson::SizeType>(DUMMY_MODEL_OUTPUT_SIZE));
+        for (const auto& value : outputs[0].GetArray()) {
+            EXPECT_EQ(value.GetFloat(), requestValue + 1) << "item: " << index;
+        }
+    }
+
+    void checkError(rapidjson::SizeType index, StatusCode code) {
+        const auto& item = responseDoc["responses"][index];
+        ASSERT_TRUE(item.HasMember("error")) << "item: " << index;
+        // Error message may be followed by details
+        EXPECT_THAT(item["error"].GetString(), ::testing::StartsWith(Status(code).string())) << "item: " << index;
+    }
+
+    ConstructorEnabledModelManager manager;
+    HttpRestApiHandler handler{5000, manager};
+    rapidjson::Document responseDoc;
+};
+
+TEST_F(HttpRestApiHandlerBatchPredictTest, ResponsesInRequestsOrder) {
+    const size_t count = 50;
+    std::vector<std::string> items;
+    for (size_t i = 0; i < count; i++) {
+        items.push_back(createDummyPredictItem(i));
+    }
+    processBatch(items);
+    for (size_t i = 0; i < count; i++) {
+        checkDummyOutput(i, i);
+    }
+}
+
+TEST_F(HttpRestApiHandlerBatchPredictTest, FailedItemsDoNotFailBatch) {
+    processBatch({createDummyPredictItem(1),
+        createDummyPredictItem(2, "missing_model"),
+        R"({"inputs": {"b": [[1, 2, 3, 4, 5, 6, 7, 8, 9, 10]]}})",
+        "5",
+        R"({"model_name": "dummy", "inputs": {"b": [[1, 2, 3]]}})",
+        createDummyPredictItem(3)});
+    checkDummyOutput(0, 1);
+    checkError(1, StatusCode::MODEL_NAME_MISSING);
+    checkError(2, StatusCode::MODEL_NAME_MISSING);
+    checkError(3, StatusCode::REST_BODY_IS_NOT_AN_OBJECT);
+    checkError(4, StatusCode::INVALID_SHAPE);
+    checkDummyOutput(5, 3);
+}
+
+TEST_F(HttpRestApiHandlerBatchPredictTest, ModelVersion) {
+    processBatch({createDummyPredictItem(1, "dummy", ", \"model_version\": 1"),
+        createDummyPredictItem(2, "dummy", ", \"model_version\": 2"),
+        createDummyPredictItem(3, "dummy", ", \"model_version\": \"1\""),
+        createDummyPredictItem(4, "dummy", ", \"model_version\": 1.5")});
+    checkDummyOutput(0, 1);
+    checkError(1, StatusCode::MODEL_VERSION_MISSING);
+    checkError(2, StatusCode::REST_COULD_NOT_PARSE_VERSION);
+    checkError(3, StatusCode::REST_COULD_NOT_PARSE_VERSION);
+}
+
+TEST_F(HttpRestApiHandlerBatchPredictTest, RequestsCountLimit) {
+    std::vector<std::string> items(HttpRestApiHandler::MAX_BATCH_PREDICT_REQUESTS, createDummyPredictItem(1));
+    processBatch(items);
+    checkDummyOutput(HttpRestApiHandler::MAX_BATCH_PREDICT_REQUESTS - 1, 1);
+
+    items.push_back(createDummyPredictItem(1));
+    std::string response;
+    EXPECT_EQ(handler.processBatchPredictRequest(createBatchPredictRequest(items), &response), StatusCode::REST_BATCH_TOO_MANY_REQUESTS);
+    EXPECT_EQ(handler.processBatchPredictRequest(createBatchPredictRequest({}), &response), StatusCode::REST_BATCH_REQUESTS_NOT_AN_ARRAY);
+    EXPECT_EQ(handler.processBatchPredictRequest(R"({"requests": {}})", &response), StatusCode::REST_BATCH_REQUESTS_NOT_AN_ARRAY);
+    EXPECT_EQ(handler.processBatchPredictRequest("[]", &response), StatusCode::REST_BODY_IS_NOT_AN_OBJECT);
+}
+
+class HttpRestApiHandlerStatefulTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        ModelConfig config = DUMMY_MODEL_CONFIG;
+        config.setStateful(true);
+        ASSERT_EQ(manager.reloadModelWithVersions(config), StatusCode::OK);
+    }
+
+    Status predict(const std::string& sequenceFields) {
+        std::string request = R"({"inputs": {"b": [[1, 2, 3, 4, 5, 6, 7, 8, 9, 10]], )" + sequenceFields + "}}";
+        std::string response;
+        auto status = handler.processPredictRequest("dummy", std::nullopt, std::nullopt, request, &response);
+        if (status.ok()) {
+            EXPECT_FALSE(responseDoc.Parse(response.c_str()).HasParseError()) << response;
+        }
+        return status;
+    }
+
+    ConstructorEnabledModelManager manager;
+    HttpRestApiHandler handler{5000, manager};
+    rapidjson::Document responseDoc;
+};
+
+TEST_F(HttpRestApiHandlerStatefulTest, SequenceIdReturnedInResponse) {
+    ASSERT_EQ(predict(R"("sequence_id": [5000000000], "sequence_control_input": [1])"), StatusCode::OK);
+    ASSERT_TRUE(responseDoc.HasMember("outputs"));
+    const auto& outputs = responseDoc["outputs"];
+    ASSERT_TRUE(outputs.IsObject());
+    ASSERT_TRUE(outputs.HasMember("a"));
+    ASSERT_TRUE(outputs.HasMember("sequence_id"));
+    ASSERT_TRUE(outputs["sequence_id"].IsArray());
+    ASSERT_EQ(outputs["sequence_id"].Size(), 1u);
+    EXPECT_EQ(outputs["sequence_id"][0].GetUint64(), 5000000000u);
+
+    ASSERT_EQ(predict(R"("sequence_id": [5000000000])"), StatusCode::OK);
+    ASSERT_EQ(predict(R"("sequence_id": [5000000000], "sequence_control_input": [2])"), StatusCode::OK);
+    EXPECT_EQ(predict(R"("sequence_id": [5000000000])"), StatusCode::SEQUENCE_MISSING);
+}
+
+TEST_F(HttpRestApiHandlerStatefulTest, GeneratedSequenceIdReturnedInResponse) {
+    ASSERT_EQ(predict(R"("sequence_control_input": [1])"), StatusCode::OK);
+    ASSERT_TRUE(responseDoc["outputs"].HasMember("sequence_id"));
+    const uint64_t sequenceId = responseDoc["outputs"]["sequence_id"][0].GetUint64();
+    EXPECT_NE(sequenceId, 0u);
+    EXPECT_EQ(predict(R"("sequence_id": [)" + std::to_string(sequenceId) + "]"), StatusCode::OK);
+}
+
+namespace {
+// Dummy model with 4 dimensional input, output is input + 1
+const char* dummy4dModelXml = R"(<?xml version="1.0" ?>
+<net name="dummy_4d" version="10">
+    <layers>
+        <layer id="0" name="b" type="Parameter" version="opset1">
+            <data element_type="f32" shape="1,1,4,4"/>
+            <output>
+                <port id="0" precision="FP32"><dim>1</dim><dim>1</dim><dim>4</dim><dim>4</dim></port>
+            </output>
+        </layer>
+        <layer id="1" name="c" type="Const" version="opset1">
+            <data element_type="f32" offset="0" shape="1,1,1,1" size="4"/>
+            <output>
+                <port id="1" precision="FP32"><dim>1</dim><dim>1</dim><dim>1</dim><dim>1</dim></port>
+            </output>
+        </layer>
+        <layer id="2" name="a" type="Add" version="opset1">
+            <input>
+                <port id="0"><dim>1</dim><dim>1</dim><dim>4</dim><dim>4</dim></port>
+                <port id="1"><dim>1</dim><dim>1</dim><dim>1</dim><dim>1</dim></port>
+            </input>
+            <output>
+                <port id="2" precision="FP32"><dim>1</dim><dim>1</dim><dim>4</dim><dim>4</dim></port>
+            </output>
+        </layer>
+        <layer id="3" name="a/sink_port_0" type="Result" version="opset1">
+            <input>
+                <port id="0"><dim>1</dim><dim>1</dim><dim>4</dim><dim>4</dim></port>
+            </input>
+        </layer>
+    </layers>
+    <edges>
+        <edge from-layer="0" from-port="0" to-layer="2" to-port="0"/>
+        <edge from-layer="1" from-port="1" to-layer="2" to-port="1"/>
+        <edge from-layer="2" from-port="2" to-layer="3" to-port="0"/>
+    </edges>
+</net>
+)";
+}  // namespace
+
+class HttpRestApiHandlerShapeBucketsTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        const std::string versionPath = modelPath + "/1";
+        std::filesystem::create_directories(versionPath);
+        std::ofstream(versionPath + "/model.xml") << dummy4dModelXml;
+        const float one = 1.0;
+        std::ofstream(versionPath + "/model.bin", std::ios::binary).write(reinterpret_cast<const char*>(&one), sizeof(one));
+
+        ModelConfig config = DUMMY_MODEL_CONFIG;
+        config.setName("dummy_4d");
+        config.setBasePath(modelPath);
+        config.setLocalPath(modelPath);
+        config.parseShapeParameter("auto");
+        config.setShapeBuckets({{"b", {4, 8}}});
+        ASSERT_EQ(manager.reloadModelWithVersions(config), StatusCode::OK);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(modelPath);
+    }
+
+    const std::string modelPath = "/tmp/ovms_rest_shape_buckets_model";
+    ConstructorEnabledModelManager manager;
+    HttpRestApiHandler handler{5000, manager};
+    rapidjson::Document responseDoc;
+};
+
+TEST_F(HttpRestApiHandlerShapeBucketsTest, PaddingReturnedInResponse) {
+    // 2x3 request is padded to 4x4 model shape
+    std::string response;
+    for (const char* request : {
+             R"({"inputs": {"b": [[[[1, 2, 3], [4, 5, 6]]]]}})",
+             R"({"instances": [{"b": [[[1, 2, 3], [4, 5, 6]]]}]})"}) {
+        ASSERT_EQ(handler.processPredictRequest("dummy_4d", std::nullopt, std::nullopt, request, &response), StatusCode::OK) << request;
+        ASSERT_FALSE(responseDoc.Parse(response.c_str()).HasParseError()) << response;
+        const bool columnOrder = responseDoc.HasMember("outputs");
+        const auto& outputs = columnOrder ? responseDoc["outputs"] : responseDoc["predictions"][0];
+        ASSERT_TRUE(outputs.IsObject()) << response;
+        ASSERT_TRUE(outputs.HasMember("a")) << response;
+        ASSERT_TRUE(outputs.HasMember("b/padding")) << response;
+        const auto& padding = columnOrder ? outputs["b/padding"][0] : outputs["b/padding"];
+        ASSERT_TRUE(padding.IsArray()) << response;
+        ASSERT_EQ(padding.Size(), 4u) << response;
+        // [top, left, bottom, right] with data placed in top left corner
+        EXPECT_EQ(padding[0].GetInt(), 0);
+        EXPECT_EQ(padding[1].GetInt(), 0);
+        EXPECT_EQ(padding[2].GetInt(), 2);
+        EXPECT_EQ(padding[3].GetInt(), 1);
+    }
+}
@@ -0,0 +1,102 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "../model_file_reader.hpp"
+
+using namespace ovms;
+
+class ModelFileReaderTest : public ::testing::TestWithParam<ModelFileReadMethod> {
+protected:
+    std::string directory;
+    std::string path;
+
+    void SetUp() override {
+        directory = std::filesystem::temp_directory_path().string() + "/ovms_model_file_reader_test";
+        std::filesystem::remove_all(directory);
+        std::filesystem::create_directories(directory);
+        path = directory + "/model.bin";
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(directory);
+    }
+
+    std::string createFile(size_t size) {
+        std::string content(size, '\0');
+        for (size_t i = 0; i < size; i++) {
+            content[i] = static_cast<char>((i * 31 + i / 4096) % 251);
+        }
+        std::ofstream file(path, std::ios::binary);
+        file.write(content.data(), content.size());
+        return content;
+    }
+
+    void expectRead(size_t size, ModelFileReadOptions options) {
+        auto content = createFile(size);
+        options.method = GetParam();
+        if (options.method == ModelFileReadMethod::IO_URING && !isIoUringSupported()) {
+            GTEST_SKIP() << "io_uring not supported";
+        }
+        std::shared_ptr<ModelFileBuffer> buffer;
+        ASSERT_EQ(readModelFile(path, buffer, options), StatusCode::OK);
+        ASSERT_NE(buffer, nullptr);
+        ASSERT_EQ(buffer->size(), size);
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(buffer->data()) % 4096, 0u);
+        EXPECT_TRUE(std::string(buffer->data(), buffer->size()) == content);
+    }
+};
+
+TEST_P(ModelFileReaderTest, ReadsFileNotAlignedToChunks) {
+    ModelFileReadOptions options;
+    options.chunkSize = 64 * 1024;
+    options.queueDepth = 4;
+    expectRead(1024 * 1024 + 123, options);
+}
+
+TEST_P(ModelFileReaderTest, ReadsFileSmallerThanChunk) {
+    expectRead(1000, ModelFileReadOptions());
+}
+
+TEST_P(ModelFileReaderTest, ReadsEmptyFile) {
+    expectRead(0, ModelFileReadOptions());
+}
+
+TEST_P(ModelFileReaderTest, ReadsWithoutDirectIoAndHugePages) {
+    ModelFileReadOptions options;
+    options.chunkSize = 4096;
+    options.directIo = false;
+    options.hugePages = false;
+    expectRead(100 * 1000, options);
+}
+
+TEST_P(ModelFileReaderTest, MissingFile) {
+    std::shared_ptr<ModelFileBuffer> buffer;
+    ModelFileReadOptions options;
+    options.method = GetParam();
+    EXPECT_EQ(readModelFile(directory + "/missing.bin", buffer, options), StatusCode::FILE_INVALID);
+    EXPECT_EQ(buffer, nullptr);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    Methods,
+    ModelFileReaderTest,
+    ::testing::Values(ModelFileReadMethod::AUTO, ModelFileReadMethod::IO_URING, ModelFileReadMethod::PREAD));
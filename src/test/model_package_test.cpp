@@ -0,0 +1,136 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "../model_package.hpp"
+
+using namespace ovms;
+
+class ModelPackageTest : public ::testing::Test {
+protected:
+    std::string directory;
+    std::string path;
+
+    void SetUp() override {
+        directory = std::filesystem::temp_directory_path().string() + "/ovms_model_package_test";
+        std::filesystem::remove_all(directory);
+        std::filesystem::create_directories(directory);
+        path = directory + "/model" + MODEL_PACKAGE_EXTENSION;
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(directory);
+    }
+
+    void writeRaw(const std::string& content) {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file << content;
+    }
+
+    std::string readRaw() {
+        std::ifstream file(path, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+};
+
+TEST_F(ModelPackageTest, WriteAndOpen) {
+    const std::string bin(10000, '\x7f');
+    ASSERT_EQ(ModelPackage::write(path, {{MODEL_PACKAGE_XML, "<net/>"}, {MODEL_PACKAGE_BIN, bin}, {"mapping_config.json", "{}"},
+                                            {MODEL_PACKAGE_PRECOMPILED_PREFIX + "MYRIAD", "blob"}}),
+        StatusCode::OK);
+    std::shared_ptr<ModelPackage> package;
+    ASSERT_EQ(ModelPackage::open(path, package), StatusCode::OK);
+    ASSERT_NE(package, nullptr);
+    EXPECT_EQ(package->getPath(), path);
+    EXPECT_TRUE(package->hasModel());
+    EXPECT_EQ(package->getEntry(MODEL_PACKAGE_XML), "<net/>");
+    EXPECT_EQ(package->getEntry(MODEL_PACKAGE_BIN), bin);
+    EXPECT_EQ(package->getEntry("mapping_config.json"), "{}");
+    EXPECT_TRUE(package->hasPrecompiledNetwork("MYRIAD"));
+    EXPECT_FALSE(package->hasPrecompiledNetwork("CPU"));
+    EXPECT_FALSE(package->hasEntry(MODEL_PACKAGE_ONNX));
+    EXPECT_TRUE(package->getEntry(MODEL_PACKAGE_ONNX).empty());
+}
+
+TEST_F(ModelPackageTest, SectionsAreAligned) {
+    ASSERT_EQ(ModelPackage::write(path, {{MODEL_PACKAGE_XML, std::string(5000, 'x')}, {MODEL_PACKAGE_BIN, std::string(3, 'b')}}), StatusCode::OK);
+    std::shared_ptr<ModelPackage> package;
+    ASSERT_EQ(ModelPackage::open(path, package), StatusCode::OK);
+    const char* xml = package->getEntry(MODEL_PACKAGE_XML).data();
+    const char* bin = package->getEntry(MODEL_PACKAGE_BIN).data();
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(xml) % MODEL_PACKAGE_ALIGNMENT, 0u);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(bin) % MODEL_PACKAGE_ALIGNMENT, 0u);
+    EXPECT_EQ(bin - xml, 2 * MODEL_PACKAGE_ALIGNMENT);
+}
+
+TEST_F(ModelPackageTest, OnnxModel) {
+    ASSERT_EQ(ModelPackage::write(path, {{MODEL_PACKAGE_ONNX, "onnx"}}), StatusCode::OK);
+    std::shared_ptr<ModelPackage> package;
+    ASSERT_EQ(ModelPackage::open(path, package), StatusCode::OK);
+    EXPECT_TRUE(package->hasModel());
+}
+
+TEST_F(ModelPackageTest, XmlWithoutWeightsIsNotModel) {
+    ASSERT_EQ(ModelPackage::write(path, {{MODEL_PACKAGE_XML, "<net/>"}}), StatusCode::OK);
+    std::shared_ptr<ModelPackage> package;
+    ASSERT_EQ(ModelPackage::open(path, package), StatusCode::OK);
+    EXPECT_FALSE(package->hasModel());
+}
+
+TEST_F(ModelPackageTest, MissingFile) {
+    std::shared_ptr<ModelPackage> package;
+    EXPECT_EQ(ModelPackage::open(directory + "/missing.ovmp", package), StatusCode::FILE_INVALID);
+    writeRaw("");
+    EXPECT_EQ(ModelPackage::open(path, package), StatusCode::FILE_INVALID);
+    EXPECT_EQ(package, nullptr);
+}
+
+TEST_F(ModelPackageTest, InvalidMagic) {
+    writeRaw("NOTAPKG1\0\0\0\0\0\0\0\0");
+    std::shared_ptr<ModelPackage> package;
+    EXPECT_EQ(ModelPackage::open(path, package), StatusCode::MODEL_PACKAGE_INVALID);
+    EXPECT_EQ(package, nullptr);
+}
+
+TEST_F(ModelPackageTest, TruncatedPackage) {
+    ASSERT_EQ(ModelPackage::write(path, {{MODEL_PACKAGE_XML, "<net/>"}, {MODEL_PACKAGE_BIN, std::string(100, 'b')}}), StatusCode::OK);
+    const auto content = readRaw();
+    for (size_t size : {content.size() - 1, MODEL_PACKAGE_ALIGNMENT, size_t(40), size_t(12)}) {
+        writeRaw(content.substr(0, size));
+        std::shared_ptr<ModelPackage> package;
+        EXPECT_EQ(ModelPackage::open(path, package), StatusCode::MODEL_PACKAGE_INVALID) << "size: " << size;
+    }
+}
+
+TEST_F(ModelPackageTest, DuplicatedEntry) {
+    ASSERT_EQ(ModelPackage::write(path, {{MODEL_PACKAGE_ONNX, "a"}, {MODEL_PACKAGE_ONNX, "b"}}), StatusCode::OK);
+    std::shared_ptr<ModelPackage> package;
+    EXPECT_EQ(ModelPackage::open(path, package), StatusCode::MODEL_PACKAGE_INVALID);
+}
+
+TEST_F(ModelPackageTest, FindInDirectory) {
+    EXPECT_EQ(ModelPackage::findInDirectory(directory), "");
+    EXPECT_EQ(ModelPackage::findInDirectory(directory + "/missing"), "");
+    ASSERT_EQ(ModelPackage::write(path, {{MODEL_PACKAGE_ONNX, "onnx"}}), StatusCode::OK);
+    EXPECT_EQ(ModelPackage::findInDirectory(directory), path);
+}
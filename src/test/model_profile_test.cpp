@@ -0,0 +1,55 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include <map>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "../model_profile.hpp"
+
+using InferenceEngine::InferenceEngineProfileInfo;
+
+namespace {
+InferenceEngineProfileInfo createProfileInfo(InferenceEngineProfileInfo::LayerStatus status, long long realTime, long long cpuTime, const std::string& layerType) {
+    InferenceEngineProfileInfo info{};
+    info.status = status;
+    info.realTime_uSec = realTime;
+    info.cpu_uSec = cpuTime;
+    layerType.copy(info.layer_type, sizeof(info.layer_type) - 1);
+    std::string("jit_avx2_FP32").copy(info.exec_type, sizeof(info.exec_type) - 1);
+    return info;
+}
+}  // namespace
+
+TEST(ModelProfile, AggregatesExecutedLayers) {
+    ovms::ModelProfile profile;
+    std::map<std::string, InferenceEngineProfileInfo> counts;
+    counts["conv1"] = createProfileInfo(InferenceEngineProfileInfo::EXECUTED, 100, 90, "Convolution");
+    counts["relu1"] = createProfileInfo(InferenceEngineProfileInfo::OPTIMIZED_OUT, 0, 0, "ReLU");
+    profile.record(counts);
+    counts["conv1"] = createProfileInfo(InferenceEngineProfileInfo::EXECUTED, 300, 250, "Convolution");
+    profile.record(counts);
+
+    EXPECT_EQ(profile.getInferencesCount(), 2);
+    auto layers = profile.getLayers();
+    ASSERT_EQ(layers.size(), 1);
+    const auto& conv = layers.at("conv1");
+    EXPECT_EQ(conv.layerType, "Convolution");
+    EXPECT_EQ(conv.execType, "jit_avx2_FP32");
+    EXPECT_EQ(conv.count, 2);
+    EXPECT_EQ(conv.realTimeUs, 400);
+    EXPECT_EQ(conv.cpuTimeUs, 340);
+}
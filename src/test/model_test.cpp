@@ -13,7 +13,10 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 //*****************************************************************************
+#include <chrono>
 #include <deque>
+#include <memory>
+#include <thread>
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
@@ -124,3 +127,67 @@ TEST_F(ModelDefaultVersions, DefaultVersionShouldReturnHighestWhenVersionReloade
     EXPECT_TRUE(nullptr != defaultInstance);
     EXPECT_EQ(2, defaultInstance->getVersion());
 }
+
+class ModelVersionRampUp : public ::testing::Test {
+protected:
+    void addVersion(MockModelWithInstancesJustChangingStates& model, ovms::model_version_t version, uint64_t rampUpMs) {
+        auto versions = std::make_shared<ovms::model_versions_t>();
+        versions->push_back(version);
+        ovms::ModelConfig config = DUMMY_MODEL_CONFIG;
+        config.setVersion(version);
+        config.setVersionRampUpMs(rampUpMs);
+        ASSERT_EQ(model.addVersions(versions, config), ovms::StatusCode::OK);
+    }
+
+    size_t countDefaultVersion(MockModelWithInstancesJustChangingStates& model, ovms::model_version_t version, size_t requests = 1000) {
+        size_t count = 0;
+        for (size_t i = 0; i < requests; i++) {
+            if (model.getDefaultModelInstance()->getVersion() == version) {
+                count++;
+            }
+        }
+        return count;
+    }
+};
+
+TEST_F(ModelVersionRampUp, PreviousVersionServesRequestsAndIsKeptLoaded) {
+    MockModelWithInstancesJustChangingStates mockModel;
+    addVersion(mockModel, 1, 60000);
+    addVersion(mockModel, 2, 60000);
+    EXPECT_TRUE(mockModel.isVersionRampingDown(1));
+    EXPECT_GT(countDefaultVersion(mockModel, 1), 900);
+
+    mockModel.retireVersions(std::make_shared<ovms::model_versions_t>(ovms::model_versions_t{1}));
+    EXPECT_EQ(ovms::ModelVersionState::AVAILABLE, mockModel.getModelInstanceByVersion(1)->getStatus().getState());
+}
+
+TEST_F(ModelVersionRampUp, AllRequestsGoToNewVersionAfterRampUp) {
+    MockModelWithInstancesJustChangingStates mockModel;
+    addVersion(mockModel, 1, 20);
+    addVersion(mockModel, 2, 20);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_FALSE(mockModel.isVersionRampingDown(1));
+    EXPECT_EQ(countDefaultVersion(mockModel, 2), 1000);
+
+    mockModel.retireVersions(std::make_shared<ovms::model_versions_t>(ovms::model_versions_t{1}));
+    EXPECT_EQ(ovms::ModelVersionState::END, mockModel.getModelInstanceByVersion(1)->getStatus().getState());
+}
+
+TEST_F(ModelVersionRampUp, NoRampUpBetweenVersionsLoadedTogether) {
+    MockModelWithInstancesJustChangingStates mockModel;
+    auto versions = std::make_shared<ovms::model_versions_t>(ovms::model_versions_t{1, 2});
+    ovms::ModelConfig config = DUMMY_MODEL_CONFIG;
+    config.setVersionRampUpMs(60000);
+    ASSERT_EQ(mockModel.addVersions(versions, config), ovms::StatusCode::OK);
+    EXPECT_FALSE(mockModel.isVersionRampingDown(1));
+    EXPECT_EQ(countDefaultVersion(mockModel, 2), 1000);
+}
+
+TEST_F(ModelVersionRampUp, RampUpIsCancelledWhenNewVersionIsRetired) {
+    MockModelWithInstancesJustChangingStates mockModel;
+    addVersion(mockModel, 1, 60000);
+    addVersion(mockModel, 2, 60000);
+    mockModel.retireVersions(std::make_shared<ovms::model_versions_t>(ovms::model_versions_t{2}));
+    EXPECT_FALSE(mockModel.isVersionRampingDown(1));
+    EXPECT_EQ(countDefaultVersion(mockModel, 1), 1000);
+}
@@ -13,6 +13,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 //*****************************************************************************
+#include <algorithm>
 #include <cstdio>
 #include <filesystem>
 #include <fstream>
@@ -20,7 +21,10 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 #include <stdlib.h>
+#include <thread>
 
+#include "../cpu_budget.hpp"
+#include "../executinstreamidguard.hpp"
 #include "../modelinstance.hpp"
 #include "test_utils.hpp"
 
@@ -210,6 +214,16 @@ TEST_F(TestLoadModel, SuccessfulLoad) {
     EXPECT_EQ(ovms::ModelVersionState::AVAILABLE, modelInstance.getStatus().getState());
 }
 
+TEST_F(TestLoadModel, SuccessfulLoadWithReplicas) {
+    ovms::ModelInstance modelInstance;
+    ovms::ModelConfig config = DUMMY_MODEL_CONFIG;
+    config.setNireq(2);
+    config.setReplicas(3);
+    EXPECT_EQ(modelInstance.loadModel(config), ovms::StatusCode::OK);
+    EXPECT_EQ(ovms::ModelVersionState::AVAILABLE, modelInstance.getStatus().getState());
+    EXPECT_EQ(modelInstance.getInferRequestsQueue().getReplicasCount(), 3);
+}
+
 TEST_F(TestLoadModel, UnSuccessfulLoadWhenNireqTooHigh) {
     std::filesystem::path dir = std::filesystem::current_path();
     std::string dummy_model = dir.u8string() + "/src/test/dummy";
@@ -220,6 +234,124 @@ TEST_F(TestLoadModel, UnSuccessfulLoadWhenNireqTooHigh) {
     EXPECT_EQ(ovms::ModelVersionState::LOADING, modelInstance.getStatus().getState()) << modelInstance.getStatus().getStateString();
 }
 
+TEST_F(TestLoadModel, SuccessfulLoadFromModelPackage) {
+    const std::string modelPath = "/tmp/test_load_model_package";
+    const std::string versionDirectoryPath = modelPath + "/1";
+    std::filesystem::remove_all(modelPath);
+    ASSERT_TRUE(std::filesystem::create_directories(versionDirectoryPath));
+    auto readFile = [](const std::string& path) {
+        std::ifstream file(path, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    };
+    ASSERT_EQ(ovms::ModelPackage::write(versionDirectoryPath + "/dummy" + ovms::MODEL_PACKAGE_EXTENSION,
+                  {{ovms::MODEL_PACKAGE_XML, readFile(dummy_model_location + "/1/dummy.xml")},
+                      {ovms::MODEL_PACKAGE_BIN, readFile(dummy_model_location + "/1/dummy.bin")},
+                      {ovms::MAPPING_CONFIG_JSON, R"({"inputs": {"b": "input"}, "outputs": {"a": "output"}})"}}),
+        ovms::StatusCode::OK);
+    ovms::ModelConfig config = DUMMY_MODEL_CONFIG;
+    config.setBasePath(modelPath);
+    config.setLocalPath(modelPath);
+    ASSERT_EQ(config.parseModelMapping(), ovms::StatusCode::OK);
+    ovms::ModelInstance modelInstance;
+    ASSERT_EQ(modelInstance.loadModel(config), ovms::StatusCode::OK);
+    EXPECT_EQ(ovms::ModelVersionState::AVAILABLE, modelInstance.getStatus().getState());
+    EXPECT_EQ(modelInstance.getInputsInfo().count("input"), 1);
+    EXPECT_EQ(modelInstance.getOutputsInfo().count("output"), 1);
+    modelInstance.unloadModel();
+    std::filesystem::remove_all(modelPath);
+}
+
+class ModelInstanceReadingWeightsIntoMemory : public ovms::ModelInstance {
+public:
+    ModelInstanceReadingWeightsIntoMemory() {
+        modelFileReaderMinSize = 0;
+    }
+
+    const std::shared_ptr<ovms::ModelFileBuffer>& getWeightsBuffer() const {
+        return weightsBuffer;
+    }
+};
+
+TEST_F(TestLoadModel, SuccessfulLoadWithWeightsReadIntoMemory) {
+    ModelInstanceReadingWeightsIntoMemory modelInstance;
+    ASSERT_EQ(modelInstance.loadModel(DUMMY_MODEL_CONFIG), ovms::StatusCode::OK);
+    EXPECT_EQ(ovms::ModelVersionState::AVAILABLE, modelInstance.getStatus().getState());
+    ASSERT_NE(modelInstance.getWeightsBuffer(), nullptr);
+    EXPECT_EQ(modelInstance.getWeightsBuffer()->size(), std::filesystem::file_size(dummy_model_location + "/1/dummy.bin"));
+    {
+        // Network created from weights in memory computes the same as the one read by OpenVINO
+        ovms::ExecutingStreamIdGuard guard(modelInstance.getInferRequestsQueue());
+        auto& inferRequest = modelInstance.getInferRequestsQueue().getInferRequest(guard.getId());
+        auto input = inferRequest.GetBlob(DUMMY_MODEL_INPUT_NAME);
+        auto inputData = input->buffer().as<float*>();
+        std::fill(inputData, inputData + input->size(), 1.0f);
+        inferRequest.Infer();
+        auto output = inferRequest.GetBlob(DUMMY_MODEL_OUTPUT_NAME);
+        auto outputData = output->cbuffer().as<const float*>();
+        EXPECT_EQ(std::vector<float>(outputData, outputData + output->size()), std::vector<float>(DUMMY_MODEL_OUTPUT_SIZE, 2.0f));
+    }
+    modelInstance.unloadModel();
+    EXPECT_EQ(modelInstance.getWeightsBuffer(), nullptr);
+}
+
+TEST_F(TestLoadModel, IdenticalModelsShareNetwork) {
+    auto& sharedNetworks = ovms::SharedNetworks::instance();
+    sharedNetworks.setEnabled(true);
+    ovms::ModelConfig aliasConfig = DUMMY_MODEL_CONFIG;
+    aliasConfig.setName("dummy_alias");
+    ovms::ModelConfig batchConfig = DUMMY_MODEL_CONFIG;
+    batchConfig.setBatchSize(2);
+    ovms::ModelInstance first, alias, batched;
+    ASSERT_EQ(first.loadModel(DUMMY_MODEL_CONFIG), ovms::StatusCode::OK);
+    ASSERT_EQ(alias.loadModel(aliasConfig), ovms::StatusCode::OK);
+    ASSERT_EQ(batched.loadModel(batchConfig), ovms::StatusCode::OK);
+    EXPECT_EQ(&first.getInferRequestsQueue(), &alias.getInferRequestsQueue());
+    EXPECT_NE(&first.getInferRequestsQueue(), &batched.getInferRequestsQueue());
+    EXPECT_EQ(sharedNetworks.getNetworksCount(), 2);
+
+    first.unloadModel();
+    EXPECT_EQ(sharedNetworks.getNetworksCount(), 2);
+    EXPECT_EQ(ovms::ModelVersionState::AVAILABLE, alias.getStatus().getState());
+    {
+        ovms::ExecutingStreamIdGuard guard(alias.getInferRequestsQueue());
+        EXPECT_GE(guard.getId(), 0);
+    }
+    alias.unloadModel();
+    batched.unloadModel();
+    EXPECT_EQ(sharedNetworks.getNetworksCount(), 0);
+    sharedNetworks.setEnabled(false);
+}
+
+TEST_F(TestLoadModel, SharedNetworkKeepsWeightsOfUnloadedOwner) {
+    auto& sharedNetworks = ovms::SharedNetworks::instance();
+    sharedNetworks.setEnabled(true);
+    ovms::ModelConfig aliasConfig = DUMMY_MODEL_CONFIG;
+    aliasConfig.setName("dummy_alias");
+    ModelInstanceReadingWeightsIntoMemory owner;
+    ovms::ModelInstance alias;
+    ASSERT_EQ(owner.loadModel(DUMMY_MODEL_CONFIG), ovms::StatusCode::OK);
+    ASSERT_EQ(alias.loadModel(aliasConfig), ovms::StatusCode::OK);
+    ASSERT_EQ(&owner.getInferRequestsQueue(), &alias.getInferRequestsQueue());
+    // Weights were handed over to the shared network
+    EXPECT_EQ(owner.getWeightsBuffer(), nullptr);
+
+    owner.unloadModel();
+    {
+        ovms::ExecutingStreamIdGuard guard(alias.getInferRequestsQueue());
+        auto& inferRequest = alias.getInferRequestsQueue().getInferRequest(guard.getId());
+        auto input = inferRequest.GetBlob(DUMMY_MODEL_INPUT_NAME);
+        auto inputData = input->buffer().as<float*>();
+        std::fill(inputData, inputData + input->size(), 1.0f);
+        inferRequest.Infer();
+        auto output = inferRequest.GetBlob(DUMMY_MODEL_OUTPUT_NAME);
+        auto outputData = output->cbuffer().as<const float*>();
+        EXPECT_EQ(std::vector<float>(outputData, outputData + output->size()), std::vector<float>(DUMMY_MODEL_OUTPUT_SIZE, 2.0f));
+    }
+    alias.unloadModel();
+    EXPECT_EQ(sharedNetworks.getNetworksCount(), 0);
+    sharedNetworks.setEnabled(false);
+}
+
 class TestReloadModel : public ::testing::Test {};
 
 TEST_F(TestReloadModel, SuccessfulReloadFromAlreadyLoaded) {
@@ -321,3 +453,48 @@ TEST(CpuThroughputStreamsNotSpecified, NotSetForNonCpuDevices) {
     pluginConfig = ovms::ModelInstance::prepareDefaultPluginConfig(config);
     EXPECT_EQ(pluginConfig.count("CPU_THROUGHPUT_STREAMS"), 0);
 }
+
+TEST(CpuReplicas, ThreadsAreSplitBetweenReplicas) {
+    ovms::ModelConfig config;
+    config.setTargetDevice("CPU");
+    config.setPluginConfig({});
+    ovms::plugin_config_t pluginConfig = ovms::ModelInstance::prepareDefaultPluginConfig(config);
+    EXPECT_EQ(pluginConfig.count("CPU_THREADS_NUM"), 0);
+    config.setReplicas(2);
+    pluginConfig = ovms::ModelInstance::prepareDefaultPluginConfig(config);
+    ASSERT_EQ(pluginConfig.count("CPU_THREADS_NUM"), 1);
+    EXPECT_EQ(pluginConfig["CPU_THREADS_NUM"], std::to_string(std::max(1u, std::thread::hardware_concurrency() / 2)));
+    EXPECT_EQ(pluginConfig["CPU_BIND_THREAD"], "NO");
+    config.setPluginConfig({{"CPU_THREADS_NUM", "4"}});
+    pluginConfig = ovms::ModelInstance::prepareDefaultPluginConfig(config);
+    EXPECT_EQ(pluginConfig["CPU_THREADS_NUM"], "4");
+}
+
+TEST(CpuThreadsBudget, ThreadsAreDividedByWeight) {
+    std::vector<ovms::ModelConfig> configs(3);
+    configs[0].setTargetDevice("CPU");
+    configs[0].setCpuWeight(3);
+    configs[1].setTargetDevice("CPU");
+    configs[2].setTargetDevice("GPU");
+    ovms::assignCpuThreadsBudget(configs, 16);
+    EXPECT_EQ(configs[0].getCpuThreadsBudget(), 12);
+    EXPECT_EQ(configs[1].getCpuThreadsBudget(), 4);
+    EXPECT_EQ(configs[2].getCpuThreadsBudget(), 0);
+    ovms::assignCpuThreadsBudget(configs, 2);
+    EXPECT_EQ(configs[1].getCpuThreadsBudget(), 1);
+    ovms::assignCpuThreadsBudget(configs, 0);
+    EXPECT_EQ(configs[0].getCpuThreadsBudget(), 0);
+}
+
+TEST(CpuThreadsBudget, BudgetIsSplitBetweenReplicas) {
+    ovms::ModelConfig config;
+    config.setTargetDevice("CPU");
+    config.setPluginConfig({});
+    config.setCpuThreadsBudget(8);
+    ovms::plugin_config_t pluginConfig = ovms::ModelInstance::prepareDefaultPluginConfig(config);
+    EXPECT_EQ(pluginConfig["CPU_THREADS_NUM"], "8");
+    EXPECT_EQ(pluginConfig["CPU_BIND_THREAD"], "NO");
+    config.setReplicas(2);
+    pluginConfig = ovms::ModelInstance::prepareDefaultPluginConfig(config);
+    EXPECT_EQ(pluginConfig["CPU_THREADS_NUM"], "4");
+}
@@ -0,0 +1,102 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "../node_results_cache.hpp"
+
+using namespace ovms;
+
+namespace {
+InferenceEngine::Blob::Ptr createBlob(std::vector<float>& data) {
+    const InferenceEngine::TensorDesc desc{InferenceEngine::Precision::FP32, {1, data.size()}, InferenceEngine::Layout::NC};
+    return InferenceEngine::make_shared_blob<float>(desc, data.data());
+}
+}  // namespace
+
+TEST(NodeResultsCache, MissThenHit) {
+    NodeResultsCache cache("dummy", 10);
+    std::vector<float> inputData{1.0, 2.0, 3.0};
+    std::vector<float> outputData{2.0, 3.0, 4.0};
+    std::shared_ptr<NodeResultsCacheEntry> entry;
+    ASSERT_EQ(cache.acquire({{"b", createBlob(inputData)}}, entry, []() {}), NodeResultsCache::Lookup::MISS);
+    cache.complete(entry, StatusCode::OK, {{"a", createBlob(outputData)}});
+
+    // Equal content in different memory
+    std::vector<float> sameInputData{inputData};
+    std::shared_ptr<NodeResultsCacheEntry> cachedEntry;
+    ASSERT_EQ(cache.acquire({{"b", createBlob(sameInputData)}}, cachedEntry, []() {}), NodeResultsCache::Lookup::HIT);
+    EXPECT_EQ(cachedEntry, entry);
+    EXPECT_TRUE(cachedEntry->getStatus().ok());
+    ASSERT_EQ(cachedEntry->getOutputs().count("a"), 1);
+
+    std::vector<float> otherInputData{1.0, 2.0, 4.0};
+    std::shared_ptr<NodeResultsCacheEntry> otherEntry;
+    EXPECT_EQ(cache.acquire({{"b", createBlob(otherInputData)}}, otherEntry, []() {}), NodeResultsCache::Lookup::MISS);
+    EXPECT_EQ(cache.getSize(), 2);
+}
+
+TEST(NodeResultsCache, PendingEntryNotifiesWaiters) {
+    NodeResultsCache cache("dummy", 10);
+    std::vector<float> inputData{1.0, 2.0, 3.0};
+    std::shared_ptr<NodeResultsCacheEntry> entry;
+    ASSERT_EQ(cache.acquire({{"b", createBlob(inputData)}}, entry, []() {}), NodeResultsCache::Lookup::MISS);
+
+    int notifiedCount = 0;
+    std::shared_ptr<NodeResultsCacheEntry> waitingEntries[2];
+    for (auto& waitingEntry : waitingEntries) {
+        ASSERT_EQ(cache.acquire({{"b", createBlob(inputData)}}, waitingEntry, [&notifiedCount]() { notifiedCount++; }), NodeResultsCache::Lookup::PENDING);
+    }
+    EXPECT_EQ(notifiedCount, 0);
+    cache.complete(entry, StatusCode::OK);
+    EXPECT_EQ(notifiedCount, 2);
+    EXPECT_TRUE(waitingEntries[0]->getStatus().ok());
+}
+
+TEST(NodeResultsCache, AbandonedEntryIsRemoved) {
+    NodeResultsCache cache("dummy", 10);
+    std::vector<float> inputData{1.0, 2.0, 3.0};
+    std::shared_ptr<NodeResultsCacheEntry> entry;
+    std::shared_ptr<NodeResultsCacheEntry> waitingEntry;
+    bool notified = false;
+    ASSERT_EQ(cache.acquire({{"b", createBlob(inputData)}}, entry, []() {}), NodeResultsCache::Lookup::MISS);
+    ASSERT_EQ(cache.acquire({{"b", createBlob(inputData)}}, waitingEntry, [&notified]() { notified = true; }), NodeResultsCache::Lookup::PENDING);
+    {
+        NodeResultsCacheProducer producer(cache, entry);
+    }
+    EXPECT_TRUE(notified);
+    EXPECT_EQ(waitingEntry->getStatus(), StatusCode::PIPELINE_NODE_CACHED_RESULTS_ABANDONED);
+    EXPECT_EQ(cache.getSize(), 0);
+    EXPECT_EQ(cache.acquire({{"b", createBlob(inputData)}}, entry, []() {}), NodeResultsCache::Lookup::MISS);
+}
+
+TEST(NodeResultsCache, EvictsLeastRecentlyUsed) {
+    NodeResultsCache cache("dummy", 2);
+    std::vector<float> inputsData[3]{{1.0}, {2.0}, {3.0}};
+    std::shared_ptr<NodeResultsCacheEntry> entry;
+    for (auto& inputData : inputsData) {
+        ASSERT_EQ(cache.acquire({{"b", createBlob(inputData)}}, entry, []() {}), NodeResultsCache::Lookup::MISS);
+        cache.complete(entry, StatusCode::OK);
+        // keep first entry recently used
+        ASSERT_EQ(cache.acquire({{"b", createBlob(inputsData[0])}}, entry, []() {}), NodeResultsCache::Lookup::HIT);
+    }
+    EXPECT_EQ(cache.getSize(), 2);
+    EXPECT_EQ(cache.acquire({{"b", createBlob(inputsData[0])}}, entry, []() {}), NodeResultsCache::Lookup::HIT);
+    EXPECT_EQ(cache.acquire({{"b", createBlob(inputsData[2])}}, entry, []() {}), NodeResultsCache::Lookup::HIT);
+    EXPECT_EQ(cache.acquire({{"b", createBlob(inputsData[1])}}, entry, []() {}), NodeResultsCache::Lookup::MISS);
+}
@@ -62,3 +62,28 @@ TEST(OVUtils, CopyBlob) {
     // Expect memory addresses to differ since cloning should allocate new memory space for the cloned blob
     EXPECT_NE((float*)copyBlob->buffer(), (float*)originalBlob->buffer());
 }
+
+TEST(OVUtils, SliceBlob) {
+    const std::vector<size_t> shape{4, 3};
+    const InferenceEngine::Precision precision{InferenceEngine::Precision::FP32};
+    const InferenceEngine::Layout layout{InferenceEngine::Layout::NC};
+    const InferenceEngine::TensorDesc desc{precision, shape, layout};
+
+    std::vector<float> data(12);
+    std::iota(data.begin(), data.end(), 0);
+
+    InferenceEngine::Blob::Ptr originalBlob = InferenceEngine::make_shared_blob<float>(desc, data.data());
+    InferenceEngine::Blob::Ptr sliceBlob = ovms::blobSlice(originalBlob, 1, 2);
+
+    ASSERT_NE(sliceBlob, nullptr);
+    EXPECT_EQ(sliceBlob->getTensorDesc().getDims(), (std::vector<size_t>{2, 3}));
+    EXPECT_EQ(sliceBlob->getTensorDesc().getLayout(), layout);
+    EXPECT_EQ(sliceBlob->getTensorDesc().getPrecision(), precision);
+
+    std::vector<float> sliceBlobActualData;
+    sliceBlobActualData.assign((float*)sliceBlob->buffer(), ((float*)sliceBlob->buffer()) + 6);
+    EXPECT_THAT(sliceBlobActualData, ElementsAre(3, 4, 5, 6, 7, 8));
+
+    EXPECT_EQ(ovms::blobSlice(originalBlob, 3, 2), nullptr);
+    EXPECT_EQ(ovms::blobSlice(originalBlob, 0, 0), nullptr);
+}
@@ -14,11 +14,13 @@
 // limitations under the License.
 //*****************************************************************************
 
+#include <algorithm>
 #include <chrono>
 #include <filesystem>
 #include <random>
 #include <string>
 #include <thread>
+#include <vector>
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
@@ -48,6 +50,35 @@ TEST(OVInferRequestQueue, ShortQueue) {
     EXPECT_EQ(reqid, 0);
 }
 
+TEST(OVInferRequestQueue, ReplicasAreBalanced) {
+    InferenceEngine::Core engine;
+    InferenceEngine::CNNNetwork network = engine.ReadNetwork(DUMMY_MODEL_PATH);
+    InferenceEngine::ExecutableNetwork firstExecNetwork = engine.LoadNetwork(network, "CPU");
+    InferenceEngine::ExecutableNetwork secondExecNetwork = engine.LoadNetwork(network, "CPU");
+    ovms::OVInferRequestsQueue inferRequestsQueue({firstExecNetwork, secondExecNetwork}, 2);
+    // streams 0, 1 belong to first replica, streams 2, 3 to second one
+    EXPECT_EQ(inferRequestsQueue.getReplicasCount(), 2);
+    EXPECT_EQ(inferRequestsQueue.getIdleStream().get(), 0);
+    EXPECT_EQ(inferRequestsQueue.getIdleStream().get(), 2);
+    EXPECT_EQ(inferRequestsQueue.getIdleStream().get(), 1);
+    inferRequestsQueue.returnStream(0);
+    EXPECT_EQ(inferRequestsQueue.getIdleStream().get(), 0);
+    EXPECT_EQ(inferRequestsQueue.getIdleStream().get(), 3);
+}
+
+TEST(OVInferRequestQueue, PreferredStreamIsGivenWhenIdle) {
+    InferenceEngine::Core engine;
+    InferenceEngine::CNNNetwork network = engine.ReadNetwork(DUMMY_MODEL_PATH);
+    InferenceEngine::ExecutableNetwork execNetwork = engine.LoadNetwork(network, "CPU");
+    ovms::OVInferRequestsQueue inferRequestsQueue(execNetwork, 3);
+    EXPECT_EQ(inferRequestsQueue.getIdleStream(ovms::StreamRequester::PREDICT, nullptr, 2).get(), 2);
+    // preferred stream is busy, any idle stream is given
+    EXPECT_EQ(inferRequestsQueue.getIdleStream(ovms::StreamRequester::PREDICT, nullptr, 2).get(), 0);
+    inferRequestsQueue.returnStream(2);
+    EXPECT_EQ(inferRequestsQueue.getIdleStream(ovms::StreamRequester::PREDICT, nullptr, 2).get(), 2);
+    EXPECT_EQ(inferRequestsQueue.getIdleStream().get(), 1);
+}
+
 void releaseStream(ovms::OVInferRequestsQueue& requestsQueue) {
     std::this_thread::sleep_for(std::chrono::seconds(1));
     requestsQueue.returnStream(3);
@@ -127,3 +158,195 @@ TEST(OVInferRequestQueue, AsyncGetInferRequest) {
     const int secondStreamId = secondStreamRequest.get();
     EXPECT_EQ(firstStreamId, secondStreamId);
 }
+
+TEST(OVInferRequestQueue, OnReadyIsCalledWhenStreamAssigned) {
+    InferenceEngine::Core engine;
+    InferenceEngine::CNNNetwork network = engine.ReadNetwork(DUMMY_MODEL_PATH);
+    InferenceEngine::ExecutableNetwork execNetwork = engine.LoadNetwork(network, "CPU");
+    ovms::OVInferRequestsQueue inferRequestsQueue(execNetwork, 1);
+
+    int notifications = 0;
+    auto firstStreamRequest = inferRequestsQueue.getIdleStream(ovms::StreamRequester::PIPELINE_NODE, [&notifications]() { notifications++; });
+    EXPECT_EQ(notifications, 1);
+    auto secondStreamRequest = inferRequestsQueue.getIdleStream(ovms::StreamRequester::PIPELINE_NODE, [&notifications]() { notifications++; });
+    EXPECT_EQ(notifications, 1);
+    inferRequestsQueue.returnStream(firstStreamRequest.get());
+    EXPECT_EQ(notifications, 2);
+    EXPECT_EQ(std::future_status::ready, secondStreamRequest.wait_for(std::chrono::microseconds(1)));
+}
+
+static std::vector<ovms::StreamRequester> serveWaitingRequests(ovms::OVInferRequestsQueue& inferRequestsQueue, const std::vector<ovms::StreamRequester>& requesters) {
+    std::vector<ovms::StreamRequester> served;
+    const int streamId = inferRequestsQueue.getIdleStream().get();
+    std::vector<std::future<int>> futures;
+    for (auto requester : requesters) {
+        futures.emplace_back(inferRequestsQueue.getIdleStream(requester, [&served, requester]() { served.push_back(requester); }));
+    }
+    for (size_t i = 0; i <= requesters.size(); i++) {
+        inferRequestsQueue.returnStream(streamId);
+    }
+    return served;
+}
+
+TEST(OVInferRequestQueue, WeightedFairSchedulingSharesStreamsByWeight) {
+    InferenceEngine::Core engine;
+    InferenceEngine::CNNNetwork network = engine.ReadNetwork(DUMMY_MODEL_PATH);
+    InferenceEngine::ExecutableNetwork execNetwork = engine.LoadNetwork(network, "CPU");
+    ovms::StreamSchedulingConfig schedulingConfig;
+    schedulingConfig.policy = ovms::StreamSchedulingPolicy::WEIGHTED_FAIR;
+    schedulingConfig.pipelineWeight = 3;
+    ovms::OVInferRequestsQueue inferRequestsQueue({execNetwork}, 1, schedulingConfig);
+
+    const auto predict = ovms::StreamRequester::PREDICT;
+    const auto node = ovms::StreamRequester::PIPELINE_NODE;
+    auto served = serveWaitingRequests(inferRequestsQueue, {predict, predict, predict, predict, node, node, node, node});
+    ASSERT_EQ(served.size(), 8);
+    EXPECT_EQ(std::count(served.begin(), served.begin() + 4, node), 3);
+}
+
+TEST(OVInferRequestQueue, FifoSchedulingServesInOrderOfArrival) {
+    InferenceEngine::Core engine;
+    InferenceEngine::CNNNetwork network = engine.ReadNetwork(DUMMY_MODEL_PATH);
+    InferenceEngine::ExecutableNetwork execNetwork = engine.LoadNetwork(network, "CPU");
+    ovms::OVInferRequestsQueue inferRequestsQueue(execNetwork, 1);
+
+    const auto predict = ovms::StreamRequester::PREDICT;
+    const auto node = ovms::StreamRequester::PIPELINE_NODE;
+    std::vector<ovms::StreamRequester> requesters{predict, node, predict, node, node};
+    EXPECT_EQ(serveWaitingRequests(inferRequestsQueue, requesters), requesters);
+}
+
+TEST(OVInferRequestQueue, DeadlineSchedulingServesEarliestDeadlineFirst) {
+    InferenceEngine::Core engine;
+    InferenceEngine::CNNNetwork network = engine.ReadNetwork(DUMMY_MODEL_PATH);
+    InferenceEngine::ExecutableNetwork execNetwork = engine.LoadNetwork(network, "CPU");
+    ovms::StreamSchedulingConfig schedulingConfig;
+    schedulingConfig.policy = ovms::StreamSchedulingPolicy::DEADLINE;
+    schedulingConfig.predictLatencyTargetMs = 10000;
+    ovms::OVInferRequestsQueue inferRequestsQueue({execNetwork}, 1, schedulingConfig);
+
+    const auto predict = ovms::StreamRequester::PREDICT;
+    const auto node = ovms::StreamRequester::PIPELINE_NODE;
+    auto served = serveWaitingRequests(inferRequestsQueue, {predict, predict, node, node});
+    EXPECT_EQ(served, (std::vector<ovms::StreamRequester>{node, node, predict, predict}));
+}
+
+TEST(OVInferRequestQueue, HighPriorityPipelineNodesServedFirst) {
+    InferenceEngine::Core engine;
+    InferenceEngine::CNNNetwork network = engine.ReadNetwork(DUMMY_MODEL_PATH);
+    InferenceEngine::ExecutableNetwork execNetwork = engine.LoadNetwork(network, "CPU");
+    ovms::OVInferRequestsQueue inferRequestsQueue(execNetwork, 1);
+
+    const auto predict = ovms::StreamRequester::PREDICT;
+    const auto node = ovms::StreamRequester::PIPELINE_NODE;
+    const auto priorityNode = ovms::StreamRequester::PRIORITY_PIPELINE_NODE;
+    auto served = serveWaitingRequests(inferRequestsQueue, {predict, node, priorityNode, predict, priorityNode});
+    EXPECT_EQ(served, (std::vector<ovms::StreamRequester>{priorityNode, priorityNode, predict, node, predict}));
+}
+
+TEST(OVInferRequestQueue, ReservedStreamsAreKeptForHighPriority) {
+    InferenceEngine::Core engine;
+    InferenceEngine::CNNNetwork network = engine.ReadNetwork(DUMMY_MODEL_PATH);
+    InferenceEngine::ExecutableNetwork execNetwork = engine.LoadNetwork(network, "CPU");
+    ovms::StreamSchedulingConfig schedulingConfig;
+    schedulingConfig.reservedStreamsRatio = 0.5;
+    schedulingConfig.reservedStreamsBorrowAfterMs = 60000;
+    ovms::OVInferRequestsQueue inferRequestsQueue({execNetwork}, 4, schedulingConfig);
+    EXPECT_FALSE(inferRequestsQueue.isStreamReserved(0));
+    EXPECT_FALSE(inferRequestsQueue.isStreamReserved(1));
+    EXPECT_TRUE(inferRequestsQueue.isStreamReserved(2));
+    EXPECT_TRUE(inferRequestsQueue.isStreamReserved(3));
+
+    const int priorityStream = inferRequestsQueue.getIdleStream(ovms::StreamRequester::PRIORITY_PIPELINE_NODE).get();
+    EXPECT_TRUE(inferRequestsQueue.isStreamReserved(priorityStream));
+    inferRequestsQueue.returnStream(priorityStream);
+
+    EXPECT_EQ(inferRequestsQueue.getIdleStream().get(), 0);
+    EXPECT_EQ(inferRequestsQueue.getIdleStream().get(), 1);
+    auto waitingPredict = inferRequestsQueue.getIdleStream();
+    EXPECT_EQ(std::future_status::timeout, waitingPredict.wait_for(std::chrono::microseconds(1)));
+    auto priorityRequest = inferRequestsQueue.getIdleStream(ovms::StreamRequester::PRIORITY_PIPELINE_NODE);
+    ASSERT_EQ(std::future_status::ready, priorityRequest.wait_for(std::chrono::microseconds(1)));
+    const int reservedStream = priorityRequest.get();
+    EXPECT_TRUE(inferRequestsQueue.isStreamReserved(reservedStream));
+
+    // returned reserved stream stays idle for high priority requests
+    inferRequestsQueue.returnStream(reservedStream);
+    EXPECT_EQ(std::future_status::timeout, waitingPredict.wait_for(std::chrono::microseconds(1)));
+    inferRequestsQueue.returnStream(1);
+    ASSERT_EQ(std::future_status::ready, waitingPredict.wait_for(std::chrono::microseconds(1)));
+    EXPECT_EQ(waitingPredict.get(), 1);
+}
+
+TEST(OVInferRequestQueue, ReservedStreamsAreBorrowedWhenHighPriorityIsIdle) {
+    InferenceEngine::Core engine;
+    InferenceEngine::CNNNetwork network = engine.ReadNetwork(DUMMY_MODEL_PATH);
+    InferenceEngine::ExecutableNetwork firstExecNetwork = engine.LoadNetwork(network, "CPU");
+    InferenceEngine::ExecutableNetwork secondExecNetwork = engine.LoadNetwork(network, "CPU");
+    ovms::StreamSchedulingConfig schedulingConfig;
+    schedulingConfig.reservedStreamsRatio = 0.5;
+    schedulingConfig.reservedStreamsBorrowAfterMs = 0;
+    ovms::OVInferRequestsQueue inferRequestsQueue({firstExecNetwork, secondExecNetwork}, 2, schedulingConfig);
+    // last stream of each replica is reserved
+    EXPECT_TRUE(inferRequestsQueue.isStreamReserved(1));
+    EXPECT_TRUE(inferRequestsQueue.isStreamReserved(3));
+
+    std::vector<int> streams;
+    for (int i = 0; i < 4; i++) {
+        auto request = inferRequestsQueue.getIdleStream();
+        ASSERT_EQ(std::future_status::ready, request.wait_for(std::chrono::microseconds(1)));
+        streams.push_back(request.get());
+    }
+    // unreserved streams are taken first
+    EXPECT_FALSE(inferRequestsQueue.isStreamReserved(streams[0]));
+    EXPECT_FALSE(inferRequestsQueue.isStreamReserved(streams[1]));
+    std::sort(streams.begin(), streams.end());
+    EXPECT_EQ(streams, (std::vector<int>{0, 1, 2, 3}));
+}
+
+TEST(OVInferRequestQueue, WaitingRequestsGetReservedStreamsWhenBorrowingStarts) {
+    InferenceEngine::Core engine;
+    InferenceEngine::CNNNetwork network = engine.ReadNetwork(DUMMY_MODEL_PATH);
+    InferenceEngine::ExecutableNetwork execNetwork = engine.LoadNetwork(network, "CPU");
+    ovms::StreamSchedulingConfig schedulingConfig;
+    schedulingConfig.reservedStreamsRatio = 1.0;
+    schedulingConfig.reservedStreamsBorrowAfterMs = 50;
+    ovms::OVInferRequestsQueue inferRequestsQueue({execNetwork}, 1, schedulingConfig);
+    ASSERT_TRUE(inferRequestsQueue.isStreamReserved(0));
+
+    inferRequestsQueue.returnStream(inferRequestsQueue.getIdleStream(ovms::StreamRequester::PRIORITY_PIPELINE_NODE).get());
+    const auto start = std::chrono::steady_clock::now();
+    auto waitingPredict = inferRequestsQueue.getIdleStream();
+    EXPECT_EQ(std::future_status::timeout, waitingPredict.wait_for(std::chrono::microseconds(1)));
+    // no stream is returned meanwhile, reserved stream is given once high priority requests are idle long enough
+    ASSERT_EQ(std::future_status::ready, waitingPredict.wait_for(std::chrono::seconds(5)));
+    EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(40));
+    EXPECT_EQ(waitingPredict.get(), 0);
+    inferRequestsQueue.returnStream(0);
+}
+
+TEST(OVInferRequestQueue, NewRequestsDoNotOvertakeWaitingOnes) {
+    InferenceEngine::Core engine;
+    InferenceEngine::CNNNetwork network = engine.ReadNetwork(DUMMY_MODEL_PATH);
+    InferenceEngine::ExecutableNetwork execNetwork = engine.LoadNetwork(network, "CPU");
+    ovms::StreamSchedulingConfig schedulingConfig;
+    schedulingConfig.reservedStreamsRatio = 0.5;
+    schedulingConfig.reservedStreamsBorrowAfterMs = 50;
+    ovms::OVInferRequestsQueue inferRequestsQueue({execNetwork}, 2, schedulingConfig);
+    ASSERT_TRUE(inferRequestsQueue.isStreamReserved(1));
+
+    inferRequestsQueue.returnStream(inferRequestsQueue.getIdleStream(ovms::StreamRequester::PRIORITY_PIPELINE_NODE).get());
+    EXPECT_EQ(inferRequestsQueue.getIdleStream().get(), 0);
+    auto waitingNode = inferRequestsQueue.getIdleStream(ovms::StreamRequester::PIPELINE_NODE);
+    EXPECT_EQ(std::future_status::timeout, waitingNode.wait_for(std::chrono::microseconds(1)));
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    auto newPredict = inferRequestsQueue.getIdleStream();
+    ASSERT_EQ(std::future_status::ready, waitingNode.wait_for(std::chrono::seconds(5)));
+    EXPECT_EQ(waitingNode.get(), 1);
+    EXPECT_EQ(std::future_status::timeout, newPredict.wait_for(std::chrono::microseconds(1)));
+    inferRequestsQueue.returnStream(0);
+    ASSERT_EQ(std::future_status::ready, newPredict.wait_for(std::chrono::microseconds(1)));
+    EXPECT_EQ(newPredict.get(), 0);
+    inferRequestsQueue.returnStream(1);
+    inferRequestsQueue.returnStream(0);
+}
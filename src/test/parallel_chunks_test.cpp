@@ -0,0 +1,61 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include <atomic>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "../parallel_chunks.hpp"
+
+using namespace ovms;
+
+TEST(ParallelChunks, ChunksCountLimitedByPayloadSize) {
+    EXPECT_EQ(getParallelChunksCount(1000, 0), 1u);
+    EXPECT_EQ(getParallelChunksCount(1000, PARALLEL_CHUNK_MIN_VALUES - 1), 1u);
+    EXPECT_EQ(getParallelChunksCount(1, PARALLEL_CHUNK_MIN_VALUES * 1000), 1u);
+    EXPECT_LE(getParallelChunksCount(1000, PARALLEL_CHUNK_MIN_VALUES * 2), 2u);
+    EXPECT_LE(getParallelChunksCount(1000, PARALLEL_CHUNK_MIN_VALUES * 1000), std::max(std::thread::hardware_concurrency(), 1u));
+}
+
+TEST(ParallelChunks, EachItemProcessedOnce) {
+    for (size_t chunks : {1, 2, 3, 7, 100}) {
+        std::vector<std::atomic<int>> counters(10);
+        std::vector<std::atomic<int>> chunksSeen(chunks);
+        EXPECT_TRUE(runInParallelChunks(3, 10, chunks, [&](size_t chunk, size_t begin, size_t end) {
+            chunksSeen[chunk]++;
+            for (size_t i = begin; i < end; i++) {
+                counters[i]++;
+            }
+            return true;
+        }));
+        for (size_t i = 0; i < counters.size(); i++) {
+            EXPECT_EQ(counters[i], i < 3 ? 0 : 1) << "chunks: " << chunks << " item: " << i;
+        }
+        for (size_t i = 0; i < chunks; i++) {
+            EXPECT_EQ(chunksSeen[i], i < 7 ? 1 : 0) << "chunks: " << chunks << " chunk: " << i;
+        }
+    }
+}
+
+TEST(ParallelChunks, FailureOfAnyChunkReported) {
+    EXPECT_FALSE(runInParallelChunks(0, 100, 4, [](size_t chunk, size_t begin, size_t end) {
+        return chunk != 3;
+    }));
+    EXPECT_FALSE(runInParallelChunks(0, 100, 4, [](size_t chunk, size_t begin, size_t end) {
+        return chunk != 0;
+    }));
+}
@@ -0,0 +1,72 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "../parallel_workers.hpp"
+
+using namespace ovms;
+
+TEST(ParallelWorkers, EachItemProcessedOnce) {
+    for (size_t workersCount : {0, 1, 4}) {
+        ParallelWorkers workers(workersCount);
+        EXPECT_EQ(workers.getWorkersCount(), workersCount);
+        for (size_t count : {0, 1, 2, 100}) {
+            std::vector<std::atomic<int>> counters(count);
+            workers.run(count, [&counters](size_t i) { counters[i]++; });
+            for (size_t i = 0; i < count; i++) {
+                EXPECT_EQ(counters[i], 1) << "workers: " << workersCount << " count: " << count << " item: " << i;
+            }
+        }
+    }
+}
+
+TEST(ParallelWorkers, ThreadsLimitedByWorkersCount) {
+    ParallelWorkers workers(2);
+    std::atomic<int> running{0};
+    std::atomic<int> maxRunning{0};
+    workers.run(20, [&](size_t) {
+        int current = ++running;
+        int previousMax = maxRunning;
+        while (current > previousMax && !maxRunning.compare_exchange_weak(previousMax, current)) {
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        running--;
+    });
+    EXPECT_LE(maxRunning, 3);
+}
+
+TEST(ParallelWorkers, NestedAndConcurrentRunsComplete) {
+    ParallelWorkers workers(2);
+    std::atomic<int> processed{0};
+    std::vector<std::thread> callers;
+    for (int i = 0; i < 4; i++) {
+        callers.emplace_back([&workers, &processed]() {
+            workers.run(8, [&workers, &processed](size_t) {
+                workers.run(8, [&processed](size_t) { processed++; });
+            });
+        });
+    }
+    for (auto& caller : callers) {
+        caller.join();
+    }
+    EXPECT_EQ(processed, 4 * 8 * 8);
+}
@@ -348,6 +348,16 @@ TEST(RestParserColumn, ParseUint64) {
     }
 }
 
+TEST(RestParserColumn, UntypedLargeIntegerAcceptedOnlyForSequenceId) {
+    RestParser parser;
+    ASSERT_EQ(parser.parse(R"({"signature_name":"","inputs":{"sequence_id":[5000000000]}})"), StatusCode::OK);
+    EXPECT_EQ(parser.getProto().inputs().at("sequence_id").dtype(), DataType::DT_UINT64);
+    EXPECT_THAT(asVector<uint64_t>(parser.getProto().inputs().at("sequence_id").tensor_content()), ElementsAre(5000000000U));
+
+    RestParser otherInputParser;
+    EXPECT_EQ(otherInputParser.parse(R"({"signature_name":"","inputs":{"i":[5000000000]}})"), StatusCode::REST_COULD_NOT_PARSE_INPUT);
+}
+
 TEST(RestParserColumn, ParseInt64) {
     std::vector<RestParser> parsers{RestParser(prepareTensors({{"i", {1, 1, 4}}}, InferenceEngine::Precision::I64))};
     for (RestParser& parser : parsers) {
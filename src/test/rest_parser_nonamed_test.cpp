@@ -13,6 +13,9 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 //*****************************************************************************
+#include <numeric>
+#include <sstream>
+
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
@@ -117,3 +120,27 @@ TEST(RestParserNoNamed, ColumnOrder_5) {
     EXPECT_THAT(asVector(my_input.tensor_shape()), ElementsAre(5));
     EXPECT_THAT(asVector<float>(my_input.tensor_content()), ElementsAre(1, 2, 3, 4, 5));
 }
+
+TEST(RestParserNoNamed, RowOrder_LargeRequestParsedInParallelChunks) {
+    const int batchSize = 4096, size = 64;
+    RestParser parser(prepareTensors({{"my_input", {batchSize, size}}}));
+    std::stringstream ss;
+    ss << R"({"signature_name":"","instances":[)";
+    for (int i = 0; i < batchSize; i++) {
+        ss << (i ? ",[" : "[");
+        for (int j = 0; j < size; j++) {
+            ss << (j ? "," : "") << i * size + j;
+        }
+        ss << "]";
+    }
+    ss << "]}";
+
+    ASSERT_EQ(parser.parse(ss.str().c_str()), StatusCode::OK);
+    EXPECT_EQ(parser.getOrder(), Order::ROW);
+    EXPECT_EQ(parser.getFormat(), Format::NONAMED);
+    const auto& my_input = parser.getProto().inputs().at("my_input");
+    EXPECT_THAT(asVector(my_input.tensor_shape()), ElementsAre(batchSize, size));
+    std::vector<float> expected(batchSize * size);
+    std::iota(expected.begin(), expected.end(), 0);
+    EXPECT_EQ(asVector<float>(my_input.tensor_content()), expected);
+}
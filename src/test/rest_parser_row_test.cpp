@@ -13,6 +13,9 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 //*****************************************************************************
+#include <numeric>
+#include <sstream>
+
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
@@ -106,6 +109,25 @@ TEST(RestParserRow, ParseValid2Inputs) {
     }
 }
 
+TEST(RestParserRow, ParseBatchPredictItem) {
+    rapidjson::Document doc;
+    ASSERT_FALSE(doc.Parse(R"({"requests": [
+        {"model_name": "a", "instances": [{"i": [1.0, 2.0]}]},
+        {"model_name": "b", "model_version": 2, "instances": [{"i": [3.0]}, {"i": [4.0]}]}
+    ]})").HasParseError());
+    auto& requests = doc["requests"];
+
+    RestParser first;
+    ASSERT_EQ(first.parse(requests[0]), StatusCode::OK);
+    ASSERT_EQ(first.getProto().inputs().count("i"), 1);
+    EXPECT_THAT(asVector(first.getProto().inputs().at("i").tensor_shape()), ElementsAre(1, 2));
+
+    RestParser second;
+    ASSERT_EQ(second.parse(requests[1]), StatusCode::OK);
+    ASSERT_EQ(second.getProto().inputs().count("i"), 1);
+    EXPECT_THAT(asVector(second.getProto().inputs().at("i").tensor_shape()), ElementsAre(2, 1));
+}
+
 TEST(RestParserRow, ValidShape_1x1) {
     std::vector<RestParser> parsers{RestParser(), RestParser(prepareTensors({{"i", {1, 1}}}))};
     for (RestParser& parser : parsers) {
@@ -663,3 +685,49 @@ TEST(RestParserRow, RemoveUnnecessaryInputs) {
         ASSERT_EQ(parser.getProto().inputs().count("l"), 1);
     }
 }
+
+static std::string prepareLargeNamedRequest(int batchSize, int size, int lastInstanceSize) {
+    std::stringstream ss;
+    ss << R"({"signature_name":"","instances":[)";
+    for (int i = 0; i < batchSize; i++) {
+        ss << (i ? "," : "") << R"({"i":[[)";
+        for (int j = 0; j < (i + 1 < batchSize ? size : lastInstanceSize); j++) {
+            ss << (j ? "," : "") << i * size + j;
+        }
+        ss << R"(]],"j":[)" << i << "]}";
+    }
+    ss << "]}";
+    return ss.str();
+}
+
+TEST(RestParserRow, ParseLargeRequestInParallelChunks) {
+    const int batchSize = 4096, size = 64;
+    std::vector<RestParser> parsers{RestParser(), RestParser(prepareTensors({{"i", {batchSize, 1, size}}, {"j", {batchSize, 1}}}))};
+    for (RestParser& parser : parsers) {
+        ASSERT_EQ(parser.parse(prepareLargeNamedRequest(batchSize, size, size).c_str()), StatusCode::OK);
+        EXPECT_EQ(parser.getFormat(), Format::NAMED);
+        const auto& i = parser.getProto().inputs().at("i");
+        const auto& j = parser.getProto().inputs().at("j");
+        EXPECT_THAT(asVector(i.tensor_shape()), ElementsAre(batchSize, 1, size));
+        EXPECT_THAT(asVector(j.tensor_shape()), ElementsAre(batchSize, 1));
+        std::vector<float> expectedI(batchSize * size), expectedJ(batchSize);
+        std::iota(expectedI.begin(), expectedI.end(), 0);
+        std::iota(expectedJ.begin(), expectedJ.end(), 0);
+        if (i.dtype() == DataType::DT_FLOAT) {
+            EXPECT_EQ(asVector<float>(i.tensor_content()), expectedI);
+            EXPECT_EQ(asVector<float>(j.tensor_content()), expectedJ);
+        } else {
+            ASSERT_EQ(i.dtype(), DataType::DT_INT32);
+            EXPECT_EQ(asVector<int32_t>(i.tensor_content()), std::vector<int32_t>(expectedI.begin(), expectedI.end()));
+            EXPECT_EQ(asVector<int32_t>(j.tensor_content()), std::vector<int32_t>(expectedJ.begin(), expectedJ.end()));
+        }
+    }
+}
+
+TEST(RestParserRow, ParseLargeRequestWithInvalidLastInstance) {
+    const int batchSize = 4096, size = 64;
+    std::vector<RestParser> parsers{RestParser(), RestParser(prepareTensors({{"i", {batchSize, 1, size}}, {"j", {batchSize, 1}}}))};
+    for (RestParser& parser : parsers) {
+        EXPECT_EQ(parser.parse(prepareLargeNamedRequest(batchSize, size, size - 1).c_str()), StatusCode::REST_COULD_NOT_PARSE_INSTANCE);
+    }
+}
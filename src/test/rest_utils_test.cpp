@@ -13,8 +13,12 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 //*****************************************************************************
+#include <sstream>
+
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
+#include <rapidjson/document.h>
+#include <zlib.h>
 
 #include "../rest_utils.hpp"
 
@@ -406,3 +410,123 @@ TEST_F(RestUtilsPrecisionTest, MakeJsonFromPredictResponse_Uint64) {
     ]
 })");
 }
+
+TEST(RestUtilsParallel, MakeJsonFromPredictResponse_LargeRowOrderResponse) {
+    const int batchSize = 70000;
+    tensorflow::serving::PredictResponse proto;
+    auto& output = (*proto.mutable_outputs())["output"];
+    output.set_dtype(tensorflow::DataType::DT_INT8);
+    output.mutable_tensor_shape()->add_dim()->set_size(batchSize);
+    output.mutable_tensor_shape()->add_dim()->set_size(2);
+    std::stringstream expected;
+    expected << "{\n    \"predictions\": [";
+    for (int i = 0; i < batchSize; i++) {
+        int8_t row[2] = {static_cast<int8_t>(i % 100), static_cast<int8_t>(-(i % 100))};
+        output.mutable_tensor_content()->append(reinterpret_cast<const char*>(row), sizeof(row));
+        expected << (i ? ", [" : "[") << static_cast<int>(row[0]) << ", " << static_cast<int>(row[1]) << "]";
+    }
+    expected << "\n    ]\n}";
+
+    std::string json;
+    ASSERT_EQ(makeJsonFromPredictResponse(proto, &json, Order::ROW), StatusCode::OK);
+    EXPECT_EQ(json, expected.str());
+}
+
+class RestUtilsChunksTest : public ::testing::Test {
+protected:
+    tensorflow::serving::PredictResponse proto;
+
+    void addOutput(const std::string& name, size_t batchSize) {
+        auto& output = (*proto.mutable_outputs())[name];
+        output.set_dtype(tensorflow::DataType::DT_FLOAT);
+        output.mutable_tensor_shape()->add_dim()->set_size(batchSize);
+        output.mutable_tensor_shape()->add_dim()->set_size(3);
+        for (size_t i = 0; i < batchSize * 3; i++) {
+            float value = i * 0.5f - name.size();
+            output.mutable_tensor_content()->append(reinterpret_cast<const char*>(&value), sizeof(value));
+        }
+    }
+
+    std::string makeJsonInSinglePass() {
+        auto copy = proto;
+        std::string json;
+        EXPECT_EQ(makeJsonFromPredictResponse(copy, &json, Order::ROW), StatusCode::OK);
+        return json;
+    }
+};
+
+TEST_F(RestUtilsChunksTest, UnnamedOutputSameAsSinglePass) {
+    addOutput("output", 5);
+    const auto expected = makeJsonInSinglePass();
+    for (size_t chunks : {2, 3, 5, 8}) {
+        std::string json;
+        ASSERT_EQ(makeJsonFromRowOrderResponseInChunks(proto, &json, chunks), StatusCode::OK);
+        EXPECT_EQ(json, expected) << "chunks: " << chunks;
+    }
+}
+
+TEST_F(RestUtilsChunksTest, NamedOutputsSameAsSinglePass) {
+    addOutput("output1", 7);
+    addOutput("output2", 7);
+    // Brackets and escaped quotes in output names must not be taken for predictions array boundaries
+    addOutput("out[\"]\"put3", 7);
+    const auto singlePass = makeJsonInSinglePass();
+    rapidjson::Document expected;
+    ASSERT_FALSE(expected.Parse(singlePass.c_str()).HasParseError());
+    for (size_t chunks : {2, 3, 7}) {
+        std::string json;
+        ASSERT_EQ(makeJsonFromRowOrderResponseInChunks(proto, &json, chunks), StatusCode::OK);
+        // Order of outputs within prediction objects is not defined, so documents are compared instead of text
+        rapidjson::Document actual;
+        ASSERT_FALSE(actual.Parse(json.c_str()).HasParseError()) << json;
+        EXPECT_TRUE(actual == expected) << "chunks: " << chunks << std::endl
+                                        << json;
+        EXPECT_EQ(json.size(), singlePass.size());
+    }
+}
+
+TEST_F(RestUtilsChunksTest, OutputsWithDifferentBatchSizeRejected) {
+    addOutput("output1", 4);
+    addOutput("output2", 5);
+    std::string json;
+    EXPECT_EQ(makeJsonFromRowOrderResponseInChunks(proto, &json, 2), StatusCode::REST_PROTO_TO_STRING_ERROR);
+}
+
+TEST(RestUtilsCompression, GzipEncodingAccepted) {
+    EXPECT_TRUE(isGzipEncodingAccepted("gzip"));
+    EXPECT_TRUE(isGzipEncodingAccepted("deflate, gzip;q=1.0, *;q=0.5"));
+    EXPECT_TRUE(isGzipEncodingAccepted("br, GZIP"));
+    EXPECT_TRUE(isGzipEncodingAccepted("*"));
+    EXPECT_FALSE(isGzipEncodingAccepted(""));
+    EXPECT_FALSE(isGzipEncodingAccepted("deflate, br"));
+    EXPECT_FALSE(isGzipEncodingAccepted("gzip;q=0, deflate"));
+    EXPECT_FALSE(isGzipEncodingAccepted("x-gzip"));
+    EXPECT_FALSE(isGzipEncodingAccepted("gzip;q=0, *"));
+    EXPECT_FALSE(isGzipEncodingAccepted("*, gzip;q=0"));
+    EXPECT_TRUE(isGzipEncodingAccepted("*;q=0, gzip"));
+}
+
+TEST(RestUtilsCompression, CompressGzip) {
+    std::string input;
+    for (int i = 0; i < 1000; i++) {
+        input += "{\"outputs\": [1.0, 2.0, 3.0]}";
+    }
+    std::string compressed;
+    ASSERT_TRUE(compressGzip(input, &compressed));
+    EXPECT_LT(compressed.size(), input.size());
+    // gzip magic bytes
+    ASSERT_GT(compressed.size(), 2);
+    EXPECT_EQ((unsigned char)compressed[0], 0x1f);
+    EXPECT_EQ((unsigned char)compressed[1], 0x8b);
+
+    z_stream stream{};
+    ASSERT_EQ(inflateInit2(&stream, 15 + 16), Z_OK);
+    std::string decompressed(input.size(), '\0');
+    stream.next_in = (Bytef*)compressed.data();
+    stream.avail_in = compressed.size();
+    stream.next_out = (Bytef*)decompressed.data();
+    stream.avail_out = decompressed.size();
+    EXPECT_EQ(inflate(&stream, Z_FINISH), Z_STREAM_END);
+    inflateEnd(&stream);
+    EXPECT_EQ(decompressed, input);
+}
@@ -0,0 +1,143 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include <chrono>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "../sequence_manager.hpp"
+
+using ovms::Sequence;
+using ovms::SequenceControl;
+using ovms::SequenceEndGuard;
+using ovms::SequenceManager;
+using ovms::StatusCode;
+
+namespace {
+const std::string DUMMY_MODEL_PATH = std::filesystem::current_path().u8string() + "/src/test/dummy/1/dummy.xml";
+}
+
+TEST(SequenceManager, StartWithoutIdGeneratesId) {
+    SequenceManager manager(10, std::chrono::milliseconds(0), 1);
+    std::shared_ptr<Sequence> sequence;
+    uint64_t sequenceId = 0;
+    ASSERT_EQ(manager.acquireSequence(sequenceId, SequenceControl::SEQUENCE_START, sequence), StatusCode::OK);
+    EXPECT_NE(sequenceId, 0);
+    EXPECT_EQ(sequence->getId(), sequenceId);
+    uint64_t nextSequenceId = 0;
+    ASSERT_EQ(manager.acquireSequence(nextSequenceId, SequenceControl::SEQUENCE_START, sequence), StatusCode::OK);
+    EXPECT_NE(nextSequenceId, sequenceId);
+    EXPECT_EQ(manager.getSequencesCount(), 2);
+}
+
+TEST(SequenceManager, StartExistingSequenceFails) {
+    SequenceManager manager(10, std::chrono::milliseconds(0), 1);
+    std::shared_ptr<Sequence> sequence;
+    uint64_t sequenceId = 42;
+    ASSERT_EQ(manager.acquireSequence(sequenceId, SequenceControl::SEQUENCE_START, sequence), StatusCode::OK);
+    EXPECT_EQ(sequenceId, 42);
+    EXPECT_EQ(manager.acquireSequence(sequenceId, SequenceControl::SEQUENCE_START, sequence), StatusCode::SEQUENCE_ALREADY_EXISTS);
+    EXPECT_EQ(manager.acquireSequence(sequenceId, SequenceControl::NO_CONTROL, sequence), StatusCode::OK);
+}
+
+TEST(SequenceManager, ContinueRequiresExistingSequence) {
+    SequenceManager manager(10, std::chrono::milliseconds(0), 1);
+    std::shared_ptr<Sequence> sequence;
+    uint64_t sequenceId = 0;
+    EXPECT_EQ(manager.acquireSequence(sequenceId, SequenceControl::NO_CONTROL, sequence), StatusCode::SEQUENCE_ID_MISSING);
+    sequenceId = 7;
+    EXPECT_EQ(manager.acquireSequence(sequenceId, SequenceControl::SEQUENCE_END, sequence), StatusCode::SEQUENCE_MISSING);
+    ASSERT_EQ(manager.acquireSequence(sequenceId, SequenceControl::SEQUENCE_START, sequence), StatusCode::OK);
+    manager.removeSequence(sequenceId);
+    EXPECT_EQ(manager.acquireSequence(sequenceId, SequenceControl::NO_CONTROL, sequence), StatusCode::SEQUENCE_MISSING);
+}
+
+TEST(SequenceManager, MaxSequenceNumber) {
+    SequenceManager manager(2, std::chrono::milliseconds(0), 1);
+    std::shared_ptr<Sequence> sequence;
+    for (uint64_t id = 1; id <= 2; id++) {
+        ASSERT_EQ(manager.acquireSequence(id, SequenceControl::SEQUENCE_START, sequence), StatusCode::OK);
+    }
+    uint64_t sequenceId = 3;
+    EXPECT_EQ(manager.acquireSequence(sequenceId, SequenceControl::SEQUENCE_START, sequence), StatusCode::MAX_SEQUENCE_NUMBER_REACHED);
+}
+
+TEST(SequenceManager, IdleSequencesAreRemoved) {
+    SequenceManager manager(2, std::chrono::milliseconds(10), 1);
+    std::shared_ptr<Sequence> idleSequence, processedSequence;
+    uint64_t idleSequenceId = 1, processedSequenceId = 2;
+    ASSERT_EQ(manager.acquireSequence(idleSequenceId, SequenceControl::SEQUENCE_START, idleSequence), StatusCode::OK);
+    ASSERT_EQ(manager.acquireSequence(processedSequenceId, SequenceControl::SEQUENCE_START, processedSequence), StatusCode::OK);
+    std::lock_guard<std::mutex> processingLock(processedSequence->getMutex());
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    std::shared_ptr<Sequence> sequence;
+    uint64_t sequenceId = 3;
+    ASSERT_EQ(manager.acquireSequence(sequenceId, SequenceControl::SEQUENCE_START, sequence), StatusCode::OK);
+    EXPECT_EQ(manager.getSequencesCount(), 2);
+    EXPECT_EQ(manager.acquireSequence(idleSequenceId, SequenceControl::NO_CONTROL, sequence), StatusCode::SEQUENCE_MISSING);
+    EXPECT_EQ(manager.acquireSequence(processedSequenceId, SequenceControl::NO_CONTROL, sequence), StatusCode::OK);
+}
+
+TEST(SequenceManager, IdleSequencesAreRemovedOnAnyAccess) {
+    SequenceManager manager(10, std::chrono::milliseconds(50), 1);
+    std::shared_ptr<Sequence> idleSequence, activeSequence;
+    uint64_t idleSequenceId = 1, activeSequenceId = 2;
+    ASSERT_EQ(manager.acquireSequence(idleSequenceId, SequenceControl::SEQUENCE_START, idleSequence), StatusCode::OK);
+    ASSERT_EQ(manager.acquireSequence(activeSequenceId, SequenceControl::SEQUENCE_START, activeSequence), StatusCode::OK);
+    for (int i = 0; i < 3; i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(30));
+        ASSERT_EQ(manager.acquireSequence(activeSequenceId, SequenceControl::NO_CONTROL, activeSequence), StatusCode::OK);
+    }
+    EXPECT_EQ(manager.getSequencesCount(), 1);
+}
+
+TEST(SequenceManager, EndGuardRemovesOnlyEndedSequence) {
+    SequenceManager manager(10, std::chrono::milliseconds(0), 1);
+    std::shared_ptr<Sequence> sequence;
+    uint64_t sequenceId = 1;
+    ASSERT_EQ(manager.acquireSequence(sequenceId, SequenceControl::SEQUENCE_START, sequence), StatusCode::OK);
+    { SequenceEndGuard guard(&manager, sequenceId, SequenceControl::NO_CONTROL); }
+    EXPECT_EQ(manager.getSequencesCount(), 1);
+    { SequenceEndGuard guard(&manager, sequenceId, SequenceControl::SEQUENCE_END); }
+    EXPECT_EQ(manager.getSequencesCount(), 0);
+    { SequenceEndGuard guard(nullptr, sequenceId, SequenceControl::SEQUENCE_END); }
+}
+
+TEST(SequenceManager, SequencePrefersStreamHoldingItsState) {
+    InferenceEngine::Core engine;
+    InferenceEngine::CNNNetwork network = engine.ReadNetwork(DUMMY_MODEL_PATH);
+    InferenceEngine::ExecutableNetwork execNetwork = engine.LoadNetwork(network, "CPU");
+    ovms::OVInferRequestsQueue inferRequestsQueue(execNetwork, 2);
+    SequenceManager manager(10, std::chrono::milliseconds(0), 2);
+    std::shared_ptr<Sequence> first, second;
+    uint64_t firstId = 1, secondId = 2;
+    ASSERT_EQ(manager.acquireSequence(firstId, SequenceControl::SEQUENCE_START, first), StatusCode::OK);
+    ASSERT_EQ(manager.acquireSequence(secondId, SequenceControl::SEQUENCE_START, second), StatusCode::OK);
+    EXPECT_EQ(manager.getPreferredStream(*first), -1);
+    ASSERT_EQ(manager.bindSequenceState(*first, 1, inferRequestsQueue, true), StatusCode::OK);
+    EXPECT_EQ(manager.getPreferredStream(*first), 1);
+    // Stream taken by other sequence is not preferred anymore
+    ASSERT_EQ(manager.bindSequenceState(*second, 1, inferRequestsQueue, true), StatusCode::OK);
+    EXPECT_EQ(manager.getPreferredStream(*first), -1);
+    EXPECT_EQ(manager.getPreferredStream(*second), 1);
+    ASSERT_EQ(manager.bindSequenceState(*first, 0, inferRequestsQueue, false), StatusCode::OK);
+    EXPECT_EQ(manager.getPreferredStream(*first), 0);
+    manager.removeSequence(firstId);
+    EXPECT_EQ(manager.bindSequenceState(*first, 0, inferRequestsQueue, false), StatusCode::SEQUENCE_MISSING);
+}
@@ -0,0 +1,129 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include <cstring>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wall"
+#include "tensorflow_serving/apis/prediction_service.grpc.pb.h"
+#pragma GCC diagnostic pop
+
+#include "../shape_buckets.hpp"
+
+using namespace ovms;
+
+using InferenceEngine::Layout;
+using InferenceEngine::Precision;
+
+namespace {
+tensorflow::TensorShapeProto makeShape(const shape_t& dims) {
+    tensorflow::TensorShapeProto shape;
+    for (auto dim : dims) {
+        shape.add_dim()->set_size(dim);
+    }
+    return shape;
+}
+}  // namespace
+
+TEST(ShapeBuckets, FitsInShapeOnlyWhenSpatialDimensionsAreNotLarger) {
+    EXPECT_TRUE(fitsInShapeWithPadding({1, 3, 640, 640}, Layout::NCHW, makeShape({1, 3, 480, 640})));
+    EXPECT_TRUE(fitsInShapeWithPadding({1, 640, 640, 3}, Layout::NHWC, makeShape({1, 480, 320, 3})));
+    EXPECT_FALSE(fitsInShapeWithPadding({1, 3, 640, 640}, Layout::NCHW, makeShape({1, 3, 641, 640})));
+    EXPECT_FALSE(fitsInShapeWithPadding({1, 3, 640, 640}, Layout::NCHW, makeShape({1, 1, 320, 320})));
+    EXPECT_FALSE(fitsInShapeWithPadding({1, 3, 640, 640}, Layout::NCHW, makeShape({2, 3, 320, 320})));
+    EXPECT_FALSE(fitsInShapeWithPadding({1, 640}, Layout::NC, makeShape({1, 320})));
+}
+
+TEST(ShapeBuckets, SmallestFittingBucketIsSelectedPerDimension) {
+    shape_t bucketShape;
+    ASSERT_EQ(getBucketShape({1280, 320, 640}, Layout::NCHW, makeShape({1, 3, 300, 700}), bucketShape), StatusCode::OK);
+    EXPECT_EQ(bucketShape, (shape_t{1, 3, 320, 1280}));
+    ASSERT_EQ(getBucketShape({320, 640}, Layout::NHWC, makeShape({1, 640, 100, 3}), bucketShape), StatusCode::OK);
+    EXPECT_EQ(bucketShape, (shape_t{1, 640, 320, 3}));
+}
+
+TEST(ShapeBuckets, RequestLargerThanBucketsShouldFail) {
+    shape_t bucketShape;
+    EXPECT_EQ(getBucketShape({320, 640}, Layout::NCHW, makeShape({1, 3, 641, 100}), bucketShape), StatusCode::INVALID_SHAPE);
+    EXPECT_EQ(getBucketShape({320, 640}, Layout::NC, makeShape({1, 100}), bucketShape), StatusCode::INVALID_NO_OF_SHAPE_DIMENSIONS);
+}
+
+TEST(ShapeBuckets, PaddingDependsOnMode) {
+    auto padding = getBucketPadding({1, 3, 8, 8}, Layout::NCHW, makeShape({1, 3, 5, 2}), BucketPaddingMode::PAD);
+    EXPECT_EQ(padding.top, 0u);
+    EXPECT_EQ(padding.left, 0u);
+    EXPECT_EQ(padding.bottom, 3u);
+    EXPECT_EQ(padding.right, 6u);
+    padding = getBucketPadding({1, 3, 8, 8}, Layout::NCHW, makeShape({1, 3, 5, 2}), BucketPaddingMode::LETTERBOX);
+    EXPECT_EQ(padding.top, 1u);
+    EXPECT_EQ(padding.left, 3u);
+    EXPECT_EQ(padding.bottom, 2u);
+    EXPECT_EQ(padding.right, 3u);
+}
+
+TEST(ShapeBuckets, PadBlobNHWC) {
+    std::vector<float> data{1, 2, 3, 4};
+    InferenceEngine::TensorDesc sourceDesc(Precision::FP32, {1, 1, 2, 2}, Layout::NHWC);
+    InferenceEngine::Blob::Ptr source = InferenceEngine::make_shared_blob<float>(sourceDesc, data.data());
+    InferenceEngine::TensorDesc desc(Precision::FP32, {1, 2, 3, 2}, Layout::NHWC);
+    BucketPadding padding;
+    padding.top = 1;
+    padding.left = 1;
+    padding.right = 1;
+    InferenceEngine::Blob::Ptr padded;
+    ASSERT_EQ(padBlob(source, desc, padding, -1.0, padded), StatusCode::OK);
+    const float* result = padded->buffer().as<const float*>();
+    std::vector<float> expected{
+        -1, -1, -1, -1, -1, -1,
+        -1, -1, 1, 2, 3, 4};
+    EXPECT_EQ(std::vector<float>(result, result + padded->size()), expected);
+}
+
+TEST(ShapeBuckets, PadBlobNCHW) {
+    std::vector<uint8_t> data{1, 2, 3, 4};
+    InferenceEngine::TensorDesc sourceDesc(Precision::U8, {1, 2, 1, 2}, Layout::NCHW);
+    InferenceEngine::Blob::Ptr source = InferenceEngine::make_shared_blob<uint8_t>(sourceDesc, data.data());
+    InferenceEngine::TensorDesc desc(Precision::U8, {1, 2, 2, 2}, Layout::NCHW);
+    BucketPadding padding;
+    padding.bottom = 1;
+    InferenceEngine::Blob::Ptr padded;
+    ASSERT_EQ(padBlob(source, desc, padding, 0, padded), StatusCode::OK);
+    const uint8_t* result = padded->buffer().as<const uint8_t*>();
+    std::vector<uint8_t> expected{1, 2, 0, 0, 3, 4, 0, 0};
+    EXPECT_EQ(std::vector<uint8_t>(result, result + padded->size()), expected);
+}
+
+TEST(ShapeBuckets, PaddingIsAddedToResponse) {
+    tensorflow::serving::PredictResponse response;
+    BucketPadding padding;
+    padding.top = 1;
+    padding.left = 2;
+    padding.bottom = 3;
+    padding.right = 4;
+    addBucketPaddingToResponse("image", padding, 2, response);
+    ASSERT_EQ(response.outputs().count("image/padding"), 1);
+    const auto& output = response.outputs().at("image/padding");
+    EXPECT_EQ(output.dtype(), tensorflow::DataType::DT_INT32);
+    ASSERT_EQ(output.tensor_shape().dim_size(), 2);
+    EXPECT_EQ(output.tensor_shape().dim(0).size(), 2);
+    EXPECT_EQ(output.tensor_shape().dim(1).size(), 4);
+    ASSERT_EQ(output.tensor_content().size(), 8 * sizeof(int32_t));
+    std::vector<int32_t> values(8);
+    std::memcpy(values.data(), output.tensor_content().data(), output.tensor_content().size());
+    EXPECT_EQ(values, (std::vector<int32_t>{1, 2, 3, 4, 1, 2, 3, 4}));
+}
@@ -0,0 +1,92 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "../shared_networks.hpp"
+
+using namespace ovms;
+
+class SharedNetworksTest : public ::testing::Test {
+protected:
+    std::string directory;
+
+    void SetUp() override {
+        directory = std::filesystem::temp_directory_path().string() + "/ovms_shared_networks_test";
+        std::filesystem::remove_all(directory);
+        std::filesystem::create_directories(directory);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(directory);
+    }
+
+    std::string createFile(const std::string& name, const std::string& content) {
+        std::string path = directory + "/" + name;
+        std::ofstream file(path, std::ios::binary);
+        file << content;
+        return path;
+    }
+};
+
+TEST_F(SharedNetworksTest, IdenticalFilesHaveEqualHash) {
+    auto& sharedNetworks = SharedNetworks::instance();
+    std::string first, second, other;
+    ASSERT_EQ(sharedNetworks.hashFiles({createFile("1.xml", "xml"), createFile("1.bin", "weights")}, first), StatusCode::OK);
+    ASSERT_EQ(sharedNetworks.hashFiles({createFile("2.xml", "xml"), createFile("2.bin", "weights")}, second), StatusCode::OK);
+    ASSERT_EQ(sharedNetworks.hashFiles({createFile("3.xml", "xml"), createFile("3.bin", "weightz")}, other), StatusCode::OK);
+    EXPECT_EQ(first, second);
+    EXPECT_NE(first, other);
+    EXPECT_EQ(first, "bf92a04e60b4b2362d45490e5142e47b687c2ebb5898da6bc71b697602016e6e"
+              "9a129038d9a00aed0cf6a7ea059ca50a813449061ab87848cf1a13eafdf33b2c");
+}
+
+TEST_F(SharedNetworksTest, ChangedFileIsHashedAgain) {
+    auto& sharedNetworks = SharedNetworks::instance();
+    auto path = createFile("model.bin", "weights");
+    std::string before, after;
+    ASSERT_EQ(sharedNetworks.hashFiles({path}, before), StatusCode::OK);
+    createFile("model.bin", "other weights");
+    ASSERT_EQ(sharedNetworks.hashFiles({path}, after), StatusCode::OK);
+    EXPECT_NE(before, after);
+}
+
+TEST_F(SharedNetworksTest, MissingFile) {
+    std::string hash;
+    EXPECT_EQ(SharedNetworks::instance().hashFiles({directory + "/missing.bin"}, hash), StatusCode::FILE_INVALID);
+}
+
+TEST_F(SharedNetworksTest, NetworkRegisteredUntilLastUserReleasesIt) {
+    auto& sharedNetworks = SharedNetworks::instance();
+    const std::string key = "SharedNetworksTest";
+    EXPECT_EQ(sharedNetworks.find(key), nullptr);
+    auto network = std::make_shared<SharedNetwork>();
+    EXPECT_TRUE(sharedNetworks.add(key, network));
+    EXPECT_FALSE(sharedNetworks.add(key, std::make_shared<SharedNetwork>()));
+    auto user = sharedNetworks.find(key);
+    EXPECT_EQ(user, network);
+    network.reset();
+    EXPECT_NE(sharedNetworks.find(key), nullptr);
+    user.reset();
+    EXPECT_EQ(sharedNetworks.find(key), nullptr);
+    EXPECT_TRUE(sharedNetworks.add(key, std::make_shared<SharedNetwork>()));
+    EXPECT_EQ(sharedNetworks.find(key), nullptr);
+}
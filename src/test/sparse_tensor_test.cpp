@@ -0,0 +1,71 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "../sparse_tensor.hpp"
+
+using ovms::densifyCoo;
+using ovms::densifyCsr;
+using ovms::StatusCode;
+
+TEST(SparseTensor, DensifyCoo) {
+    std::vector<int64_t> indices{0, 1, 1, 2};
+    std::vector<float> values{1.5, -2.0};
+    std::vector<float> dense(2 * 3, 0);
+    std::vector<size_t> writtenOffsets;
+    auto status = densifyCoo((const char*)indices.data(), (const char*)values.data(), values.size(), sizeof(float),
+        {2, 3}, (char*)dense.data(), writtenOffsets);
+    ASSERT_EQ(status, StatusCode::OK);
+    EXPECT_EQ(dense, (std::vector<float>{0, 1.5, 0, 0, 0, -2.0}));
+    EXPECT_EQ(writtenOffsets, (std::vector<size_t>{1, 5}));
+}
+
+TEST(SparseTensor, DensifyCooIndexOutOfBounds) {
+    std::vector<int64_t> indices{2, 0};
+    std::vector<float> values{1.0};
+    std::vector<float> dense(2 * 3, 0);
+    std::vector<size_t> writtenOffsets;
+    auto status = densifyCoo((const char*)indices.data(), (const char*)values.data(), values.size(), sizeof(float),
+        {2, 3}, (char*)dense.data(), writtenOffsets);
+    EXPECT_EQ(status, StatusCode::INVALID_SPARSE_INDEX);
+}
+
+TEST(SparseTensor, DensifyCsr) {
+    std::vector<int64_t> rowPtr{0, 1, 1, 3};
+    std::vector<int64_t> colIndices{2, 0, 1};
+    std::vector<int32_t> values{7, 8, 9};
+    std::vector<int32_t> dense(3 * 3, 0);
+    std::vector<size_t> writtenOffsets;
+    auto status = densifyCsr((const char*)rowPtr.data(), (const char*)colIndices.data(), (const char*)values.data(), values.size(), sizeof(int32_t),
+        {3, 3}, (char*)dense.data(), writtenOffsets);
+    ASSERT_EQ(status, StatusCode::OK);
+    EXPECT_EQ(dense, (std::vector<int32_t>{0, 0, 7, 0, 0, 0, 8, 9, 0}));
+    EXPECT_EQ(writtenOffsets, (std::vector<size_t>{2, 6, 7}));
+}
+
+TEST(SparseTensor, DensifyCsrInvalidRowPtr) {
+    std::vector<int64_t> rowPtr{0, 2, 1, 3};
+    std::vector<int64_t> colIndices{0, 1, 2};
+    std::vector<int32_t> values{1, 2, 3};
+    std::vector<int32_t> dense(3 * 3, 0);
+    std::vector<size_t> writtenOffsets;
+    auto status = densifyCsr((const char*)rowPtr.data(), (const char*)colIndices.data(), (const char*)values.data(), values.size(), sizeof(int32_t),
+        {3, 3}, (char*)dense.data(), writtenOffsets);
+    EXPECT_EQ(status, StatusCode::INVALID_SPARSE_INDEX);
+}
@@ -0,0 +1,127 @@
+//*****************************************************************************
+// Copyright 2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include <cmath>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "../tensor_encoding.hpp"
+
+using namespace ovms;
+
+namespace {
+std::string createFloatContent(size_t elements) {
+    std::vector<float> data(elements);
+    for (size_t i = 0; i < elements; i++) {
+        data[i] = std::sin(i * 0.01f);
+    }
+    return std::string(reinterpret_cast<const char*>(data.data()), data.size() * sizeof(float));
+}
+}  // namespace
+
+TEST(TensorEncoding, ParseEncodings) {
+    std::map<std::string, TensorEncoding> encodings;
+    ASSERT_EQ(parseTensorEncodings("a=deflate, b=shuffle-deflate,c=none", encodings), StatusCode::OK);
+    ASSERT_EQ(encodings.size(), 3);
+    EXPECT_EQ(encodings["a"], TensorEncoding::DEFLATE);
+    EXPECT_EQ(encodings["b"], TensorEncoding::SHUFFLE_DEFLATE);
+    EXPECT_EQ(encodings["c"], TensorEncoding::NONE);
+}
+
+TEST(TensorEncoding, ParseEncodingsWrongFormat) {
+    std::map<std::string, TensorEncoding> encodings;
+    EXPECT_EQ(parseTensorEncodings("a", encodings), StatusCode::TENSOR_ENCODING_WRONG_FORMAT);
+    EXPECT_EQ(parseTensorEncodings("=deflate", encodings), StatusCode::TENSOR_ENCODING_WRONG_FORMAT);
+    EXPECT_EQ(parseTensorEncodings("a=lz4", encodings), StatusCode::TENSOR_ENCODING_WRONG_FORMAT);
+}
+
+TEST(TensorEncoding, RoundTrip) {
+    const auto content = createFloatContent(10000);
+    for (auto encoding : {TensorEncoding::NONE, TensorEncoding::DEFLATE, TensorEncoding::SHUFFLE_DEFLATE}) {
+        std::string encoded, decoded;
+        ASSERT_EQ(encodeTensorContent(encoding, sizeof(float), content, encoded), StatusCode::OK);
+        ASSERT_EQ(decodeTensorContent(encoding, sizeof(float), encoded, content.size(), decoded), StatusCode::OK);
+        EXPECT_EQ(decoded, content) << tensorEncodingToString(encoding);
+    }
+}
+
+TEST(TensorEncoding, ShuffleImprovesFloatsCompression) {
+    const auto content = createFloatContent(10000);
+    std::string deflated, shuffled;
+    ASSERT_EQ(encodeTensorContent(TensorEncoding::DEFLATE, sizeof(float), content, deflated), StatusCode::OK);
+    ASSERT_EQ(encodeTensorContent(TensorEncoding::SHUFFLE_DEFLATE, sizeof(float), content, shuffled), StatusCode::OK);
+    EXPECT_LT(shuffled.size(), deflated.size());
+    EXPECT_LT(deflated.size(), content.size());
+}
+
+TEST(TensorEncoding, DecodeWrongSize) {
+    const auto content = createFloatContent(100);
+    std::string encoded, decoded;
+    ASSERT_EQ(encodeTensorContent(TensorEncoding::SHUFFLE_DEFLATE, sizeof(float), content, encoded), StatusCode::OK);
+    EXPECT_EQ(decodeTensorContent(TensorEncoding::SHUFFLE_DEFLATE, sizeof(float), encoded, content.size() + 4, decoded), StatusCode::TENSOR_DECODING_ERROR);
+    EXPECT_EQ(decodeTensorContent(TensorEncoding::SHUFFLE_DEFLATE, sizeof(float), encoded, content.size() - 4, decoded), StatusCode::TENSOR_DECODING_ERROR);
+    EXPECT_EQ(decodeTensorContent(TensorEncoding::DEFLATE, sizeof(float), "garbage", content.size(), decoded), StatusCode::TENSOR_DECODING_ERROR);
+}
+
+TEST(TensorEncoding, DecodeRequestInputs) {
+    const std::string content = createFloatContent(1000);
+    tensorflow::serving::PredictRequest request;
+    request.mutable_model_spec()->set_name("model");
+    auto& encodedInput = (*request.mutable_inputs())["encoded"];
+    encodedInput.set_dtype(tensorflow::DataType::DT_FLOAT);
+    encodedInput.mutable_tensor_shape()->add_dim()->set_size(1);
+    encodedInput.mutable_tensor_shape()->add_dim()->set_size(1000);
+    ASSERT_EQ(encodeTensorContent(TensorEncoding::SHUFFLE_DEFLATE, sizeof(float), content, *encodedInput.mutable_tensor_content()), StatusCode::OK);
+    auto& plainInput = (*request.mutable_inputs())["plain"];
+    plainInput.set_dtype(tensorflow::DataType::DT_FLOAT);
+    plainInput.mutable_tensor_shape()->add_dim()->set_size(1000);
+    plainInput.mutable_tensor_content()->assign(content);
+
+    DecodedInputs decodedInputs;
+    ASSERT_EQ(decodeRequestInputs({{"encoded", TensorEncoding::SHUFFLE_DEFLATE}}, request, decodedInputs), StatusCode::OK);
+    // Only encoded input is decoded, plain input is read from request without copying
+    ASSERT_EQ(decodedInputs.size(), 1);
+    EXPECT_EQ(decodedInputs.at("encoded"), content);
+    EXPECT_EQ(&getInputContent("encoded", request.inputs().at("encoded"), &decodedInputs), &decodedInputs.at("encoded"));
+    EXPECT_EQ(&getInputContent("plain", request.inputs().at("plain"), &decodedInputs), &request.inputs().at("plain").tensor_content());
+    EXPECT_EQ(&getInputContent("encoded", request.inputs().at("encoded"), nullptr), &request.inputs().at("encoded").tensor_content());
+
+    DecodedInputs missingInputDecoded;
+    EXPECT_EQ(decodeRequestInputs({{"missing", TensorEncoding::DEFLATE}}, request, missingInputDecoded), StatusCode::INVALID_MISSING_INPUT);
+}
+
+TEST(TensorEncoding, DecodeRequestInputsRejectsOversizedShape) {
+    const std::string content = createFloatContent(1000);
+    for (const std::vector<int64_t>& shape : std::vector<std::vector<int64_t>>{
+             {1, -1000},
+             {1ll << 40, 1ll << 40},
+             {1000, 1000, 1000},
+             {1, 1ll << 30}}) {
+        tensorflow::serving::PredictRequest request;
+        auto& input = (*request.mutable_inputs())["input"];
+        input.set_dtype(tensorflow::DataType::DT_FLOAT);
+        for (auto dim : shape) {
+            input.mutable_tensor_shape()->add_dim()->set_size(dim);
+        }
+        ASSERT_EQ(encodeTensorContent(TensorEncoding::DEFLATE, sizeof(float), content, *input.mutable_tensor_content()), StatusCode::OK);
+        DecodedInputs decodedInputs;
+        EXPECT_EQ(decodeRequestInputs({{"input", TensorEncoding::DEFLATE}}, request, decodedInputs), StatusCode::TENSOR_DECODING_ERROR)
+            << "shape dims: " << shape.size();
+    }
+}
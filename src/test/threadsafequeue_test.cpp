@@ -15,6 +15,7 @@
 //*****************************************************************************
 #include <chrono>
 #include <future>
+#include <memory>
 #include <queue>
 #include <thread>
 #include <utility>
@@ -125,3 +126,41 @@ TEST(TestThreadSafeQueue, SeveralThreadsAllElementsPresent) {
         EXPECT_EQ(NUMBER_OF_PRODUCERS, counter);
     }
 }
+
+TEST(TestThreadSafeQueue, NonCopyableElement) {
+    ThreadSafeQueue<NonCopyableInt> queue;
+    queue.push(NonCopyableInt(7));
+    EXPECT_EQ(1, queue.size());
+    auto element = queue.tryPull(WAIT_FOR_ELEMENT_TIMEOUT_MICROSECONDS);
+    ASSERT_TRUE(element.has_value());
+    EXPECT_EQ(NonCopyableInt(7), element.value());
+    EXPECT_EQ(0, queue.size());
+}
+
+TEST(TestThreadSafeQueue, ParkedConsumerIsWokenUp) {
+    ThreadSafeQueue<int> queue;
+    std::promise<void> pulling;
+    auto start = std::chrono::steady_clock::now();
+    std::thread consumerThread([&queue, &pulling]() {
+        pulling.set_value();
+        EXPECT_EQ(3, queue.tryPull(WAIT_FOR_ELEMENT_TIMEOUT_MICROSECONDS));
+    });
+    pulling.get_future().get();
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    queue.push(3);
+    consumerThread.join();
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::microseconds(WAIT_FOR_ELEMENT_TIMEOUT_MICROSECONDS));
+}
+
+TEST(TestThreadSafeQueue, ElementsLeftInQueueAreReleased) {
+    auto element = std::make_shared<int>(1);
+    {
+        ThreadSafeQueue<std::shared_ptr<int>> queue;
+        queue.push(element);
+        queue.push(element);
+        EXPECT_EQ(3, element.use_count());
+        queue.tryPull(WAIT_FOR_ELEMENT_TIMEOUT_MICROSECONDS);
+        EXPECT_EQ(2, element.use_count());
+    }
+    EXPECT_EQ(1, element.use_count());
+}
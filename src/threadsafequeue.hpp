@@ -15,51 +15,159 @@
 //*****************************************************************************
 #pragma once
 
-#include <condition_variable>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <ctime>
 #include <optional>
-#include <queue>
 #include <thread>
 #include <utility>
 
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
 namespace ovms {
 
+/**
+ * @brief Lock-free multiple producers single consumer queue.
+ * Producers never block, consumer spins shortly and then parks on futex until element is pushed or timeout expires.
+ * Used for notifications about finished pipeline nodes, which are pushed from inference callbacks and pulled by the pipeline.
+ */
 template <typename T>
 class ThreadSafeQueue {
 public:
+    ThreadSafeQueue() :
+        head(new Cell),
+        tail(head.load(std::memory_order_relaxed)) {}
+
+    ThreadSafeQueue(const ThreadSafeQueue&) = delete;
+    ThreadSafeQueue& operator=(const ThreadSafeQueue&) = delete;
+
+    ~ThreadSafeQueue() {
+        // producer may still be waking consumer up after its element was pulled
+        while ((state.load(std::memory_order_acquire) >> PRODUCER_SHIFT) != 0) {
+            std::this_thread::yield();
+        }
+        while (tail != nullptr) {
+            Cell* next = tail->next.load(std::memory_order_relaxed);
+            delete tail;
+            tail = next;
+        }
+    }
+
     void push(const T& element) {
-        std::unique_lock<std::mutex> lock(mtx);
-        queue.push(std::move(element));
-        lock.unlock();
-        signal.notify_one();
+        enqueue(new Cell(element));
     }
 
     void push(T&& element) {
-        std::unique_lock<std::mutex> lock(mtx);
-        queue.push(std::move(element));
-        lock.unlock();
-        signal.notify_one();
+        enqueue(new Cell(std::move(element)));
     }
 
+    /**
+     * @brief Pulls element, waiting for it up to given time. May be called only from one thread at a time.
+     */
     std::optional<T> tryPull(const uint waitDurationMicroseconds) {
-        std::unique_lock<std::mutex> lock(mtx);
-        if (signal.wait_for(lock,
-                std::chrono::microseconds(waitDurationMicroseconds),
-                [this]() { return queue.size() > 0; })) {
-            T element = std::move(queue.front());
-            queue.pop();
-            return std::optional<T>{std::move(element)};
-        } else {
-            return std::nullopt;
+        // spinning only delays producers when they share single core with consumer
+        static const uint32_t spinCount = std::thread::hardware_concurrency() > 1 ? SPIN_COUNT : 0;
+        for (uint32_t i = 0; i < spinCount; ++i) {
+            auto element = pop();
+            if (element) {
+                return element;
+            }
+            cpuRelax();
+        }
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::microseconds(waitDurationMicroseconds);
+        while (true) {
+            const uint32_t expected = state.fetch_or(PARKED) | PARKED;
+            auto element = pop();
+            if (element) {
+                state.fetch_and(~PARKED);
+                return element;
+            }
+            const auto now = std::chrono::steady_clock::now();
+            if (now >= deadline) {
+                state.fetch_and(~PARKED);
+                return std::nullopt;
+            }
+            futexWait(expected, std::chrono::duration_cast<std::chrono::nanoseconds>(deadline - now));
         }
     }
 
+    /**
+     * @brief Number of elements in queue. May be called only from consumer thread.
+     */
     size_t size() {
-        return queue.size();
+        size_t count = 0;
+        for (Cell* cell = tail->next.load(std::memory_order_acquire); cell != nullptr; cell = cell->next.load(std::memory_order_acquire)) {
+            ++count;
+        }
+        return count;
     }
 
 private:
-    std::mutex mtx;
-    std::queue<T> queue;
-    std::condition_variable signal;
+    struct Cell {
+        Cell() = default;
+        template <typename U>
+        explicit Cell(U&& element) :
+            value(std::forward<U>(element)) {}
+        std::atomic<Cell*> next{nullptr};
+        std::optional<T> value;
+    };
+
+    // lowest bit of state is set while consumer is parked, the rest counts producers in the middle of push
+    static constexpr uint32_t PARKED = 1;
+    static constexpr uint32_t PRODUCER_SHIFT = 1;
+    static constexpr uint32_t PRODUCER = 1 << PRODUCER_SHIFT;
+    static constexpr uint32_t SPIN_COUNT = 64;
+
+    void enqueue(Cell* cell) {
+        state.fetch_add(PRODUCER);
+        Cell* previous = head.exchange(cell);
+        previous->next.store(cell);
+        // only one of producers which completed push while consumer was parked wakes it up
+        const bool wake = (state.load() & PARKED) && (state.fetch_and(~PARKED) & PARKED);
+        state.fetch_sub(PRODUCER);
+        // futex wake is safe even if consumer already destroyed the queue
+        if (wake) {
+            syscall(SYS_futex, reinterpret_cast<uint32_t*>(&state), FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+        }
+    }
+
+    std::optional<T> pop() {
+        Cell* next = tail->next.load();
+        if (next == nullptr) {
+            return std::nullopt;
+        }
+        std::optional<T> element = std::move(next->value);
+        next->value.reset();
+        delete tail;
+        tail = next;
+        return element;
+    }
+
+    void futexWait(uint32_t expected, std::chrono::nanoseconds timeout) {
+        struct timespec ts;
+        ts.tv_sec = static_cast<decltype(ts.tv_sec)>(timeout.count() / 1'000'000'000);
+        ts.tv_nsec = static_cast<decltype(ts.tv_nsec)>(timeout.count() % 1'000'000'000);
+        syscall(SYS_futex, reinterpret_cast<uint32_t*>(&state), FUTEX_WAIT_PRIVATE, expected, &ts, nullptr, 0);
+    }
+
+    static void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+#else
+        std::this_thread::yield();
+#endif
+    }
+
+    static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t) && std::atomic<uint32_t>::is_always_lock_free,
+        "futex requires plain 32 bit atomic");
+
+    // producers touch head and state, consumer works on tail in separate cache line until it parks
+    alignas(64) std::atomic<Cell*> head;
+    std::atomic<uint32_t> state{0};
+    alignas(64) Cell* tail;
 };
 }  // namespace ovms
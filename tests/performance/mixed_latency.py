@@ -0,0 +1,100 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2020 Intel Corporation
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+import argparse
+import datetime
+import json
+import threading
+import urllib.request
+
+import grpc
+import numpy as np
+from tensorflow import make_tensor_proto
+from tensorflow_serving.apis import predict_pb2
+from tensorflow_serving.apis import prediction_service_pb2_grpc
+
+
+parser = argparse.ArgumentParser(
+    description='Sends concurrent requests via TFS gRPC and REST API using images in numpy format.'
+                ' It measures latency percentiles of each API under mixed load.')
+parser.add_argument('--images_numpy_path', required=True, help='image in numpy format')
+parser.add_argument('--address', default='localhost', help='Specify server address. default: localhost')
+parser.add_argument('--grpc_port', default=9178, help='Specify port to grpc service. default: 9178')
+parser.add_argument('--rest_port', default=5555, help='Specify port to rest service. default: 5555')
+parser.add_argument('--grpc_clients', default=4, type=int, help='Number of concurrent gRPC clients. default: 4')
+parser.add_argument('--rest_clients', default=4, type=int, help='Number of concurrent REST clients. default: 4')
+parser.add_argument('--iterations', default=1000, type=int, help='Number of requests sent by each client. default: 1000')
+parser.add_argument('--input_name', default='input', help='Specify input tensor name. default: input')
+parser.add_argument('--model_name', default='resnet', help='Define model name in payload. default: resnet')
+parser.add_argument('--batchsize', default=1, type=int, help='Number of images in a single request. default: 1')
+args = parser.parse_args()
+
+imgs = np.load(args.images_numpy_path, mmap_mode='r', allow_pickle=False).astype(np.float32)
+while args.batchsize > imgs.shape[0]:
+    imgs = np.append(imgs, imgs, axis=0)
+img = imgs[0:args.batchsize]
+
+latencies = {'grpc': [], 'rest': []}
+lock = threading.Lock()
+
+
+def record(api, start):
+    duration = (datetime.datetime.now() - start).total_seconds() * 1000
+    with lock:
+        latencies[api].append(duration)
+
+
+def grpc_client():
+    channel = grpc.insecure_channel("{}:{}".format(args.address, args.grpc_port))
+    stub = prediction_service_pb2_grpc.PredictionServiceStub(channel)
+    request = predict_pb2.PredictRequest()
+    request.model_spec.name = args.model_name
+    request.inputs[args.input_name].CopyFrom(make_tensor_proto(img, shape=img.shape))
+    for _ in range(args.iterations):
+        start = datetime.datetime.now()
+        stub.Predict(request, 10.0)
+        record('grpc', start)
+
+
+def rest_client():
+    url = "http://{}:{}/v1/models/{}:predict".format(args.address, args.rest_port, args.model_name)
+    body = json.dumps({"inputs": {args.input_name: img.tolist()}}).encode()
+    for _ in range(args.iterations):
+        start = datetime.datetime.now()
+        request = urllib.request.Request(url, data=body, headers={'Content-Type': 'application/json'})
+        with urllib.request.urlopen(request, timeout=10) as response:
+            response.read()
+        record('rest', start)
+
+
+clients = [threading.Thread(target=grpc_client) for _ in range(args.grpc_clients)]
+clients += [threading.Thread(target=rest_client) for _ in range(args.rest_clients)]
+start = datetime.datetime.now()
+for client in clients:
+    client.start()
+for client in clients:
+    client.join()
+duration = (datetime.datetime.now() - start).total_seconds()
+
+for api, values in latencies.items():
+    if not values:
+        continue
+    print("{:4}: requests: {:6}; p50: {:.2f}ms; p90: {:.2f}ms; p99: {:.2f}ms; max: {:.2f}ms".format(
+        api, len(values), np.percentile(values, 50), np.percentile(values, 90),
+        np.percentile(values, 99), np.max(values)))
+total = sum(len(values) for values in latencies.values())
+print("Total: {} requests in {:.2f}s; {:.2f} requests per second".format(total, duration, total / duration))
@@ -0,0 +1,119 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2020 Intel Corporation
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+import argparse
+import datetime
+import zlib
+
+import grpc
+import numpy as np
+from tensorflow import make_tensor_proto
+from tensorflow_serving.apis import predict_pb2
+from tensorflow_serving.apis import prediction_service_pb2_grpc
+
+
+parser = argparse.ArgumentParser(
+    description='Compares per tensor encodings of gRPC predict requests. It reports bytes sent, '
+                'client CPU time of encoding and end to end latency of each encoding.')
+parser.add_argument('--images_numpy_path', required=True, help='image in numpy format')
+parser.add_argument('--grpc_address', default='localhost', help='Specify url to grpc service. default: localhost')
+parser.add_argument('--grpc_port', default=9178, help='Specify port to grpc service. default: 9178')
+parser.add_argument('--iterations', default=100, type=int, help='Number of requests for each encoding. default: 100')
+parser.add_argument('--input_name', default='input', help='Specify input tensor name. default: input')
+parser.add_argument('--model_name', default='resnet', help='Define model name in payload. default: resnet')
+parser.add_argument('--batchsize', default=1, type=int, help='Number of images in a single request. default: 1')
+parser.add_argument('--encode_only', action='store_true', help='Measure compression without sending requests')
+args = parser.parse_args()
+
+ENCODINGS = ['none', 'deflate', 'shuffle-deflate']
+
+imgs = np.load(args.images_numpy_path, mmap_mode='r', allow_pickle=False).astype(np.float32)
+while args.batchsize > imgs.shape[0]:
+    imgs = np.append(imgs, imgs, axis=0)
+img = np.ascontiguousarray(imgs[0:args.batchsize])
+
+
+def encode(data, encoding):
+    if encoding == 'none':
+        return data.tobytes()
+    raw = data.view(np.uint8).reshape(-1, data.itemsize)
+    if encoding == 'shuffle-deflate':
+        raw = raw.T
+    return zlib.compress(np.ascontiguousarray(raw).tobytes(), 1)
+
+
+def decode(content, dtype, encoding):
+    if encoding == 'none':
+        return np.frombuffer(content, dtype=dtype)
+    raw = np.frombuffer(zlib.decompress(content), dtype=np.uint8)
+    itemsize = np.dtype(dtype).itemsize
+    if encoding == 'shuffle-deflate':
+        raw = np.ascontiguousarray(raw.reshape(itemsize, -1).T)
+    return raw.view(dtype)
+
+
+def create_request(encoding):
+    request = predict_pb2.PredictRequest()
+    request.model_spec.name = args.model_name
+    tensor = make_tensor_proto(img, shape=img.shape)
+    tensor.tensor_content = encode(img, encoding)
+    request.inputs[args.input_name].CopyFrom(tensor)
+    return request
+
+
+def measure_encoding(encoding):
+    start = datetime.datetime.now()
+    for _ in range(args.iterations):
+        content = encode(img, encoding)
+    encode_ms = (datetime.datetime.now() - start).total_seconds() * 1000 / args.iterations
+    return len(content), encode_ms
+
+
+def measure_latency(stub, encoding):
+    request = create_request(encoding)
+    metadata = [('ovms-accept-tensor-encoding', encoding)]
+    if encoding != 'none':
+        metadata.append(('ovms-tensor-encoding', '{}={}'.format(args.input_name, encoding)))
+    latencies = []
+    for _ in range(args.iterations):
+        start = datetime.datetime.now()
+        response, call = stub.Predict.with_call(request, 10.0, metadata=metadata)
+        encoded_outputs = {}
+        for key, value in call.initial_metadata():
+            if key == 'ovms-tensor-encoding':
+                encoded_outputs.update(entry.split('=') for entry in value.split(','))
+        for name, output in response.outputs.items():
+            if name in encoded_outputs:
+                decode(output.tensor_content, np.float32, encoded_outputs[name])
+        latencies.append((datetime.datetime.now() - start).total_seconds() * 1000)
+    return np.mean(latencies), np.percentile(latencies, 99)
+
+
+stub = None
+if not args.encode_only:
+    channel = grpc.insecure_channel("{}:{}".format(args.grpc_address, args.grpc_port))
+    stub = prediction_service_pb2_grpc.PredictionServiceStub(channel)
+
+raw_size = img.nbytes
+for encoding in ENCODINGS:
+    size, encode_ms = measure_encoding(encoding)
+    line = "{:16} bytes: {:10} ({:5.1f}%); encode: {:.3f}ms".format(
+        encoding, size, size * 100.0 / raw_size, encode_ms)
+    if stub is not None:
+        mean, p99 = measure_latency(stub, encoding)
+        line += "; latency avg: {:.2f}ms; p99: {:.2f}ms".format(mean, p99)
+    print(line)
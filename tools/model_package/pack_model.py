@@ -0,0 +1,85 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2020 Intel Corporation
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+"""Packs model version directory into single file model package (.ovmp) loaded by the model server."""
+
+import argparse
+import os
+import struct
+
+MAGIC = b'OVMSPKG1'
+ALIGNMENT = 4096
+
+
+def align(offset):
+    return (offset + ALIGNMENT - 1) // ALIGNMENT * ALIGNMENT
+
+
+def collect_entries(args):
+    entries = []
+    if args.xml:
+        entries.append(('model.xml', args.xml))
+        entries.append(('model.bin', args.bin or os.path.splitext(args.xml)[0] + '.bin'))
+    else:
+        entries.append(('model.onnx', args.onnx))
+    if args.mapping:
+        entries.append(('mapping_config.json', args.mapping))
+    for precompiled in args.precompiled or []:
+        device, path = precompiled.split('=', 1)
+        entries.append(('precompiled/' + device, path))
+    return entries
+
+
+def write_package(output, entries):
+    names = [name.encode() for name, _ in entries]
+    sizes = [os.path.getsize(path) for _, path in entries]
+    offset = len(MAGIC) + 8 + sum(20 + len(name) for name in names)
+    offsets = []
+    for size in sizes:
+        offset = align(offset)
+        offsets.append(offset)
+        offset += size
+    with open(output, 'wb') as package:
+        package.write(MAGIC + struct.pack('<II', len(entries), 0))
+        for name, offset, size in zip(names, offsets, sizes):
+            package.write(struct.pack('<QQI', offset, size, len(name)) + name)
+        for (_, path), offset in zip(entries, offsets):
+            package.write(b'\0' * (offset - package.tell()))
+            with open(path, 'rb') as entry:
+                while True:
+                    chunk = entry.read(1 << 20)
+                    if not chunk:
+                        break
+                    package.write(chunk)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Packs model files into single file model package')
+    model = parser.add_mutually_exclusive_group(required=True)
+    model.add_argument('--xml', help='model in IR format; weights are read from .bin file with the same name unless --bin is set')
+    model.add_argument('--onnx', help='model in ONNX format')
+    parser.add_argument('--bin', help='weights of IR model')
+    parser.add_argument('--mapping', help='mapping_config.json of model version')
+    parser.add_argument('--precompiled', action='append', metavar='DEVICE=PATH',
+                        help='network exported for target device, can be repeated')
+    parser.add_argument('--output', required=True, help='package path, for example models/resnet/1/resnet.ovmp')
+    args = parser.parse_args()
+    write_package(args.output, collect_entries(args))
+
+
+if __name__ == '__main__':
+    main()